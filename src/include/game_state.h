@@ -1,6 +1,7 @@
 #ifndef NETPLAY_GAME_STATE_H
 #define NETPLAY_GAME_STATE_H
 
+#include "sf33rd/Source/Game/effect/effect.h"
 #include "sf33rd/Source/Game/ending/end_data.h"
 #include "sf33rd/Source/Game/engine/cmb_win.h"
 #include "sf33rd/Source/Game/engine/grade.h"
@@ -695,4 +696,25 @@ typedef struct GameState {
 void GameState_Save(GameState* dst);
 void GameState_Load(const GameState* src);
 
+// Effect work kept outside GameState; field names match the globals
+typedef struct EffectState {
+    s16 frwctr;
+    s16 frwctr_min;
+    s16 head_ix[8];
+    s16 tail_ix[8];
+    s16 exec_tm[8];
+    uintptr_t frw[EFFECT_MAX][448];
+    s16 frwque[EFFECT_MAX];
+} EffectState;
+
+// Everything a netplay rollback saves and restores. Benchmark rollbacks and
+// the training lookahead snapshot the match through the same pair.
+typedef struct RollbackState {
+    GameState gs;
+    EffectState es;
+} RollbackState;
+
+void RollbackState_Save(RollbackState* dst);
+void RollbackState_Load(const RollbackState* src);
+
 #endif
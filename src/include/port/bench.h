@@ -0,0 +1,60 @@
+#ifndef PORT_BENCH_H
+#define PORT_BENCH_H
+
+#include <stdbool.h>
+
+// Deterministic scenario benchmark (`3sx --bench <scenario>`, or the
+// `3sx_bench` build target). Boots normally from the AFS, then drives the
+// attract mode with all pad input held at neutral:
+//
+//   attract   the attract loop from boot: logo, title, demo fights, ranking
+//   versus    20 CPU-vs-CPU demo fights, character i against i + 1, so
+//             every character is timed once on each side
+//   supers    the first 5 versus pairs with super arts always available
+//             (effects-heavy)
+//   rollback  the first 5 versus pairs, where every frame also rewinds and
+//             resimulates --bench-rollback frames, like a worst-case
+//             netplay rollback
+//
+// Each fight costs a full attract cycle to reach, so the scenarios sample
+// the roster rather than cover all 400 character pairs; the report gives
+// the number of pairs each scenario ran.
+//
+// Each frame's time is split into the sections below and the per-frame
+// percentiles are written as JSON (--bench-out), so runs on different
+// machines and architectures can be compared and tracked. Backends that
+// track GPU uploads (SDL_GPU) also report texture/palette KiB per frame and
+// dropped texture uploads.
+
+typedef enum BenchSection {
+    BENCH_SECTION_LOGIC = 0, // Game tasks, players, effects, timers, BGM server
+    BENCH_SECTION_SPRITES,   // Sprite/texture transfer and 2D primitive flush
+    BENCH_SECTION_RENDER,    // Render submission and present
+    BENCH_SECTION_AUDIO,     // SPU mix (mixed on the game thread while benchmarking)
+    BENCH_SECTION_STATE,     // Rollback state save/load
+    BENCH_SECTION_COUNT
+} BenchSection;
+
+typedef struct BenchFrameHooks {
+    void (*step_0)(void); // Input, game logic and sprite flush (pre-render)
+    void (*step_1)(void); // Timers, screen transitions, BGM (post-render)
+} BenchFrameHooks;
+
+// True if --bench was given on the command line.
+bool Bench_IsRequested(void);
+
+// Run the requested scenarios after game init and write the report.
+// Returns the process exit code.
+int Bench_Run(const BenchFrameHooks* hooks);
+
+// True while a scenario is being driven.
+bool Bench_IsRunning(void);
+
+// Neutralize this frame's pad input. Called right after the pads are read.
+void Bench_ClearInput(void);
+
+// Bracket a section of the frame. No-ops unless a scenario is running.
+void Bench_BeginSection(BenchSection section);
+void Bench_EndSection(BenchSection section);
+
+#endif
@@ -15,6 +15,13 @@ typedef struct BroadcastConfig {
     bool show_ui;
 } BroadcastConfig;
 
+typedef struct BroadcastStats {
+    bool measured;    // False until the backend has a full window of sends
+    double send_ms;   // Mean game-thread cost of a send over the last window
+    uint32_t frames;  // Sends in that window
+    uint32_t dropped; // Frames the consumer had no buffer for in that window
+} BroadcastStats;
+
 /// Interface for platform-specific broadcast backends
 typedef struct BroadcastPort {
     /// Initialize the broadcast backend
@@ -32,6 +39,9 @@ typedef struct BroadcastPort {
 
     /// Update configuration
     void (*UpdateConfig)(const BroadcastConfig* config);
+
+    /// Send cost of the last stats window (optional)
+    void (*GetStats)(BroadcastStats* out);
 } BroadcastPort;
 
 // Public API
@@ -39,5 +49,6 @@ void Broadcast_Initialize(void);
 void Broadcast_Shutdown(void);
 bool Broadcast_Send(uint32_t texture_id, uint32_t width, uint32_t height, bool is_flipped);
 void Broadcast_Update(void); // Call this to sync config changes
+void Broadcast_GetStats(BroadcastStats* out);
 
 #endif
@@ -3,7 +3,7 @@
  * @brief Native filesystem save system — replaces PS2 memory card subsystem.
  *
  * Provides direct file I/O for options (INI), direction config (INI), and
- * replay data (binary). All operations are synchronous — no async state
+ * replay data (binary, see port/replay_format.h). All operations are synchronous — no async state
  * machine needed on modern platforms.
  */
 
@@ -61,7 +61,14 @@ void NativeSave_SaveDirection(void);
 
 /* ── Replay ────────────────────────────────────────────────────────── */
 
-#define NATIVE_SAVE_REPLAY_SLOTS 20
+/*
+ * Replays are numbered 0..count-1 in the order they were first saved. The
+ * list comes from replays/index.bin, so none of these open a replay file
+ * except Load/Save/Delete.
+ */
+
+/** Number of saved replays. */
+int NativeSave_GetReplayCount(void);
 
 /** Check if a replay slot has a saved file. Returns 1=exists, 0=empty. */
 int NativeSave_ReplayExists(int slot);
@@ -72,12 +79,15 @@ int NativeSave_GetReplayInfo(int slot, _sub_info* out);
 /** Load replay data from slot. Returns 0 on success. */
 int NativeSave_LoadReplay(int slot);
 
-/** Save current replay data to slot. Returns 0 on success. */
+/** Save current replay data to slot; slot == count saves a new replay. Returns 0 on success. */
 int NativeSave_SaveReplay(int slot);
 
-/** Delete a replay slot. Returns 0 on success. */
+/** Delete a replay slot; later slots move down by one. Returns 0 on success. */
 int NativeSave_DeleteReplay(int slot);
 
+/** Convert a v1 replay (replay_NN.bin plus optional .meta sidecar) to a v2 file. Returns 0 on success. */
+int NativeSave_ConvertReplayV1(const char* v1_path, const char* meta_path, const char* out_path);
+
 /* ── Utility ───────────────────────────────────────────────────────── */
 
 /** Get the save directory path (for debug display). */
@@ -0,0 +1,57 @@
+#ifndef PORT_RECORDER_H
+#define PORT_RECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Built-in gameplay recorder: captures the 384x224 game canvas and the
+// SPU/ADX audio into a compact .3sxrec file (see recorder_codec.h).
+// Encoding and file I/O run on a worker thread; the game thread only
+// queues an asynchronous readback and copies out the one that finished.
+
+// Game-thread capture cost the recorder aims to stay under, per frame
+#define RECORDER_CAPTURE_BUDGET_US 250.0
+
+typedef enum RecorderAudioSource {
+    RECORDER_AUDIO_SPU = 0, // Sound effects and voices
+    RECORDER_AUDIO_ADX = 1, // Streamed BGM
+    RECORDER_AUDIO_SOURCE_COUNT
+} RecorderAudioSource;
+
+typedef struct RecorderStats {
+    bool active;
+    uint64_t frames;         // Video frames written, including repeats
+    uint64_t repeated;       // Frames the encoder had no room for
+    uint64_t bytes;          // File size so far
+    double capture_us;       // Smoothed game-thread cost per frame
+    double capture_max_us;   // Worst game-thread cost of this recording
+    double encode_ms;        // Smoothed worker time per frame
+    uint64_t audio_overruns; // Sample blocks dropped because the worker fell behind
+} RecorderStats;
+
+// Start recording to `path`. Only the OpenGL backend can capture; returns
+// false (and logs why) otherwise or if the file can't be created.
+bool Recorder_Start(const char* path);
+
+// Stop and finalize the file. Blocks until the worker has written
+// everything queued. Safe to call when not recording.
+void Recorder_Stop(void);
+
+// Start recording to a timestamped file in the user's recordings folder,
+// or stop the running recording.
+void Recorder_Toggle(void);
+
+bool Recorder_IsActive(void);
+
+// Game thread, once per rendered frame: queue a readback of the canvas
+// texture and hand the frame that completed to the encoder.
+void Recorder_CaptureFrameGL(uint32_t texture_id, int width, int height);
+
+// Audio threads: copy interleaved stereo S16 samples produced by a source,
+// scaled by the gain the device applies to that source's stream.
+// Lock-free; samples are dropped if the worker falls behind.
+void Recorder_PushAudio(RecorderAudioSource source, const int16_t* samples, int sample_frames, float gain);
+
+void Recorder_GetStats(RecorderStats* out);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef PORT_REPLAY_LOG_H
+#define PORT_REPLAY_LOG_H
+
+#include "types.h"
+
+#include <stdbool.h>
+
+// Growable input log behind replay recording and playback, replacing the
+// fixed Replay_w.io_unit.key_buff so matches of any length fit. Entries keep
+// the PS2 key_buff code format: the key in the low 12 bits and the run
+// length - 1 in the top 4.
+
+// Empty both players' logs.
+void ReplayLog_Clear(void);
+
+// Append a code. Returns false if the log can't grow.
+bool ReplayLog_Push(int player, u16 code);
+
+u32 ReplayLog_Count(int player);
+const u16* ReplayLog_Codes(int player);
+
+// Replace a player's log with `codes` (malloc'd, ownership moves to the log).
+void ReplayLog_Adopt(int player, u16* codes, u32 count);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PORT_REPLAY_VIEWER_H
+#define PORT_REPLAY_VIEWER_H
+
+#include <stdbool.h>
+
+// Replay viewer controls: fast-forward, pause and frame step while a saved
+// replay plays back. Fast-forward runs the extra game ticks with their
+// rendering discarded and only presents the last one; the tick count adapts
+// to measured costs (replay_pacer.h) so playback never falls behind real
+// time, even at 1x on machines that can't render every frame.
+
+typedef enum ReplayViewerSpeed {
+    REPLAY_VIEWER_SPEED_1X = 0,
+    REPLAY_VIEWER_SPEED_2X,
+    REPLAY_VIEWER_SPEED_4X,
+    REPLAY_VIEWER_SPEED_8X,
+    REPLAY_VIEWER_SPEED_MAX, // As many ticks as fit in the frame budget
+    REPLAY_VIEWER_SPEED_COUNT
+} ReplayViewerSpeed;
+
+// True while a saved replay is playing back.
+bool ReplayViewer_IsActive(void);
+
+// Main thread (hotkeys). Ignored outside replay playback.
+void ReplayViewer_ChangeSpeed(int direction);
+void ReplayViewer_TogglePause(void);
+void ReplayViewer_Step(void);
+
+// Game thread, once per displayed frame before its game tick. Runs this
+// frame's logic-only fast-forward ticks through `logic_tick`. Returns false
+// if playback is paused and the frame must not tick at all.
+bool ReplayViewer_BeginFrame(void (*logic_tick)(void));
+
+// Game thread, during the presented tick: draw the speed/pause indicator.
+void ReplayViewer_DrawStatus(void);
+
+#endif
@@ -33,6 +33,13 @@ typedef struct Sprite2 {
     unsigned int id;
 } Sprite2;
 
+// Texture and palette data sent to the GPU for one rendered frame
+typedef struct SDLGameRenderer_UploadStats {
+    unsigned int texture_bytes;
+    unsigned int palette_bytes;
+    unsigned int drops; // Textures that couldn't be uploaded and weren't drawn
+} SDLGameRenderer_UploadStats;
+
 extern unsigned int cps3_canvas_texture;
 
 void SDLGameRenderer_Init();
@@ -40,6 +47,7 @@ void SDLGameRenderer_Shutdown();
 void SDLGameRenderer_BeginFrame();
 void SDLGameRenderer_RenderFrame();
 void SDLGameRenderer_EndFrame();
+void SDLGameRenderer_ResetBatchState();
 
 void SDLGameRenderer_CreateTexture(unsigned int th);
 void SDLGameRenderer_DestroyTexture(unsigned int texture_handle);
@@ -47,6 +55,7 @@ void SDLGameRenderer_UnlockTexture(unsigned int th);
 void SDLGameRenderer_CreatePalette(unsigned int ph);
 void SDLGameRenderer_DestroyPalette(unsigned int palette_handle);
 void SDLGameRenderer_UnlockPalette(unsigned int ph);
+void SDLGameRenderer_UnlockPalettes(unsigned int first, unsigned int count);
 void SDLGameRenderer_SetTexture(unsigned int th);
 void SDLGameRenderer_DrawTexturedQuad(const Sprite* sprite, unsigned int color);
 void SDLGameRenderer_DrawSolidQuad(const Quad* vertices, unsigned int color);
@@ -57,4 +66,13 @@ void SDLGameRenderer_DrawSprite2(const Sprite2* sprite2);
 // Used by ImGui to render game textures. Returns 0 if not found/invalid.
 unsigned int SDLGameRenderer_GetCachedGLTexture(unsigned int texture_handle, unsigned int palette_handle);
 
+// Upload stats for the last rendered frame. Returns false if the active
+// backend doesn't track them.
+bool SDLGameRenderer_GetUploadStats(SDLGameRenderer_UploadStats* stats);
+
+// Render pipeline: resource and draw calls made from `thread` are recorded instead
+// of executed, then run in order by ReplayRecorded on the graphics thread.
+void SDLGameRenderer_SetRecordingThread(SDL_ThreadID thread);
+void SDLGameRenderer_ReplayRecorded(void);
+
 #endif
@@ -5,16 +5,32 @@
 extern "C" {
 #endif
 
+/// SHADOW: one-pixel drop shadow down-right. OUTLINE: one-pixel black outline.
+typedef enum TextStyle {
+    TEXT_STYLE_PLAIN,
+    TEXT_STYLE_SHADOW,
+    TEXT_STYLE_OUTLINE,
+} TextStyle;
+
+/// Overlay work submitted by the last flush.
+typedef struct TextRendererStats {
+    int draw_calls;
+    int quads;
+} TextRendererStats;
+
 void SDLTextRenderer_Init(const char* base_path, const char* font_path);
 void SDLTextRenderer_Shutdown(void);
 void SDLTextRenderer_DrawText(const char* text, float x, float y, float scale, float r, float g, float b,
                               float target_width, float target_height);
+void SDLTextRenderer_DrawTextStyled(const char* text, float x, float y, float scale, float r, float g, float b,
+                                    TextStyle style, float target_width, float target_height);
 void SDLTextRenderer_DrawDebugBuffer(float target_width, float target_height);
 void SDLTextRenderer_SetYOffset(float y_offset);
 void SDLTextRenderer_SetBackgroundEnabled(int enabled);
 void SDLTextRenderer_SetBackgroundColor(float r, float g, float b, float a);
 void SDLTextRenderer_SetBackgroundPadding(float px);
 void SDLTextRenderer_Flush(void);
+void SDLTextRenderer_GetStats(TextRendererStats* out);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,69 @@
+#ifndef PORT_SELFPLAY_H
+#define PORT_SELFPLAY_H
+
+#include <stdbool.h>
+
+// CPU-vs-CPU self-play for AI and balance testing (`3sx --selfplay <matches>`,
+// or the `3sx_selfplay` build target). Boots normally from the AFS and plays
+// the attract mode's demo fight over and over with all pad input held at
+// neutral, so both sides are the com/ AI at the demo's level. Match n of a
+// run with --selfplay-seed S uses seed S + n, which picks both characters,
+// their super arts, the stage and the engine RNG at the first fight frame;
+// the demo's random handicap and 30 second cut are switched off.
+//
+// Headless runs are logic-only ticks with texture transfers and sound
+// requests dropped, presenting once per SELFPLAY_TICKS_PER_PRESENT ticks, and
+// with --selfplay-jobs the matches are split over independent worker
+// processes. The JSON report (--selfplay-out) has win rates per character,
+// how the matches ended and how long they took, attacks started per
+// character and move id, ticks/second, and every match's seed and setup.
+//
+// A match is reproduced by running its seed alone, and watched with
+// --selfplay-watch, which plays it at normal speed with picture and sound:
+//
+//   3sx --selfplay 1 --selfplay-seed <seed> --selfplay-watch
+//
+// Each match starts from the engine state the first one was set up in, so it
+// plays the same alone as in sequence. --selfplay-check verifies that: it
+// replays the last match of each worker alone, marks those matches "same" or
+// "differs" in the report and counts the mismatches; any mismatch makes the
+// exit code 1.
+
+#define SELFPLAY_TICKS_PER_PRESENT 256
+
+typedef struct SelfPlayHooks {
+    void (*step_0)(void);     // Input, game logic and sprite flush (pre-render)
+    void (*step_1)(void);     // Timers, screen transitions, BGM (post-render)
+    void (*logic_tick)(void); // step_0 and step_1 with the frame's rendering discarded
+} SelfPlayHooks;
+
+// True if --selfplay was given on the command line.
+bool SelfPlay_IsRequested(void);
+
+// True if this run only spawns workers and merges their results (with
+// --selfplay-jobs other than 1, or --selfplay-check). Such a run needs no
+// window or game: call SelfPlay_RunWorkers instead of booting.
+bool SelfPlay_IsParent(void);
+
+// Split the matches over worker processes of argv[0], which get the other
+// options in argv, then write the merged report. Returns the process exit code.
+int SelfPlay_RunWorkers(int argc, char* argv[]);
+
+// Set up a headless run before SDLApp_Init: no audio device is opened.
+void SelfPlay_PrepareHeadless(void);
+
+// Play the requested matches after game init and write the report (or, in
+// a worker, the totals for the parent). Returns the process exit code.
+int SelfPlay_Run(const SelfPlayHooks* hooks);
+
+// True while matches are being played.
+bool SelfPlay_IsRunning(void);
+
+// Apply the next match's characters, super arts and stage. Called where the
+// attract demo fight is set up, before its data is loaded.
+void SelfPlay_SetupFight(void);
+
+// Count one fight tick. Called from the player update every tick of a fight.
+void SelfPlay_Tick(void);
+
+#endif
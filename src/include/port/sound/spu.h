@@ -22,4 +22,9 @@ bool SPU_VoiceIsFinished(int vnum);
 void SPU_VoiceKeyOff(int vnum);
 void SPU_VoiceStop(int vnum);
 
+// Offline mixing (used by the benchmark): with manual mix on, the audio
+// device is paused and the SPU only advances when SPU_Mix is called.
+void SPU_SetManualMix(bool manual);
+void SPU_Mix(s16* output, int sample_frames);
+
 #endif // SPU_H_
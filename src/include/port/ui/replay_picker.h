@@ -19,7 +19,7 @@ int ReplayPicker_Update(void);
 
 /**
  * @brief Get the slot chosen by the user after Update() returns 0.
- * @return Slot index 0-19, or -1 if none selected.
+ * @return Replay slot (NativeSave_GetReplayCount() for a new replay in save mode), or -1 if none selected.
  */
 int ReplayPicker_GetSelectedSlot(void);
 
@@ -5,6 +5,7 @@
  * Manages a pool of memory blocks identified by handles. Supports
  * forward/reverse allocation, aligned allocation, defragmentation
  * via compaction, and temporary (non-persistent) allocations.
+ * Compaction is skipped entirely while the pool is known to be gap-free.
  *
  * Part of the AcrSDK common module.
  * Originally from the PS2 SDK abstraction layer.
@@ -36,6 +37,10 @@ typedef struct {
     s32 used_size;
     s32 tmemsize;
     u32 blocklist;
+    u32 generation;         // Bumped whenever a gap may have opened between blocks
+    u32 compact_generation; // Generation at the last completed compaction
+    u32 compact_count;      // Compactions that actually ran
+    u32 compact_moved;      // Bytes moved by compaction, cumulative
 } MEM_MGR;
 
 void plmemInit(MEM_MGR* memmgr, MEM_BLOCK* block, s32 count, void* mem_ptr, s32 memsize, s32 memalign, s32 direction);
@@ -0,0 +1,29 @@
+/**
+ * @file flps2convert.h
+ * @brief Pixel format conversion between plContext surfaces and GS-native layouts.
+ *
+ * The texture/palette creation and lock paths convert between the game's
+ * pixel formats and the GS ones (PSMCT16/24/32, R and B swapped). Each
+ * entry point picks a kernel specialised for the (source format,
+ * destination format, CLUT swizzle) combination and falls back to the
+ * generic per-pixel converter for anything without one; both produce
+ * byte-identical output.
+ *
+ * Part of the AcrSDK ps2 module.
+ */
+#ifndef FLPS2CONVERT_H
+#define FLPS2CONVERT_H
+
+#include "sf33rd/AcrSDK/common/plcommon.h"
+#include "types.h"
+
+/** @brief Converts `count` contiguous pixels from `src` to `dst`. */
+typedef void (*FLPS2ConvertKernel)(const u8* src, u8* dst, s32 count);
+
+s32 flPS2ConvertContext(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type);
+s32 flPS2ConvertContextGeneric(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type);
+FLPS2ConvertKernel flPS2GetConvertKernel(const plContext* lpSrc, const plContext* lpDst, u32 direction, u32 type);
+s32 flPS2ConvertLockContext(plContext* dst, plContext* src);
+FLPS2ConvertKernel flPS2GetLockKernel(const plContext* dst, const plContext* src);
+
+#endif
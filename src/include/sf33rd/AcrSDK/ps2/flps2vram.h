@@ -14,10 +14,10 @@
 #define FLPS2VRAM_H
 
 #include "sf33rd/AcrSDK/common/plcommon.h"
+#include "sf33rd/AcrSDK/ps2/flps2convert.h"
 #include "structs.h"
 #include "types.h"
 
-s32 flPS2ConvertContext(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type);
 u32 flPS2GetPaletteHandle();
 s32 flPS2CreatePaletteHandle(u32 ph, u32 flag);
 s32 flPS2GetPaletteInfoFromContext(plContext* bits, u32 ph, u32 flag);
@@ -34,6 +34,7 @@ void flPS2VramInit();
 s16 flPS2GetVramSize();
 s32 flLockPalette(Rect* lprect, u32 th, plContext* lpcontext, u32 flag);
 s32 flUnlockPalette(u32 th);
+s32 flUnlockPalettes(u32 th, s32 count);
 void flPS2PurgePaletteFromVRAM(u32 ph);
 void flPS2PurgeTextureFromVRAM(u32 th);
 
@@ -3,8 +3,10 @@
  * @brief Doubly-linked-list heap memory manager.
  *
  * Provides a best-fit allocator that supports both forward and reverse
- * allocation within a pre-allocated memory region. Used by the PPG
- * subsystem and the zlib decompression wrapper.
+ * allocation within a pre-allocated memory region. Free gaps are indexed
+ * by size class so allocation cost scales with the gaps of one class, not
+ * the whole cell list. Used by the PPG subsystem, the Ramcnt key pool and
+ * the zlib decompression wrapper.
  *
  * Part of the Common module.
  * Originally from the PS2 memory management module.
@@ -15,6 +17,19 @@
 #include "structs.h"
 #include "types.h"
 
+/** @brief Allocation counters plus a fragmentation snapshot, filled by mmGetStats(). */
+typedef struct {
+    u32 allocCount;
+    u32 freeCount;
+    u32 failCount;
+    u32 probeMax;      // Most free-list nodes examined by one allocation
+    f32 probeAvg;      // Mean free-list nodes examined per allocation
+    u32 freeBlocks;    // Number of distinct free gaps
+    ssize_t freeTotal; // Sum of all free gaps (includes cell headers to be carved)
+    ssize_t freeLargest;
+    f32 fragmentation; // 100 * (1 - largest / total), 0 when unfragmented
+} MMStats;
+
 void mmSystemInitialize();
 void mmHeapInitialize(_MEMMAN_OBJ* mmobj, u8* adrs, s32 size, s32 unit, s8* format);
 uintptr_t mmRoundUp(s32 unit, uintptr_t num);
@@ -25,5 +40,6 @@ ssize_t mmGetRemainderMin(_MEMMAN_OBJ* mmobj);
 u8* mmAlloc(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag);
 struct _MEMMAN_CELL* mmAllocSub(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag);
 void mmFree(_MEMMAN_OBJ* mmobj, u8* adrs);
+void mmGetStats(_MEMMAN_OBJ* mmobj, MMStats* out);
 
 #endif
@@ -886,6 +886,23 @@ typedef struct _MEMMAN_CELL {
     ssize_t size;
 } _MEMMAN_CELL;
 
+#define MEMMAN_FREE_BINS 32
+
+/** Free-gap node, stored in-place at the start of every non-empty gap between cells. */
+typedef struct _MEMMAN_FREE {
+    struct _MEMMAN_FREE* prev;
+    struct _MEMMAN_FREE* next;
+    struct _MEMMAN_CELL* owner; // Cell immediately below the gap
+} _MEMMAN_FREE;
+
+typedef struct {
+    u32 allocCount;
+    u32 freeCount;
+    u32 failCount;
+    u32 probeTotal; // Free-list nodes examined across all allocations
+    u32 probeMax;   // Worst case for a single allocation
+} _MEMMAN_STATS;
+
 typedef struct {
     u8* memHead;
     ssize_t memSize;
@@ -898,6 +915,9 @@ typedef struct {
     u8* oriHead;
     s32 oriSize;
     s32 debIndex;
+    struct _MEMMAN_FREE* freeBin[MEMMAN_FREE_BINS];
+    u32 freeMap;
+    _MEMMAN_STATS stats;
 } _MEMMAN_OBJ;
 
 typedef struct {
@@ -1224,7 +1244,7 @@ typedef struct {
     s32 size;
     s32 sect;
     u16 fnum;
-    u8 free[2];
+    s16 afs; // AFSHandle of the open file, AFS_NONE when closed
     TEX_GRP_LD* lds;
     struct {
         u32 number;
@@ -1556,6 +1576,31 @@ typedef struct {
     PatternInstance patt[64];
 } PatternCollection;
 
+#define CASH_WHEEL_SIZE 32
+
+/** Texture cache entry's place in a CashWheel slot list. */
+typedef struct {
+    u16 next;
+    u16 prev;
+    u16 due; // Low 16 bits of the tick the entry expires on
+    u16 be;
+} CashWheelLink;
+
+/** Timing wheel of texture cache lifetimes, one list of entries per expiry tick modulo CASH_WHEEL_SIZE. */
+typedef struct {
+    u32 tick;
+    s32 count;
+    CashWheelLink* link;
+    u16 head[CASH_WHEEL_SIZE];
+} CashWheel;
+
+/** What a texture cache tile held when it was last freed; the pixels stay in place until the tile is reused. */
+typedef struct {
+    PatternCode cs; // -1 if nothing worth taking back
+    s16 state;
+    u32 freed; // Wheel tick the tile was freed on, 0 if never
+} PatternHistory;
+
 typedef struct {
     s32 mltnum16;
     s32 mltnum32;
@@ -1573,6 +1618,10 @@ typedef struct {
     PatternCollection* cpat;
     TexturePoolFree* tpf;
     TexturePoolUsed* tpu;
+    PatternHistory* mltold16;
+    PatternHistory* mltold32;
+    u8* hostmem;
+    CashWheel wheel;
     u8 id;
     u8 ext;
     s16 mode;
@@ -1912,7 +1961,8 @@ typedef struct {
     Palette palCP3;
     s16 req[32][2];
     s16 reqNum;
-    u32 upBits;
+    u32 upBits;        // Dirty palDC rows, one bit per 64-color row
+    u32 upBitsCP3[16]; // Dirty palCP3 rows, one bit per ColorRAM row
 } Col3rd_W;
 
 typedef struct {
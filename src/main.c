@@ -14,9 +14,13 @@
 #include "main.h"
 #include "common.h"
 #include "netplay/netplay.h"
+#include "netplay/spectator_relay.h"
 #include "port/renderer.h"
 #include "port/sdl/sdl_app.h"
 #include "port/sdl/sdl_app_config.h"
+#include "port/sdl/sdl_game_renderer.h"
+#include "port/sdl/sdl_pad.h"
+#include "port/sdl/sdl_render_pipeline.h"
 #include "sf33rd/AcrSDK/common/mlPAD.h"
 #include "sf33rd/AcrSDK/ps2/flps2debug.h"
 #include "sf33rd/AcrSDK/ps2/flps2etc.h"
@@ -44,6 +48,7 @@
 #include "sf33rd/Source/Game/system/sys_sub.h"
 #include "sf33rd/Source/Game/system/sys_sub2.h"
 #include "sf33rd/Source/Game/system/work_sys.h"
+#include "sf33rd/Source/Game/training/training_fork.h"
 #include "sf33rd/Source/Game/training/training_hud.h"
 
 #include "menu_bridge.h"
@@ -55,9 +60,12 @@
 #include "sf33rd/Source/Game/debug/debug_config.h"
 #endif
 
+#include "port/bench.h"
 #include "port/cli_parser.h"
 #include "port/io/afs.h"
+#include "port/replay_viewer.h"
 #include "port/resources.h"
+#include "port/selfplay.h"
 
 #include <SDL3/SDL.h>
 
@@ -95,10 +103,14 @@ static int s_lag_test_initial_routine = 0;
 static int s_lag_test_initial_routine_1 = 0;
 static Uint64 s_lag_test_start_ticks = 0;
 
+// Set when the replay viewer holds this frame (paused playback)
+static bool replay_frame_held = false;
+
 // forward decls
 static void game_init();
 static void game_step_0();
 static void game_step_1();
+static void replay_logic_tick();
 static void init_windows_console();
 
 void distributeScratchPadAddress();
@@ -139,7 +151,8 @@ static void afs_init() {
 /**
  * @brief Pre-render frame step: process input, run game logic, flush rendering.
  *
- * Skipped when the game is paused.
+ * Skipped when the game is paused. During replay fast-forward the viewer
+ * runs extra logic-only ticks first; a paused replay skips the frame.
  */
 static void step_0() {
     TRACE_ZONE_N("GameLogic");
@@ -150,6 +163,13 @@ static void step_0() {
 
     MenuBridge_StepGate();
     AFS_RunServer();
+
+    replay_frame_held = !ReplayViewer_BeginFrame(replay_logic_tick);
+    if (replay_frame_held) {
+        TRACE_ZONE_END();
+        return;
+    }
+
     game_step_0();
     TRACE_ZONE_END();
 }
@@ -161,7 +181,7 @@ static void step_0() {
  */
 static void step_1() {
     TRACE_ZONE_N("PostRender");
-    if (game_paused) {
+    if (game_paused || replay_frame_held) {
         TRACE_ZONE_END();
         return;
     }
@@ -170,12 +190,73 @@ static void step_1() {
     TRACE_ZONE_END();
 }
 
+/** @brief One full logic frame as run on the render pipeline's worker thread. */
+static void pipelined_logic_frame() {
+    step_0();
+    step_1();
+}
+
+/**
+ * @brief Main-loop iteration with logic running one frame ahead on the pipeline thread.
+ *
+ * Waits for the recorded logic frame, replays its render calls while the worker
+ * is parked (they read game memory), polls input, then queues the next logic
+ * frame. EndFrame releases it right before present, after the last read of
+ * game state, so it overlaps present and pacing of this one. With
+ * `keep_pipelining` false nothing new is kicked, which drains the pipeline.
+ */
+static void run_pipelined_frame(bool keep_pipelining, bool* is_running) {
+    if (!SDLRenderPipeline_IsInFlight()) {
+        // First pipelined frame after serial ones: no logic is ahead yet
+        SDLRenderPipeline_Kick();
+    }
+    SDLRenderPipeline_Wait();
+
+    const Uint64 replay_start = SDL_GetTicksNS();
+    SDLApp_BeginFrame();
+    SDLGameRenderer_ReplayRecorded();
+    const Uint64 replay_ns = SDL_GetTicksNS() - replay_start;
+
+    SDLPad_UpdatePreviousState();
+    TRACE_SUB_BEGIN("PollEvents");
+    *is_running = SDLApp_PollEvents();
+    TRACE_SUB_END();
+
+    if (keep_pipelining && *is_running) {
+        SDLRenderPipeline_KickDeferred();
+    }
+
+    SDLApp_SetPipelinedFrame(true);
+    SDLApp_EndFrame();
+    SDLApp_SetPipelinedFrame(false);
+
+    // EndFrame paths that never present (minimized window, present-only) still start it
+    SDLRenderPipeline_ReleaseKick();
+
+    const Uint64 work_ns = SDLRenderPipeline_GetLastLogicNS() + replay_ns + SDLApp_GetLastRenderWorkNS();
+    SDLRenderPipeline_EndFrame(true, work_ns, SDLApp_GetTargetFrameTimeNS());
+}
+
 /** @brief Application entry point. Parses CLI, runs SDL frame loop. */
 int main(int argc, char* argv[]) {
     bool is_running = true;
 
     ParseCLI(argc, argv);
 
+    // Headless spectator relay: no window, no game, just fan-out
+    extern const char* g_relay_upstream;
+    extern unsigned short g_spectator_port;
+    if (g_relay_upstream) {
+        return SpectatorRelay_RunHeadless(g_spectator_port, g_relay_upstream);
+    }
+
+    // Parallel self-play: workers boot the game, this process only merges their results
+    if (SelfPlay_IsParent()) {
+        return SelfPlay_RunWorkers(argc, argv);
+    }
+
+    SelfPlay_PrepareHeadless();
+
     init_windows_console();
     SDLApp_Init();
 
@@ -202,6 +283,31 @@ int main(int argc, char* argv[]) {
 
     Menu_UpdateNetworkLabel();
 
+    extern const char* g_spectate_upstream;
+    extern int g_spectate_delay;
+    Netplay_SetSpectatorPort(g_spectator_port);
+    if (g_spectate_upstream) {
+        Netplay_BeginSpectate(g_spectate_upstream, g_spectate_delay);
+    }
+
+    if (Bench_IsRequested()) {
+        const BenchFrameHooks hooks = { step_0, step_1 };
+        const int result = Bench_Run(&hooks);
+        AFS_Finish();
+        SDLApp_Quit();
+        return result;
+    }
+
+    if (SelfPlay_IsRequested()) {
+        const SelfPlayHooks hooks = { step_0, step_1, replay_logic_tick };
+        const int result = SelfPlay_Run(&hooks);
+        AFS_Finish();
+        SDLApp_Quit();
+        return result;
+    }
+
+    SDLRenderPipeline_Init(pipelined_logic_frame);
+
     /* Timing state for decoupled rendering mode (F5 + VSync ON) */
     Uint64 last_tick_time = SDL_GetTicksNS();
     Uint64 game_accumulator = 0;
@@ -214,8 +320,9 @@ int main(int argc, char* argv[]) {
          * Uncapped + VSync ON:          tick only when accumulator >= target_frame_time (decoupled)
          */
         bool should_tick_game;
+        const bool decoupled = SDLApp_IsFrameRateUncapped() && SDLApp_IsVSyncEnabled();
 
-        if (SDLApp_IsFrameRateUncapped() && SDLApp_IsVSyncEnabled()) {
+        if (decoupled) {
             /* === Decoupled mode === */
             Uint64 now = SDL_GetTicksNS();
             Uint64 elapsed = now - last_tick_time;
@@ -239,14 +346,25 @@ int main(int argc, char* argv[]) {
             game_accumulator = 0;
         }
 
-        if (should_tick_game) {
+        /* Pipelining only applies when every iteration ticks; an in-flight
+         * logic frame is always drained before going back to serial. */
+        const bool pipelined = should_tick_game && !decoupled && SDLRenderPipeline_WantPipelined();
+
+        if (pipelined || SDLRenderPipeline_IsInFlight()) {
+            run_pipelined_frame(pipelined, &is_running);
+        } else if (should_tick_game) {
+            const Uint64 logic_start = SDL_GetTicksNS();
             SDLApp_BeginFrame();
             step_0();
+            const Uint64 logic_ns = SDL_GetTicksNS() - logic_start;
             SDLApp_EndFrame();
             TRACE_SUB_BEGIN("PollEvents");
             is_running = SDLApp_PollEvents();
             TRACE_SUB_END();
+            const Uint64 step_1_start = SDL_GetTicksNS();
             step_1();
+            const Uint64 work_ns = logic_ns + SDLApp_GetLastRenderWorkNS() + (SDL_GetTicksNS() - step_1_start);
+            SDLRenderPipeline_EndFrame(false, work_ns, SDLApp_GetTargetFrameTimeNS());
         } else {
             /* Re-present the existing canvas (no game logic, no FBO clear) */
             SDLApp_PresentOnly();
@@ -257,6 +375,7 @@ int main(int argc, char* argv[]) {
         TRACE_FRAME_MARK();
     }
 
+    SDLRenderPipeline_Shutdown();
     AFS_Finish();
     SDLApp_Quit();
     return 0;
@@ -341,6 +460,9 @@ static void game_step_0() {
     TRACE_SUB_BEGIN("Input");
     flPADGetALL();
     keyConvert();
+    if (Bench_IsRunning() || SelfPlay_IsRunning()) {
+        Bench_ClearInput();
+    }
     TRACE_SUB_END();
 
 #if defined(DEBUG)
@@ -430,7 +552,13 @@ static void game_step_0() {
     // Only run game loop directly if we are in IDLE or LOBBY mode.
     // In TRANSITIONING, CONNECTING, and RUNNING modes, Netplay_Run() calls step_game() automatically.
     if (current_net_state == NETPLAY_SESSION_IDLE || current_net_state == NETPLAY_SESSION_LOBBY) {
+        // Training lookahead runs from this frame's starting state, before its logic
+        TRACE_SUB_BEGIN("TrainingFork");
+        training_fork_step();
+        TRACE_SUB_END();
+
         TRACE_SUB_BEGIN("GameTasks");
+        Bench_BeginSection(BENCH_SECTION_LOGIC);
         njUserMain();
 
         // ⚡ Bolt: Input Lag Test Detection
@@ -454,23 +582,53 @@ static void game_step_0() {
         }
 
         seqsBeforeProcess();
+        Bench_EndSection(BENCH_SECTION_LOGIC);
         TRACE_SUB_END();
 
         TRACE_SUB_BEGIN("Render2D");
+        Bench_BeginSection(BENCH_SECTION_SPRITES);
         Renderer_Flush2DPrimitives();
         seqsAfterProcess();
+        Bench_EndSection(BENCH_SECTION_SPRITES);
         TRACE_SUB_END();
     }
 
+    Bench_BeginSection(BENCH_SECTION_SPRITES);
     disp_effect_work();
+    Bench_EndSection(BENCH_SECTION_SPRITES);
 
     MenuBridge_PostTick();
 
     training_hud_draw();
 
+    ReplayViewer_DrawStatus();
+
+    // Late palette changes (effects, color loads) still make this frame
+    if (!No_Trans) {
+        palFlushGhost();
+    }
+
     flFlip(0);
 }
 
+/**
+ * @brief One replay fast-forward tick: a full game frame with its rendering discarded.
+ *
+ * Like netplay's resimulated frames, texture transfers are skipped and the
+ * batch state is reset so only the presented tick's draws reach the renderer.
+ * Headless self-play runs its matches on these ticks too.
+ */
+static void replay_logic_tick() {
+    const u8 saved_no_trans = No_Trans;
+
+    No_Trans = 1;
+    game_step_0();
+    game_step_1();
+    No_Trans = saved_no_trans;
+
+    SDLGameRenderer_ResetBatchState();
+}
+
 /**
  * @brief Per-frame game logic (post-render).
  *
@@ -1355,3 +1355,33 @@ void GameState_Load(const GameState* src) {
     GS_LOAD(X_Adjust_Buff);
     GS_LOAD(Y_Adjust_Buff);
 }
+
+static void effect_state_save(EffectState* dst) {
+    GS_SAVE(frwctr);
+    GS_SAVE(frwctr_min);
+    GS_SAVE(head_ix);
+    GS_SAVE(tail_ix);
+    GS_SAVE(exec_tm);
+    GS_SAVE(frw);
+    GS_SAVE(frwque);
+}
+
+static void effect_state_load(const EffectState* src) {
+    GS_LOAD(frwctr);
+    GS_LOAD(frwctr_min);
+    GS_LOAD(head_ix);
+    GS_LOAD(tail_ix);
+    GS_LOAD(exec_tm);
+    GS_LOAD(frw);
+    GS_LOAD(frwque);
+}
+
+void RollbackState_Save(RollbackState* dst) {
+    GameState_Save(&dst->gs);
+    effect_state_save(&dst->es);
+}
+
+void RollbackState_Load(const RollbackState* src) {
+    GameState_Load(&src->gs);
+    effect_state_load(&src->es);
+}
@@ -3,7 +3,8 @@
  * @brief HTTP client for the 3SX lobby/matchmaking server.
  *
  * Communicates with the Node.js lobby server via HTTP/1.1 + HMAC-SHA256
- * request signing. Uses raw sockets — no libcurl dependency.
+ * request signing. Uses raw sockets — no libcurl dependency. Connections
+ * are kept alive and reused; lobby changes are pushed through a long-poll.
  *
  * HMAC implementation:
  *   - Windows: bcrypt.h (BCryptCreateHash / BCryptHashData / BCryptFinishHash)
@@ -37,6 +38,7 @@ typedef int socklen_t;
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -55,6 +57,9 @@ static bool configured = false;
 #define DEFAULT_LOBBY_URL "http://152.67.75.184:3000"
 #define DEFAULT_LOBBY_KEY "zqv0R11DN5DI8ZdRDhRmXzexQ2ciExSKXBvZSfXG0Z8="
 
+static void create_locks(void);
+static void close_connections(void);
+
 void LobbyServer_Init(void) {
     const char* url_override = Config_GetString(CFG_KEY_LOBBY_SERVER_URL);
     const char* key_override = Config_GetString(CFG_KEY_LOBBY_SERVER_KEY);
@@ -62,6 +67,8 @@ void LobbyServer_Init(void) {
     const char* url = (url_override && strlen(url_override) > 0) ? url_override : DEFAULT_LOBBY_URL;
     const char* key = (key_override && strlen(key_override) > 0) ? key_override : DEFAULT_LOBBY_KEY;
 
+    create_locks();
+    close_connections();
     configured = false;
     memset(server_host, 0, sizeof(server_host));
     server_port = 80; // default to 80 if no port specified
@@ -305,138 +312,375 @@ static void compute_hmac(const char* payload, char* out_hex, size_t hex_size) {
 
 /* ======== HTTP client ======== */
 
-#define HTTP_BUF_SIZE 4096
-
-/* Open a TCP connection to server_host:server_port */
-static int http_connect(void) {
-    struct addrinfo hints, *res = NULL;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_INET;
-    hints.ai_socktype = SOCK_STREAM;
-
-    char port_str[16];
-    snprintf(port_str, sizeof(port_str), "%d", server_port);
+/*
+ * Two persistent HTTP/1.1 keep-alive connections are kept to the server:
+ *   - ctrl_conn:  presence/search/leave calls, pipelined when batched
+ *   - watch_conn: long-poll for lobby changes, which may block for seconds
+ * The resolved server address is cached, so steady-state traffic costs no
+ * DNS lookups or TCP handshakes. A request that fails on a reused socket
+ * (server dropped the idle connection) is retried once on a fresh one.
+ */
 
-    if (getaddrinfo(server_host, port_str, &hints, &res) != 0 || !res) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LobbyServer: DNS resolve failed for %s", server_host);
-        return -1;
-    }
+#define HTTP_BUF_SIZE 4096
+#define HTTP_RECV_BUF_SIZE 8192
+#define HTTP_MAX_PIPELINE 4
+#define LOBBY_IO_TIMEOUT_MS 5000
 
-    int sock = (int)socket(AF_INET, SOCK_STREAM, 0);
-    if (sock < 0) {
-        freeaddrinfo(res);
-        return -1;
-    }
+typedef struct {
+    int sock; // -1 when disconnected
+    SDL_Mutex* lock;
+    char rbuf[HTTP_RECV_BUF_SIZE];
+    int rlen;
+} LobbyConn;
 
-    /* Set socket timeout (5 seconds) */
+typedef struct {
+    const char* method;
+    const char* path;
+    const char* body;
+    char* out_buf;
+    size_t out_buf_size;
+    int status;
+} HttpCall;
+
+static LobbyConn ctrl_conn = { -1 };
+static LobbyConn watch_conn = { -1 };
+
+static SDL_Mutex* dns_lock = NULL;
+static struct sockaddr_in server_addr;
+static bool server_addr_cached = false;
+
+static SDL_AtomicInt stat_dns_lookups;
+static SDL_AtomicInt stat_connects;
+static SDL_AtomicInt stat_requests;
+
+static void sock_set_timeout(int sock, int timeout_ms) {
 #ifdef _WIN32
-    DWORD timeout = 5000;
+    DWORD timeout = (DWORD)timeout_ms;
     setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
     setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
 #else
     struct timeval tv;
-    tv.tv_sec = 5;
-    tv.tv_usec = 0;
+    tv.tv_sec = timeout_ms / 1000;
+    tv.tv_usec = (timeout_ms % 1000) * 1000;
     setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
     setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 #endif
+}
 
-    if (connect(sock, res->ai_addr, (socklen_t)res->ai_addrlen) < 0) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LobbyServer: connect() failed to %s:%d", server_host, server_port);
-        closesocket(sock);
+/* Resolve server_host once; later connects reuse the cached address. */
+static bool resolve_server(struct sockaddr_in* out) {
+    SDL_LockMutex(dns_lock);
+
+    if (!server_addr_cached) {
+        struct addrinfo hints, *res = NULL;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        char port_str[16];
+        snprintf(port_str, sizeof(port_str), "%d", server_port);
+
+        SDL_AddAtomicInt(&stat_dns_lookups, 1);
+        if (getaddrinfo(server_host, port_str, &hints, &res) != 0 || !res) {
+            SDL_UnlockMutex(dns_lock);
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LobbyServer: DNS resolve failed for %s", server_host);
+            return false;
+        }
+
+        memcpy(&server_addr, res->ai_addr, sizeof(server_addr));
+        server_addr_cached = true;
         freeaddrinfo(res);
-        return -1;
     }
 
-    freeaddrinfo(res);
-    return sock;
+    *out = server_addr;
+    SDL_UnlockMutex(dns_lock);
+    return true;
 }
 
-/**
- * Perform an HTTP request with HMAC signing.
- * Returns the HTTP response body in out_buf (null-terminated).
- * Returns true on HTTP 2xx response.
- */
-static bool http_request(const char* method, const char* path, const char* body, char* out_buf, size_t out_buf_size) {
-    if (!configured)
+static void invalidate_dns(void) {
+    SDL_LockMutex(dns_lock);
+    server_addr_cached = false;
+    SDL_UnlockMutex(dns_lock);
+}
+
+static void conn_close(LobbyConn* c) {
+    if (c->sock >= 0) {
+        closesocket(c->sock);
+        c->sock = -1;
+    }
+    c->rlen = 0;
+}
+
+/* Open a TCP connection to server_host:server_port (caller holds c->lock) */
+static bool conn_open(LobbyConn* c) {
+    struct sockaddr_in addr;
+    if (!resolve_server(&addr))
         return false;
 
-    int sock = http_connect();
+    int sock = (int)socket(AF_INET, SOCK_STREAM, 0);
     if (sock < 0)
         return false;
 
+    sock_set_timeout(sock, LOBBY_IO_TIMEOUT_MS);
+
+    /* Pipelined requests are small writes; don't let Nagle hold them back */
+    int nodelay = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+
+    if (connect(sock, (const struct sockaddr*)&addr, (socklen_t)sizeof(addr)) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "LobbyServer: connect() failed to %s:%d", server_host, server_port);
+        closesocket(sock);
+        invalidate_dns(); // Server may have moved — re-resolve next time
+        return false;
+    }
+
+    SDL_AddAtomicInt(&stat_connects, 1);
+    c->sock = sock;
+    c->rlen = 0;
+    return true;
+}
+
+/* Pull more bytes into the connection's receive buffer. Returns bytes read, <= 0 on close/error. */
+static int conn_fill(LobbyConn* c) {
+    if (c->rlen >= (int)sizeof(c->rbuf))
+        return -1;
+    int n = recv(c->sock, c->rbuf + c->rlen, (int)sizeof(c->rbuf) - c->rlen, 0);
+    if (n > 0)
+        c->rlen += n;
+    return n;
+}
+
+static void conn_consume(LobbyConn* c, int n) {
+    memmove(c->rbuf, c->rbuf + n, (size_t)(c->rlen - n));
+    c->rlen -= n;
+}
+
+/* Read one CRLF-terminated line (CRLF stripped, truncated to out_size). */
+static bool conn_read_line(LobbyConn* c, char* out, size_t out_size) {
+    for (;;) {
+        for (int i = 0; i + 1 < c->rlen; i++) {
+            if (c->rbuf[i] == '\r' && c->rbuf[i + 1] == '\n') {
+                size_t len = (size_t)i < out_size - 1 ? (size_t)i : out_size - 1;
+                memcpy(out, c->rbuf, len);
+                out[len] = '\0';
+                conn_consume(c, i + 2);
+                return true;
+            }
+        }
+        if (conn_fill(c) <= 0)
+            return false;
+    }
+}
+
+/* Read exactly len body bytes, appending what fits into out (always fully drained for keep-alive). */
+static bool conn_read_body(LobbyConn* c, long len, char* out, size_t out_size, size_t* out_len) {
+    while (len > 0) {
+        if (c->rlen == 0 && conn_fill(c) <= 0)
+            return false;
+        int take = (long)c->rlen < len ? c->rlen : (int)len;
+        size_t room = out_size - 1 - *out_len;
+        size_t copy = (size_t)take < room ? (size_t)take : room;
+        memcpy(out + *out_len, c->rbuf, copy);
+        *out_len += copy;
+        conn_consume(c, take);
+        len -= take;
+    }
+    return true;
+}
+
+/* Read one complete HTTP/1.x response. Handles Content-Length, chunked and read-until-close bodies. */
+static bool conn_read_response(LobbyConn* c, char* out_buf, size_t out_buf_size, int* out_status, bool* out_keep_alive) {
+    char line[512];
+    long content_length = -1;
+    bool chunked = false;
+    bool keep_alive = true;
+    size_t out_len = 0;
+
+    out_buf[0] = '\0';
+
+    if (!conn_read_line(c, line, sizeof(line)))
+        return false;
+    if (strncmp(line, "HTTP/1.1 ", 9) != 0 && strncmp(line, "HTTP/1.0 ", 9) != 0)
+        return false;
+    if (line[7] == '0')
+        keep_alive = false;
+    *out_status = atoi(line + 9);
+
+    for (;;) {
+        if (!conn_read_line(c, line, sizeof(line)))
+            return false;
+        if (line[0] == '\0')
+            break;
+        if (SDL_strncasecmp(line, "Content-Length:", 15) == 0) {
+            content_length = atol(line + 15);
+        } else if (SDL_strncasecmp(line, "Transfer-Encoding:", 18) == 0 && SDL_strcasestr(line + 18, "chunked")) {
+            chunked = true;
+        } else if (SDL_strncasecmp(line, "Connection:", 11) == 0) {
+            keep_alive = SDL_strcasestr(line + 11, "close") == NULL;
+        }
+    }
+
+    if (chunked) {
+        for (;;) {
+            if (!conn_read_line(c, line, sizeof(line)))
+                return false;
+            long chunk = strtol(line, NULL, 16);
+            if (chunk <= 0)
+                break;
+            if (!conn_read_body(c, chunk, out_buf, out_buf_size, &out_len) || !conn_read_line(c, line, sizeof(line)))
+                return false;
+        }
+        /* Trailer section ends with an empty line */
+        do {
+            if (!conn_read_line(c, line, sizeof(line)))
+                return false;
+        } while (line[0] != '\0');
+    } else if (content_length >= 0) {
+        if (!conn_read_body(c, content_length, out_buf, out_buf_size, &out_len))
+            return false;
+    } else {
+        /* No framing — body runs until the server closes */
+        while (conn_fill(c) > 0 || c->rlen > 0) {
+            int take = c->rlen;
+            conn_read_body(c, take, out_buf, out_buf_size, &out_len);
+        }
+        keep_alive = false;
+    }
+
+    out_buf[out_len] = '\0';
+    *out_keep_alive = keep_alive;
+    return true;
+}
+
+/* Append one signed request to buf. Returns bytes written, or -1 if it doesn't fit. */
+static int http_format_request(char* buf, size_t buf_size, const HttpCall* call) {
     /* Generate timestamp and signature */
     char timestamp[32];
     snprintf(timestamp, sizeof(timestamp), "%lld", (long long)time(NULL));
 
     /* payload for HMAC = timestamp + method + path + body */
-    size_t payload_len = strlen(timestamp) + strlen(method) + strlen(path) + strlen(body);
+    size_t payload_len = strlen(timestamp) + strlen(call->method) + strlen(call->path) + strlen(call->body);
     char* payload = (char*)malloc(payload_len + 1);
-    snprintf(payload, payload_len + 1, "%s%s%s%s", timestamp, method, path, body);
+    snprintf(payload, payload_len + 1, "%s%s%s%s", timestamp, call->method, call->path, call->body);
 
     char signature[66];
     compute_hmac(payload, signature, sizeof(signature));
     free(payload);
 
-    /* Build HTTP request */
-    char request[HTTP_BUF_SIZE];
-    int body_len = (int)strlen(body);
-
-    int req_len = snprintf(request,
-                           sizeof(request),
+    int req_len = snprintf(buf,
+                           buf_size,
                            "%s %s HTTP/1.1\r\n"
                            "Host: %s:%d\r\n"
                            "Content-Type: application/json\r\n"
                            "Content-Length: %d\r\n"
                            "X-Timestamp: %s\r\n"
                            "X-Signature: %s\r\n"
-                           "Connection: close\r\n"
+                           "Connection: keep-alive\r\n"
                            "\r\n"
                            "%s",
-                           method,
-                           path,
+                           call->method,
+                           call->path,
                            server_host,
                            server_port,
-                           body_len,
+                           (int)strlen(call->body),
                            timestamp,
                            signature,
-                           body);
+                           call->body);
 
-    /* Send */
-    int sent = send(sock, request, req_len, 0);
-    if (sent < req_len) {
-        closesocket(sock);
-        return false;
+    return (req_len < 0 || (size_t)req_len >= buf_size) ? -1 : req_len;
+}
+
+static bool send_all(int sock, const char* data, int len) {
+    while (len > 0) {
+        int sent = send(sock, data, len, 0);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        len -= sent;
     }
+    return true;
+}
 
-    /* Receive response */
-    char response[HTTP_BUF_SIZE];
-    int total = 0;
-    while (total < (int)sizeof(response) - 1) {
-        int n = recv(sock, response + total, (int)sizeof(response) - 1 - total, 0);
-        if (n <= 0)
-            break;
-        total += n;
+/* One attempt at a pipelined exchange. *progressed is set once any response byte arrived. */
+static bool http_exchange_once(LobbyConn* c, HttpCall* calls, int count, const char* request, int req_len,
+                               bool* progressed) {
+    *progressed = false;
+
+    if (!send_all(c->sock, request, req_len))
+        return false;
+
+    for (int i = 0; i < count; i++) {
+        bool keep_alive = true;
+        calls[i].status = 0;
+        if (!conn_read_response(c, calls[i].out_buf, calls[i].out_buf_size, &calls[i].status, &keep_alive)) {
+            *progressed = *progressed || i > 0;
+            return false;
+        }
+        *progressed = true;
+        SDL_AddAtomicInt(&stat_requests, 1);
+
+        if (!keep_alive) {
+            conn_close(c);
+            /* Server closed mid-pipeline: the remaining requests were never answered */
+            if (i + 1 < count)
+                return false;
+        }
     }
-    response[total] = '\0';
-    closesocket(sock);
+    return true;
+}
+
+/**
+ * Perform count HMAC-signed requests back-to-back on one keep-alive connection
+ * and read the responses in order. timeout_ms bounds each socket read.
+ * Returns true if every response arrived (check each call's status for 2xx).
+ */
+static bool http_pipeline(LobbyConn* c, HttpCall* calls, int count, int timeout_ms) {
+    if (!configured || count <= 0 || count > HTTP_MAX_PIPELINE)
+        return false;
 
-    /* Parse HTTP status code */
-    int status = 0;
-    if (strncmp(response, "HTTP/1.1 ", 9) == 0 || strncmp(response, "HTTP/1.0 ", 9) == 0) {
-        status = atoi(response + 9);
+    char request[HTTP_BUF_SIZE * HTTP_MAX_PIPELINE];
+    int req_len = 0;
+    for (int i = 0; i < count; i++) {
+        int n = http_format_request(request + req_len, sizeof(request) - (size_t)req_len, &calls[i]);
+        if (n < 0)
+            return false;
+        req_len += n;
     }
 
-    /* Extract body (after \r\n\r\n) */
-    const char* body_start = strstr(response, "\r\n\r\n");
-    if (body_start) {
-        body_start += 4;
-        snprintf(out_buf, out_buf_size, "%s", body_start);
-    } else {
-        out_buf[0] = '\0';
+    SDL_LockMutex(c->lock);
+
+    bool ok = false;
+    for (int attempt = 0; attempt < 2 && !ok; attempt++) {
+        bool reused = c->sock >= 0;
+        if (!reused && !conn_open(c))
+            break;
+
+        sock_set_timeout(c->sock, timeout_ms);
+        bool progressed = false;
+        ok = http_exchange_once(c, calls, count, request, req_len, &progressed);
+
+        if (!ok) {
+            conn_close(c);
+            /* Only a stale reused socket that produced nothing is safe to replay */
+            if (!reused || progressed)
+                break;
+        }
     }
 
-    return (status >= 200 && status < 300);
+    SDL_UnlockMutex(c->lock);
+    return ok;
+}
+
+/**
+ * Perform a single HTTP request on the control connection.
+ * Returns the HTTP response body in out_buf (null-terminated).
+ * Returns true on HTTP 2xx response.
+ */
+static bool http_request(const char* method, const char* path, const char* body, char* out_buf, size_t out_buf_size) {
+    HttpCall call = { method, path, body, out_buf, out_buf_size, 0 };
+    if (!http_pipeline(&ctrl_conn, &call, 1, LOBBY_IO_TIMEOUT_MS))
+        return false;
+    return (call.status >= 200 && call.status < 300);
 }
 
 /* ======== JSON helpers ======== */
@@ -487,10 +731,111 @@ static bool json_get_string(const char* json, const char* key, char* out, size_t
     return true;
 }
 
+/* Extract an integer value for a key like "key":123 */
+static bool json_get_int(const char* json, const char* key, int* out) {
+    char pattern[128];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char* p = strstr(json, pattern);
+    if (!p)
+        return false;
+    p += strlen(pattern);
+    if ((*p < '0' || *p > '9') && *p != '-')
+        return false;
+    *out = atoi(p);
+    return true;
+}
+
+/* Parse the player array out of a {"players":[...]} response. */
+static int parse_players(const char* response, LobbyPlayer* out_players, int max_players) {
+    /* Parse JSON array of players from {"players":[...]} */
+    int count = 0;
+    const char* cursor = strstr(response, "\"players\":[");
+    if (!cursor)
+        return 0;
+    cursor += 11; /* skip past "players":[ */
+
+    while (count < max_players) {
+        /* Find next object */
+        const char* obj_start = strchr(cursor, '{');
+        if (!obj_start)
+            break;
+        const char* obj_end = strchr(obj_start, '}');
+        if (!obj_end)
+            break;
+
+        /* Extract fields from this object */
+        size_t obj_len = (size_t)(obj_end - obj_start + 1);
+        char obj[512];
+        if (obj_len >= sizeof(obj))
+            obj_len = sizeof(obj) - 1;
+        memcpy(obj, obj_start, obj_len);
+        obj[obj_len] = '\0';
+
+        LobbyPlayer* p = &out_players[count];
+        memset(p, 0, sizeof(*p));
+        json_get_string(obj, "player_id", p->player_id, sizeof(p->player_id));
+        json_get_string(obj, "display_name", p->display_name, sizeof(p->display_name));
+        json_get_string(obj, "region", p->region, sizeof(p->region));
+        json_get_string(obj, "room_code", p->room_code, sizeof(p->room_code));
+        json_get_string(obj, "connect_to", p->connect_to, sizeof(p->connect_to));
+
+        if (strlen(p->player_id) > 0)
+            count++;
+
+        cursor = obj_end + 1;
+    }
+
+    return count;
+}
+
+/* ======== Connection lifecycle ======== */
+
+/* Create the connection and DNS locks once, before any worker can take them. */
+static void create_locks(void) {
+    if (dns_lock) {
+        return;
+    }
+
+    ctrl_conn.lock = SDL_CreateMutex();
+    watch_conn.lock = SDL_CreateMutex();
+    dns_lock = SDL_CreateMutex();
+}
+
+static void close_connections(void) {
+    /* Unblock a long-poll that may be sitting in recv() before taking its lock */
+    if (watch_conn.sock >= 0) {
+#ifdef _WIN32
+        shutdown(watch_conn.sock, SD_BOTH);
+#else
+        shutdown(watch_conn.sock, SHUT_RDWR);
+#endif
+    }
+
+    SDL_LockMutex(ctrl_conn.lock);
+    conn_close(&ctrl_conn);
+    SDL_UnlockMutex(ctrl_conn.lock);
+
+    SDL_LockMutex(watch_conn.lock);
+    conn_close(&watch_conn);
+    SDL_UnlockMutex(watch_conn.lock);
+
+    invalidate_dns();
+}
+
+void LobbyServer_Shutdown(void) {
+    close_connections();
+}
+
+void LobbyServer_GetStats(LobbyServerStats* out) {
+    out->dns_lookups = SDL_GetAtomicInt(&stat_dns_lookups);
+    out->connects = SDL_GetAtomicInt(&stat_connects);
+    out->requests = SDL_GetAtomicInt(&stat_requests);
+}
+
 /* ======== Public API ======== */
 
-bool LobbyServer_UpdatePresence(const char* player_id, const char* display_name, const char* region,
-                                const char* room_code, const char* connect_to) {
+static void format_presence_body(char* body, size_t body_size, const char* player_id, const char* display_name,
+                                 const char* region, const char* room_code, const char* connect_to) {
     char esc_pid[128], esc_name[64], esc_region[16], esc_code[32], esc_ct[32];
     json_escape_string(player_id, esc_pid, sizeof(esc_pid));
     json_escape_string(display_name, esc_name, sizeof(esc_name));
@@ -498,21 +843,48 @@ bool LobbyServer_UpdatePresence(const char* player_id, const char* display_name,
     json_escape_string(room_code ? room_code : "", esc_code, sizeof(esc_code));
     json_escape_string(connect_to ? connect_to : "", esc_ct, sizeof(esc_ct));
 
-    char body[512];
     snprintf(
         body,
-        sizeof(body),
+        body_size,
         "{\"player_id\":\"%s\",\"display_name\":\"%s\",\"region\":\"%s\",\"room_code\":\"%s\",\"connect_to\":\"%s\"}",
         esc_pid,
         esc_name,
         esc_region,
         esc_code,
         esc_ct);
+}
+
+bool LobbyServer_UpdatePresence(const char* player_id, const char* display_name, const char* region,
+                                const char* room_code, const char* connect_to) {
+    char body[512];
+    format_presence_body(body, sizeof(body), player_id, display_name, region, room_code, connect_to);
 
     char response[HTTP_BUF_SIZE];
     return http_request("POST", "/presence", body, response, sizeof(response));
 }
 
+bool LobbyServer_UpdatePresenceAndStartSearching(const char* player_id, const char* display_name, const char* region,
+                                                 const char* room_code, const char* connect_to) {
+    char presence_body[512];
+    format_presence_body(presence_body, sizeof(presence_body), player_id, display_name, region, room_code, connect_to);
+
+    char esc_pid[128];
+    json_escape_string(player_id, esc_pid, sizeof(esc_pid));
+    char search_body[128];
+    snprintf(search_body, sizeof(search_body), "{\"player_id\":\"%s\"}", esc_pid);
+
+    /* Both requests go out in one write; the server answers them in order */
+    char presence_resp[256], search_resp[256];
+    HttpCall calls[2] = {
+        { "POST", "/presence", presence_body, presence_resp, sizeof(presence_resp), 0 },
+        { "POST", "/searching/start", search_body, search_resp, sizeof(search_resp), 0 },
+    };
+
+    if (!http_pipeline(&ctrl_conn, calls, 2, LOBBY_IO_TIMEOUT_MS))
+        return false;
+    return (calls[0].status >= 200 && calls[0].status < 300) && (calls[1].status >= 200 && calls[1].status < 300);
+}
+
 bool LobbyServer_StartSearching(const char* player_id) {
     char esc_pid[128];
     json_escape_string(player_id, esc_pid, sizeof(esc_pid));
@@ -547,45 +919,31 @@ int LobbyServer_GetSearching(LobbyPlayer* out_players, int max_players, const ch
     if (!http_request("GET", path, "", response, sizeof(response)))
         return 0;
 
-    /* Parse JSON array of players from {"players":[...]} */
-    int count = 0;
-    const char* cursor = strstr(response, "\"players\":[");
-    if (!cursor)
-        return 0;
-    cursor += 11; /* skip past "players":[ */
-
-    while (count < max_players) {
-        /* Find next object */
-        const char* obj_start = strchr(cursor, '{');
-        if (!obj_start)
-            break;
-        const char* obj_end = strchr(obj_start, '}');
-        if (!obj_end)
-            break;
-
-        /* Extract fields from this object */
-        size_t obj_len = (size_t)(obj_end - obj_start + 1);
-        char obj[512];
-        if (obj_len >= sizeof(obj))
-            obj_len = sizeof(obj) - 1;
-        memcpy(obj, obj_start, obj_len);
-        obj[obj_len] = '\0';
+    return parse_players(response, out_players, max_players);
+}
 
-        LobbyPlayer* p = &out_players[count];
-        memset(p, 0, sizeof(*p));
-        json_get_string(obj, "player_id", p->player_id, sizeof(p->player_id));
-        json_get_string(obj, "display_name", p->display_name, sizeof(p->display_name));
-        json_get_string(obj, "region", p->region, sizeof(p->region));
-        json_get_string(obj, "room_code", p->room_code, sizeof(p->room_code));
-        json_get_string(obj, "connect_to", p->connect_to, sizeof(p->connect_to));
+int LobbyServer_WaitSearching(LobbyPlayer* out_players, int max_players, const char* region_filter, int* version,
+                              int timeout_ms) {
+    char path[160];
+    if (region_filter && strlen(region_filter) > 0) {
+        snprintf(path, sizeof(path), "/searching?wait=%d&timeout=%d&region=%s", *version, timeout_ms, region_filter);
+    } else {
+        snprintf(path, sizeof(path), "/searching?wait=%d&timeout=%d", *version, timeout_ms);
+    }
 
-        if (strlen(p->player_id) > 0)
-            count++;
+    /* Runs on its own connection so a parked long-poll never delays presence calls */
+    char response[HTTP_BUF_SIZE];
+    HttpCall call = { "GET", path, "", response, sizeof(response), 0 };
+    if (!http_pipeline(&watch_conn, &call, 1, timeout_ms + LOBBY_IO_TIMEOUT_MS))
+        return -1;
+    if (call.status < 200 || call.status >= 300)
+        return -1;
 
-        cursor = obj_end + 1;
-    }
+    /* Servers without long-poll support answer immediately without a version */
+    if (!json_get_int(response, "version", version))
+        *version = -1;
 
-    return count;
+    return parse_players(response, out_players, max_players);
 }
 
 bool LobbyServer_Leave(const char* player_id) {
@@ -15,6 +15,12 @@ typedef struct {
     char connect_to[16];
 } LobbyPlayer;
 
+typedef struct {
+    int dns_lookups; // getaddrinfo calls since startup
+    int connects;    // TCP connections opened since startup
+    int requests;    // HTTP responses received since startup
+} LobbyServerStats;
+
 /// Initialize lobby server client — reads URL and key from config.ini.
 /// Must be called after Config_Init().
 void LobbyServer_Init(void);
@@ -27,6 +33,11 @@ bool LobbyServer_IsConfigured(void);
 bool LobbyServer_UpdatePresence(const char* player_id, const char* display_name, const char* region,
                                 const char* room_code, const char* connect_to);
 
+/// Register presence and mark the player as searching in one pipelined round trip.
+/// Guarantees the server sees the presence update before the search request.
+bool LobbyServer_UpdatePresenceAndStartSearching(const char* player_id, const char* display_name, const char* region,
+                                                 const char* room_code, const char* connect_to);
+
 /// Mark player as searching for a match.
 bool LobbyServer_StartSearching(const char* player_id);
 
@@ -38,9 +49,23 @@ bool LobbyServer_StopSearching(const char* player_id);
 /// region_filter may be NULL or "" to get all regions.
 int LobbyServer_GetSearching(LobbyPlayer* out_players, int max_players, const char* region_filter);
 
+/// Long-poll the searching list: the server holds the request until the lobby
+/// changes from *version or timeout_ms elapses. *version is updated from the
+/// response, or set to -1 if the server does not support long-polling (the
+/// caller should fall back to interval polling with LobbyServer_GetSearching).
+/// Returns number of players written, or -1 on a network/HTTP error.
+int LobbyServer_WaitSearching(LobbyPlayer* out_players, int max_players, const char* region_filter, int* version,
+                              int timeout_ms);
+
 /// Remove this player from the lobby server entirely.
 bool LobbyServer_Leave(const char* player_id);
 
+/// Close the keep-alive connections (also aborts a pending long-poll).
+void LobbyServer_Shutdown(void);
+
+/// Connection reuse counters for diagnostics.
+void LobbyServer_GetStats(LobbyServerStats* out);
+
 #ifdef __cplusplus
 }
 #endif
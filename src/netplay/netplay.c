@@ -17,6 +17,7 @@ extern unsigned short g_netplay_port;
 #include "sf33rd/Source/Game/io/gd3rd.h"
 #include "sf33rd/Source/Game/io/pulpul.h"
 #include "sf33rd/Source/Game/rendering/color3rd.h"
+#include "spectator_relay.h"
 #include "stun.h"
 // dc_ghost.h does not exist in our repo; njdp2d_draw was renamed to Renderer_Flush2DPrimitives.
 #include "port/renderer.h"
@@ -49,6 +50,8 @@ extern void SDLGameRenderer_ResetBatchState(); // Reset texture stack between ne
 #define DELAY_FRAMES_MAX 4
 #define PING_SAMPLE_INTERVAL 30
 #define PLAYER_COUNT 2
+#define INPUT_PREDICTION_WINDOW 12
+#define SPECTATE_CATCH_UP_MAX 8 // Frames a lagging spectator may simulate per tick
 
 // Uncomment to enable packet drops
 // #define LOSSY_ADAPTER
@@ -56,20 +59,6 @@ extern void SDLGameRenderer_ResetBatchState(); // Reset texture stack between ne
 // 3SX-private: forward declaration for event queue (defined at end of file)
 static void push_event(NetplayEventType type);
 
-typedef struct EffectState {
-    s16 frwctr;
-    s16 frwctr_min;
-    s16 head_ix[8];
-    s16 tail_ix[8];
-    s16 exec_tm[8];
-    uintptr_t frw[EFFECT_MAX][448];
-    s16 frwque[EFFECT_MAX];
-} EffectState;
-
-typedef struct State {
-    GameState gs;
-    EffectState es;
-} State;
 
 static GekkoSession* session = NULL;
 static unsigned short local_port = 0;
@@ -89,6 +78,20 @@ static int stats_update_timer = 0;
 static int frame_max_rollback = 0;
 static NetworkStats network_stats = { 0 };
 
+// --- Spectator broadcast ---
+// Players with a spectator port feed confirmed inputs into a relay node;
+// spectators subscribe to a player or relay and replay those inputs behind
+// a delay buffer while serving their own subscribers.
+static SpectatorRelay* relay = NULL;
+static unsigned short spectator_port = 0;
+static int relay_frame_base = -1; // GekkoNet frame that maps to relay frame 0
+static int relay_next_frame = -1; // Next GekkoNet frame to push
+static bool spectating = false;
+static bool spectate_started = false;
+static int spectate_frame = 0;
+static int spectate_delay = 0;
+static uint32_t spectate_session = 0;
+
 // --- Dynamic delay from ping ---
 static int    dynamic_delay = DELAY_FRAMES_DEFAULT;
 static bool   dynamic_delay_applied = false;
@@ -100,7 +103,7 @@ static int    ping_sample_timer = 0;
 #if defined(DEBUG)
 static int battle_start_frame = -1;
 #define STATE_BUFFER_MAX 20
-static State state_buffer[STATE_BUFFER_MAX];
+static RollbackState state_buffer[STATE_BUFFER_MAX];
 #endif
 
 #if defined(LOSSY_ADAPTER)
@@ -265,60 +268,107 @@ static void configure_lossy_adapter() {
 // preserving the NAT pinhole. The default ASIO adapter creates a new
 // socket which may get a different public port on Symmetric NAT.
 
+//
+// The packet path is allocation-free: GekkoNet addresses are binary
+// StunEndpoints rather than "ip:port" strings, received packets land in a
+// static slab that is recycled on every receive call, and outgoing packets
+// are queued and flushed in one batch per poll (sendmmsg/recvmmsg on Linux).
+
 #define STUN_ADAPTER_RECV_BUF 1024
 #define STUN_ADAPTER_MAX_RESULTS 64
+#define STUN_ADAPTER_MAX_SENDS 32
+
+typedef struct {
+    GekkoNetResult result;
+    StunEndpoint from;
+    char payload[STUN_ADAPTER_RECV_BUF];
+} StunPacketSlot;
 
+static StunPacketSlot stun_recv_slab[STUN_ADAPTER_MAX_RESULTS];
+static StunDatagram stun_recv_dgrams[STUN_ADAPTER_MAX_RESULTS];
 static GekkoNetResult* stun_recv_pool[STUN_ADAPTER_MAX_RESULTS];
-static int stun_recv_count = 0;
+
+static char stun_send_payload[STUN_ADAPTER_MAX_SENDS][STUN_ADAPTER_RECV_BUF];
+static StunDatagram stun_send_queue[STUN_ADAPTER_MAX_SENDS];
+static int stun_send_count = 0;
+static bool stun_dropped_address_logged = false;
+
+static void stun_adapter_flush() {
+    if (stun_send_count == 0)
+        return;
+
+    if (stun_socket_fd >= 0)
+        Stun_SocketSendBatch(stun_socket_fd, stun_send_queue, stun_send_count);
+    stun_send_count = 0;
+}
 
 static void stun_adapter_send(GekkoNetAddress* addr, const char* data, int length) {
     if (stun_socket_fd < 0)
         return;
 
-    // Extract null-terminated endpoint string from GekkoNetAddress
-    char addr_str[128];
-    int copy_len = addr->size < (int)sizeof(addr_str) - 1 ? (int)addr->size : (int)sizeof(addr_str) - 1;
-    SDL_memcpy(addr_str, addr->data, copy_len);
-    addr_str[copy_len] = '\0';
-
-    Stun_SocketSendTo(stun_socket_fd, addr_str, data, length);
-}
+    if (addr->size != sizeof(StunEndpoint)) {
+        // Only binary endpoints can be sent to; see the warning in the session setup
+        if (!stun_dropped_address_logged) {
+            SDL_Log("[netplay] STUN adapter dropping packets to a peer with no IPv4 endpoint");
+            stun_dropped_address_logged = true;
+        }
+        return;
+    }
 
-static GekkoNetResult** stun_adapter_receive(int* length) {
-    // GekkoNet's backend frees each result via free_data() after processing,
-    // so we just reset our pointer array here (matching ASIO's _results.clear()).
-    stun_recv_count = 0;
+    StunDatagram dgram;
+    SDL_memcpy(&dgram.addr, addr->data, sizeof(StunEndpoint));
 
-    if (stun_socket_fd < 0) {
-        *length = 0;
-        return (GekkoNetResult**)stun_recv_pool;
+    // Oversized packets bypass the queue; GekkoNet's buffer is only valid during this call
+    if (length > STUN_ADAPTER_RECV_BUF) {
+        stun_adapter_flush();
+        dgram.buf = (char*)data;
+        dgram.len = length;
+        Stun_SocketSendBatch(stun_socket_fd, &dgram, 1);
+        return;
     }
 
-    char buf[STUN_ADAPTER_RECV_BUF];
-    while (stun_recv_count < STUN_ADAPTER_MAX_RESULTS) {
-        char endpoint[48];
-        int n = Stun_SocketRecvFrom(stun_socket_fd, buf, sizeof(buf), endpoint, sizeof(endpoint));
-        if (n <= 0)
-            break;
+    if (stun_send_count == STUN_ADAPTER_MAX_SENDS)
+        stun_adapter_flush();
 
-        int ep_len = (int)SDL_strlen(endpoint);
+    dgram.buf = stun_send_payload[stun_send_count];
+    dgram.len = length;
+    SDL_memcpy(dgram.buf, data, length);
+    stun_send_queue[stun_send_count++] = dgram;
+}
 
-        GekkoNetResult* res = (GekkoNetResult*)SDL_malloc(sizeof(GekkoNetResult));
-        res->addr.data = SDL_malloc(ep_len);
-        res->addr.size = ep_len;
-        SDL_memcpy(res->addr.data, endpoint, ep_len);
-        res->data_len = n;
-        res->data = SDL_malloc(n);
-        SDL_memcpy(res->data, buf, n);
+static GekkoNetResult** stun_adapter_receive(int* length) {
+    // GekkoNet frees each result via free_data() after processing; slab
+    // entries are recycled here instead, so those frees are no-ops.
+    int count = 0;
+
+    if (stun_socket_fd >= 0) {
+        for (int i = 0; i < STUN_ADAPTER_MAX_RESULTS; i++) {
+            stun_recv_dgrams[i].buf = stun_recv_slab[i].payload;
+            stun_recv_dgrams[i].buf_size = STUN_ADAPTER_RECV_BUF;
+        }
+        count = SDL_max(Stun_SocketRecvBatch(stun_socket_fd, stun_recv_dgrams, STUN_ADAPTER_MAX_RESULTS), 0);
+    }
 
-        stun_recv_pool[stun_recv_count++] = res;
+    for (int i = 0; i < count; i++) {
+        StunPacketSlot* slot = &stun_recv_slab[i];
+        slot->from = stun_recv_dgrams[i].addr;
+        slot->result.addr.data = &slot->from;
+        slot->result.addr.size = sizeof(StunEndpoint);
+        slot->result.data = slot->payload;
+        slot->result.data_len = stun_recv_dgrams[i].len;
+        stun_recv_pool[i] = &slot->result;
     }
 
-    *length = stun_recv_count;
+    *length = count;
     return (GekkoNetResult**)stun_recv_pool;
 }
 
 static void stun_adapter_free(void* data_ptr) {
+    const char* p = (const char*)data_ptr;
+    const char* slab = (const char*)stun_recv_slab;
+    if (p >= slab && p < slab + sizeof(stun_recv_slab))
+        return;
+
     SDL_free(data_ptr);
 }
 
@@ -339,9 +389,9 @@ static void configure_gekko() {
 
     config.num_players = PLAYER_COUNT;
     config.input_size = sizeof(u16);
-    config.state_size = sizeof(State);
+    config.state_size = sizeof(RollbackState);
     config.max_spectators = 0;
-    config.input_prediction_window = 12;
+    config.input_prediction_window = INPUT_PREDICTION_WINDOW;
 
 #if defined(DEBUG)
     config.desync_detection = true;
@@ -369,8 +419,8 @@ static void configure_gekko() {
     printf("starting a session for player %d at port %hu\n", player_number, local_port);
 
     // Temporary: dump key field offsets to map desync diffs
-    printf("[offsetof] sizeof(State)=%zu sizeof(GameState)=%zu sizeof(PLW)=%zu\n",
-           sizeof(State),
+    printf("[offsetof] sizeof(RollbackState)=%zu sizeof(GameState)=%zu sizeof(PLW)=%zu\n",
+           sizeof(RollbackState),
            sizeof(GameState),
            sizeof(PLW));
     // Fields near first diffs (0x1D4-0x2F1 range)
@@ -452,6 +502,19 @@ static void configure_gekko() {
     }
     GekkoNetAddress remote_address = { .data = remote_address_str, .size = strlen(remote_address_str) };
 
+    // The STUN adapter addresses peers by binary endpoint
+    StunEndpoint remote_endpoint;
+    stun_dropped_address_logged = false;
+    if (stun_socket_fd >= 0) {
+        if (Stun_ParseEndpoint(remote_address_str, &remote_endpoint)) {
+            remote_address.data = &remote_endpoint;
+            remote_address.size = sizeof(remote_endpoint);
+        } else {
+            SDL_Log("[netplay] '%s' is not an IPv4 ip:port; the STUN socket can't reach this peer",
+                    remote_address_str);
+        }
+    }
+
     for (int i = 0; i < PLAYER_COUNT; i++) {
         const bool is_local_player = (i == player_number);
 
@@ -512,18 +575,18 @@ typedef struct {
 static SectionedChecksum saved_section_checksums[STATE_BUFFER_MAX];
 static PLW saved_plw_scratch[STATE_BUFFER_MAX][2];
 
-static void dump_state(const State* src, const char* filename) {
+static void dump_state(const RollbackState* src, const char* filename) {
     SDL_IOStream* io = SDL_IOFromFile(filename, "w");
     if (io == NULL) {
         SDL_Log("[netplay] dump_state: failed to open '%s' — states/ dir missing?", filename);
         return;
     }
-    SDL_WriteIO(io, src, sizeof(State));
+    SDL_WriteIO(io, src, sizeof(RollbackState));
     SDL_CloseIO(io);
 }
 
 static void dump_saved_state(int frame) {
-    const State* src = &state_buffer[frame % STATE_BUFFER_MAX];
+    const RollbackState* src = &state_buffer[frame % STATE_BUFFER_MAX];
 
     char filename[100];
     SDL_snprintf(filename, sizeof(filename), "states/%d_%d", player_handle, frame);
@@ -532,24 +595,6 @@ static void dump_saved_state(int frame) {
 }
 #endif
 
-#define SDL_copya(dst, src) SDL_memcpy(dst, src, sizeof(src))
-
-static void gather_state(State* dst) {
-    // GameState
-    GameState* gs = &dst->gs;
-    GameState_Save(gs);
-
-    // EffectState
-    EffectState* es = &dst->es;
-    SDL_copya(es->frw, frw);
-    SDL_copya(es->exec_tm, exec_tm);
-    SDL_copya(es->frwque, frwque);
-    SDL_copya(es->head_ix, head_ix);
-    SDL_copya(es->tail_ix, tail_ix);
-    es->frwctr = frwctr;
-    es->frwctr_min = frwctr_min;
-}
-
 #if defined(DEBUG)
 // These effect IDs use the WORK_Other_CONN layout (variable-length conn[] tail).
 // Derived by auditing every effXX.c that casts to WORK_Other_CONN*.
@@ -645,22 +690,22 @@ static void sanitize_plw_pointers(PLW* p) {
 
 /// Save state in state buffer.
 /// @return Mutable pointer to state as it has been saved.
-static State* note_state(const State* state, int frame) {
+static RollbackState* note_state(const RollbackState* state, int frame) {
     if (frame < 0) {
         frame += STATE_BUFFER_MAX;
     }
 
-    State* dst = &state_buffer[frame % STATE_BUFFER_MAX];
-    SDL_memcpy(dst, state, sizeof(State));
+    RollbackState* dst = &state_buffer[frame % STATE_BUFFER_MAX];
+    SDL_memcpy(dst, state, sizeof(RollbackState));
     return dst;
 }
 #endif
 
 static void save_state(GekkoGameEvent* event) {
-    *event->data.save.state_len = sizeof(State);
-    State* dst = (State*)event->data.save.state;
+    *event->data.save.state_len = sizeof(RollbackState);
+    RollbackState* dst = (RollbackState*)event->data.save.state;
 
-    gather_state(dst);
+    RollbackState_Save(dst);
 
 #if defined(DEBUG)
     const int frame = event->data.save.frame;
@@ -811,25 +856,9 @@ static void save_state(GekkoGameEvent* event) {
 #endif
 }
 
-static void load_state(const State* src) {
-    // GameState
-    const GameState* gs = &src->gs;
-    GameState_Load(gs);
-
-    // EffectState
-    const EffectState* es = &src->es;
-    SDL_copya(frw, es->frw);
-    SDL_copya(exec_tm, es->exec_tm);
-    SDL_copya(frwque, es->frwque);
-    SDL_copya(head_ix, es->head_ix);
-    SDL_copya(tail_ix, es->tail_ix);
-    frwctr = es->frwctr;
-    frwctr_min = es->frwctr_min;
-}
-
 static void load_state_from_event(GekkoGameEvent* event) {
-    const State* src = (State*)event->data.load.state;
-    load_state(src);
+    const RollbackState* src = (RollbackState*)event->data.load.state;
+    RollbackState_Load(src);
 }
 
 static bool game_ready_to_run_character_select() {
@@ -857,10 +886,7 @@ static void step_game(bool render) {
     seqsAfterProcess();
 }
 
-static void advance_game(GekkoGameEvent* event, bool render) {
-    const u16* inputs = (u16*)event->data.adv.inputs;
-    const int frame = event->data.adv.frame;
-
+static void apply_inputs_and_step(const u16* inputs, int frame, bool render) {
     p1sw_0 = PLsw[0][0] = inputs[0];
     p2sw_0 = PLsw[1][0] = inputs[1];
     p1sw_1 = PLsw[0][1] = recall_input(0, frame - 1);
@@ -872,6 +898,39 @@ static void advance_game(GekkoGameEvent* event, bool render) {
     step_game(render);
 }
 
+/// Push every frame up to and including `last` that the relay doesn't have yet.
+static void relay_push_through(int last) {
+    for (; relay_next_frame <= last; relay_next_frame++) {
+        const uint16_t inputs[2] = { recall_input(0, relay_next_frame), recall_input(1, relay_next_frame) };
+        SpectatorRelay_PushFrame(relay, relay_next_frame - relay_frame_base, inputs);
+    }
+}
+
+/// Feed the relay with the frames that can no longer be rolled back.
+/// GekkoNet never predicts more than INPUT_PREDICTION_WINDOW frames ahead,
+/// so once `frame` advances, everything older than the window is confirmed.
+/// GekkoNet doesn't report when a prediction turned out right, so the frames
+/// still inside the window when the session ends are never pushed: the
+/// spectator stream stops at the last frame known to be confirmed.
+static void relay_confirmed_frame(int frame) {
+    if (relay_frame_base < 0) {
+        relay_frame_base = frame;
+        relay_next_frame = frame;
+    }
+
+    relay_push_through(frame - INPUT_PREDICTION_WINDOW - 1);
+}
+
+static void advance_game(GekkoGameEvent* event, bool render) {
+    const int frame = event->data.adv.frame;
+
+    apply_inputs_and_step((u16*)event->data.adv.inputs, frame, render);
+
+    if (relay != NULL && !event->data.adv.rolling_back) {
+        relay_confirmed_frame(frame);
+    }
+}
+
 static void process_session() {
     frames_behind = -gekko_frames_ahead(session);
 
@@ -996,7 +1055,7 @@ static void process_session() {
 
             // Global context: player identity and key globals
             {
-                const State* st = &state_buffer[frame % STATE_BUFFER_MAX];
+                const RollbackState* st = &state_buffer[frame % STATE_BUFFER_MAX];
                 const GameState* gs = &st->gs;
                 printf("  globals context:\n");
                 printf("    My_char: [%d, %d]  Player_Color: [%d, %d]\n",
@@ -1069,6 +1128,7 @@ static void process_events(bool drawing_allowed) {
 static void step_logic(bool drawing_allowed) {
     process_session();
     process_events(drawing_allowed);
+    stun_adapter_flush();
 }
 
 static void update_network_stats() {
@@ -1146,6 +1206,51 @@ static void run_netplay() {
     update_network_stats();
 }
 
+static void run_spectator() {
+    const uint32_t session_id = SpectatorRelay_GetSessionId(relay);
+
+    // The players started a new match: rewind to character select and follow it
+    if (session_id != spectate_session) {
+        const bool restart = spectate_frame > 0;
+        spectate_session = session_id;
+        spectate_started = false;
+        spectate_frame = 0;
+
+        if (restart) {
+            setup_vs_mode();
+            SDL_zeroa(input_history);
+            transition_ready_frames = 0;
+            session_state = NETPLAY_SESSION_TRANSITIONING;
+            return;
+        }
+    }
+
+    const int buffered = SpectatorRelay_GetFrameCount(relay) - spectate_frame;
+
+    if (!spectate_started) {
+        if (session_id == 0 || buffered < spectate_delay) {
+            return;
+        }
+        spectate_started = true;
+        SDL_Log("[netplay] spectating session %08x with %d frames of delay", session_id, spectate_delay);
+    }
+
+    // Late joiners and stalls fast-forward until the buffer is back at the target delay
+    int steps = SDL_min(buffered, 1);
+    if (buffered > spectate_delay * 2 + 1) {
+        steps = SDL_min(buffered - spectate_delay, SPECTATE_CATCH_UP_MAX);
+    }
+
+    for (int i = 0; i < steps; i++) {
+        uint16_t inputs[2];
+        if (!SpectatorRelay_GetFrame(relay, spectate_frame, inputs)) {
+            break;
+        }
+        apply_inputs_and_step(inputs, spectate_frame, i == steps - 1);
+        spectate_frame += 1;
+    }
+}
+
 void Netplay_SetPlayerNumber(int player_num) {
     SDL_assert(player_num == 0 || player_num == 1);
     player_number = player_num;
@@ -1176,10 +1281,23 @@ void Netplay_SetStunSocket(int fd) {
     stun_socket_fd = fd;
 }
 
+void Netplay_SetSpectatorPort(unsigned short port) {
+    spectator_port = port;
+}
+
 void Netplay_Begin() {
     setup_vs_mode();
     Discovery_Shutdown();
 
+    // The relay outlives sessions so subscribed spectators follow every match
+    if (relay == NULL && spectator_port != 0) {
+        relay = SpectatorRelay_Create(spectator_port);
+    }
+    SpectatorRelay_BeginSession(relay);
+    relay_frame_base = -1;
+    relay_next_frame = -1;
+    spectating = false;
+
     SDL_zeroa(input_history);
     frames_behind = 0;
     frame_skip_timer = 0;
@@ -1201,12 +1319,38 @@ void Netplay_Begin() {
     session_state = NETPLAY_SESSION_TRANSITIONING;
 }
 
+bool Netplay_BeginSpectate(const char* upstream, int delay_frames) {
+    if (relay == NULL) {
+        relay = SpectatorRelay_Create(spectator_port);
+    }
+    if (!SpectatorRelay_SetUpstream(relay, upstream)) {
+        SDL_Log("[netplay] can't spectate '%s' (expected ip:port)", upstream ? upstream : "");
+        return false;
+    }
+
+    setup_vs_mode();
+    Discovery_Shutdown();
+
+    SDL_zeroa(input_history);
+    transition_ready_frames = 0;
+    spectating = true;
+    spectate_started = false;
+    spectate_frame = 0;
+    spectate_session = 0;
+    spectate_delay = SDL_max(delay_frames, 0);
+
+    session_state = NETPLAY_SESSION_TRANSITIONING;
+    return true;
+}
+
 void Netplay_EnterLobby() {
     session_state = NETPLAY_SESSION_LOBBY;
     Discovery_Init(Config_GetBool(CFG_KEY_NETPLAY_AUTO_CONNECT));
 }
 
 void Netplay_Run() {
+    SpectatorRelay_Poll(relay);
+
     switch (session_state) {
     case NETPLAY_SESSION_LOBBY:
         Discovery_Update();
@@ -1291,7 +1435,10 @@ void Netplay_Run() {
             step_game(true);
         }
 
-        if (transition_ready_frames >= 2) {
+        if (transition_ready_frames >= 2 && spectating) {
+            printf("[netplay] transition done, waiting for spectator stream\n");
+            session_state = NETPLAY_SESSION_RUNNING;
+        } else if (transition_ready_frames >= 2) {
             printf("[netplay] transition done, configuring gekko\n");
             configure_gekko();
             session_state = NETPLAY_SESSION_CONNECTING;
@@ -1301,7 +1448,11 @@ void Netplay_Run() {
 
     case NETPLAY_SESSION_CONNECTING:
     case NETPLAY_SESSION_RUNNING:
-        run_netplay();
+        if (spectating) {
+            run_spectator();
+        } else {
+            run_netplay();
+        }
         break;
 
     case NETPLAY_SESSION_EXITING:
@@ -1314,6 +1465,7 @@ void Netplay_Run() {
                 Stun_SocketClose(stun_socket_fd);
                 stun_socket_fd = -1;
             }
+            stun_send_count = 0;
 
 #ifndef LOSSY_ADAPTER
             // also cleanup default socket.
@@ -1321,6 +1473,13 @@ void Netplay_Run() {
 #endif
         }
 
+        if (spectating) {
+            // Spectator relays only exist to follow one upstream; players keep theirs
+            SpectatorRelay_Destroy(relay);
+            relay = NULL;
+            spectating = false;
+        }
+
         Discovery_Shutdown();
         session_state = NETPLAY_SESSION_IDLE;
         break;
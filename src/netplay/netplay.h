@@ -54,6 +54,14 @@ bool Netplay_PollEvent(NetplayEvent* out);
 /// Set to -1 to fall back to the default ASIO adapter.
 void Netplay_SetStunSocket(int fd);
 
+/// UDP port of the local spectator relay (0 = disabled for players).
+/// Players relay confirmed inputs on it; spectators serve chained spectators from it.
+void Netplay_SetSpectatorPort(unsigned short port);
+
+/// Spectate the match streamed by a player or relay at "ip:port", playing
+/// `delay_frames` behind the stream. Returns false on a malformed endpoint.
+bool Netplay_BeginSpectate(const char* upstream, int delay_frames);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,514 @@
+/**
+ * @file spectator_relay.c
+ * @brief Spectator broadcast relay — fans confirmed inputs out over UDP.
+ *
+ * Every node keeps the confirmed P1/P2 inputs of the current session in a
+ * ring and streams them to its subscribers. A subscriber periodically sends
+ * SUBSCRIBE(session, next_frame), which doubles as keep-alive and cumulative
+ * ack; the node answers with FRAMES packets starting at that frame, so lost
+ * packets are simply resent on the next poll. Nodes that subscribe upstream
+ * store what they receive and serve it onward, forming a relay tree.
+ *
+ * Wire format (little-endian):
+ *   header    u32 magic, u8 type
+ *   SUBSCRIBE u32 session_id, i32 next_frame
+ *   FRAMES    u32 session_id, i32 start_frame, u16 count, count x (u16 p1, u16 p2)
+ */
+#include "spectator_relay.h"
+#include "stun.h"
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#ifndef SIO_UDP_CONNRESET
+#define SIO_UDP_CONNRESET _WSAIOW(IOC_VENDOR, 12)
+#endif
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+#define RELAY_MAGIC 0x52535333u // "3SSR"
+#define RELAY_MSG_SUBSCRIBE 1
+#define RELAY_MSG_FRAMES 2
+
+#define RELAY_HEADER_SIZE 5
+#define RELAY_SUBSCRIBE_SIZE (RELAY_HEADER_SIZE + 8)
+#define RELAY_FRAMES_HEADER_SIZE (RELAY_HEADER_SIZE + 10)
+#define RELAY_FRAMES_PER_PACKET 128
+#define RELAY_MAX_DATAGRAM (RELAY_FRAMES_HEADER_SIZE + RELAY_FRAMES_PER_PACKET * 4)
+
+#define RELAY_PACKETS_PER_POLL 4 // Per subscriber; bounds catch-up bursts for late joiners
+#define RELAY_RECV_BATCH 32
+#define RELAY_SUBSCRIBE_INTERVAL_MS 100
+#define RELAY_RESEND_INTERVAL_MS 100
+#define RELAY_SUBSCRIBER_TIMEOUT_MS 5000
+
+#define RELAY_SEND_SLOTS (SPECTATOR_RELAY_MAX_SUBSCRIBERS * RELAY_PACKETS_PER_POLL + 1)
+
+typedef struct {
+    bool active;
+    StunEndpoint addr;
+    uint32_t session_id; // Session the subscriber's ack refers to
+    int acked;           // First frame the subscriber is missing
+    int sent;            // Frames sent so far (exclusive end)
+    uint32_t last_heard;
+    uint32_t last_send;
+} RelaySubscriber;
+
+struct SpectatorRelay {
+    int sock;
+    unsigned short port;
+
+    bool has_upstream;
+    StunEndpoint upstream;
+    uint32_t last_subscribe;
+    bool ack_pending;
+
+    uint32_t session_id;
+    int frame_count;
+    uint16_t (*frames)[2]; // Ring of SPECTATOR_RELAY_HISTORY_FRAMES entries
+
+    RelaySubscriber subs[SPECTATOR_RELAY_MAX_SUBSCRIBERS];
+
+    StunDatagram send_queue[RELAY_SEND_SLOTS];
+    char send_buf[RELAY_SEND_SLOTS][RELAY_MAX_DATAGRAM];
+    int send_count;
+
+    StunDatagram recv_slots[RELAY_RECV_BATCH];
+    char recv_buf[RELAY_RECV_BATCH][RELAY_MAX_DATAGRAM];
+
+    uint32_t packets_sent;
+    uint32_t packets_received;
+};
+
+// --- Little-endian wire helpers ---
+
+static void put_u16(char* p, uint16_t v) {
+    p[0] = (char)(v & 0xFF);
+    p[1] = (char)(v >> 8);
+}
+
+static void put_u32(char* p, uint32_t v) {
+    put_u16(p, (uint16_t)(v & 0xFFFF));
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const char* p) {
+    return (uint16_t)((uint8_t)p[0] | ((uint8_t)p[1] << 8));
+}
+
+static uint32_t get_u32(const char* p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static void put_header(char* p, uint8_t type) {
+    put_u32(p, RELAY_MAGIC);
+    p[4] = (char)type;
+}
+
+// --- Socket ---
+
+static int open_socket(unsigned short port, unsigned short* out_port) {
+    int sock = (int)socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+        return -1;
+
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(port);
+
+    if (bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        closesocket(sock);
+        return -1;
+    }
+    getsockname(sock, (struct sockaddr*)&addr, &addr_len);
+    *out_port = ntohs(addr.sin_port);
+
+#ifdef _WIN32
+    u_long mode = 1;
+    ioctlsocket(sock, FIONBIO, &mode);
+    // Don't let an ICMP "port unreachable" from a departed spectator fail the next recvfrom
+    BOOL report = FALSE;
+    DWORD bytes = 0;
+    WSAIoctl(sock, SIO_UDP_CONNRESET, &report, sizeof(report), NULL, 0, &bytes, NULL, NULL);
+#else
+    int flags = fcntl(sock, F_GETFL, 0);
+    fcntl(sock, F_SETFL, flags | O_NONBLOCK);
+#endif
+    return sock;
+}
+
+static char* queue_datagram(SpectatorRelay* relay, const StunEndpoint* to, int len) {
+    if (relay->send_count == RELAY_SEND_SLOTS)
+        return NULL;
+
+    StunDatagram* d = &relay->send_queue[relay->send_count];
+    d->addr = *to;
+    d->buf = relay->send_buf[relay->send_count];
+    d->len = len;
+    relay->send_count++;
+    return d->buf;
+}
+
+static void flush_sends(SpectatorRelay* relay) {
+    if (relay->send_count == 0)
+        return;
+
+    int sent = Stun_SocketSendBatch(relay->sock, relay->send_queue, relay->send_count);
+    if (sent > 0)
+        relay->packets_sent += sent;
+    relay->send_count = 0;
+}
+
+// --- Frame store ---
+
+static void reset_session(SpectatorRelay* relay, uint32_t session_id) {
+    relay->session_id = session_id;
+    relay->frame_count = 0;
+    for (int i = 0; i < SPECTATOR_RELAY_MAX_SUBSCRIBERS; i++) {
+        relay->subs[i].sent = 0;
+    }
+}
+
+static void store_frame(SpectatorRelay* relay, uint16_t p1, uint16_t p2) {
+    uint16_t* slot = relay->frames[relay->frame_count & (SPECTATOR_RELAY_HISTORY_FRAMES - 1)];
+    slot[0] = p1;
+    slot[1] = p2;
+    relay->frame_count++;
+}
+
+// --- Message handling ---
+
+static RelaySubscriber* find_subscriber(SpectatorRelay* relay, const StunEndpoint* addr, bool create) {
+    RelaySubscriber* free_slot = NULL;
+
+    for (int i = 0; i < SPECTATOR_RELAY_MAX_SUBSCRIBERS; i++) {
+        RelaySubscriber* sub = &relay->subs[i];
+        if (!sub->active) {
+            if (!free_slot)
+                free_slot = sub;
+            continue;
+        }
+        if (memcmp(&sub->addr, addr, sizeof(*addr)) == 0)
+            return sub;
+    }
+
+    if (!create || !free_slot)
+        return NULL;
+
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->active = true;
+    free_slot->addr = *addr;
+    return free_slot;
+}
+
+static void handle_subscribe(SpectatorRelay* relay, const StunDatagram* d, uint32_t now) {
+    if (d->len < RELAY_SUBSCRIBE_SIZE)
+        return;
+
+    RelaySubscriber* sub = find_subscriber(relay, &d->addr, true);
+    if (!sub) {
+        return; // Full — the subscriber should chain behind another spectator
+    }
+
+    const bool is_new = sub->last_heard == 0;
+    sub->last_heard = now;
+    sub->session_id = get_u32(d->buf + RELAY_HEADER_SIZE);
+    int next = (int)get_u32(d->buf + RELAY_HEADER_SIZE + 4);
+    sub->acked = (sub->session_id == relay->session_id) ? SDL_max(next, 0) : 0;
+
+    if (is_new) {
+        char ip[32];
+        Stun_FormatIP(d->addr.ip, ip, sizeof(ip));
+        SDL_Log("[relay] subscriber %s:%u joined at frame %d", ip, ntohs(d->addr.port), sub->acked);
+    }
+}
+
+static void handle_frames(SpectatorRelay* relay, const StunDatagram* d) {
+    if (!relay->has_upstream || memcmp(&d->addr, &relay->upstream, sizeof(d->addr)) != 0)
+        return;
+    if (d->len < RELAY_FRAMES_HEADER_SIZE)
+        return;
+
+    const char* p = d->buf + RELAY_HEADER_SIZE;
+    uint32_t session_id = get_u32(p);
+    int start = (int)get_u32(p + 4);
+    int count = get_u16(p + 8);
+
+    if (count > RELAY_FRAMES_PER_PACKET || d->len < RELAY_FRAMES_HEADER_SIZE + count * 4 || session_id == 0)
+        return;
+
+    if (session_id != relay->session_id) {
+        SDL_Log("[relay] upstream started session %08x", session_id);
+        reset_session(relay, session_id);
+    }
+
+    // Only contiguous data is useful; anything beyond a gap gets resent after our ack
+    if (start > relay->frame_count || start + count <= relay->frame_count)
+        return;
+
+    const char* in = d->buf + RELAY_FRAMES_HEADER_SIZE + (relay->frame_count - start) * 4;
+    for (int f = relay->frame_count; f < start + count; f++, in += 4) {
+        store_frame(relay, get_u16(in), get_u16(in + 2));
+    }
+    relay->ack_pending = true;
+}
+
+static void receive_packets(SpectatorRelay* relay, uint32_t now) {
+    for (;;) {
+        for (int i = 0; i < RELAY_RECV_BATCH; i++) {
+            relay->recv_slots[i].buf = relay->recv_buf[i];
+            relay->recv_slots[i].buf_size = RELAY_MAX_DATAGRAM;
+        }
+
+        int n = Stun_SocketRecvBatch(relay->sock, relay->recv_slots, RELAY_RECV_BATCH);
+        if (n <= 0)
+            return;
+        relay->packets_received += n;
+
+        for (int i = 0; i < n; i++) {
+            const StunDatagram* d = &relay->recv_slots[i];
+            if (d->len < RELAY_HEADER_SIZE || get_u32(d->buf) != RELAY_MAGIC)
+                continue;
+
+            switch ((uint8_t)d->buf[4]) {
+            case RELAY_MSG_SUBSCRIBE:
+                handle_subscribe(relay, d, now);
+                break;
+
+            case RELAY_MSG_FRAMES:
+                handle_frames(relay, d);
+                break;
+            }
+        }
+
+        if (n < RELAY_RECV_BATCH)
+            return;
+    }
+}
+
+static void send_subscribe(SpectatorRelay* relay, uint32_t now) {
+    char* p = queue_datagram(relay, &relay->upstream, RELAY_SUBSCRIBE_SIZE);
+    if (!p)
+        return;
+
+    put_header(p, RELAY_MSG_SUBSCRIBE);
+    put_u32(p + RELAY_HEADER_SIZE, relay->session_id);
+    put_u32(p + RELAY_HEADER_SIZE + 4, (uint32_t)relay->frame_count);
+    relay->last_subscribe = now;
+    relay->ack_pending = false;
+}
+
+static void send_frames(SpectatorRelay* relay, RelaySubscriber* sub, uint32_t now) {
+    int next = (sub->session_id == relay->session_id) ? sub->acked : 0;
+    const int oldest = relay->frame_count - SPECTATOR_RELAY_HISTORY_FRAMES;
+
+    if (next >= relay->frame_count || next < oldest)
+        return;
+
+    // Send when new frames exist; otherwise only resend unacked frames periodically
+    if (relay->frame_count <= sub->sent && now - sub->last_send < RELAY_RESEND_INTERVAL_MS)
+        return;
+
+    for (int pkt = 0; pkt < RELAY_PACKETS_PER_POLL && next < relay->frame_count; pkt++) {
+        const int count = SDL_min(relay->frame_count - next, RELAY_FRAMES_PER_PACKET);
+        char* p = queue_datagram(relay, &sub->addr, RELAY_FRAMES_HEADER_SIZE + count * 4);
+        if (!p)
+            break;
+
+        put_header(p, RELAY_MSG_FRAMES);
+        put_u32(p + RELAY_HEADER_SIZE, relay->session_id);
+        put_u32(p + RELAY_HEADER_SIZE + 4, (uint32_t)next);
+        put_u16(p + RELAY_HEADER_SIZE + 8, (uint16_t)count);
+
+        char* out = p + RELAY_FRAMES_HEADER_SIZE;
+        for (int f = next; f < next + count; f++, out += 4) {
+            const uint16_t* slot = relay->frames[f & (SPECTATOR_RELAY_HISTORY_FRAMES - 1)];
+            put_u16(out, slot[0]);
+            put_u16(out + 2, slot[1]);
+        }
+
+        next += count;
+    }
+
+    sub->sent = next;
+    sub->last_send = now;
+}
+
+// --- Public API ---
+
+SpectatorRelay* SpectatorRelay_Create(unsigned short port) {
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+
+    SpectatorRelay* relay = (SpectatorRelay*)SDL_calloc(1, sizeof(SpectatorRelay));
+    if (!relay)
+        return NULL;
+
+    relay->frames = SDL_calloc(SPECTATOR_RELAY_HISTORY_FRAMES, sizeof(relay->frames[0]));
+    relay->sock = open_socket(port, &relay->port);
+    if (!relay->frames || relay->sock < 0) {
+        SDL_Log("[relay] failed to open UDP port %u", port);
+        SpectatorRelay_Destroy(relay);
+        return NULL;
+    }
+
+    SDL_Log("[relay] listening on UDP port %u", relay->port);
+    return relay;
+}
+
+void SpectatorRelay_Destroy(SpectatorRelay* relay) {
+    if (!relay)
+        return;
+
+    if (relay->sock >= 0)
+        closesocket(relay->sock);
+    SDL_free(relay->frames);
+    SDL_free(relay);
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+unsigned short SpectatorRelay_GetPort(const SpectatorRelay* relay) {
+    return relay ? relay->port : 0;
+}
+
+bool SpectatorRelay_SetUpstream(SpectatorRelay* relay, const char* endpoint) {
+    if (!relay || !Stun_ParseEndpoint(endpoint, &relay->upstream))
+        return false;
+
+    relay->has_upstream = true;
+    relay->last_subscribe = 0;
+    relay->ack_pending = true;
+    return true;
+}
+
+void SpectatorRelay_BeginSession(SpectatorRelay* relay) {
+    if (!relay)
+        return;
+
+    uint32_t id = (uint32_t)SDL_GetPerformanceCounter() * 2654435761u ^ (uint32_t)SDL_GetTicks();
+    if (id == 0 || id == relay->session_id)
+        id++;
+    reset_session(relay, id);
+}
+
+void SpectatorRelay_PushFrame(SpectatorRelay* relay, int frame, const uint16_t inputs[2]) {
+    if (!relay || relay->session_id == 0 || frame != relay->frame_count)
+        return;
+
+    store_frame(relay, inputs[0], inputs[1]);
+}
+
+void SpectatorRelay_Poll(SpectatorRelay* relay) {
+    if (!relay)
+        return;
+
+    const uint32_t now = (uint32_t)SDL_GetTicks();
+
+    receive_packets(relay, now);
+
+    if (relay->has_upstream && (relay->ack_pending || now - relay->last_subscribe >= RELAY_SUBSCRIBE_INTERVAL_MS)) {
+        send_subscribe(relay, now);
+    }
+
+    for (int i = 0; i < SPECTATOR_RELAY_MAX_SUBSCRIBERS; i++) {
+        RelaySubscriber* sub = &relay->subs[i];
+        if (!sub->active)
+            continue;
+
+        if (now - sub->last_heard > RELAY_SUBSCRIBER_TIMEOUT_MS) {
+            sub->active = false;
+            continue;
+        }
+
+        if (relay->session_id != 0)
+            send_frames(relay, sub, now);
+    }
+
+    flush_sends(relay);
+}
+
+int SpectatorRelay_GetFrameCount(const SpectatorRelay* relay) {
+    return relay ? relay->frame_count : 0;
+}
+
+bool SpectatorRelay_GetFrame(const SpectatorRelay* relay, int frame, uint16_t out_inputs[2]) {
+    if (!relay || frame < 0 || frame >= relay->frame_count ||
+        frame < relay->frame_count - SPECTATOR_RELAY_HISTORY_FRAMES) {
+        return false;
+    }
+
+    const uint16_t* slot = relay->frames[frame & (SPECTATOR_RELAY_HISTORY_FRAMES - 1)];
+    out_inputs[0] = slot[0];
+    out_inputs[1] = slot[1];
+    return true;
+}
+
+uint32_t SpectatorRelay_GetSessionId(const SpectatorRelay* relay) {
+    return relay ? relay->session_id : 0;
+}
+
+void SpectatorRelay_GetStats(const SpectatorRelay* relay, SpectatorRelayStats* out) {
+    SDL_zerop(out);
+    if (!relay)
+        return;
+
+    for (int i = 0; i < SPECTATOR_RELAY_MAX_SUBSCRIBERS; i++) {
+        if (relay->subs[i].active)
+            out->subscribers++;
+    }
+    out->frames = relay->frame_count;
+    out->session_id = relay->session_id;
+    out->packets_sent = relay->packets_sent;
+    out->packets_received = relay->packets_received;
+}
+
+int SpectatorRelay_RunHeadless(unsigned short port, const char* upstream) {
+    SpectatorRelay* relay = SpectatorRelay_Create(port);
+    if (!relay)
+        return 1;
+
+    if (!SpectatorRelay_SetUpstream(relay, upstream)) {
+        SDL_Log("[relay] invalid upstream endpoint '%s' (expected ip:port)", upstream);
+        SpectatorRelay_Destroy(relay);
+        return 1;
+    }
+
+    SDL_Log("[relay] headless relay on port %u, upstream %s", relay->port, upstream);
+
+    uint32_t last_report = 0;
+    for (;;) {
+        SpectatorRelay_Poll(relay);
+
+        const uint32_t now = (uint32_t)SDL_GetTicks();
+        if (now - last_report >= 5000) {
+            SpectatorRelayStats stats;
+            SpectatorRelay_GetStats(relay, &stats);
+            SDL_Log("[relay] session %08x: %d frames, %d subscribers, %u sent / %u received",
+                    stats.session_id,
+                    stats.frames,
+                    stats.subscribers,
+                    stats.packets_sent,
+                    stats.packets_received);
+            last_report = now;
+        }
+
+        SDL_Delay(1);
+    }
+}
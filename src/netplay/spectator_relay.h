@@ -0,0 +1,75 @@
+#ifndef NETPLAY_SPECTATOR_RELAY_H
+#define NETPLAY_SPECTATOR_RELAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Downstream spectators/relays a single node serves.
+#define SPECTATOR_RELAY_MAX_SUBSCRIBERS 16
+
+/// Confirmed frames a node keeps; late joiners can replay up to this far back (~18 min at 60 fps).
+#define SPECTATOR_RELAY_HISTORY_FRAMES 65536
+
+/// A node in the spectator broadcast tree.
+///
+/// The source node (a player) pushes confirmed P1/P2 inputs with PushFrame.
+/// Any other node subscribes to an upstream node (a player or another relay)
+/// and stores the frames it receives. Every node re-broadcasts its frames to
+/// its own subscribers, so spectators can chain behind each other and the
+/// player's uplink only carries one stream per direct subscriber.
+typedef struct SpectatorRelay SpectatorRelay;
+
+typedef struct {
+    int subscribers;     // Live downstream subscribers
+    int frames;          // Contiguous frames held for the current session
+    uint32_t session_id; // 0 until a session has started
+    uint32_t packets_sent;
+    uint32_t packets_received;
+} SpectatorRelayStats;
+
+/// Open a relay node on a UDP port (0 = ephemeral). Returns NULL if the socket can't be bound.
+SpectatorRelay* SpectatorRelay_Create(unsigned short port);
+
+/// Close the socket and free the node.
+void SpectatorRelay_Destroy(SpectatorRelay* relay);
+
+/// Actual bound UDP port (useful after creating with port 0).
+unsigned short SpectatorRelay_GetPort(const SpectatorRelay* relay);
+
+/// Subscribe to an upstream node at "ip:port". Returns false on a malformed endpoint.
+bool SpectatorRelay_SetUpstream(SpectatorRelay* relay, const char* endpoint);
+
+/// Source only: start a new stream (fresh session id, frames restart at 0).
+void SpectatorRelay_BeginSession(SpectatorRelay* relay);
+
+/// Source only: append the confirmed inputs of `frame`. Frames must arrive in order starting at 0.
+void SpectatorRelay_PushFrame(SpectatorRelay* relay, int frame, const uint16_t inputs[2]);
+
+/// Receive pending packets, refresh the upstream subscription and fan frames out
+/// to subscribers. Call once per game frame (or in a loop when headless).
+void SpectatorRelay_Poll(SpectatorRelay* relay);
+
+/// Number of contiguous frames (0..n-1) held for the current session.
+int SpectatorRelay_GetFrameCount(const SpectatorRelay* relay);
+
+/// Copy the inputs of a held frame. Returns false if the frame isn't available.
+bool SpectatorRelay_GetFrame(const SpectatorRelay* relay, int frame, uint16_t out_inputs[2]);
+
+/// Id of the session currently being relayed (0 = none yet).
+uint32_t SpectatorRelay_GetSessionId(const SpectatorRelay* relay);
+
+void SpectatorRelay_GetStats(const SpectatorRelay* relay, SpectatorRelayStats* out);
+
+/// Run a headless relay (no game) until the process is terminated.
+/// Listens on `port` and subscribes to `upstream` ("ip:port"). Returns a process exit code.
+int SpectatorRelay_RunHeadless(unsigned short port, const char* upstream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
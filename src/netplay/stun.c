@@ -10,6 +10,7 @@
 #endif
 #include "stun.h"
 #include <SDL3/SDL.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -479,3 +480,172 @@ void Stun_SocketClose(int fd) {
         closesocket(fd);
     }
 }
+
+// --- Binary endpoint / batched datagram I/O ---
+
+// Datagrams per sendmmsg/recvmmsg call; larger batches are split.
+#define STUN_BATCH_CHUNK 32
+
+static void endpoint_to_sockaddr(const StunEndpoint* ep, struct sockaddr_in* sa) {
+    memset(sa, 0, sizeof(*sa));
+    sa->sin_family = AF_INET;
+    sa->sin_addr.s_addr = ep->ip;
+    sa->sin_port = ep->port;
+}
+
+static void endpoint_from_sockaddr(const struct sockaddr_in* sa, StunEndpoint* ep) {
+    ep->ip = sa->sin_addr.s_addr;
+    ep->port = sa->sin_port;
+    ep->pad = 0;
+}
+
+static bool socket_would_block(void) {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+bool Stun_ParseEndpoint(const char* str, StunEndpoint* out) {
+    if (!str || !out)
+        return false;
+
+    char ip_str[64];
+    const char* colon = strrchr(str, ':');
+    if (!colon || (size_t)(colon - str) >= sizeof(ip_str))
+        return false;
+    memcpy(ip_str, str, colon - str);
+    ip_str[colon - str] = '\0';
+
+    struct in_addr ip;
+    if (inet_pton(AF_INET, ip_str, &ip) != 1)
+        return false;
+
+    int port = atoi(colon + 1);
+    if (port <= 0 || port > 65535)
+        return false;
+
+    memset(out, 0, sizeof(*out));
+    out->ip = ip.s_addr;
+    out->port = htons((uint16_t)port);
+    return true;
+}
+
+#if defined(__linux__)
+
+int Stun_SocketSendBatch(int fd, const StunDatagram* dgrams, int count) {
+    if (fd < 0)
+        return -1;
+
+    int sent = 0;
+    while (sent < count) {
+        struct mmsghdr msgs[STUN_BATCH_CHUNK];
+        struct iovec iov[STUN_BATCH_CHUNK];
+        struct sockaddr_in dest[STUN_BATCH_CHUNK];
+        int n = SDL_min(count - sent, STUN_BATCH_CHUNK);
+
+        memset(msgs, 0, sizeof(msgs[0]) * n);
+        for (int i = 0; i < n; i++) {
+            const StunDatagram* d = &dgrams[sent + i];
+            endpoint_to_sockaddr(&d->addr, &dest[i]);
+            iov[i].iov_base = d->buf;
+            iov[i].iov_len = d->len;
+            msgs[i].msg_hdr.msg_name = &dest[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(dest[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int r = sendmmsg(fd, msgs, n, MSG_DONTWAIT);
+        if (r <= 0)
+            return sent > 0 ? sent : -1;
+        sent += r;
+        if (r < n)
+            break;
+    }
+    return sent;
+}
+
+int Stun_SocketRecvBatch(int fd, StunDatagram* dgrams, int count) {
+    if (fd < 0)
+        return -1;
+
+    int received = 0;
+    while (received < count) {
+        struct mmsghdr msgs[STUN_BATCH_CHUNK];
+        struct iovec iov[STUN_BATCH_CHUNK];
+        struct sockaddr_in from[STUN_BATCH_CHUNK];
+        int n = SDL_min(count - received, STUN_BATCH_CHUNK);
+
+        memset(msgs, 0, sizeof(msgs[0]) * n);
+        for (int i = 0; i < n; i++) {
+            StunDatagram* d = &dgrams[received + i];
+            iov[i].iov_base = d->buf;
+            iov[i].iov_len = d->buf_size;
+            msgs[i].msg_hdr.msg_name = &from[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(from[i]);
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int r = recvmmsg(fd, msgs, n, MSG_DONTWAIT, NULL);
+        if (r <= 0) {
+            if (received > 0 || (r < 0 && socket_would_block()))
+                return received;
+            return r;
+        }
+
+        for (int i = 0; i < r; i++) {
+            StunDatagram* d = &dgrams[received + i];
+            endpoint_from_sockaddr(&from[i], &d->addr);
+            d->len = (int)msgs[i].msg_len;
+        }
+        received += r;
+        if (r < n)
+            break;
+    }
+    return received;
+}
+
+#else
+
+int Stun_SocketSendBatch(int fd, const StunDatagram* dgrams, int count) {
+    if (fd < 0)
+        return -1;
+
+    int sent = 0;
+    for (int i = 0; i < count; i++) {
+        struct sockaddr_in dest;
+        endpoint_to_sockaddr(&dgrams[i].addr, &dest);
+        if (sendto(fd, dgrams[i].buf, dgrams[i].len, 0, (struct sockaddr*)&dest, sizeof(dest)) < 0)
+            return sent > 0 ? sent : -1;
+        sent++;
+    }
+    return sent;
+}
+
+// Relies on the socket being non-blocking (see Stun_SetNonBlocking).
+int Stun_SocketRecvBatch(int fd, StunDatagram* dgrams, int count) {
+    if (fd < 0)
+        return -1;
+
+    int received = 0;
+    while (received < count) {
+        StunDatagram* d = &dgrams[received];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        int n = recvfrom(fd, d->buf, d->buf_size, 0, (struct sockaddr*)&from, &from_len);
+        if (n < 0) {
+            if (received > 0 || socket_would_block())
+                return received;
+            return -1;
+        }
+        endpoint_from_sockaddr(&from, &d->addr);
+        d->len = n;
+        received++;
+    }
+    return received;
+}
+
+#endif
@@ -57,6 +57,34 @@ int Stun_SocketRecvFrom(int fd, char* buf, int buf_size, char* from_endpoint, in
 /// Close a raw socket fd.
 void Stun_SocketClose(int fd);
 
+/// Binary IPv4 endpoint. Used as the GekkoNetAddress payload on STUN sessions
+/// so the packet path never formats or parses "ip:port" strings.
+/// GekkoNet compares addresses bytewise, so `pad` must always be zero.
+typedef struct {
+    uint32_t ip;   // Network byte order
+    uint16_t port; // Network byte order
+    uint16_t pad;  // Always zero
+} StunEndpoint;
+
+/// One datagram for batched socket I/O. The caller owns `buf`.
+typedef struct {
+    StunEndpoint addr; // Destination on send, source on receive
+    char* buf;
+    int buf_size; // Capacity of buf (receive only)
+    int len;      // Bytes to send / bytes received
+} StunDatagram;
+
+/// Parse "ip:port" into a binary endpoint. Returns false on malformed input.
+bool Stun_ParseEndpoint(const char* str, StunEndpoint* out);
+
+/// Send `count` datagrams (sendmmsg on Linux, sendto loop elsewhere).
+/// Returns the number of datagrams handed to the kernel, or -1 on error.
+int Stun_SocketSendBatch(int fd, const StunDatagram* dgrams, int count);
+
+/// Receive up to `count` datagrams without blocking (recvmmsg on Linux, recvfrom loop elsewhere).
+/// Fills each slot's addr and len. Returns the number received, 0 if none available, or -1 on error.
+int Stun_SocketRecvBatch(int fd, StunDatagram* dgrams, int count);
+
 #ifdef __cplusplus
 }
 #endif
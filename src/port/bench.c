@@ -0,0 +1,536 @@
+/**
+ * @file bench.c
+ * @brief Deterministic scenario benchmark with per-subsystem frame timings.
+ *
+ * Drives the attract mode with neutral input, so every run plays the same
+ * frames: the demo fights are CPU vs CPU and their characters are picked
+ * through the same debug overrides the demo setup already honours. The
+ * frame loop mirrors main()'s serial path with vsync and the frame pacer
+ * off, and the SPU is mixed on the game thread so its cost lands in the
+ * frame that produced it. Rollback frames save, rewind and resimulate the
+ * same state netplay snapshots, with rendering suppressed the way GekkoNet
+ * resimulation runs.
+ */
+#include "port/bench.h"
+#include "game_state.h"
+#include "main.h"
+#include "port/bench_stats.h"
+#include "port/renderer.h"
+#include "port/sdl/sdl_app.h"
+#include "port/sdl/sdl_app_internal.h"
+#include "port/sdl/sdl_game_renderer.h"
+#include "port/sound/spu.h"
+#include "sf33rd/Source/Game/debug/debug_config.h"
+#include "sf33rd/Source/Game/engine/workuser.h"
+#include "sf33rd/Source/Game/io/ioconv.h"
+#include "sf33rd/Source/Game/rendering/mtrans.h"
+#include "sf33rd/Source/Game/system/work_sys.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_CHARACTER_COUNT 20
+#define BENCH_SHORT_PAIR_COUNT 5  // Pairs used by the supers and rollback scenarios
+#define BENCH_ATTRACT_FRAMES 3600 // ~1 min: logo, title and the first demo fight
+#define BENCH_FIGHT_FRAMES 600    // In-fight frames timed per pair
+#define BENCH_DEFAULT_ROLLBACK 8  // Frames resimulated per rollback tick
+#define BENCH_MAX_ROLLBACK 12     // GekkoNet's prediction window
+#define BENCH_WAIT_FRAMES 20000   // Give up waiting for a demo fight after this
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_MIX_CAPACITY 4096   // Sample frames per SPU_Mix call
+
+// Set by ParseCLI
+extern const char* g_bench_scenario;
+extern int g_bench_frames;
+extern int g_bench_rollback;
+extern const char* g_bench_out;
+
+extern void njUserMain();
+
+// Everything a netplay rollback restores, plus the attract-demo counters
+// netplay never needs; without them a rewound demo fight would end early.
+typedef struct BenchSnapshot {
+    RollbackState state;
+    u8 D_No[4];
+    s16 D_Timer;
+} BenchSnapshot;
+
+typedef struct BenchScenarioResult {
+    const char* name;
+    int pairs;
+    int rollback;
+    BenchSeries frame;
+    BenchSeries sections[BENCH_SECTION_COUNT];
+    bool has_uploads; // The renderer reports upload stats
+    BenchSeries texture_kib;
+    BenchSeries palette_kib;
+    unsigned long long upload_drops;
+} BenchScenarioResult;
+
+static const char* const section_names[BENCH_SECTION_COUNT] = {
+    "logic", "sprites", "render", "audio", "state",
+};
+
+static const BenchFrameHooks* frame_hooks = NULL;
+static bool running = false;
+static bool quit_requested = false;
+static Uint64 section_start[BENCH_SECTION_COUNT];
+static Uint64 section_ns[BENCH_SECTION_COUNT];
+
+static double audio_remainder = 0.0;
+static s16 mix_buffer[BENCH_MIX_CAPACITY * 2];
+
+static BenchSnapshot* snapshots = NULL;
+static int snapshot_count = 0;
+
+bool Bench_IsRequested(void) {
+    return g_bench_scenario != NULL;
+}
+
+bool Bench_IsRunning(void) {
+    return running;
+}
+
+void Bench_ClearInput(void) {
+    for (int i = 0; i < 2; i++) {
+        IOPad* pad = &io_w.data[i];
+        pad->sw = 0;
+        pad->sw_old = 0;
+        pad->sw_new = 0;
+        pad->sw_off = 0;
+        pad->sw_chg = 0;
+        pad->sw_repeat = 0;
+        SDL_zeroa(pad->stick);
+        io_w.sw[i] = 0;
+    }
+    p1sw_buff = 0;
+    p2sw_buff = 0;
+    p3sw_buff = 0;
+    p4sw_buff = 0;
+}
+
+void Bench_BeginSection(BenchSection section) {
+    if (!running)
+        return;
+    section_start[section] = SDL_GetTicksNS();
+}
+
+void Bench_EndSection(BenchSection section) {
+    if (!running)
+        return;
+    section_ns[section] += SDL_GetTicksNS() - section_start[section];
+}
+
+static double ns_to_ms(Uint64 ns) {
+    return (double)ns / 1000000.0;
+}
+
+// --- State snapshots ---
+
+static void save_snapshot(BenchSnapshot* dst) {
+    RollbackState_Save(&dst->state);
+    SDL_memcpy(dst->D_No, D_No, sizeof(D_No));
+    dst->D_Timer = D_Timer;
+}
+
+static void load_snapshot(const BenchSnapshot* src) {
+    RollbackState_Load(&src->state);
+    SDL_memcpy(D_No, src->D_No, sizeof(D_No));
+    D_Timer = src->D_Timer;
+}
+
+// --- Frame driver ---
+
+static void mix_audio(void) {
+    // Mix exactly one frame's worth, carrying the fraction so the sound
+    // driver's 250 Hz timer keeps the same pace as with the device running
+    audio_remainder += (double)BENCH_SAMPLE_RATE * (double)SDLApp_GetTargetFrameTimeNS() / 1e9;
+    int sample_frames = (int)audio_remainder;
+    audio_remainder -= sample_frames;
+
+    while (sample_frames > 0) {
+        const int batch = SDL_min(sample_frames, BENCH_MIX_CAPACITY);
+        SPU_Mix(mix_buffer, batch);
+        sample_frames -= batch;
+    }
+}
+
+/** @brief One game frame as netplay resimulates it: logic only, no texture transfer. */
+static void resimulate_frame(void) {
+    SDLGameRenderer_ResetBatchState();
+    No_Trans = 1;
+
+    Bench_BeginSection(BENCH_SECTION_LOGIC);
+    njUserMain();
+    seqsBeforeProcess();
+    Bench_EndSection(BENCH_SECTION_LOGIC);
+
+    Bench_BeginSection(BENCH_SECTION_SPRITES);
+    Renderer_Flush2DPrimitives();
+    seqsAfterProcess();
+    Bench_EndSection(BENCH_SECTION_SPRITES);
+}
+
+/**
+ * @brief Snapshot this frame, rewind `depth` frames and resimulate back to it.
+ *
+ * Matches a GekkoNet rollback with a full misprediction window: one load,
+ * `depth` silent frames, and a save after each of them. With CPU-only input
+ * the resimulation lands on exactly the state it started from.
+ */
+static void rollback(int frame, int depth) {
+    const int ring = depth + 1;
+
+    Bench_BeginSection(BENCH_SECTION_STATE);
+    save_snapshot(&snapshots[frame % ring]);
+    Bench_EndSection(BENCH_SECTION_STATE);
+    snapshot_count += 1;
+
+    if (snapshot_count <= depth)
+        return;
+
+    const u8 saved_no_trans = No_Trans;
+
+    Bench_BeginSection(BENCH_SECTION_STATE);
+    load_snapshot(&snapshots[(frame - depth) % ring]);
+    Bench_EndSection(BENCH_SECTION_STATE);
+
+    for (int i = 1; i <= depth; i++) {
+        resimulate_frame();
+
+        Bench_BeginSection(BENCH_SECTION_STATE);
+        save_snapshot(&snapshots[(frame - depth + i) % ring]);
+        Bench_EndSection(BENCH_SECTION_STATE);
+    }
+
+    // The rendered frame starts with a clean texture stack, as in step_game
+    SDLGameRenderer_ResetBatchState();
+    No_Trans = saved_no_trans;
+}
+
+/**
+ * @brief Run one frame through the serial main-loop path.
+ *
+ * With `result` set the frame's section times are recorded; `rollback_frame`
+ * >= 0 makes it a rollback tick of `rollback_depth` frames.
+ */
+static void run_frame(BenchScenarioResult* result, int rollback_frame, int rollback_depth) {
+    SDL_zeroa(section_ns);
+    const Uint64 frame_start = SDL_GetTicksNS();
+
+    if (rollback_frame >= 0) {
+        rollback(rollback_frame, rollback_depth);
+    }
+
+    SDLApp_BeginFrame();
+    frame_hooks->step_0();
+
+    Bench_BeginSection(BENCH_SECTION_RENDER);
+    SDLApp_EndFrame();
+    Bench_EndSection(BENCH_SECTION_RENDER);
+
+    if (!SDLApp_PollEvents()) {
+        quit_requested = true;
+    }
+
+    Bench_BeginSection(BENCH_SECTION_LOGIC);
+    frame_hooks->step_1();
+    Bench_EndSection(BENCH_SECTION_LOGIC);
+
+    Bench_BeginSection(BENCH_SECTION_AUDIO);
+    mix_audio();
+    Bench_EndSection(BENCH_SECTION_AUDIO);
+
+    if (result) {
+        BenchSeries_Push(&result->frame, ns_to_ms(SDL_GetTicksNS() - frame_start));
+        for (int i = 0; i < BENCH_SECTION_COUNT; i++) {
+            BenchSeries_Push(&result->sections[i], ns_to_ms(section_ns[i]));
+        }
+
+        SDLGameRenderer_UploadStats uploads;
+        if (SDLGameRenderer_GetUploadStats(&uploads)) {
+            result->has_uploads = true;
+            BenchSeries_Push(&result->texture_kib, uploads.texture_bytes / 1024.0);
+            BenchSeries_Push(&result->palette_kib, uploads.palette_bytes / 1024.0);
+            result->upload_drops += uploads.drops;
+        }
+    }
+}
+
+/** @brief Run untimed frames until the game is (or is no longer) in a fight. */
+static bool wait_for_fight(bool in_fight) {
+    for (int i = 0; i < BENCH_WAIT_FRAMES; i++) {
+        if (quit_requested)
+            return false;
+        if (mpp_w.inGame == in_fight)
+            return true;
+        run_frame(NULL, -1, 0);
+    }
+    SDL_Log("Bench: gave up waiting for the attract demo to %s a fight", in_fight ? "start" : "end");
+    return false;
+}
+
+// --- Scenarios ---
+
+static bool run_attract(BenchScenarioResult* result, int frames) {
+    for (int i = 0; i < frames && !quit_requested; i++) {
+        run_frame(result, -1, 0);
+    }
+    return !quit_requested;
+}
+
+/**
+ * @brief Time `frames` in-fight frames of a demo fight for each of the first `pairs` pairs.
+ *
+ * Pair i puts character i against character i + 1, so every character
+ * appears on both sides across the full roster.
+ */
+static bool run_fights(BenchScenarioResult* result, int pairs, int frames, int rollback_depth) {
+    for (int pair = 0; pair < pairs; pair++) {
+        const int p1 = pair;
+        const int p2 = (pair + 1) % BENCH_CHARACTER_COUNT;
+
+        // Setup_Demo_PL reads these when the next demo fight is set up
+        Debug_w[DEBUG_MY_CHAR_PL1] = (s8)(p1 + 1);
+        Debug_w[DEBUG_MY_CHAR_PL2] = (s8)(p2 + 1);
+
+        if (!wait_for_fight(false) || !wait_for_fight(true))
+            return false;
+
+        if (My_char[0] != p1 || My_char[1] != p2) {
+            SDL_Log("Bench: demo fight started with %d vs %d, expected %d vs %d", My_char[0], My_char[1], p1, p2);
+            return false;
+        }
+
+        snapshot_count = 0;
+        int timed = 0;
+        while (timed < frames && mpp_w.inGame && !quit_requested) {
+            run_frame(result, rollback_depth > 0 ? timed : -1, rollback_depth);
+            timed += 1;
+        }
+
+        SDL_Log("Bench: %s pair %d/%d (%d vs %d): %d frames", result->name, pair + 1, pairs, p1, p2, timed);
+    }
+    return !quit_requested;
+}
+
+// --- Report ---
+
+static const char* arch_name(void) {
+#if defined(__x86_64__) || defined(_M_X64)
+    return "x86_64";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return "aarch64";
+#elif defined(__i386__) || defined(_M_IX86)
+    return "x86";
+#elif defined(__arm__) || defined(_M_ARM)
+    return "arm";
+#else
+    return "unknown";
+#endif
+}
+
+static void compiler_name(char* out, size_t size) {
+#if defined(__clang__)
+    snprintf(out, size, "clang %d.%d.%d", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+    snprintf(out, size, "gcc %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    snprintf(out, size, "msvc %d", _MSC_VER);
+#else
+    snprintf(out, size, "unknown");
+#endif
+}
+
+static const char* renderer_name(void) {
+    switch (SDLApp_GetRenderer()) {
+    case RENDERER_SDLGPU:
+        return "gpu";
+    case RENDERER_SDL2D:
+        return "sdl";
+    default:
+        return "gl";
+    }
+}
+
+static void write_summary(FILE* f, const char* name, BenchSeries* series, bool last) {
+    BenchSummary s;
+    BenchSeries_Summarize(series, &s);
+    fprintf(f,
+            "        \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f }%s\n",
+            name,
+            s.mean,
+            s.p50,
+            s.p90,
+            s.p99,
+            s.max,
+            last ? "" : ",");
+}
+
+static bool write_report(BenchScenarioResult* results, int count) {
+    FILE* f = stdout;
+    if (g_bench_out) {
+        f = fopen(g_bench_out, "w");
+        if (!f) {
+            SDL_Log("Bench: can't write %s", g_bench_out);
+            return false;
+        }
+    }
+
+    char compiler[64];
+    compiler_name(compiler, sizeof(compiler));
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"schema\": 1,\n");
+    fprintf(f, "  \"units\": \"ms\",\n");
+    fprintf(f, "  \"platform\": \"%s\",\n", SDL_GetPlatform());
+    fprintf(f, "  \"arch\": \"%s\",\n", arch_name());
+    fprintf(f, "  \"compiler\": \"%s\",\n", compiler);
+#if defined(DEBUG)
+    fprintf(f, "  \"build\": \"debug\",\n");
+#else
+    fprintf(f, "  \"build\": \"release\",\n");
+#endif
+    fprintf(f, "  \"renderer\": \"%s\",\n", renderer_name());
+    fprintf(f, "  \"frame_budget_ms\": %.4f,\n", ns_to_ms(SDLApp_GetTargetFrameTimeNS()));
+    fprintf(f, "  \"scenarios\": {\n");
+
+    for (int i = 0; i < count; i++) {
+        BenchScenarioResult* r = &results[i];
+        fprintf(f, "    \"%s\": {\n", r->name);
+        fprintf(f, "      \"frames\": %zu,\n", r->frame.count);
+        fprintf(f, "      \"pairs\": %d,\n", r->pairs);
+        fprintf(f, "      \"rollback_frames\": %d,\n", r->rollback);
+        fprintf(f, "      \"sections\": {\n");
+        write_summary(f, "frame", &r->frame, false);
+        for (int s = 0; s < BENCH_SECTION_COUNT; s++) {
+            write_summary(f, section_names[s], &r->sections[s], s == BENCH_SECTION_COUNT - 1);
+        }
+        fprintf(f, "      }%s\n", r->has_uploads ? "," : "");
+        if (r->has_uploads) {
+            fprintf(f, "      \"upload_drops\": %llu,\n", r->upload_drops);
+            fprintf(f, "      \"uploads_kib\": {\n");
+            write_summary(f, "texture", &r->texture_kib, false);
+            write_summary(f, "palette", &r->palette_kib, true);
+            fprintf(f, "      }\n");
+        }
+        fprintf(f, "    }%s\n", i == count - 1 ? "" : ",");
+    }
+
+    fprintf(f, "  }\n");
+    fprintf(f, "}\n");
+
+    if (f != stdout) {
+        fclose(f);
+        SDL_Log("Bench: report written to %s", g_bench_out);
+    }
+    return true;
+}
+
+// --- Entry point ---
+
+static bool scenario_selected(const char* name) {
+    return strcmp(g_bench_scenario, "all") == 0 || strcmp(g_bench_scenario, name) == 0;
+}
+
+int Bench_Run(const BenchFrameHooks* hooks) {
+    static const char* const scenario_names[] = { "attract", "versus", "supers", "rollback" };
+    enum { SCENARIO_COUNT = SDL_arraysize(scenario_names) };
+
+    bool known = strcmp(g_bench_scenario, "all") == 0;
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        known |= strcmp(g_bench_scenario, scenario_names[i]) == 0;
+    }
+    if (!known) {
+        SDL_Log("Bench: unknown scenario '%s' (attract, versus, supers, rollback or all)", g_bench_scenario);
+        return 1;
+    }
+
+    const int rollback_depth = SDL_clamp(g_bench_rollback > 0 ? g_bench_rollback : BENCH_DEFAULT_ROLLBACK,
+                                         1,
+                                         BENCH_MAX_ROLLBACK);
+    snapshots = (BenchSnapshot*)SDL_calloc(rollback_depth + 1, sizeof(BenchSnapshot));
+    if (!snapshots) {
+        SDL_Log("Bench: out of memory for rollback snapshots");
+        return 1;
+    }
+
+    // Run flat out: no vsync, no pacer, SPU mixed in-frame
+    const bool vsync_was_enabled = SDLApp_IsVSyncEnabled();
+    const bool was_uncapped = SDLApp_IsFrameRateUncapped();
+    if (vsync_was_enabled) {
+        SDLApp_SetVSync(false);
+    }
+    if (!was_uncapped) {
+        SDLApp_ToggleFrameRateUncap();
+    }
+    SPU_SetManualMix(true);
+
+    frame_hooks = hooks;
+    running = true;
+
+    BenchScenarioResult results[SCENARIO_COUNT];
+    int result_count = 0;
+    bool ok = true;
+    SDL_zeroa(results);
+
+    for (int i = 0; i < SCENARIO_COUNT && ok; i++) {
+        const char* name = scenario_names[i];
+        if (!scenario_selected(name))
+            continue;
+
+        BenchScenarioResult* result = &results[result_count++];
+        result->name = name;
+        SDL_Log("Bench: running %s", name);
+
+        if (strcmp(name, "attract") == 0) {
+            ok = run_attract(result, g_bench_frames > 0 ? g_bench_frames : BENCH_ATTRACT_FRAMES);
+            continue;
+        }
+
+        const int frames = g_bench_frames > 0 ? g_bench_frames : BENCH_FIGHT_FRAMES;
+        if (strcmp(name, "versus") == 0) {
+            result->pairs = BENCH_CHARACTER_COUNT;
+        } else if (strcmp(name, "supers") == 0) {
+            result->pairs = BENCH_SHORT_PAIR_COUNT;
+            Debug_w[DEBUG_1SHOT_SA] = 1;
+        } else {
+            result->pairs = BENCH_SHORT_PAIR_COUNT;
+            result->rollback = rollback_depth;
+        }
+
+        ok = run_fights(result, result->pairs, frames, result->rollback);
+        Debug_w[DEBUG_1SHOT_SA] = 0;
+    }
+
+    Debug_w[DEBUG_MY_CHAR_PL1] = 0;
+    Debug_w[DEBUG_MY_CHAR_PL2] = 0;
+    running = false;
+
+    SPU_SetManualMix(false);
+    if (!was_uncapped) {
+        SDLApp_ToggleFrameRateUncap();
+    }
+    if (vsync_was_enabled) {
+        SDLApp_SetVSync(true);
+    }
+
+    if (ok) {
+        ok = write_report(results, result_count);
+    } else {
+        SDL_Log("Bench: aborted, no report written");
+    }
+
+    for (int i = 0; i < result_count; i++) {
+        BenchSeries_Free(&results[i].frame);
+        BenchSeries_Free(&results[i].texture_kib);
+        BenchSeries_Free(&results[i].palette_kib);
+        for (int s = 0; s < BENCH_SECTION_COUNT; s++) {
+            BenchSeries_Free(&results[i].sections[s]);
+        }
+    }
+    SDL_free(snapshots);
+    snapshots = NULL;
+
+    return ok ? 0 : 1;
+}
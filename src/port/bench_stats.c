@@ -0,0 +1,74 @@
+/**
+ * @file bench_stats.c
+ * @brief Sample series and percentile summaries for the scenario benchmark.
+ */
+#include "port/bench_stats.h"
+#include <stdlib.h>
+
+bool BenchSeries_Push(BenchSeries* series, double value) {
+    if (series->count == series->capacity) {
+        const size_t capacity = series->capacity ? series->capacity * 2 : 1024;
+        double* values = (double*)realloc(series->values, capacity * sizeof(double));
+        if (!values)
+            return false;
+        series->values = values;
+        series->capacity = capacity;
+    }
+    series->values[series->count++] = value;
+    return true;
+}
+
+void BenchSeries_Clear(BenchSeries* series) {
+    series->count = 0;
+}
+
+void BenchSeries_Free(BenchSeries* series) {
+    free(series->values);
+    series->values = NULL;
+    series->count = 0;
+    series->capacity = 0;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    const double da = *(const double*)a;
+    const double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+double BenchStats_Percentile(const double* sorted, size_t count, double percentile) {
+    if (count == 0)
+        return 0.0;
+    if (percentile <= 0.0)
+        return sorted[0];
+    if (percentile >= 100.0)
+        return sorted[count - 1];
+
+    // Smallest value with at least `percentile` percent of samples at or below it
+    const double exact = percentile / 100.0 * (double)count;
+    size_t rank = (size_t)exact;
+    if ((double)rank < exact)
+        rank++;
+    if (rank < 1)
+        rank = 1;
+    return sorted[rank - 1];
+}
+
+void BenchSeries_Summarize(BenchSeries* series, BenchSummary* out) {
+    *out = (BenchSummary) { 0 };
+    if (series->count == 0)
+        return;
+
+    qsort(series->values, series->count, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (size_t i = 0; i < series->count; i++) {
+        sum += series->values[i];
+    }
+
+    out->count = series->count;
+    out->mean = sum / (double)series->count;
+    out->p50 = BenchStats_Percentile(series->values, series->count, 50.0);
+    out->p90 = BenchStats_Percentile(series->values, series->count, 90.0);
+    out->p99 = BenchStats_Percentile(series->values, series->count, 99.0);
+    out->max = series->values[series->count - 1];
+}
@@ -0,0 +1,39 @@
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Per-frame sample series for the scenario benchmark (see port/bench.h).
+// Samples are milliseconds; summaries use nearest-rank percentiles so every
+// reported value is one that was actually measured.
+
+typedef struct BenchSeries {
+    double* values;
+    size_t count;
+    size_t capacity;
+} BenchSeries;
+
+typedef struct BenchSummary {
+    size_t count;
+    double mean;
+    double p50;
+    double p90;
+    double p99;
+    double max;
+} BenchSummary;
+
+// Append one sample, growing the series as needed. Returns false on OOM.
+bool BenchSeries_Push(BenchSeries* series, double value);
+
+void BenchSeries_Clear(BenchSeries* series);
+void BenchSeries_Free(BenchSeries* series);
+
+// Summarize the series. Sorts the samples in place; an empty series
+// summarizes to all zeroes.
+void BenchSeries_Summarize(BenchSeries* series, BenchSummary* out);
+
+// Nearest-rank percentile (0-100) of an ascending array of `count` values.
+double BenchStats_Percentile(const double* sorted, size_t count, double percentile);
+
+#endif
@@ -10,6 +10,7 @@
 #include "port/broadcast.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 extern BroadcastConfig broadcast_config;
 
@@ -96,3 +97,12 @@ bool Broadcast_Send(uint32_t texture_id, uint32_t width, uint32_t height, bool i
 
     return s_backend->SendTexture(texture_id, width, height, is_flipped);
 }
+
+/** @brief Send cost of the active backend; `measured` stays false if it reports none. */
+void Broadcast_GetStats(BroadcastStats* out) {
+    memset(out, 0, sizeof(*out));
+
+    if (s_backend && s_initialized && s_backend->GetStats) {
+        s_backend->GetStats(out);
+    }
+}
@@ -3,10 +3,12 @@
  * @brief Command-line argument parser for the 3SX application.
  *
  * Handles CLI flags for resolution scaling, broadcast enable,
- * window geometry overrides, and shared-memory suffix.
+ * window geometry overrides, shared-memory suffix, and spectator relays.
  */
 #include "port/broadcast.h"
 #include "port/sdl/sdl_app.h"
+#include "port/sdl/sdl_frame_pacer.h"
+#include "port/sdl/sdl_render_pipeline.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,6 +28,28 @@ bool g_font_test_mode = false;
 // Netplay game port (default 50000). Set via --port to allow multiple local instances.
 unsigned short g_netplay_port = 50000;
 
+// Spectator broadcast. See Netplay_BeginSpectate / SpectatorRelay_RunHeadless.
+unsigned short g_spectator_port = 0;    // --spectator-port: relay port (0 = players don't relay)
+const char* g_spectate_upstream = NULL; // --spectate: player/relay to watch
+int g_spectate_delay = 120;             // --spectate-delay: frames behind the live stream
+const char* g_relay_upstream = NULL;    // --relay: run a headless relay for this upstream
+
+// Scenario benchmark. See Bench_Run.
+const char* g_bench_scenario = NULL; // --bench: scenario to run (NULL = play normally)
+int g_bench_frames = 0;              // --bench-frames: timed frames per scenario or pair (0 = default)
+int g_bench_rollback = 0;            // --bench-rollback: frames resimulated per rollback tick (0 = default)
+const char* g_bench_out = NULL;      // --bench-out: JSON report path (NULL = stdout)
+
+// CPU-vs-CPU self-play. See SelfPlay_Run.
+int g_selfplay_matches = 0;          // --selfplay: matches to play (0 = play normally)
+unsigned int g_selfplay_seed = 1;    // --selfplay-seed: seed of the first match; match n uses seed + n
+int g_selfplay_jobs = 1;             // --selfplay-jobs: worker processes (0 = one per core)
+const char* g_selfplay_out = NULL;   // --selfplay-out: JSON report path (NULL = stdout)
+bool g_selfplay_watch = false;       // --selfplay-watch: play at normal speed with picture and sound
+bool g_selfplay_check = false;       // --selfplay-check: replay each worker's last match alone and compare
+int g_selfplay_first = 0;            // --selfplay-first: index of this worker's first match
+const char* g_selfplay_shard = NULL; // --selfplay-shard: worker totals path for the parent to merge
+
 // These might need to be mocked in tests
 // void SDLApp_SetWindowPosition(int x, int y);
 // void SDLApp_SetWindowSize(int w, int h);
@@ -35,7 +59,11 @@ int SDL_atoi(const char* str);
  * @brief Parse command-line arguments and configure application state.
  *
  * Supports: --scale, --volume, --renderer, --enable-broadcast,
- * --window-pos, --window-size, --shm-suffix, --port.
+ * --window-pos, --window-size, --shm-suffix, --port, --spectator-port,
+ * --spectate, --spectate-delay, --relay, --render-pipeline, --pacer,
+ * --pacer-vblank, --bench, --bench-frames, --bench-rollback, --bench-out,
+ * --selfplay, --selfplay-seed, --selfplay-jobs, --selfplay-out, --selfplay-watch,
+ * --selfplay-check and the worker-only --selfplay-first and --selfplay-shard.
  */
 void ParseCLI(int argc, char* argv[]) {
     for (int i = 1; i < argc; i++) {
@@ -45,12 +73,31 @@ void ParseCLI(int argc, char* argv[]) {
             printf("  --scale <factor>          Internal resolution multiplier (default: 1)\n");
             printf("  --volume <0-100>          Master volume percentage (default: 100)\n");
             printf("  --renderer <gl|gpu|sdl>   Renderer backend (default: gl)\n");
+            printf("  --render-pipeline <off|auto|on>\n");
+            printf("                            Run logic a frame ahead of rendering (default: off)\n");
+            printf("  --pacer <sleep|spin>      Frame pacer: deadline sleep or 2 ms spin (default: sleep)\n");
+            printf("  --pacer-vblank            Align frame starts to measured vblanks (needs vsync)\n");
             printf("  --port <number>           Netplay game port (default: 50000)\n");
+            printf("  --spectator-port <number> UDP port for relaying the match to spectators\n");
+            printf("  --spectate <ip>:<port>    Watch the match streamed by a player or relay\n");
+            printf("  --spectate-delay <frames> Spectator delay buffer (default: 120)\n");
+            printf("  --relay <ip>:<port>       Run a headless spectator relay (needs --spectator-port)\n");
             printf("  --window-pos <x>,<y>      Initial window position\n");
             printf("  --window-size <w>x<h>     Initial window size\n");
             printf("  --enable-broadcast        Enable Spout/shared-memory broadcast\n");
             printf("  --shm-suffix <suffix>     Shared-memory name suffix for broadcast\n");
             printf("  --font-test               Boot into font debug visualization screen\n");
+            printf("  --bench <scenario>        Run a benchmark and exit: attract, versus, supers,\n");
+            printf("                            rollback or all\n");
+            printf("  --bench-frames <n>        Timed frames per scenario or character pair\n");
+            printf("  --bench-rollback <n>      Frames resimulated per tick in the rollback scenario (default: 8)\n");
+            printf("  --bench-out <file>        Write the benchmark report there instead of stdout\n");
+            printf("  --selfplay <matches>      Play CPU-vs-CPU matches flat out and exit with a report\n");
+            printf("  --selfplay-seed <n>       Seed of the first self-play match (default: 1)\n");
+            printf("  --selfplay-jobs <n>       Worker processes for self-play, 0 = one per core (default: 1)\n");
+            printf("  --selfplay-out <file>     Write the self-play report there instead of stdout\n");
+            printf("  --selfplay-watch          Play the self-play matches at normal speed, to watch one\n");
+            printf("  --selfplay-check          Replay each worker's last match alone and report any mismatch\n");
             printf("  --help                    Show this help message\n");
             exit(0);
         } else if (strcmp(argv[i], "--volume") == 0 && i + 1 < argc) {
@@ -69,6 +116,18 @@ void ParseCLI(int argc, char* argv[]) {
                 g_netplay_port = (unsigned short)p;
                 printf("[CLI] Netplay port: %d\n", p);
             }
+        } else if (strcmp(argv[i], "--spectator-port") == 0 && i + 1 < argc) {
+            int p = SDL_atoi(argv[++i]);
+            if (p > 0 && p <= 65535) {
+                g_spectator_port = (unsigned short)p;
+            }
+        } else if (strcmp(argv[i], "--spectate") == 0 && i + 1 < argc) {
+            g_spectate_upstream = argv[++i];
+        } else if (strcmp(argv[i], "--spectate-delay") == 0 && i + 1 < argc) {
+            int frames = SDL_atoi(argv[++i]);
+            g_spectate_delay = frames < 0 ? 0 : frames;
+        } else if (strcmp(argv[i], "--relay") == 0 && i + 1 < argc) {
+            g_relay_upstream = argv[++i];
         } else if (strcmp(argv[i], "--enable-broadcast") == 0) {
             broadcast_config.enabled = true;
         } else if (strcmp(argv[i], "--window-pos") == 0 && i + 1 < argc) {
@@ -92,8 +151,51 @@ void ParseCLI(int argc, char* argv[]) {
             } else {
                 SDLApp_SetRenderer(RENDERER_OPENGL);
             }
+        } else if (strcmp(argv[i], "--render-pipeline") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "on") == 0) {
+                SDLRenderPipeline_SetMode(RENDER_PIPELINE_ON);
+            } else if (strcmp(mode, "auto") == 0) {
+                SDLRenderPipeline_SetMode(RENDER_PIPELINE_AUTO);
+            } else {
+                SDLRenderPipeline_SetMode(RENDER_PIPELINE_OFF);
+            }
+        } else if (strcmp(argv[i], "--pacer") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            SDLFramePacer_SetMode(strcmp(mode, "spin") == 0 ? FRAME_PACER_SPIN : FRAME_PACER_SLEEP);
+        } else if (strcmp(argv[i], "--pacer-vblank") == 0) {
+            SDLFramePacer_SetVBlankAlign(true);
         } else if (strcmp(argv[i], "--font-test") == 0) {
             g_font_test_mode = true;
+        } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            g_bench_scenario = argv[++i];
+        } else if (strcmp(argv[i], "--bench-frames") == 0 && i + 1 < argc) {
+            int frames = SDL_atoi(argv[++i]);
+            g_bench_frames = frames < 0 ? 0 : frames;
+        } else if (strcmp(argv[i], "--bench-rollback") == 0 && i + 1 < argc) {
+            int frames = SDL_atoi(argv[++i]);
+            g_bench_rollback = frames < 0 ? 0 : frames;
+        } else if (strcmp(argv[i], "--bench-out") == 0 && i + 1 < argc) {
+            g_bench_out = argv[++i];
+        } else if (strcmp(argv[i], "--selfplay") == 0 && i + 1 < argc) {
+            int matches = SDL_atoi(argv[++i]);
+            g_selfplay_matches = matches < 0 ? 0 : matches;
+        } else if (strcmp(argv[i], "--selfplay-seed") == 0 && i + 1 < argc) {
+            g_selfplay_seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--selfplay-jobs") == 0 && i + 1 < argc) {
+            int jobs = SDL_atoi(argv[++i]);
+            g_selfplay_jobs = jobs < 0 ? 0 : jobs;
+        } else if (strcmp(argv[i], "--selfplay-out") == 0 && i + 1 < argc) {
+            g_selfplay_out = argv[++i];
+        } else if (strcmp(argv[i], "--selfplay-watch") == 0) {
+            g_selfplay_watch = true;
+        } else if (strcmp(argv[i], "--selfplay-check") == 0) {
+            g_selfplay_check = true;
+        } else if (strcmp(argv[i], "--selfplay-first") == 0 && i + 1 < argc) {
+            int first = SDL_atoi(argv[++i]);
+            g_selfplay_first = first < 0 ? 0 : first;
+        } else if (strcmp(argv[i], "--selfplay-shard") == 0 && i + 1 < argc) {
+            g_selfplay_shard = argv[++i];
         }
     }
 }
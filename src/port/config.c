@@ -57,9 +57,11 @@ static const ConfigEntry default_entries[] = {
     { .key = CFG_KEY_TRAINING_STUN, .type = CFG_BOOL, .value.b = true },
     { .key = CFG_KEY_TRAINING_INPUTS, .type = CFG_BOOL, .value.b = true },
     { .key = CFG_KEY_TRAINING_FRAME_METER, .type = CFG_BOOL, .value.b = true },
+    { .key = CFG_KEY_TRAINING_LOOKAHEAD_BUDGET, .type = CFG_INT, .value.i = 2000 },
     { .key = CFG_KEY_NETPLAY_AUTO_CONNECT, .type = CFG_BOOL, .value.b = true },
     { .key = CFG_KEY_LOBBY_AUTO_CONNECT, .type = CFG_BOOL, .value.b = true },
     { .key = CFG_KEY_LOBBY_AUTO_SEARCH, .type = CFG_BOOL, .value.b = true },
+    { .key = CFG_KEY_SPRITE_CACHE_SCALE, .type = CFG_INT, .value.i = 1 },
 };
 
 static ConfigEntry entries[CONFIG_ENTRIES_MAX] = { 0 };
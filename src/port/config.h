@@ -29,6 +29,7 @@ extern "C" {
 #define CFG_KEY_TRAINING_STUN "training-stun"
 #define CFG_KEY_TRAINING_INPUTS "training-inputs"
 #define CFG_KEY_TRAINING_FRAME_METER "training-frame-meter"
+#define CFG_KEY_TRAINING_LOOKAHEAD_BUDGET "training-lookahead-budget-us"
 #define CFG_KEY_NETPLAY_AUTO_CONNECT "netplay-auto-connect"
 #define CFG_KEY_LOBBY_SERVER_URL "lobby-server-url"
 #define CFG_KEY_LOBBY_SERVER_KEY "lobby-server-key"
@@ -38,6 +39,7 @@ extern "C" {
 #define CFG_KEY_LOBBY_AUTO_SEARCH "lobby-auto-search"
 #define CFG_KEY_VSYNC "vsync"
 #define CFG_KEY_DEBUG_HUD "debug-hud"
+#define CFG_KEY_SPRITE_CACHE_SCALE "sprite-cache-scale"
 
 /// Initialize config system
 void Config_Init();
@@ -0,0 +1,62 @@
+/**
+ * @file content_hash.c
+ * @brief Word-wide hash used to skip re-uploading unchanged textures and palettes.
+ */
+#include "port/content_hash.h"
+
+#include <string.h>
+
+#define PRIME_1 0x9E3779B185EBCA87ull
+#define PRIME_2 0xC2B2AE3D27D4EB4Full
+#define PRIME_3 0x165667B19E3779F9ull
+
+static uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t load64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v)); // Unaligned-safe; compiles to a single load
+    return v;
+}
+
+static uint64_t round64(uint64_t acc, uint64_t word) {
+    acc += word * PRIME_2;
+    acc = rotl(acc, 31);
+    return acc * PRIME_1;
+}
+
+uint64_t ContentHash_Compute(const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+    const uint8_t* end = p + size;
+
+    uint64_t lanes[4] = { PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 };
+    while (end - p >= 32) {
+        lanes[0] = round64(lanes[0], load64(p));
+        lanes[1] = round64(lanes[1], load64(p + 8));
+        lanes[2] = round64(lanes[2], load64(p + 16));
+        lanes[3] = round64(lanes[3], load64(p + 24));
+        p += 32;
+    }
+
+    uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    h += (uint64_t)size;
+
+    while (end - p >= 8) {
+        h ^= round64(0, load64(p));
+        h = rotl(h, 27) * PRIME_1 + PRIME_3;
+        p += 8;
+    }
+    while (p < end) {
+        h ^= *p++ * PRIME_3;
+        h = rotl(h, 11) * PRIME_1;
+    }
+
+    // Final avalanche so a single-bit change reaches every output bit
+    h ^= h >> 33;
+    h *= PRIME_2;
+    h ^= h >> 29;
+    h *= PRIME_3;
+    h ^= h >> 32;
+    return h;
+}
@@ -0,0 +1,14 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Change detection for texture and palette data the game unlocks. Reads
+// 8 bytes at a time over four independent lanes, so a 256-color palette or
+// a full texture hashes several times faster than a byte-wise FNV-1a. Not a
+// cryptographic hash; equal input always gives an equal result regardless of
+// the buffer's alignment.
+uint64_t ContentHash_Compute(const void* data, size_t size);
+
+#endif
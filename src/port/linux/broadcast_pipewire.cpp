@@ -3,13 +3,20 @@
  * @brief PipeWire video broadcast backend (Linux).
  *
  * Provides the Broadcast API implementation for Linux using PipeWire
- * and shared memory buffers via glReadPixels.
+ * and shared memory buffers.
+ *
+ * Frames are read back asynchronously: each SendTexture() issues a
+ * glReadPixels into the next pixel-buffer object of a small ring and fences
+ * it, then copies the frame issued two calls earlier (whose fence has long
+ * since signalled) into PipeWire. Y-flipping is done by a GPU blit, so the
+ * readback is always a single bulk transfer.
  */
 #include "port/broadcast.h"
 
 #include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <pipewire/pipewire.h>
@@ -33,9 +40,44 @@ static char s_sender_name[MAX_STREAM_NAME] = "3SX Broadcast";
 static uint32_t s_current_width = 0;
 static uint32_t s_current_height = 0;
 
-// Temporary FBO for glReadPixels
+// Source FBO wrapping the texture being sent
 static GLuint s_fbo = 0;
 
+// Y-flip target: textures that need flipping are blitted here upside down first
+static GLuint s_flip_fbo = 0;
+static GLuint s_flip_texture = 0;
+static uint32_t s_flip_width = 0;
+static uint32_t s_flip_height = 0;
+
+// --- Async readback ring ---
+// With 3 slots and at most 2 in flight, frame N is copied out during the call for N+2.
+
+#define READBACK_RING_DEPTH 3
+#define READBACK_STATS_INTERVAL 600 // Frames per send-cost window shown in the diagnostics
+
+typedef struct {
+    GLuint pbo;
+    GLsync fence;
+    uint32_t width;
+    uint32_t height;
+    size_t capacity;
+} ReadbackSlot;
+
+static ReadbackSlot s_ring[READBACK_RING_DEPTH];
+static int s_ring_head = 0;    // Next slot to fill
+static int s_ring_pending = 0; // Slots with a readback in flight (oldest = head - pending)
+
+static uint64_t s_send_ns_total = 0;
+static uint32_t s_send_frames = 0;
+static uint32_t s_dropped_frames = 0;
+static BroadcastStats s_last_stats; // Last full window, for Broadcast_GetStats
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
 static void on_process(void* data) {
     // PipeWire stream callback indicating we should provide a buffer.
     // In our push-based design (Broadcast_Send is called per-frame by the game loop),
@@ -75,6 +117,104 @@ static void configure_stream(uint32_t width, uint32_t height) {
     pw_thread_loop_unlock(s_thread_loop);
 }
 
+static void discard_pending() {
+    for (int i = 0; i < READBACK_RING_DEPTH; i++) {
+        if (s_ring[i].fence) {
+            glDeleteSync(s_ring[i].fence);
+            s_ring[i].fence = NULL;
+        }
+    }
+    s_ring_pending = 0;
+}
+
+static void release_readback() {
+    discard_pending();
+
+    for (int i = 0; i < READBACK_RING_DEPTH; i++) {
+        if (s_ring[i].pbo) {
+            glDeleteBuffers(1, &s_ring[i].pbo);
+        }
+    }
+    memset(s_ring, 0, sizeof(s_ring));
+    s_ring_head = 0;
+
+    if (s_flip_fbo) {
+        glDeleteFramebuffers(1, &s_flip_fbo);
+        glDeleteTextures(1, &s_flip_texture);
+        s_flip_fbo = 0;
+        s_flip_texture = 0;
+        s_flip_width = 0;
+        s_flip_height = 0;
+    }
+}
+
+/** Copy the oldest in-flight readback into a PipeWire buffer (waiting on its fence if needed). */
+static void deliver_oldest() {
+    ReadbackSlot* slot = &s_ring[(s_ring_head - s_ring_pending + READBACK_RING_DEPTH) % READBACK_RING_DEPTH];
+    s_ring_pending--;
+
+    glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    glDeleteSync(slot->fence);
+    slot->fence = NULL;
+
+    const uint32_t stride = slot->width * 4;
+    const size_t size = (size_t)stride * slot->height;
+
+    pw_thread_loop_lock(s_thread_loop);
+    struct pw_buffer* b = pw_stream_dequeue_buffer(s_stream);
+    if (!b || b->buffer->datas[0].data == NULL || b->buffer->datas[0].maxsize < size) {
+        if (b)
+            pw_stream_queue_buffer(s_stream, b);
+        pw_thread_loop_unlock(s_thread_loop);
+        s_dropped_frames++;
+        return;
+    }
+
+    struct spa_buffer* buf = b->buffer;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (src) {
+        memcpy(buf->datas[0].data, src, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    buf->datas[0].chunk->offset = 0;
+    buf->datas[0].chunk->size = src ? size : 0;
+    buf->datas[0].chunk->stride = stride;
+
+    pw_stream_queue_buffer(s_stream, b);
+    pw_thread_loop_unlock(s_thread_loop);
+}
+
+/** Blit the source FBO upside down into the flip target and leave that bound for reading. */
+static void bind_flipped_source(uint32_t width, uint32_t height) {
+    if (s_flip_fbo == 0 || width != s_flip_width || height != s_flip_height) {
+        if (s_flip_fbo) {
+            glDeleteFramebuffers(1, &s_flip_fbo);
+            glDeleteTextures(1, &s_flip_texture);
+        }
+
+        glGenTextures(1, &s_flip_texture);
+        glBindTexture(GL_TEXTURE_2D, s_flip_texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glGenFramebuffers(1, &s_flip_fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, s_flip_fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_flip_texture, 0);
+
+        s_flip_width = width;
+        s_flip_height = height;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, s_fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_flip_fbo);
+    glBlitFramebuffer(0, 0, width, height, 0, height, width, 0, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, s_flip_fbo);
+}
+
 extern "C" {
 
 static bool PipeWire_Init(const char* sender_name) {
@@ -201,6 +341,13 @@ static void PipeWire_Shutdown() {
         s_fbo = 0;
     }
 
+    release_readback();
+
+    s_send_ns_total = 0;
+    s_send_frames = 0;
+    s_dropped_frames = 0;
+    memset(&s_last_stats, 0, sizeof(s_last_stats));
+
     s_initialized = false;
 }
 
@@ -208,29 +355,19 @@ static bool PipeWire_SendTexture(uint32_t texture_id, uint32_t width, uint32_t h
     if (!s_initialized || !s_stream)
         return false;
 
-    // Update params if stream size changed
+    const uint64_t start_ns = now_ns();
+
+    // Update params if stream size changed; in-flight frames of the old size are dropped
     if (width != s_current_width || height != s_current_height) {
+        discard_pending();
         configure_stream(width, height);
     }
 
-    pw_thread_loop_lock(s_thread_loop);
-    struct pw_buffer* b = pw_stream_dequeue_buffer(s_stream);
-    if (!b) {
-        pw_thread_loop_unlock(s_thread_loop);
-        return false;
-    }
-
-    struct spa_buffer* buf = b->buffer;
-    if (buf->datas[0].data == NULL) {
-        pw_stream_queue_buffer(s_stream, b);
-        pw_thread_loop_unlock(s_thread_loop);
-        return false;
+    // Copy out older frames so at most one readback stays in flight besides the new one
+    while (s_ring_pending >= READBACK_RING_DEPTH - 1) {
+        deliver_oldest();
     }
 
-    // Read OpenGL texture into PipeWire's shared memory buffer
-    GLint viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
-
     if (s_fbo == 0) {
         glGenFramebuffers(1, &s_fbo);
     }
@@ -238,37 +375,50 @@ static bool PipeWire_SendTexture(uint32_t texture_id, uint32_t width, uint32_t h
     glBindFramebuffer(GL_FRAMEBUFFER, s_fbo);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_id, 0);
 
-    void* dest = buf->datas[0].data;
-    uint32_t stride = SPA_ROUND_UP_N(width * 4, 4); // RGBA is 4 bytes per pixel
+    // GL textures are bottom-up and PipeWire expects top-down for SPA_VIDEO_FORMAT_RGBA.
+    // is_flipped=true means the texture is already top-down; otherwise flip on the GPU.
+    if (is_flipped) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, s_fbo);
+    } else {
+        bind_flipped_source(width, height);
+    }
 
-    // GL usually reads bottom-up. PipeWire expects top-down by default for SPA_VIDEO_FORMAT_RGBA.
-    // However, if the `is_flipped` flag is true, that implies the texture is already bottom-up and needs to be left as
-    // is, or vice versa depending on rendering backend. In standard 3SX, the OpenGL FBOs are bottom-up, and
-    // is_flipped=false forces the sender to flip it. We handle row-by-row reading if we need to flip it, or bulk read
-    // if not. Let's do a simple bulk read and handle flipping manually if needed.
+    ReadbackSlot* slot = &s_ring[s_ring_head];
+    const size_t size = (size_t)width * height * 4;
 
-    // We bind a pack alignment of 1 to be safe
-    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (slot->pbo == 0) {
+        glGenBuffers(1, &slot->pbo);
+    }
 
-    if (is_flipped) {
-        // Just read it straight; receiver expects it like this
-        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, dest);
-    } else {
-        // Need to flip Y for top-down
-        for (uint32_t y = 0; y < height; y++) {
-            uint8_t* row_dest = (uint8_t*)dest + ((height - 1 - y) * stride);
-            glReadPixels(0, y, width, 1, GL_RGBA, GL_UNSIGNED_BYTE, row_dest);
-        }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    if (slot->capacity != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        slot->capacity = size;
     }
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->width = width;
+    slot->height = height;
 
-    buf->datas[0].chunk->offset = 0;
-    buf->datas[0].chunk->size = height * stride;
-    buf->datas[0].chunk->stride = stride;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-    pw_stream_queue_buffer(s_stream, b);
-    pw_thread_loop_unlock(s_thread_loop);
+    s_ring_head = (s_ring_head + 1) % READBACK_RING_DEPTH;
+    s_ring_pending++;
+
+    // Game-thread cost of broadcasting — the frame-time delta versus broadcast off
+    s_send_ns_total += now_ns() - start_ns;
+    if (++s_send_frames == READBACK_STATS_INTERVAL) {
+        s_last_stats.measured = true;
+        s_last_stats.send_ms = (double)s_send_ns_total / s_send_frames / 1e6;
+        s_last_stats.frames = s_send_frames;
+        s_last_stats.dropped = s_dropped_frames;
+        s_send_ns_total = 0;
+        s_send_frames = 0;
+        s_dropped_frames = 0;
+    }
 
     return true;
 }
@@ -279,8 +429,12 @@ static void PipeWire_UpdateConfig(const BroadcastConfig* config) {
     }
 }
 
+static void PipeWire_GetStats(BroadcastStats* out) {
+    *out = s_last_stats;
+}
+
 BroadcastPort g_broadcast_port_linux = {
-    PipeWire_Init, PipeWire_Shutdown, PipeWire_SendTexture, PipeWire_UpdateConfig
+    PipeWire_Init, PipeWire_Shutdown, PipeWire_SendTexture, PipeWire_UpdateConfig, PipeWire_GetStats
 };
 
 } // extern "C"
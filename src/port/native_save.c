@@ -4,14 +4,19 @@
  *
  * Replaces the PS2 memory card subsystem (sdk_libmc.c + mcsub.c + savesub.c)
  * with direct file I/O. Options and direction use human-readable INI format.
- * Replay data uses binary format (performance-sensitive, ~30KB per file).
+ * Replays use the v2 binary format from replay_format.h, any number of them,
+ * listed in a small index so the picker never has to open the replays.
  *
  * Save directory: SDL_GetPrefPath("CrowdedStreet", "3SX") via Paths_GetPrefPath().
- * Files: options.ini, direction.ini, replays/replay_NN.bin, replays/replay_NN.meta
+ * Files: options.ini, direction.ini, replays/index.bin, replays/replay_NNNNNN.rpl.
+ * PS2-era replays/replay_NN.bin slots (v1) are converted when the index is
+ * first built and kept as replay_NN.bin.v1.
  */
 
 #include "port/native_save.h"
 #include "common.h"
+#include "port/replay_format.h"
+#include "port/replay_log.h"
 
 #include "sf33rd/Source/Game/engine/workuser.h"
 #include "sf33rd/Source/Game/menu/dir_data.h"
@@ -71,12 +76,6 @@ static void ensure_replay_dir(void) {
     done = 1;
 }
 
-static void make_replay_path(char* dst, size_t dst_size, int slot, const char* ext) {
-    ensure_save_dir();
-    ensure_replay_dir();
-    snprintf(dst, dst_size, "%sreplays/replay_%02d%s", save_dir, slot, ext);
-}
-
 /* ── INI parser helpers ────────────────────────────────────────────── */
 
 static void ini_trim(char* s) {
@@ -469,19 +468,24 @@ void NativeSave_SaveDirection(void) {
 }
 
 /* ═══════════════════════════════════════════════════════════════════
- *  REPLAY  —  binary format
+ *  REPLAY  —  binary format (see replay_format.h)
  * ═══════════════════════════════════════════════════════════════════ */
 
-/** Internal header for native replay files */
+/** Header of a v1 replay: the raw _REPLAY_W follows */
 typedef struct {
     u32 magic;     /* 0x33535852 = "3SXR" */
     u32 version;   /* 1 */
     u32 data_size; /* sizeof(_REPLAY_W) */
     u32 reserved;
-} NativeReplayHeader;
+} NativeReplayHeaderV1;
 
-#define NATIVE_REPLAY_MAGIC 0x33535852 /* "3SXR" */
-#define NATIVE_REPLAY_VERSION 1
+#define NATIVE_REPLAY_V1_SLOTS 20
+
+/* Replay index, kept in memory once loaded */
+static ReplayIndexEntry* replay_index = NULL;
+static u32 replay_count = 0;
+static u32 replay_next_id = 1;
+static int replay_index_loaded = 0;
 
 static void get_current_date(memcard_date* md) {
     time_t rawtime;
@@ -505,93 +509,476 @@ static void get_current_date(memcard_date* md) {
     }
 }
 
-int NativeSave_ReplayExists(int slot) {
-    if (slot < 0 || slot >= NATIVE_SAVE_REPLAY_SLOTS)
-        return 0;
+static void meta_from_info(ReplayMeta* meta, const _sub_info* info) {
+    meta->year = info->date.year;
+    meta->month = info->date.month;
+    meta->day = info->date.day;
+    meta->hour = info->date.hour;
+    meta->minute = info->date.min;
+    meta->second = info->date.sec;
+    meta->dayofweek = info->date.dayofweek;
+    meta->player[0] = info->player[0];
+    meta->player[1] = info->player[1];
+}
 
-    char path[512];
-    make_replay_path(path, sizeof(path), slot, ".bin");
+static void info_from_meta(_sub_info* info, const ReplayMeta* meta) {
+    info->date.year = meta->year;
+    info->date.month = meta->month;
+    info->date.day = meta->day;
+    info->date.hour = meta->hour;
+    info->date.min = meta->minute;
+    info->date.sec = meta->second;
+    info->date.dayofweek = meta->dayofweek;
+    info->player[0] = meta->player[0];
+    info->player[1] = meta->player[1];
+}
 
-    FILE* f = fopen(path, "rb");
-    if (!f)
-        return 0;
-    fclose(f);
-    return 1;
+static void make_replay_file_path(char* dst, size_t dst_size, u32 id) {
+    ensure_save_dir();
+    ensure_replay_dir();
+    snprintf(dst, dst_size, "%sreplays/replay_%06u.rpl", save_dir, id);
 }
 
-int NativeSave_GetReplayInfo(int slot, _sub_info* out) {
-    if (slot < 0 || slot >= NATIVE_SAVE_REPLAY_SLOTS || !out)
-        return -1;
+/* ── Setup section ─────────────────────────────────────────────────── */
 
-    char path[512];
-    make_replay_path(path, sizeof(path), slot, ".meta");
+/*
+ * Everything in _REPLAY_W except the input, packed field by field: the raw
+ * struct holds a pointer (game_infor.fname), so its layout differs between
+ * 32- and 64-bit builds. Fields are only ever appended; a shorter section
+ * from an older build leaves the rest zeroed.
+ */
 
-    FILE* f = fopen(path, "rb");
-    if (!f)
-        return -1;
+#define SETUP_MAX_BYTES 256
 
-    size_t read = fread(out, 1, sizeof(_sub_info), f);
-    fclose(f);
+typedef struct {
+    u8* data;
+    size_t size;
+} SetupWriter;
+
+typedef struct {
+    const u8* data;
+    size_t size;
+    size_t pos;
+} SetupReader;
+
+static void put_bytes(SetupWriter* w, const void* src, size_t n) {
+    memcpy(w->data + w->size, src, n);
+    w->size += n;
+}
 
-    return (read == sizeof(_sub_info)) ? 0 : -1;
+static void put_u8(SetupWriter* w, u8 v) {
+    w->data[w->size++] = v;
 }
 
-int NativeSave_LoadReplay(int slot) {
-    if (slot < 0 || slot >= NATIVE_SAVE_REPLAY_SLOTS)
+static void put_u16(SetupWriter* w, u16 v) {
+    put_u8(w, (u8)v);
+    put_u8(w, (u8)(v >> 8));
+}
+
+static void get_bytes(SetupReader* r, void* dst, size_t n) {
+    if (r->pos + n > r->size) {
+        r->pos = r->size;
+        return;
+    }
+    memcpy(dst, r->data + r->pos, n);
+    r->pos += n;
+}
+
+static u8 get_u8(SetupReader* r) {
+    u8 v = 0;
+    get_bytes(r, &v, 1);
+    return v;
+}
+
+static u16 get_u16(SetupReader* r) {
+    const u16 lo = get_u8(r);
+    return (u16)(lo | (get_u8(r) << 8));
+}
+
+static size_t pack_setup(const _REPLAY_W* rw, u8* out) {
+    SetupWriter w = { out, 0 };
+    const struct _REP_GAME_INFOR* gi = &rw->game_infor;
+    const struct _MINI_SAVE_W* ms = &rw->mini_save_w;
+
+    put_u16(&w, (u16)rw->Control_Time_Buff);
+    put_u8(&w, rw->Difficulty);
+    put_u8(&w, rw->Monitor_Type);
+
+    for (int i = 0; i < 2; i++) {
+        put_u8(&w, gi->player_infor[i].my_char);
+        put_u8(&w, (u8)gi->player_infor[i].sa);
+        put_u8(&w, (u8)gi->player_infor[i].color);
+        put_u8(&w, (u8)gi->player_infor[i].player_type);
+    }
+    put_u8(&w, (u8)gi->stage);
+    put_u8(&w, (u8)gi->Direction_Working);
+    put_u8(&w, (u8)gi->Vital_Handicap[0]);
+    put_u8(&w, (u8)gi->Vital_Handicap[1]);
+    put_u16(&w, (u16)gi->Random_ix16);
+    put_u16(&w, (u16)gi->Random_ix32);
+    put_u16(&w, (u16)gi->Random_ix16_ex);
+    put_u16(&w, (u16)gi->Random_ix32_ex);
+    put_u8(&w, gi->winner);
+    put_u8(&w, gi->play_type);
+    put_u16(&w, gi->players_timer);
+    put_u16(&w, (u16)gi->old_mes_no2);
+    put_u16(&w, (u16)gi->old_mes_no3);
+    put_u16(&w, (u16)gi->old_mes_no_pl);
+    put_u16(&w, (u16)gi->mes_already);
+
+    put_bytes(&w, ms->Pad_Infor, sizeof(ms->Pad_Infor));
+    put_u8(&w, (u8)ms->Time_Limit);
+    put_u8(&w, ms->Battle_Number[0]);
+    put_u8(&w, ms->Battle_Number[1]);
+    put_u8(&w, ms->Damage_Level);
+    put_bytes(&w, ms->extra_option.contents, sizeof(ms->extra_option.contents));
+
+    put_bytes(&w, rw->system_dir.contents, sizeof(rw->system_dir.contents));
+    put_u16(&w, rw->system_dir.sum);
+
+    put_bytes(&w, rw->lag, sizeof(rw->lag));
+    put_u8(&w, rw->champion);
+    put_u8(&w, rw->full_data);
+
+    return w.size;
+}
+
+static void unpack_setup(_REPLAY_W* rw, const u8* data, size_t size) {
+    SetupReader r = { data, size, 0 };
+    struct _REP_GAME_INFOR* gi = &rw->game_infor;
+    struct _MINI_SAVE_W* ms = &rw->mini_save_w;
+
+    rw->Control_Time_Buff = (s16)get_u16(&r);
+    rw->Difficulty = get_u8(&r);
+    rw->Monitor_Type = get_u8(&r);
+
+    for (int i = 0; i < 2; i++) {
+        gi->player_infor[i].my_char = get_u8(&r);
+        gi->player_infor[i].sa = (s8)get_u8(&r);
+        gi->player_infor[i].color = (s8)get_u8(&r);
+        gi->player_infor[i].player_type = (s8)get_u8(&r);
+    }
+    gi->stage = (s8)get_u8(&r);
+    gi->Direction_Working = (s8)get_u8(&r);
+    gi->Vital_Handicap[0] = (s8)get_u8(&r);
+    gi->Vital_Handicap[1] = (s8)get_u8(&r);
+    gi->Random_ix16 = (s16)get_u16(&r);
+    gi->Random_ix32 = (s16)get_u16(&r);
+    gi->Random_ix16_ex = (s16)get_u16(&r);
+    gi->Random_ix32_ex = (s16)get_u16(&r);
+    gi->winner = get_u8(&r);
+    gi->play_type = get_u8(&r);
+    gi->players_timer = get_u16(&r);
+    gi->old_mes_no2 = (s16)get_u16(&r);
+    gi->old_mes_no3 = (s16)get_u16(&r);
+    gi->old_mes_no_pl = (s16)get_u16(&r);
+    gi->mes_already = (s16)get_u16(&r);
+
+    get_bytes(&r, ms->Pad_Infor, sizeof(ms->Pad_Infor));
+    ms->Time_Limit = (s8)get_u8(&r);
+    ms->Battle_Number[0] = get_u8(&r);
+    ms->Battle_Number[1] = get_u8(&r);
+    ms->Damage_Level = get_u8(&r);
+    get_bytes(&r, ms->extra_option.contents, sizeof(ms->extra_option.contents));
+
+    get_bytes(&r, rw->system_dir.contents, sizeof(rw->system_dir.contents));
+    rw->system_dir.sum = get_u16(&r);
+
+    get_bytes(&r, rw->lag, sizeof(rw->lag));
+    rw->champion = get_u8(&r);
+    rw->full_data = get_u8(&r);
+}
+
+/* ── Replay files ──────────────────────────────────────────────────── */
+
+/** Write a v2 replay. Fills `entry` (except its id) for the index. */
+static int write_replay_file(const char* path, const _REPLAY_W* rw, const u16* const codes[2], const u32 counts[2],
+                             const _sub_info* info, ReplayIndexEntry* entry) {
+    char tmp[520];
+    u8 setup[SETUP_MAX_BYTES];
+    const size_t setup_size = pack_setup(rw, setup);
+
+    size_t input_size = 0;
+    u8* input = ReplayFormat_EncodeInput(codes, counts, &input_size);
+    if (!input) {
+        printf("[NativeSave] ERROR: Out of memory encoding replay input\n");
         return -1;
+    }
 
-    char path[512];
-    make_replay_path(path, sizeof(path), slot, ".bin");
+    const u32 frames0 = ReplayFormat_CountFrames(codes[0], counts[0]);
+    const u32 frames1 = ReplayFormat_CountFrames(codes[1], counts[1]);
+    ReplayFileHeader hdr = { .magic = REPLAY_FILE_MAGIC,
+                             .version = REPLAY_FILE_VERSION,
+                             .frame_count = (frames0 > frames1) ? frames0 : frames1,
+                             .flags = 0 };
+    meta_from_info(&hdr.meta, info);
+
+    size_t point_count = 0;
+    ReplaySeekPoint* points = ReplayFormat_BuildSeekPoints(codes, counts, hdr.frame_count, &point_count);
 
+    FILE* f = atomic_open_bin(path, tmp, sizeof(tmp));
+    if (!f) {
+        printf("[NativeSave] ERROR: Cannot create %s: %s\n", tmp, strerror(errno));
+        free(points);
+        free(input);
+        return -1;
+    }
+
+    int ok = ReplayFormat_WriteHeader(f, &hdr);
+    ok = ok && ReplayFormat_WriteSection(f, REPLAY_SECTION_SETUP, 0, setup, setup_size, false);
+    ok = ok && ReplayFormat_WriteSection(f, REPLAY_SECTION_INPUT, 0, input, input_size, true);
+    ok = ok && ReplayFormat_WriteSection(
+                   f, REPLAY_SECTION_INDEX, 0, points, point_count * sizeof(ReplaySeekPoint), true);
+    ok = (fclose(f) == 0) && ok;
+    free(points);
+    free(input);
+
+    if (!ok) {
+        printf("[NativeSave] ERROR: Write failed for %s\n", tmp);
+        remove(tmp);
+        return -1;
+    }
+    if (atomic_commit(path, tmp) != 0)
+        return -1;
+
+    entry->frame_count = hdr.frame_count;
+    entry->meta = hdr.meta;
+    return 0;
+}
+
+/** Load a v2 replay into Replay_w and the replay log. */
+static int read_replay_file(const char* path) {
     FILE* f = fopen(path, "rb");
     if (!f) {
-        printf("[NativeSave] Replay %d not found\n", slot);
+        printf("[NativeSave] Replay %s not found\n", path);
         return -1;
     }
 
-    /* Read and validate header */
-    NativeReplayHeader hdr;
-    if (fread(&hdr, 1, sizeof(hdr), f) != sizeof(hdr)) {
-        printf("[NativeSave] Replay %d: header read error\n", slot);
+    ReplayFileHeader hdr;
+    if (!ReplayFormat_ReadHeader(f, &hdr)) {
+        printf("[NativeSave] Replay %s: bad header (magic 0x%08X, version %u)\n", path, hdr.magic, hdr.version);
         fclose(f);
         return -2;
     }
 
-    if (hdr.magic != NATIVE_REPLAY_MAGIC) {
-        printf("[NativeSave] Replay %d: bad magic 0x%08X\n", slot, hdr.magic);
-        fclose(f);
+    int have_setup = 0;
+    int have_input = 0;
+    ReplaySectionHeader section;
+
+    while (ReplayFormat_NextSection(f, &section)) {
+        if (section.type != REPLAY_SECTION_SETUP && section.type != REPLAY_SECTION_INPUT) {
+            /* Index and keyframes are for tools and seeking, not needed to play */
+            if (!ReplayFormat_SkipPayload(f, &section))
+                break;
+            continue;
+        }
+
+        u8* payload = ReplayFormat_ReadPayload(f, &section);
+        if (!payload) {
+            printf("[NativeSave] Replay %s: corrupt section %u\n", path, section.type);
+            break;
+        }
+
+        if (section.type == REPLAY_SECTION_SETUP) {
+            memset(&Replay_w, 0, sizeof(_REPLAY_W));
+            unpack_setup(&Replay_w, payload, section.raw_size);
+            have_setup = 1;
+        } else {
+            u16* codes[2];
+            u32 counts[2];
+            if (ReplayFormat_DecodeInput(payload, section.raw_size, codes, counts)) {
+                ReplayLog_Adopt(0, codes[0], counts[0]);
+                ReplayLog_Adopt(1, codes[1], counts[1]);
+                have_input = 1;
+            }
+        }
+        free(payload);
+    }
+    fclose(f);
+
+    if (!have_setup || !have_input) {
+        printf("[NativeSave] Replay %s: missing %s\n", path, have_setup ? "input" : "setup");
         return -2;
     }
+    return 0;
+}
 
-    if (hdr.data_size != sizeof(_REPLAY_W)) {
-        printf(
-            "[NativeSave] Replay %d: size mismatch (file=%u, expected=%zu)\n", slot, hdr.data_size, sizeof(_REPLAY_W));
-        /* Still try to load — forward compat */
+/* ── Index ─────────────────────────────────────────────────────────── */
+
+static void write_replay_index(void) {
+    char path[512], tmp[520];
+    ensure_save_dir();
+    ensure_replay_dir();
+    snprintf(path, sizeof(path), "%sreplays/index.bin", save_dir);
+
+    FILE* f = atomic_open_bin(path, tmp, sizeof(tmp));
+    if (!f) {
+        printf("[NativeSave] ERROR: Cannot create %s: %s\n", tmp, strerror(errno));
+        return;
     }
 
-    /* Read replay data */
-    size_t to_read = (hdr.data_size < sizeof(_REPLAY_W)) ? hdr.data_size : sizeof(_REPLAY_W);
-    memset(&Replay_w, 0, sizeof(_REPLAY_W));
-    size_t got = fread(&Replay_w, 1, to_read, f);
-    fclose(f);
+    const int ok = ReplayFormat_WriteIndex(f, replay_index, replay_count, replay_next_id);
+    if ((fclose(f) == 0) && ok) {
+        atomic_commit(path, tmp);
+    } else {
+        remove(tmp);
+    }
+}
 
-    if (got < to_read) {
-        printf("[NativeSave] Replay %d: short read (%zu/%zu)\n", slot, got, to_read);
-        return -2;
+static int append_index_entry(const ReplayIndexEntry* entry) {
+    ReplayIndexEntry* grown = realloc(replay_index, (replay_count + 1) * sizeof(ReplayIndexEntry));
+    if (!grown)
+        return -1;
+    replay_index = grown;
+    replay_index[replay_count++] = *entry;
+    if (entry->id >= replay_next_id) {
+        replay_next_id = entry->id + 1;
+    }
+    return 0;
+}
+
+static int compare_entries(const void* a, const void* b) {
+    const u32 ia = ((const ReplayIndexEntry*)a)->id;
+    const u32 ib = ((const ReplayIndexEntry*)b)->id;
+    return (ia > ib) - (ia < ib);
+}
+
+/** Rebuild the index from the headers of the replay files on disk. */
+static void scan_replay_files(void) {
+    char dir[512];
+    snprintf(dir, sizeof(dir), "%sreplays", save_dir);
+
+    int n = 0;
+    char** names = SDL_GlobDirectory(dir, "replay_*.rpl", 0, &n);
+    if (!names)
+        return;
+
+    for (int i = 0; i < n; i++) {
+        unsigned int id;
+        if (sscanf(names[i], "replay_%u.rpl", &id) != 1)
+            continue;
+
+        char path[600];
+        snprintf(path, sizeof(path), "%s/%s", dir, names[i]);
+        FILE* f = fopen(path, "rb");
+        if (!f)
+            continue;
+
+        ReplayFileHeader hdr;
+        if (ReplayFormat_ReadHeader(f, &hdr)) {
+            const ReplayIndexEntry entry = { .id = id, .frame_count = hdr.frame_count, .meta = hdr.meta };
+            append_index_entry(&entry);
+        }
+        fclose(f);
+    }
+    SDL_free(names);
+
+    if (replay_count > 1) {
+        qsort(replay_index, replay_count, sizeof(ReplayIndexEntry), compare_entries);
+    }
+}
+
+/** Convert the PS2-era replay_NN.bin slots and move the originals aside. */
+static void migrate_v1_replays(void) {
+    for (int slot = 0; slot < NATIVE_REPLAY_V1_SLOTS; slot++) {
+        char bin_path[512], meta_path[512], out_path[512];
+        snprintf(bin_path, sizeof(bin_path), "%sreplays/replay_%02d.bin", save_dir, slot);
+        snprintf(meta_path, sizeof(meta_path), "%sreplays/replay_%02d.meta", save_dir, slot);
+
+        SDL_PathInfo info;
+        if (!SDL_GetPathInfo(bin_path, &info) || info.type != SDL_PATHTYPE_FILE)
+            continue;
+
+        const u32 id = replay_next_id;
+        make_replay_file_path(out_path, sizeof(out_path), id);
+        if (NativeSave_ConvertReplayV1(bin_path, meta_path, out_path) != 0)
+            continue;
+
+        FILE* f = fopen(out_path, "rb");
+        ReplayFileHeader hdr;
+        if (f && ReplayFormat_ReadHeader(f, &hdr)) {
+            const ReplayIndexEntry entry = { .id = id, .frame_count = hdr.frame_count, .meta = hdr.meta };
+            append_index_entry(&entry);
+        }
+        if (f)
+            fclose(f);
+
+        char old_path[520];
+        snprintf(old_path, sizeof(old_path), "%s.v1", bin_path);
+        rename(bin_path, old_path);
+        snprintf(old_path, sizeof(old_path), "%s.v1", meta_path);
+        rename(meta_path, old_path);
+    }
+}
+
+static void ensure_replay_index(void) {
+    if (replay_index_loaded)
+        return;
+    replay_index_loaded = 1;
+
+    char path[512];
+    ensure_save_dir();
+    ensure_replay_dir();
+    snprintf(path, sizeof(path), "%sreplays/index.bin", save_dir);
+
+    FILE* f = fopen(path, "rb");
+    if (f) {
+        const int ok = ReplayFormat_ReadIndex(f, &replay_index, &replay_count, &replay_next_id);
+        fclose(f);
+        if (ok)
+            return;
     }
 
-    printf("[NativeSave] Replay %d loaded from %s\n", slot, path);
+    /* Missing or damaged: rebuild from the files, converting any v1 slots */
+    free(replay_index);
+    replay_index = NULL;
+    replay_count = 0;
+    replay_next_id = 1;
+
+    scan_replay_files();
+    migrate_v1_replays();
+    write_replay_index();
+    printf("[NativeSave] Replay index rebuilt: %u replays\n", replay_count);
+}
+
+/* ── Public API ────────────────────────────────────────────────────── */
+
+int NativeSave_GetReplayCount(void) {
+    ensure_replay_index();
+    return (int)replay_count;
+}
+
+int NativeSave_ReplayExists(int slot) {
+    ensure_replay_index();
+    return (slot >= 0 && (u32)slot < replay_count) ? 1 : 0;
+}
+
+int NativeSave_GetReplayInfo(int slot, _sub_info* out) {
+    if (!out || !NativeSave_ReplayExists(slot))
+        return -1;
+
+    info_from_meta(out, &replay_index[slot].meta);
     return 0;
 }
 
-int NativeSave_SaveReplay(int slot) {
-    if (slot < 0 || slot >= NATIVE_SAVE_REPLAY_SLOTS)
+int NativeSave_LoadReplay(int slot) {
+    if (!NativeSave_ReplayExists(slot))
         return -1;
 
-    char bin_path[512], bin_tmp[520];
-    char meta_path[512], meta_tmp[520];
-    make_replay_path(bin_path, sizeof(bin_path), slot, ".bin");
-    make_replay_path(meta_path, sizeof(meta_path), slot, ".meta");
+    char path[512];
+    make_replay_file_path(path, sizeof(path), replay_index[slot].id);
+
+    const int result = read_replay_file(path);
+    if (result == 0) {
+        printf("[NativeSave] Replay %d loaded from %s\n", slot, path);
+    }
+    return result;
+}
+
+int NativeSave_SaveReplay(int slot) {
+    ensure_replay_index();
+    if (slot < 0 || (u32)slot > replay_count)
+        return -1;
 
     /* Prepare replay data — copy from game state (mirrors save_data_store_replay) */
     _REPLAY_W* rw = &Replay_w;
@@ -608,48 +995,118 @@ int NativeSave_SaveReplay(int slot) {
     memcpy(&rw->mini_save_w.extra_option, &sw->extra_option, sizeof(sw->extra_option));
     memcpy(&rw->system_dir, &system_dir[Present_Mode], sizeof(rw->system_dir));
 
-    /* Write binary data */
-    FILE* f = atomic_open_bin(bin_path, bin_tmp, sizeof(bin_tmp));
-    if (!f) {
-        printf("[NativeSave] ERROR: Cannot create %s: %s\n", bin_tmp, strerror(errno));
-        return -1;
-    }
-
-    NativeReplayHeader hdr = {
-        .magic = NATIVE_REPLAY_MAGIC, .version = NATIVE_REPLAY_VERSION, .data_size = sizeof(_REPLAY_W), .reserved = 0
-    };
-    fwrite(&hdr, 1, sizeof(hdr), f);
-    fwrite(rw, 1, sizeof(_REPLAY_W), f);
-    fclose(f);
-    atomic_commit(bin_path, bin_tmp);
-
-    /* Write metadata sidecar */
     _sub_info meta;
     get_current_date(&meta.date);
     meta.player[0] = rp->player_infor[0].my_char;
     meta.player[1] = rp->player_infor[1].my_char;
 
-    f = atomic_open_bin(meta_path, meta_tmp, sizeof(meta_tmp));
-    if (f) {
-        fwrite(&meta, 1, sizeof(meta), f);
-        fclose(f);
-        atomic_commit(meta_path, meta_tmp);
+    /* A new replay takes the next free file number; overwriting keeps its own */
+    ReplayIndexEntry entry = { .id = ((u32)slot == replay_count) ? replay_next_id : replay_index[slot].id };
+
+    char path[512];
+    make_replay_file_path(path, sizeof(path), entry.id);
+
+    const u16* codes[2] = { ReplayLog_Codes(0), ReplayLog_Codes(1) };
+    const u32 counts[2] = { ReplayLog_Count(0), ReplayLog_Count(1) };
+    if (write_replay_file(path, rw, codes, counts, &meta, &entry) != 0)
+        return -1;
+
+    if ((u32)slot == replay_count) {
+        if (append_index_entry(&entry) != 0)
+            return -1;
+    } else {
+        replay_index[slot] = entry;
     }
+    write_replay_index();
 
-    printf("[NativeSave] Replay %d saved to %s\n", slot, bin_path);
+    printf("[NativeSave] Replay %d saved to %s (%u frames)\n", slot, path, entry.frame_count);
     return 0;
 }
 
 int NativeSave_DeleteReplay(int slot) {
-    if (slot < 0 || slot >= NATIVE_SAVE_REPLAY_SLOTS)
+    if (!NativeSave_ReplayExists(slot))
         return -1;
 
     char path[512];
-    make_replay_path(path, sizeof(path), slot, ".bin");
-    remove(path);
-    make_replay_path(path, sizeof(path), slot, ".meta");
+    make_replay_file_path(path, sizeof(path), replay_index[slot].id);
     remove(path);
 
+    memmove(&replay_index[slot], &replay_index[slot + 1], (replay_count - slot - 1) * sizeof(ReplayIndexEntry));
+    replay_count -= 1;
+    write_replay_index();
+
     printf("[NativeSave] Replay %d deleted\n", slot);
     return 0;
 }
+
+int NativeSave_ConvertReplayV1(const char* v1_path, const char* meta_path, const char* out_path) {
+    FILE* f = fopen(v1_path, "rb");
+    if (!f) {
+        printf("[NativeSave] Replay %s not found\n", v1_path);
+        return -1;
+    }
+
+    NativeReplayHeaderV1 hdr;
+    if (fread(&hdr, 1, sizeof(hdr), f) != sizeof(hdr) || hdr.magic != REPLAY_FILE_MAGIC ||
+        hdr.version != REPLAY_FILE_VERSION_V1) {
+        printf("[NativeSave] Replay %s: not a v1 replay\n", v1_path);
+        fclose(f);
+        return -2;
+    }
+
+    if (hdr.data_size != sizeof(_REPLAY_W)) {
+        printf("[NativeSave] Replay %s: size mismatch (file=%u, expected=%zu)\n",
+               v1_path,
+               hdr.data_size,
+               sizeof(_REPLAY_W));
+        /* Still try to convert — forward compat */
+    }
+
+    _REPLAY_W* rw = calloc(1, sizeof(_REPLAY_W));
+    if (!rw) {
+        fclose(f);
+        return -1;
+    }
+
+    const size_t to_read = (hdr.data_size < sizeof(_REPLAY_W)) ? hdr.data_size : sizeof(_REPLAY_W);
+    const size_t got = fread(rw, 1, to_read, f);
+    fclose(f);
+    if (got < to_read) {
+        printf("[NativeSave] Replay %s: short read (%zu/%zu)\n", v1_path, got, to_read);
+        free(rw);
+        return -2;
+    }
+
+    /* Trailing empty entries are what playback reads past the end of a log anyway */
+    const u16* codes[2];
+    u32 counts[2];
+    for (int i = 0; i < 2; i++) {
+        const u32 capacity = sizeof(rw->io_unit.key_buff[i]) / sizeof(u16);
+        u32 n = capacity;
+        while (n > 0 && rw->io_unit.key_buff[i][n - 1] == 0) {
+            n -= 1;
+        }
+        codes[i] = rw->io_unit.key_buff[i];
+        counts[i] = n;
+    }
+
+    _sub_info meta;
+    memset(&meta, 0, sizeof(meta));
+    FILE* mf = meta_path ? fopen(meta_path, "rb") : NULL;
+    if (!mf || fread(&meta, 1, sizeof(meta), mf) != sizeof(meta)) {
+        memset(&meta, 0, sizeof(meta));
+        meta.player[0] = rw->game_infor.player_infor[0].my_char;
+        meta.player[1] = rw->game_infor.player_infor[1].my_char;
+    }
+    if (mf)
+        fclose(mf);
+
+    ReplayIndexEntry entry;
+    const int result = write_replay_file(out_path, rw, codes, counts, &meta, &entry);
+    free(rw);
+
+    if (result == 0) {
+        printf("[NativeSave] Converted v1 replay %s -> %s (%u frames)\n", v1_path, out_path, entry.frame_count);
+    }
+    return result;
+}
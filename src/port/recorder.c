@@ -0,0 +1,554 @@
+/**
+ * @file recorder.c
+ * @brief Native-resolution gameplay recorder.
+ *
+ * The game thread reads the canvas back through a ring of pixel pack
+ * buffers, so the copy it maps was queued two frames earlier and never
+ * stalls the pipeline. Mapped frames are copied into a small pool of slots
+ * and handed to a worker thread, which delta-encodes them (recorder_codec.c)
+ * and writes them together with the audio the SPU and ADX callbacks push
+ * into per-source lock-free rings. When the worker falls behind, the game
+ * thread records a repeat frame instead of waiting.
+ */
+#include "port/recorder.h"
+#include "port/paths.h"
+#include "port/recorder_codec.h"
+#include "port/sdl/sdl_app.h"
+#include <SDL3/SDL.h>
+#include <glad/gl.h>
+#include <string.h>
+
+#define CAPTURE_PBO_COUNT 3
+#define FRAME_SLOTS 4
+#define QUEUE_CAPACITY 16
+#define KEYFRAME_INTERVAL 600          // ~10 s at 59.6 Hz
+#define AUDIO_RING_FRAMES (48000 * 1) // One second of stereo per source
+#define AUDIO_SAMPLE_RATE 48000
+#define AUDIO_CHANNELS 2
+#define WORKER_IDLE_MS 20 // Audio keeps draining while the game is paused
+
+typedef struct {
+    int16_t samples[AUDIO_RING_FRAMES * AUDIO_CHANNELS];
+    SDL_AtomicU32 write_pos; // In sample frames, wraps
+    SDL_AtomicU32 read_pos;
+    SDL_AtomicU32 overruns;
+    uint64_t written; // Worker: sample frames stored so far
+} AudioRing;
+
+typedef struct {
+    int slot;       // Frame slot, -1 for a repeat
+    uint64_t index; // Video frame index
+} QueuedFrame;
+
+typedef struct {
+    // Game thread
+    bool active;
+    int width;
+    int height;
+    size_t frame_bytes;
+    GLuint read_fbo;
+    GLuint attached_texture;
+    GLuint pbos[CAPTURE_PBO_COUNT];
+    bool pbo_pending[CAPTURE_PBO_COUNT];
+    int pbo_head;
+    uint64_t next_frame;
+    double capture_us;
+    double capture_max_us;
+    uint64_t repeated;
+
+    // Shared, under mutex
+    SDL_Mutex* mutex;
+    SDL_Condition* cond;
+    uint8_t* slots[FRAME_SLOTS];
+    bool slot_busy[FRAME_SLOTS];
+    QueuedFrame queue[QUEUE_CAPACITY];
+    int queue_head;
+    int queue_count;
+    bool stop;
+    uint64_t frames_written;
+    uint64_t bytes_written;
+    double encode_ms;
+
+    // Worker thread
+    SDL_Thread* thread;
+    SDL_IOStream* file;
+    RecorderCodec* codec;
+    uint8_t* encoded;
+    size_t encoded_capacity;
+    uint64_t frames_since_key;
+    bool write_failed;
+} Recorder;
+
+static Recorder s_rec;
+static AudioRing s_audio[RECORDER_AUDIO_SOURCE_COUNT];
+static SDL_AtomicInt s_audio_enabled;
+
+// --- Worker ---
+
+static bool write_chunk(RecorderChunkType type, uint32_t track, uint64_t timestamp, const void* data, uint32_t size) {
+    if (s_rec.write_failed)
+        return false;
+
+    RecorderChunkHeader header;
+    header.type = (uint32_t)type;
+    header.size = size;
+    header.timestamp = timestamp;
+    header.track = track;
+    header.reserved = 0;
+
+    if (SDL_WriteIO(s_rec.file, &header, sizeof(header)) != sizeof(header) ||
+        (size > 0 && SDL_WriteIO(s_rec.file, data, size) != size)) {
+        SDL_Log("Recorder: write failed: %s", SDL_GetError());
+        s_rec.write_failed = true;
+        return false;
+    }
+
+    SDL_LockMutex(s_rec.mutex);
+    s_rec.bytes_written += sizeof(header) + size;
+    SDL_UnlockMutex(s_rec.mutex);
+    return true;
+}
+
+static void drain_audio(void) {
+    for (int source = 0; source < RECORDER_AUDIO_SOURCE_COUNT; source++) {
+        AudioRing* ring = &s_audio[source];
+        const Uint32 write = SDL_GetAtomicU32(&ring->write_pos);
+        Uint32 read = SDL_GetAtomicU32(&ring->read_pos);
+
+        while (read != write) {
+            const Uint32 offset = read % AUDIO_RING_FRAMES;
+            Uint32 count = write - read;
+            if (count > AUDIO_RING_FRAMES - offset)
+                count = AUDIO_RING_FRAMES - offset;
+
+            write_chunk(RECORDER_CHUNK_AUDIO,
+                        (uint32_t)source,
+                        ring->written,
+                        &ring->samples[offset * AUDIO_CHANNELS],
+                        count * AUDIO_CHANNELS * sizeof(int16_t));
+            ring->written += count;
+            read += count;
+            SDL_SetAtomicU32(&ring->read_pos, read);
+        }
+    }
+}
+
+static void encode_frame(const QueuedFrame* frame) {
+    if (frame->slot < 0) {
+        write_chunk(RECORDER_CHUNK_VIDEO_REPEAT, 0, frame->index, NULL, 0);
+        return;
+    }
+
+    const Uint64 start = SDL_GetTicksNS();
+    const bool keyframe = s_rec.frames_since_key >= KEYFRAME_INTERVAL;
+    RecorderChunkType type = RECORDER_CHUNK_VIDEO_KEY;
+    const size_t size =
+        RecorderCodec_Encode(s_rec.codec, s_rec.slots[frame->slot], keyframe, s_rec.encoded, s_rec.encoded_capacity, &type);
+
+    if (size == 0) {
+        SDL_Log("Recorder: frame %llu failed to encode", (unsigned long long)frame->index);
+        write_chunk(RECORDER_CHUNK_VIDEO_REPEAT, 0, frame->index, NULL, 0);
+        return;
+    }
+
+    s_rec.frames_since_key = (type == RECORDER_CHUNK_VIDEO_KEY) ? 1 : s_rec.frames_since_key + 1;
+    write_chunk(type, 0, frame->index, s_rec.encoded, (uint32_t)size);
+
+    const double ms = (double)(SDL_GetTicksNS() - start) / 1e6;
+    SDL_LockMutex(s_rec.mutex);
+    s_rec.encode_ms = (s_rec.encode_ms == 0.0) ? ms : s_rec.encode_ms * 0.95 + ms * 0.05;
+    SDL_UnlockMutex(s_rec.mutex);
+}
+
+static int SDLCALL worker_main(void* data) {
+    (void)data;
+
+    SDL_LockMutex(s_rec.mutex);
+    for (;;) {
+        if (s_rec.queue_count == 0 && !s_rec.stop) {
+            SDL_WaitConditionTimeout(s_rec.cond, s_rec.mutex, WORKER_IDLE_MS);
+        }
+
+        while (s_rec.queue_count > 0) {
+            const QueuedFrame frame = s_rec.queue[s_rec.queue_head];
+            SDL_UnlockMutex(s_rec.mutex);
+
+            encode_frame(&frame);
+
+            SDL_LockMutex(s_rec.mutex);
+            if (frame.slot >= 0) {
+                s_rec.slot_busy[frame.slot] = false;
+            }
+            s_rec.queue_head = (s_rec.queue_head + 1) % QUEUE_CAPACITY;
+            s_rec.queue_count--;
+            s_rec.frames_written++;
+        }
+
+        const bool stop = s_rec.stop;
+        SDL_UnlockMutex(s_rec.mutex);
+        drain_audio();
+        SDL_LockMutex(s_rec.mutex);
+
+        if (stop && s_rec.queue_count == 0)
+            break;
+    }
+    SDL_UnlockMutex(s_rec.mutex);
+    return 0;
+}
+
+// --- Game thread ---
+
+static void enqueue_frame(int slot) {
+    SDL_LockMutex(s_rec.mutex);
+    if (s_rec.queue_count < QUEUE_CAPACITY) {
+        QueuedFrame* entry = &s_rec.queue[(s_rec.queue_head + s_rec.queue_count) % QUEUE_CAPACITY];
+        entry->slot = slot;
+        entry->index = s_rec.next_frame++;
+        s_rec.queue_count++;
+        SDL_SignalCondition(s_rec.cond);
+    } else if (slot >= 0) {
+        s_rec.slot_busy[slot] = false;
+    }
+    SDL_UnlockMutex(s_rec.mutex);
+}
+
+static int acquire_slot(void) {
+    int slot = -1;
+    SDL_LockMutex(s_rec.mutex);
+    // Keep queue room for repeats, so the frame count never loses track of time
+    if (s_rec.queue_count < QUEUE_CAPACITY - 1) {
+        for (int i = 0; i < FRAME_SLOTS; i++) {
+            if (!s_rec.slot_busy[i]) {
+                s_rec.slot_busy[i] = true;
+                slot = i;
+                break;
+            }
+        }
+    }
+    SDL_UnlockMutex(s_rec.mutex);
+    return slot;
+}
+
+/** @brief Map a finished readback and hand it to the worker (or record a repeat). */
+static void collect_pbo(int index) {
+    if (!s_rec.pbo_pending[index])
+        return;
+    s_rec.pbo_pending[index] = false;
+
+    const int slot = acquire_slot();
+    if (slot >= 0) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s_rec.pbos[index]);
+        const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)s_rec.frame_bytes, GL_MAP_READ_BIT);
+        if (pixels) {
+            memcpy(s_rec.slots[slot], pixels, s_rec.frame_bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            enqueue_frame(slot);
+            return;
+        }
+        SDL_LockMutex(s_rec.mutex);
+        s_rec.slot_busy[slot] = false;
+        SDL_UnlockMutex(s_rec.mutex);
+    }
+
+    s_rec.repeated++;
+    enqueue_frame(-1);
+}
+
+static bool create_gl_objects(void) {
+    glGenFramebuffers(1, &s_rec.read_fbo);
+    glGenBuffers(CAPTURE_PBO_COUNT, s_rec.pbos);
+    for (int i = 0; i < CAPTURE_PBO_COUNT; i++) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s_rec.pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)s_rec.frame_bytes, NULL, GL_STREAM_READ);
+        s_rec.pbo_pending[i] = false;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    s_rec.attached_texture = 0;
+    s_rec.pbo_head = 0;
+    return s_rec.read_fbo != 0;
+}
+
+static void destroy_gl_objects(void) {
+    if (s_rec.read_fbo) {
+        glDeleteFramebuffers(1, &s_rec.read_fbo);
+        s_rec.read_fbo = 0;
+    }
+    glDeleteBuffers(CAPTURE_PBO_COUNT, s_rec.pbos);
+    memset(s_rec.pbos, 0, sizeof(s_rec.pbos));
+}
+
+static void free_session(void) {
+    for (int i = 0; i < FRAME_SLOTS; i++) {
+        SDL_free(s_rec.slots[i]);
+        s_rec.slots[i] = NULL;
+    }
+    SDL_free(s_rec.encoded);
+    s_rec.encoded = NULL;
+    RecorderCodec_Destroy(s_rec.codec);
+    s_rec.codec = NULL;
+    if (s_rec.cond) {
+        SDL_DestroyCondition(s_rec.cond);
+        s_rec.cond = NULL;
+    }
+    if (s_rec.mutex) {
+        SDL_DestroyMutex(s_rec.mutex);
+        s_rec.mutex = NULL;
+    }
+}
+
+bool Recorder_Start(const char* path) {
+    if (s_rec.active)
+        return true;
+
+    if (SDLApp_GetRenderer() != RENDERER_OPENGL) {
+        SDL_Log("Recorder: native recording needs the OpenGL renderer");
+        return false;
+    }
+
+    memset(&s_rec, 0, sizeof(s_rec));
+    s_rec.width = 384;
+    s_rec.height = 224;
+    s_rec.codec = RecorderCodec_Create(s_rec.width, s_rec.height);
+    if (!s_rec.codec) {
+        return false;
+    }
+    s_rec.frame_bytes = RecorderCodec_FrameBytes(s_rec.codec);
+    s_rec.encoded_capacity = RecorderCodec_MaxEncodedBytes(s_rec.codec);
+    s_rec.encoded = (uint8_t*)SDL_malloc(s_rec.encoded_capacity);
+    for (int i = 0; i < FRAME_SLOTS; i++) {
+        s_rec.slots[i] = (uint8_t*)SDL_malloc(s_rec.frame_bytes);
+    }
+    s_rec.mutex = SDL_CreateMutex();
+    s_rec.cond = SDL_CreateCondition();
+    if (!s_rec.encoded || !s_rec.slots[FRAME_SLOTS - 1] || !s_rec.mutex || !s_rec.cond) {
+        free_session();
+        return false;
+    }
+
+    s_rec.file = SDL_IOFromFile(path, "wb");
+    if (!s_rec.file) {
+        SDL_Log("Recorder: can't create %s: %s", path, SDL_GetError());
+        free_session();
+        return false;
+    }
+
+    RecorderFileHeader header;
+    SDL_zero(header);
+    header.magic = RECORDER_FILE_MAGIC;
+    header.version = RECORDER_FILE_VERSION;
+    header.width = (uint16_t)s_rec.width;
+    header.height = (uint16_t)s_rec.height;
+    header.flags = RECORDER_FLAG_BOTTOM_UP;
+    header.frame_time_ns = SDLApp_GetTargetFrameTimeNS();
+    header.sample_rate = AUDIO_SAMPLE_RATE;
+    header.channels = AUDIO_CHANNELS;
+    header.audio_sources = RECORDER_AUDIO_SOURCE_COUNT;
+    if (SDL_WriteIO(s_rec.file, &header, sizeof(header)) != sizeof(header) || !create_gl_objects()) {
+        SDL_Log("Recorder: can't start %s: %s", path, SDL_GetError());
+        SDL_CloseIO(s_rec.file);
+        s_rec.file = NULL;
+        destroy_gl_objects();
+        free_session();
+        return false;
+    }
+    s_rec.bytes_written = sizeof(header);
+
+    for (int source = 0; source < RECORDER_AUDIO_SOURCE_COUNT; source++) {
+        SDL_SetAtomicU32(&s_audio[source].write_pos, 0);
+        SDL_SetAtomicU32(&s_audio[source].read_pos, 0);
+        SDL_SetAtomicU32(&s_audio[source].overruns, 0);
+        s_audio[source].written = 0;
+    }
+
+    s_rec.thread = SDL_CreateThread(worker_main, "Recorder", NULL);
+    if (!s_rec.thread) {
+        SDL_Log("Recorder: can't start worker: %s", SDL_GetError());
+        SDL_CloseIO(s_rec.file);
+        s_rec.file = NULL;
+        destroy_gl_objects();
+        free_session();
+        return false;
+    }
+
+    SDL_SetAtomicInt(&s_audio_enabled, 1);
+    s_rec.active = true;
+    SDL_Log("Recorder: recording to %s", path);
+    return true;
+}
+
+void Recorder_Stop(void) {
+    if (!s_rec.active)
+        return;
+
+    // Hand over the readbacks still in flight, oldest first
+    for (int i = 0; i < CAPTURE_PBO_COUNT; i++) {
+        collect_pbo((s_rec.pbo_head + i) % CAPTURE_PBO_COUNT);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    SDL_SetAtomicInt(&s_audio_enabled, 0);
+
+    SDL_LockMutex(s_rec.mutex);
+    s_rec.stop = true;
+    SDL_SignalCondition(s_rec.cond);
+    SDL_UnlockMutex(s_rec.mutex);
+    SDL_WaitThread(s_rec.thread, NULL);
+    s_rec.thread = NULL;
+
+    uint64_t overruns = 0;
+    for (int source = 0; source < RECORDER_AUDIO_SOURCE_COUNT; source++) {
+        overruns += SDL_GetAtomicU32(&s_audio[source].overruns);
+    }
+    SDL_Log("Recorder: stopped after %llu frames (%llu repeated, %llu audio overruns), %.1f MiB, capture %.1f us avg / "
+            "%.1f us max, encode %.2f ms",
+            (unsigned long long)s_rec.frames_written,
+            (unsigned long long)s_rec.repeated,
+            (unsigned long long)overruns,
+            (double)s_rec.bytes_written / (1024.0 * 1024.0),
+            s_rec.capture_us,
+            s_rec.capture_max_us,
+            s_rec.encode_ms);
+    if (s_rec.capture_us > RECORDER_CAPTURE_BUDGET_US) {
+        SDL_Log("Recorder: capture cost exceeded the %.0f us budget", RECORDER_CAPTURE_BUDGET_US);
+    }
+
+    SDL_CloseIO(s_rec.file);
+    s_rec.file = NULL;
+    destroy_gl_objects();
+    free_session();
+    s_rec.active = false;
+}
+
+void Recorder_Toggle(void) {
+    if (s_rec.active) {
+        Recorder_Stop();
+        return;
+    }
+
+    char dir[1024];
+    SDL_snprintf(dir, sizeof(dir), "%srecordings/", Paths_GetPrefPath());
+    if (!SDL_CreateDirectory(dir)) {
+        SDL_Log("Recorder: can't create %s: %s", dir, SDL_GetError());
+        return;
+    }
+
+    SDL_Time now = 0;
+    SDL_DateTime dt;
+    SDL_GetCurrentTime(&now);
+    if (!SDL_TimeToDateTime(now, &dt, true)) {
+        SDL_zero(dt);
+    }
+
+    char path[1100];
+    SDL_snprintf(path,
+                 sizeof(path),
+                 "%s3sx_%04d%02d%02d_%02d%02d%02d.3sxrec",
+                 dir,
+                 dt.year,
+                 dt.month,
+                 dt.day,
+                 dt.hour,
+                 dt.minute,
+                 dt.second);
+    Recorder_Start(path);
+}
+
+bool Recorder_IsActive(void) {
+    return s_rec.active;
+}
+
+void Recorder_CaptureFrameGL(uint32_t texture_id, int width, int height) {
+    if (!s_rec.active || width != s_rec.width || height != s_rec.height)
+        return;
+
+    const Uint64 start = SDL_GetTicksNS();
+
+    GLint prev_read_fbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prev_read_fbo);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, s_rec.read_fbo);
+    if (s_rec.attached_texture != texture_id) {
+        glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_id, 0);
+        s_rec.attached_texture = texture_id;
+    }
+
+    // Queue this frame's readback...
+    const int head = s_rec.pbo_head;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s_rec.pbos[head]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    s_rec.pbo_pending[head] = true;
+    s_rec.pbo_head = (head + 1) % CAPTURE_PBO_COUNT;
+
+    // ...and take the one queued CAPTURE_PBO_COUNT - 1 frames ago, which the GPU has finished
+    collect_pbo(s_rec.pbo_head);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)prev_read_fbo);
+
+    const double us = (double)(SDL_GetTicksNS() - start) / 1000.0;
+    s_rec.capture_us = (s_rec.capture_us == 0.0) ? us : s_rec.capture_us * 0.95 + us * 0.05;
+    if (us > s_rec.capture_max_us) {
+        s_rec.capture_max_us = us;
+    }
+}
+
+static void copy_scaled(int16_t* dst, const int16_t* src, int count, float gain) {
+    if (gain == 1.0f) {
+        memcpy(dst, src, (size_t)count * sizeof(int16_t));
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        const float value = (float)src[i] * gain;
+        dst[i] = (int16_t)(value > 32767.0f ? 32767.0f : (value < -32768.0f ? -32768.0f : value));
+    }
+}
+
+void Recorder_PushAudio(RecorderAudioSource source, const int16_t* samples, int sample_frames, float gain) {
+    if (!SDL_GetAtomicInt(&s_audio_enabled) || source < 0 || source >= RECORDER_AUDIO_SOURCE_COUNT ||
+        sample_frames <= 0)
+        return;
+
+    AudioRing* ring = &s_audio[source];
+    const Uint32 read = SDL_GetAtomicU32(&ring->read_pos);
+    Uint32 write = SDL_GetAtomicU32(&ring->write_pos);
+    const Uint32 space = AUDIO_RING_FRAMES - (write - read);
+
+    Uint32 count = (Uint32)sample_frames;
+    if (count > space) {
+        SDL_AddAtomicU32(&ring->overruns, 1);
+        count = space;
+    }
+
+    while (count > 0) {
+        const Uint32 offset = write % AUDIO_RING_FRAMES;
+        Uint32 chunk = AUDIO_RING_FRAMES - offset;
+        if (chunk > count)
+            chunk = count;
+        copy_scaled(&ring->samples[offset * AUDIO_CHANNELS], samples, (int)(chunk * AUDIO_CHANNELS), gain);
+        samples += chunk * AUDIO_CHANNELS;
+        write += chunk;
+        count -= chunk;
+    }
+    SDL_SetAtomicU32(&ring->write_pos, write);
+}
+
+void Recorder_GetStats(RecorderStats* out) {
+    SDL_zerop(out);
+    if (!s_rec.active)
+        return;
+
+    out->active = true;
+    out->repeated = s_rec.repeated;
+    out->capture_us = s_rec.capture_us;
+    out->capture_max_us = s_rec.capture_max_us;
+
+    SDL_LockMutex(s_rec.mutex);
+    out->frames = s_rec.frames_written;
+    out->bytes = s_rec.bytes_written;
+    out->encode_ms = s_rec.encode_ms;
+    SDL_UnlockMutex(s_rec.mutex);
+
+    for (int source = 0; source < RECORDER_AUDIO_SOURCE_COUNT; source++) {
+        out->audio_overruns += SDL_GetAtomicU32(&s_audio[source].overruns);
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file recorder_codec.c
+ * @brief Lossless delta codec for native gameplay recordings.
+ *
+ * Consecutive canvas frames differ in a few sprites, so each frame is XORed
+ * against the previous one and the mostly-zero result is deflated at level 1
+ * with the bundled zlib. Key frames skip the XOR so a file can be cut or
+ * seeked at any key frame.
+ */
+#include "port/recorder_codec.h"
+#include "zlib.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct RecorderCodec {
+    int width;
+    int height;
+    size_t frame_bytes;
+    uint8_t* reference; // Last frame encoded or decoded
+    uint8_t* scratch;   // XOR delta
+    bool has_reference;
+    z_stream deflater;
+    z_stream inflater;
+    bool deflater_ready;
+    bool inflater_ready;
+};
+
+static void xor_frames(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t bytes) {
+    // Frame sizes are whole RGBA pixels, so 64-bit words cover all but the tail
+    size_t i = 0;
+    for (; i + 8 <= bytes; i += 8) {
+        uint64_t wa;
+        uint64_t wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        wa ^= wb;
+        memcpy(dst + i, &wa, 8);
+    }
+    for (; i < bytes; i++) {
+        dst[i] = a[i] ^ b[i];
+    }
+}
+
+RecorderCodec* RecorderCodec_Create(int width, int height) {
+    if (width <= 0 || height <= 0)
+        return NULL;
+
+    RecorderCodec* codec = (RecorderCodec*)calloc(1, sizeof(RecorderCodec));
+    if (!codec)
+        return NULL;
+
+    codec->width = width;
+    codec->height = height;
+    codec->frame_bytes = (size_t)width * (size_t)height * 4;
+    codec->reference = (uint8_t*)malloc(codec->frame_bytes);
+    codec->scratch = (uint8_t*)malloc(codec->frame_bytes);
+    if (!codec->reference || !codec->scratch) {
+        RecorderCodec_Destroy(codec);
+        return NULL;
+    }
+    return codec;
+}
+
+void RecorderCodec_Destroy(RecorderCodec* codec) {
+    if (!codec)
+        return;
+    if (codec->deflater_ready)
+        deflateEnd(&codec->deflater);
+    if (codec->inflater_ready)
+        inflateEnd(&codec->inflater);
+    free(codec->reference);
+    free(codec->scratch);
+    free(codec);
+}
+
+size_t RecorderCodec_FrameBytes(const RecorderCodec* codec) {
+    return codec->frame_bytes;
+}
+
+size_t RecorderCodec_MaxEncodedBytes(const RecorderCodec* codec) {
+    // zlib 1.1's documented bound is 0.1% + 12 bytes; leave generous slack
+    return codec->frame_bytes + (codec->frame_bytes >> 8) + 64;
+}
+
+size_t RecorderCodec_Encode(RecorderCodec* codec, const uint8_t* pixels, bool keyframe, uint8_t* out,
+                            size_t out_capacity, RecorderChunkType* type) {
+    if (!codec->deflater_ready) {
+        memset(&codec->deflater, 0, sizeof(codec->deflater));
+        if (deflateInit(&codec->deflater, 1) != Z_OK)
+            return 0;
+        codec->deflater_ready = true;
+    } else {
+        deflateReset(&codec->deflater);
+    }
+
+    const bool key = keyframe || !codec->has_reference;
+    const uint8_t* input = pixels;
+    if (!key) {
+        xor_frames(codec->scratch, pixels, codec->reference, codec->frame_bytes);
+        input = codec->scratch;
+    }
+
+    codec->deflater.next_in = (Bytef*)input;
+    codec->deflater.avail_in = (uInt)codec->frame_bytes;
+    codec->deflater.next_out = out;
+    codec->deflater.avail_out = (uInt)out_capacity;
+    if (deflate(&codec->deflater, Z_FINISH) != Z_STREAM_END)
+        return 0;
+
+    memcpy(codec->reference, pixels, codec->frame_bytes);
+    codec->has_reference = true;
+    *type = key ? RECORDER_CHUNK_VIDEO_KEY : RECORDER_CHUNK_VIDEO_DELTA;
+    return (size_t)codec->deflater.total_out;
+}
+
+bool RecorderCodec_Decode(RecorderCodec* codec, RecorderChunkType type, const uint8_t* data, size_t size,
+                          uint8_t* pixels) {
+    if (type == RECORDER_CHUNK_VIDEO_REPEAT) {
+        if (!codec->has_reference)
+            return false;
+        memcpy(pixels, codec->reference, codec->frame_bytes);
+        return true;
+    }
+    if (type != RECORDER_CHUNK_VIDEO_KEY && type != RECORDER_CHUNK_VIDEO_DELTA)
+        return false;
+    if (type == RECORDER_CHUNK_VIDEO_DELTA && !codec->has_reference)
+        return false;
+
+    if (!codec->inflater_ready) {
+        memset(&codec->inflater, 0, sizeof(codec->inflater));
+        if (inflateInit(&codec->inflater) != Z_OK)
+            return false;
+        codec->inflater_ready = true;
+    } else {
+        inflateReset(&codec->inflater);
+    }
+
+    uint8_t* target = (type == RECORDER_CHUNK_VIDEO_KEY) ? pixels : codec->scratch;
+    codec->inflater.next_in = (Bytef*)data;
+    codec->inflater.avail_in = (uInt)size;
+    codec->inflater.next_out = target;
+    codec->inflater.avail_out = (uInt)codec->frame_bytes;
+    if (inflate(&codec->inflater, Z_FINISH) != Z_STREAM_END || codec->inflater.total_out != codec->frame_bytes)
+        return false;
+
+    if (type == RECORDER_CHUNK_VIDEO_DELTA) {
+        xor_frames(pixels, codec->scratch, codec->reference, codec->frame_bytes);
+    }
+    memcpy(codec->reference, pixels, codec->frame_bytes);
+    codec->has_reference = true;
+    return true;
+}
@@ -0,0 +1,77 @@
+#ifndef RECORDER_CODEC_H
+#define RECORDER_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// On-disk layout of a native recording (.3sxrec):
+//
+//   RecorderFileHeader
+//   { RecorderChunkHeader, payload } ...
+//
+// All fields are little-endian. Video chunks hold one frame of RGBA8 pixels
+// at the canvas resolution: a key frame is the deflated frame, a delta frame
+// is the deflated XOR against the previous frame, and a repeat frame has no
+// payload (the game thread produced a frame the encoder had no room for, so
+// the previous one is shown again). Audio chunks hold raw interleaved S16
+// samples of one source; tools/rec2video.py mixes the sources when
+// transcoding.
+
+#define RECORDER_FILE_MAGIC 0x52585333u // "3SXR"
+#define RECORDER_FILE_VERSION 1u
+
+#define RECORDER_FLAG_BOTTOM_UP 0x1u // Rows are stored bottom-up (GL readback order)
+
+typedef enum RecorderChunkType {
+    RECORDER_CHUNK_VIDEO_KEY = 1,
+    RECORDER_CHUNK_VIDEO_DELTA = 2,
+    RECORDER_CHUNK_VIDEO_REPEAT = 3,
+    RECORDER_CHUNK_AUDIO = 4,
+} RecorderChunkType;
+
+typedef struct RecorderFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t width;
+    uint16_t height;
+    uint32_t flags;
+    uint64_t frame_time_ns; // Nominal duration of one video frame
+    uint32_t sample_rate;
+    uint16_t channels;
+    uint16_t audio_sources; // Number of audio tracks (RecorderAudioSource)
+} RecorderFileHeader;
+
+typedef struct RecorderChunkHeader {
+    uint32_t type;      // RecorderChunkType
+    uint32_t size;      // Payload bytes following this header
+    uint64_t timestamp; // Frame index for video, first sample frame for audio
+    uint32_t track;     // Audio source, 0 for video
+    uint32_t reserved;
+} RecorderChunkHeader;
+
+// Delta encoder/decoder state for one video stream. Holds the reference
+// frame, so frames must be fed in order.
+typedef struct RecorderCodec RecorderCodec;
+
+RecorderCodec* RecorderCodec_Create(int width, int height);
+void RecorderCodec_Destroy(RecorderCodec* codec);
+
+// Size of one RGBA8 frame in bytes.
+size_t RecorderCodec_FrameBytes(const RecorderCodec* codec);
+
+// Worst-case size of an encoded frame.
+size_t RecorderCodec_MaxEncodedBytes(const RecorderCodec* codec);
+
+// Encode `pixels` into `out` and make it the new reference. A key frame is
+// always produced for the first frame. Returns the payload size, or 0 on
+// failure; `*type` receives the chunk type to store it under.
+size_t RecorderCodec_Encode(RecorderCodec* codec, const uint8_t* pixels, bool keyframe, uint8_t* out,
+                            size_t out_capacity, RecorderChunkType* type);
+
+// Decode one video chunk into `pixels` (the frame size) and make it the new
+// reference. Returns false on corrupt input or a delta without a reference.
+bool RecorderCodec_Decode(RecorderCodec* codec, RecorderChunkType type, const uint8_t* data, size_t size,
+                          uint8_t* pixels);
+
+#endif
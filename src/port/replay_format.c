@@ -0,0 +1,327 @@
+/**
+ * @file replay_format.c
+ * @brief Encoding, seeking and file I/O for v2 replays and the replay index.
+ *
+ * Input is stored as runs of (key, frames) with LEB128 varints, which on
+ * typical matches is several times smaller than the PS2 code log before the
+ * bundled zlib deflates it further. Nothing here touches game state, so
+ * native_save.c owns what goes into the SETUP and KEYFRAME sections.
+ */
+#include "port/replay_format.h"
+
+#include "zlib.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define VARINT_MAX_BYTES 5
+
+static uint32_t code_frames(uint16_t code) {
+    return (uint32_t)(code >> 12) + 1;
+}
+
+uint32_t ReplayFormat_CountFrames(const uint16_t* codes, uint32_t count) {
+    uint32_t frames = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        frames += code_frames(codes[i]);
+    }
+    return frames;
+}
+
+// --- Input streams ---
+
+static uint8_t* put_varint(uint8_t* out, uint32_t value) {
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+static bool get_varint(const uint8_t** cursor, const uint8_t* end, uint32_t* value) {
+    uint32_t result = 0;
+    for (int i = 0; i < VARINT_MAX_BYTES; i++) {
+        if (*cursor >= end)
+            return false;
+        const uint8_t byte = *(*cursor)++;
+        result |= (uint32_t)(byte & 0x7F) << (7 * i);
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t count_runs(const uint16_t* codes, uint32_t count) {
+    uint32_t runs = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i == 0 || (codes[i] & REPLAY_CODE_KEY_MASK) != (codes[i - 1] & REPLAY_CODE_KEY_MASK)) {
+            runs += 1;
+        }
+    }
+    return runs;
+}
+
+uint8_t* ReplayFormat_EncodeInput(const uint16_t* const codes[2], const uint32_t counts[2], size_t* size) {
+    // Worst case: a run per code, each a 2-byte key and a full-width length
+    const size_t capacity = 2 * VARINT_MAX_BYTES + ((size_t)counts[0] + counts[1]) * (2 + VARINT_MAX_BYTES);
+    uint8_t* out = malloc(capacity);
+    if (out == NULL)
+        return NULL;
+
+    uint8_t* p = out;
+    for (int player = 0; player < 2; player++) {
+        const uint16_t* log = codes[player];
+        const uint32_t count = counts[player];
+        p = put_varint(p, count_runs(log, count));
+
+        uint32_t i = 0;
+        while (i < count) {
+            const uint16_t key = log[i] & REPLAY_CODE_KEY_MASK;
+            uint32_t frames = 0;
+            while (i < count && (log[i] & REPLAY_CODE_KEY_MASK) == key) {
+                frames += code_frames(log[i]);
+                i += 1;
+            }
+            p = put_varint(p, key);
+            p = put_varint(p, frames);
+        }
+    }
+
+    *size = (size_t)(p - out);
+    return out;
+}
+
+bool ReplayFormat_DecodeInput(const uint8_t* data, size_t size, uint16_t* codes[2], uint32_t counts[2]) {
+    codes[0] = codes[1] = NULL;
+    counts[0] = counts[1] = 0;
+
+    const uint8_t* end = data + size;
+
+    // Validate and size both streams before allocating
+    const uint8_t* cursor = data;
+    const uint8_t* starts[2];
+    uint64_t totals[2] = { 0, 0 };
+    for (int player = 0; player < 2; player++) {
+        starts[player] = cursor;
+        uint32_t runs;
+        if (!get_varint(&cursor, end, &runs))
+            return false;
+        for (uint32_t r = 0; r < runs; r++) {
+            uint32_t key, frames;
+            if (!get_varint(&cursor, end, &key) || !get_varint(&cursor, end, &frames))
+                return false;
+            if (key > REPLAY_CODE_KEY_MASK || frames == 0)
+                return false;
+            totals[player] += (frames + REPLAY_CODE_MAX_FRAMES - 1) / REPLAY_CODE_MAX_FRAMES;
+            if (totals[player] > UINT32_MAX)
+                return false;
+        }
+    }
+
+    for (int player = 0; player < 2; player++) {
+        if (totals[player] == 0)
+            continue;
+
+        uint16_t* log = malloc(totals[player] * sizeof(uint16_t));
+        if (log == NULL) {
+            free(codes[0]);
+            codes[0] = NULL;
+            counts[0] = 0;
+            return false;
+        }
+
+        cursor = starts[player];
+        uint32_t runs;
+        get_varint(&cursor, end, &runs);
+        uint32_t n = 0;
+        for (uint32_t r = 0; r < runs; r++) {
+            uint32_t key, frames;
+            get_varint(&cursor, end, &key);
+            get_varint(&cursor, end, &frames);
+            while (frames > 0) {
+                const uint32_t chunk = frames < REPLAY_CODE_MAX_FRAMES ? frames : REPLAY_CODE_MAX_FRAMES;
+                log[n++] = (uint16_t)(((chunk - 1) << 12) | key);
+                frames -= chunk;
+            }
+        }
+
+        codes[player] = log;
+        counts[player] = n;
+    }
+
+    return true;
+}
+
+// --- Seeking ---
+
+// Advance one player's position by `frames`
+static void advance(const uint16_t* codes, uint32_t count, uint32_t* code, uint32_t* elapsed, uint32_t frames) {
+    while (*code < count) {
+        const uint32_t left = code_frames(codes[*code]) - *elapsed;
+        if (frames < left) {
+            *elapsed += frames;
+            return;
+        }
+        frames -= left;
+        *code += 1;
+        *elapsed = 0;
+    }
+    *elapsed = 0;
+}
+
+ReplaySeekPoint* ReplayFormat_BuildSeekPoints(const uint16_t* const codes[2], const uint32_t counts[2],
+                                              uint32_t frame_count, size_t* count) {
+    const size_t n = frame_count == 0 ? 0 : (frame_count - 1) / REPLAY_SEEK_INTERVAL + 1;
+    *count = 0;
+    if (n == 0)
+        return NULL;
+
+    ReplaySeekPoint* points = malloc(n * sizeof(ReplaySeekPoint));
+    if (points == NULL)
+        return NULL;
+
+    ReplaySeekPoint at = { 0 };
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0) {
+            for (int player = 0; player < 2; player++) {
+                advance(codes[player], counts[player], &at.code[player], &at.elapsed[player], REPLAY_SEEK_INTERVAL);
+            }
+            at.frame += REPLAY_SEEK_INTERVAL;
+        }
+        points[i] = at;
+    }
+
+    *count = n;
+    return points;
+}
+
+bool ReplayFormat_Seek(const ReplaySeekPoint* points, size_t point_count, const uint16_t* const codes[2],
+                       const uint32_t counts[2], uint32_t frame, ReplaySeekPoint* out) {
+    // Last seek point at or before `frame`
+    ReplaySeekPoint at = { 0 };
+    size_t lo = 0;
+    size_t hi = point_count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (points[mid].frame <= frame) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo > 0) {
+        at = points[lo - 1];
+    }
+
+    for (int player = 0; player < 2; player++) {
+        advance(codes[player], counts[player], &at.code[player], &at.elapsed[player], frame - at.frame);
+    }
+    at.frame = frame;
+
+    *out = at;
+    return at.code[0] < counts[0] || at.code[1] < counts[1];
+}
+
+// --- Files ---
+
+bool ReplayFormat_WriteHeader(FILE* f, const ReplayFileHeader* header) {
+    return fwrite(header, sizeof(*header), 1, f) == 1;
+}
+
+bool ReplayFormat_WriteSection(FILE* f, ReplaySectionType type, uint32_t frame, const void* data, size_t size,
+                               bool compress) {
+    if (size > UINT32_MAX)
+        return false;
+
+    ReplaySectionHeader section = { .type = type, .size = (uint32_t)size, .raw_size = (uint32_t)size, .frame = frame };
+    const void* payload = data;
+    uint8_t* packed = NULL;
+
+    if (compress && size > 0) {
+        // zlib 1.1's documented bound is 0.1% + 12 bytes; leave some slack
+        uLongf packed_size = (uLongf)(size + size / 1000 + 64);
+        packed = malloc(packed_size);
+        if (packed != NULL && compress2(packed, &packed_size, data, (uLong)size, Z_BEST_COMPRESSION) == Z_OK &&
+            packed_size < size) {
+            section.size = (uint32_t)packed_size;
+            payload = packed;
+        }
+    }
+
+    const bool ok = fwrite(&section, sizeof(section), 1, f) == 1 &&
+                    (section.size == 0 || fwrite(payload, section.size, 1, f) == 1);
+    free(packed);
+    return ok;
+}
+
+bool ReplayFormat_ReadHeader(FILE* f, ReplayFileHeader* header) {
+    if (fread(header, sizeof(*header), 1, f) != 1)
+        return false;
+    return header->magic == REPLAY_FILE_MAGIC && header->version == REPLAY_FILE_VERSION;
+}
+
+bool ReplayFormat_NextSection(FILE* f, ReplaySectionHeader* section) {
+    return fread(section, sizeof(*section), 1, f) == 1;
+}
+
+uint8_t* ReplayFormat_ReadPayload(FILE* f, const ReplaySectionHeader* section) {
+    uint8_t* stored = malloc(section->size ? section->size : 1);
+    if (stored == NULL)
+        return NULL;
+    if (section->size > 0 && fread(stored, section->size, 1, f) != 1) {
+        free(stored);
+        return NULL;
+    }
+    if (section->size == section->raw_size)
+        return stored;
+
+    uint8_t* raw = malloc(section->raw_size ? section->raw_size : 1);
+    uLongf raw_size = section->raw_size;
+    if (raw == NULL || uncompress(raw, &raw_size, stored, section->size) != Z_OK || raw_size != section->raw_size) {
+        free(raw);
+        raw = NULL;
+    }
+    free(stored);
+    return raw;
+}
+
+bool ReplayFormat_SkipPayload(FILE* f, const ReplaySectionHeader* section) {
+    return fseek(f, (long)section->size, SEEK_CUR) == 0;
+}
+
+bool ReplayFormat_WriteIndex(FILE* f, const ReplayIndexEntry* entries, uint32_t count, uint32_t next_id) {
+    const ReplayIndexHeader header = {
+        .magic = REPLAY_INDEX_MAGIC, .version = REPLAY_INDEX_VERSION, .count = count, .next_id = next_id
+    };
+    return fwrite(&header, sizeof(header), 1, f) == 1 &&
+           (count == 0 || fwrite(entries, sizeof(ReplayIndexEntry), count, f) == count);
+}
+
+bool ReplayFormat_ReadIndex(FILE* f, ReplayIndexEntry** entries, uint32_t* count, uint32_t* next_id) {
+    *entries = NULL;
+    *count = 0;
+
+    ReplayIndexHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1)
+        return false;
+    if (header.magic != REPLAY_INDEX_MAGIC || header.version != REPLAY_INDEX_VERSION)
+        return false;
+
+    if (header.count > 0) {
+        ReplayIndexEntry* list = malloc((size_t)header.count * sizeof(ReplayIndexEntry));
+        if (list == NULL)
+            return false;
+        if (fread(list, sizeof(ReplayIndexEntry), header.count, f) != header.count) {
+            free(list);
+            return false;
+        }
+        *entries = list;
+    }
+
+    *count = header.count;
+    *next_id = header.next_id;
+    return true;
+}
@@ -0,0 +1,156 @@
+#ifndef REPLAY_FORMAT_H
+#define REPLAY_FORMAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// On-disk layout of a v2 replay (replays/replay_NNNNNN.rpl):
+//
+//   ReplayFileHeader
+//   { ReplaySectionHeader, payload } ...
+//
+// All fields are little-endian. Payloads are deflated when the section's
+// stored size differs from its raw size. Sections:
+//
+//   SETUP     Match setup (characters, RNG seeds, options); packed by
+//             native_save.c, opaque here.
+//   INPUT     Both players' input as runs: per player a varint run count,
+//             then (varint key, varint frames) per run.
+//   INDEX     ReplaySeekPoint every REPLAY_SEEK_INTERVAL frames.
+//   KEYFRAME  A game state snapshot taken at the section's frame.
+//
+// Readers skip section types they don't know, so new sections can be added
+// without a version bump. The header repeats the picker metadata so the
+// replay index can be rebuilt from headers alone.
+//
+// In memory the game keeps the PS2 key_buff code format (see replay_log.h):
+// one u16 per run, the key in the low 12 bits and frames - 1 in the top 4.
+
+#define REPLAY_FILE_MAGIC 0x33535852u // Same magic as v1, told apart by version
+#define REPLAY_FILE_VERSION 2u
+#define REPLAY_FILE_VERSION_V1 1u
+
+#define REPLAY_INDEX_MAGIC 0x58495233u // "3RIX"
+#define REPLAY_INDEX_VERSION 1u
+
+#define REPLAY_SEEK_INTERVAL 600 // Frames between seek points (10 s)
+
+#define REPLAY_CODE_KEY_MASK 0x0FFF
+#define REPLAY_CODE_MAX_FRAMES 16
+
+#define REPLAY_FLAG_KEYFRAMES 0x1u // File has KEYFRAME sections
+
+typedef enum ReplaySectionType {
+    REPLAY_SECTION_SETUP = 1,
+    REPLAY_SECTION_INPUT = 2,
+    REPLAY_SECTION_INDEX = 3,
+    REPLAY_SECTION_KEYFRAME = 4,
+} ReplaySectionType;
+
+// Picker metadata: save date and characters
+typedef struct ReplayMeta {
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t dayofweek;
+    int32_t player[2];
+} ReplayMeta;
+
+typedef struct ReplayFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t frame_count; // Longer of the two players' input streams
+    uint32_t flags;
+    ReplayMeta meta;
+} ReplayFileHeader;
+
+typedef struct ReplaySectionHeader {
+    uint32_t type;     // ReplaySectionType
+    uint32_t size;     // Payload bytes following this header
+    uint32_t raw_size; // Payload bytes once inflated
+    uint32_t frame;    // Frame a KEYFRAME was taken at, 0 otherwise
+} ReplaySectionHeader;
+
+// Position in both players' code logs at a given frame
+typedef struct ReplaySeekPoint {
+    uint32_t frame;
+    uint32_t code[2];    // Index of the code playing at `frame`
+    uint32_t elapsed[2]; // Frames of that code already played
+} ReplaySeekPoint;
+
+// replays/index.bin: a ReplayIndexHeader followed by `count` entries
+typedef struct ReplayIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t next_id; // File number for the next saved replay
+} ReplayIndexHeader;
+
+typedef struct ReplayIndexEntry {
+    uint32_t id; // replay_<id>.rpl
+    uint32_t frame_count;
+    ReplayMeta meta;
+} ReplayIndexEntry;
+
+// --- Input streams ---
+
+// Frames covered by a code log.
+uint32_t ReplayFormat_CountFrames(const uint16_t* codes, uint32_t count);
+
+// Encode both players' code logs into an INPUT payload. Adjacent codes with
+// the same key are merged into one run. Returns a malloc'd buffer and its
+// size in `*size`, or NULL on allocation failure.
+uint8_t* ReplayFormat_EncodeInput(const uint16_t* const codes[2], const uint32_t counts[2], size_t* size);
+
+// Decode an INPUT payload back into code logs, splitting runs at
+// REPLAY_CODE_MAX_FRAMES. `codes[i]` receive malloc'd arrays (NULL when
+// empty). Returns false on corrupt input.
+bool ReplayFormat_DecodeInput(const uint8_t* data, size_t size, uint16_t* codes[2], uint32_t counts[2]);
+
+// --- Seeking ---
+
+// Build the INDEX payload: one point every REPLAY_SEEK_INTERVAL frames up to
+// `frame_count`. Returns a malloc'd array and its length in `*count`.
+ReplaySeekPoint* ReplayFormat_BuildSeekPoints(const uint16_t* const codes[2], const uint32_t counts[2],
+                                              uint32_t frame_count, size_t* count);
+
+// Locate `frame` in both code logs, starting from the closest seek point at
+// or before it. Returns false if `frame` is past the end of both logs.
+bool ReplayFormat_Seek(const ReplaySeekPoint* points, size_t point_count, const uint16_t* const codes[2],
+                       const uint32_t counts[2], uint32_t frame, ReplaySeekPoint* out);
+
+// --- Files ---
+
+bool ReplayFormat_WriteHeader(FILE* f, const ReplayFileHeader* header);
+
+// Write one section, deflating the payload when `compress` is set and it
+// actually shrinks.
+bool ReplayFormat_WriteSection(FILE* f, ReplaySectionType type, uint32_t frame, const void* data, size_t size,
+                               bool compress);
+
+// Read and validate a v2 header. Returns false for anything else, including
+// v1 files (`header->version` tells them apart).
+bool ReplayFormat_ReadHeader(FILE* f, ReplayFileHeader* header);
+
+// Read the next section header. Returns false at the end of the file.
+bool ReplayFormat_NextSection(FILE* f, ReplaySectionHeader* section);
+
+// Read the payload of the section just returned by NextSection, inflating it
+// if needed. Returns a malloc'd buffer of `section->raw_size` bytes (at least
+// one byte), or NULL on corrupt input.
+uint8_t* ReplayFormat_ReadPayload(FILE* f, const ReplaySectionHeader* section);
+
+// Skip the payload of the section just returned by NextSection.
+bool ReplayFormat_SkipPayload(FILE* f, const ReplaySectionHeader* section);
+
+bool ReplayFormat_WriteIndex(FILE* f, const ReplayIndexEntry* entries, uint32_t count, uint32_t next_id);
+
+// Read an index file. `*entries` receives a malloc'd array (NULL when empty).
+bool ReplayFormat_ReadIndex(FILE* f, ReplayIndexEntry** entries, uint32_t* count, uint32_t* next_id);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file replay_log.c
+ * @brief Growable per-player replay input log.
+ */
+#include "port/replay_log.h"
+
+#include <stdlib.h>
+
+#define INITIAL_CAPACITY 4096 // About a minute of busy input
+
+typedef struct ReplayLog {
+    u16* codes;
+    u32 count;
+    u32 capacity;
+} ReplayLog;
+
+static ReplayLog logs[2];
+
+void ReplayLog_Clear(void) {
+    // Keep the allocations for the next recording
+    logs[0].count = 0;
+    logs[1].count = 0;
+}
+
+bool ReplayLog_Push(int player, u16 code) {
+    ReplayLog* log = &logs[player];
+
+    if (log->count == log->capacity) {
+        const u32 capacity = log->capacity ? log->capacity * 2 : INITIAL_CAPACITY;
+        u16* codes = realloc(log->codes, (size_t)capacity * sizeof(u16));
+        if (codes == NULL)
+            return false;
+        log->codes = codes;
+        log->capacity = capacity;
+    }
+
+    log->codes[log->count++] = code;
+    return true;
+}
+
+u32 ReplayLog_Count(int player) {
+    return logs[player].count;
+}
+
+const u16* ReplayLog_Codes(int player) {
+    return logs[player].codes;
+}
+
+void ReplayLog_Adopt(int player, u16* codes, u32 count) {
+    ReplayLog* log = &logs[player];
+    free(log->codes);
+    log->codes = codes;
+    log->count = count;
+    log->capacity = count;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file replay_pacer.c
+ * @brief Tick budgeting for replay fast-forward.
+ */
+#include "port/replay_pacer.h"
+
+#define MAX_CATCH_UP_FRAMES 4    // Longer hitches are dropped rather than replayed as a burst
+#define BUDGET_SHARE 0.9         // Leave headroom for pacing jitter
+#define UNMEASURED_MAX_TICKS 2   // Max-speed ticks before the first measurement
+#define TICK_SMOOTHING 0.125
+
+void ReplayPacer_Reset(ReplayPacer* pacer) {
+    pacer->owed = 0.0;
+    pacer->realtime_owed = 0.0;
+    pacer->tick_ns = 0.0;
+}
+
+static double clamp(double value, double lo, double hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+int ReplayPacer_Plan(ReplayPacer* pacer, int speed, uint64_t elapsed_ns, uint64_t frame_ns, uint64_t render_ns) {
+    if (frame_ns == 0)
+        return 1;
+
+    if (elapsed_ns > frame_ns * MAX_CATCH_UP_FRAMES)
+        elapsed_ns = frame_ns * MAX_CATCH_UP_FRAMES;
+    const double frames = (double)elapsed_ns / (double)frame_ns;
+
+    // Ticks that must run for playback to keep up with the wall clock
+    pacer->realtime_owed += frames;
+    const int realtime_ticks = (int)pacer->realtime_owed;
+
+    // Ticks that fit in one frame next to rendering the last of them
+    int budget_ticks;
+    if (pacer->tick_ns > 0.0) {
+        const double spare = (double)frame_ns * BUDGET_SHARE - (double)render_ns - pacer->tick_ns;
+        budget_ticks = 1 + (spare > 0.0 ? (int)(spare / pacer->tick_ns) : 0);
+    } else {
+        budget_ticks = (speed == REPLAY_PACER_MAX_SPEED) ? UNMEASURED_MAX_TICKS : speed;
+    }
+
+    int ticks;
+    if (speed == REPLAY_PACER_MAX_SPEED) {
+        ticks = budget_ticks;
+    } else {
+        pacer->owed += frames * speed;
+        ticks = (int)pacer->owed;
+        if (ticks > budget_ticks)
+            ticks = budget_ticks;
+    }
+    if (ticks < realtime_ticks)
+        ticks = realtime_ticks;
+    if (ticks < 1)
+        ticks = 1;
+
+    // Only the fractional tick carries over: ticks the budget cut at 8x are
+    // dropped, not made up with a burst once frames get cheap again
+    pacer->owed = (speed == REPLAY_PACER_MAX_SPEED) ? 0.0 : clamp(pacer->owed - ticks, 0.0, pacer->owed - (int)pacer->owed);
+    pacer->realtime_owed = clamp(pacer->realtime_owed - ticks, 0.0, 1.0);
+    return ticks;
+}
+
+void ReplayPacer_ReportTicks(ReplayPacer* pacer, int ticks, uint64_t elapsed_ns) {
+    if (ticks <= 0)
+        return;
+
+    const double per_tick = (double)elapsed_ns / ticks;
+    if (pacer->tick_ns <= 0.0) {
+        pacer->tick_ns = per_tick;
+    } else {
+        pacer->tick_ns += (per_tick - pacer->tick_ns) * TICK_SMOOTHING;
+    }
+}
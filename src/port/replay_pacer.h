@@ -0,0 +1,31 @@
+#ifndef REPLAY_PACER_H
+#define REPLAY_PACER_H
+
+#include <stdint.h>
+
+// Decides how many game ticks a displayed frame runs during replay
+// fast-forward (see port/replay_viewer.h). All but the last tick are
+// logic-only; the count follows the chosen speed but is capped by what fits
+// in the frame budget, and never falls below what keeps playback at real
+// time when the machine can't render every frame.
+
+#define REPLAY_PACER_MAX_SPEED 0 // Speed value for "as fast as the frame budget allows"
+
+typedef struct ReplayPacer {
+    double owed;          // Ticks owed to the wall clock at the chosen speed
+    double realtime_owed; // Ticks owed to the wall clock at 1x
+    double tick_ns;       // Smoothed cost of one logic-only tick, 0 until measured
+} ReplayPacer;
+
+void ReplayPacer_Reset(ReplayPacer* pacer);
+
+// Plan the next displayed frame. `speed` is ticks per frame time (or
+// REPLAY_PACER_MAX_SPEED), `elapsed_ns` the wall time since the previous
+// plan, `render_ns` the CPU cost of rendering and presenting a frame.
+// Returns the total tick count, always >= 1.
+int ReplayPacer_Plan(ReplayPacer* pacer, int speed, uint64_t elapsed_ns, uint64_t frame_ns, uint64_t render_ns);
+
+// Report how long `ticks` logic-only ticks took.
+void ReplayPacer_ReportTicks(ReplayPacer* pacer, int ticks, uint64_t elapsed_ns);
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * @file replay_viewer.c
+ * @brief Fast-forward, pause and frame step for replay playback.
+ *
+ * Replay input is consumed once per game tick in njUserMain, so
+ * fast-forward has to run whole ticks rather than the inner sysFF loop of
+ * Game_Task. Pause holds whole ticks as well, like the menu pause: the debug
+ * pause (Game_pause bit 7) freezes the fight but keeps reading replay input,
+ * which would desync playback.
+ */
+#include "port/replay_viewer.h"
+#include "port/replay_pacer.h"
+#include "port/sdl/sdl_app.h"
+#include "port/sound/adx.h"
+#include "sf33rd/AcrSDK/ps2/flps2debug.h"
+#include "sf33rd/Source/Game/engine/workuser.h"
+#include <SDL3/SDL.h>
+
+extern bool game_paused;
+
+static const int speed_ticks[REPLAY_VIEWER_SPEED_COUNT] = { 1, 2, 4, 8, REPLAY_PACER_MAX_SPEED };
+static const char* const speed_labels[REPLAY_VIEWER_SPEED_COUNT] = { "x1", "x2", "x4", "x8", "MAX" };
+
+// Requests from the main thread
+static SDL_AtomicInt requested_speed;
+static SDL_AtomicInt pause_toggles;
+static SDL_AtomicInt step_requests;
+
+// Game thread
+static bool engaged = false; // Viewer state has been touched since the replay started
+static bool paused = false;
+static ReplayPacer pacer;
+static Uint64 last_frame_ns = 0;
+
+bool ReplayViewer_IsActive(void) {
+    return Mode_Type == MODE_REPLAY && Play_Mode == 3;
+}
+
+void ReplayViewer_ChangeSpeed(int direction) {
+    if (!ReplayViewer_IsActive())
+        return;
+
+    const int speed = SDL_clamp(SDL_GetAtomicInt(&requested_speed) + direction, 0, REPLAY_VIEWER_SPEED_COUNT - 1);
+    SDL_SetAtomicInt(&requested_speed, speed);
+    SDL_Log("Replay: speed %s", speed_labels[speed]);
+}
+
+void ReplayViewer_TogglePause(void) {
+    if (ReplayViewer_IsActive()) {
+        SDL_AddAtomicInt(&pause_toggles, 1);
+    }
+}
+
+void ReplayViewer_Step(void) {
+    if (ReplayViewer_IsActive()) {
+        SDL_AddAtomicInt(&step_requests, 1);
+    }
+}
+
+static void reset(void) {
+    SDL_SetAtomicInt(&requested_speed, REPLAY_VIEWER_SPEED_1X);
+    SDL_SetAtomicInt(&pause_toggles, 0);
+    SDL_SetAtomicInt(&step_requests, 0);
+    if (paused) {
+        ADX_SetHeld(game_paused);
+    }
+    paused = false;
+    engaged = false;
+    ReplayPacer_Reset(&pacer);
+    last_frame_ns = 0;
+}
+
+bool ReplayViewer_BeginFrame(void (*logic_tick)(void)) {
+    if (!ReplayViewer_IsActive()) {
+        if (engaged) {
+            reset();
+        }
+        return true;
+    }
+    engaged = true;
+
+    if (SDL_SetAtomicInt(&pause_toggles, 0) & 1) {
+        paused = !paused;
+        SDL_SetAtomicInt(&step_requests, 0);
+        ADX_SetHeld(paused || game_paused);
+
+        // The frame that pauses still ticks once so it shows the indicator
+        if (paused)
+            return true;
+    }
+
+    const Uint64 now = SDL_GetTicksNS();
+    const Uint64 elapsed = last_frame_ns ? now - last_frame_ns : SDLApp_GetTargetFrameTimeNS();
+    last_frame_ns = now;
+
+    if (paused) {
+        // Frame step: one presented tick per request
+        const int steps = SDL_GetAtomicInt(&step_requests);
+        if (steps > 0) {
+            SDL_AddAtomicInt(&step_requests, -1);
+            return true;
+        }
+        return false;
+    }
+
+    // The in-replay pause menu runs at normal speed
+    if (Game_pause == 0x81)
+        return true;
+
+    const int speed = SDL_GetAtomicInt(&requested_speed);
+    const int ticks = ReplayPacer_Plan(
+        &pacer, speed_ticks[speed], elapsed, SDLApp_GetTargetFrameTimeNS(), SDLApp_GetLastRenderWorkNS());
+    if (ticks <= 1)
+        return true;
+
+    const Uint64 start = SDL_GetTicksNS();
+    int ran = 0;
+    while (ran < ticks - 1 && ReplayViewer_IsActive()) {
+        logic_tick();
+        ran += 1;
+    }
+    ReplayPacer_ReportTicks(&pacer, ran, SDL_GetTicksNS() - start);
+    return true;
+}
+
+void ReplayViewer_DrawStatus(void) {
+    if (!engaged || !ReplayViewer_IsActive())
+        return;
+
+    const int speed = SDL_GetAtomicInt(&requested_speed);
+    if (!paused && speed == REPLAY_VIEWER_SPEED_1X)
+        return;
+
+    flPrintColor(0xFFFFFFFF);
+    if (paused) {
+        flPrintL(40, 1, "PAUSE");
+    } else {
+        flPrintL(40, 1, ">> %s", speed_labels[speed]);
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "port/sdl/sdl_app.h"
 #include "port/sdl/training_menu.h"
+#include "sf33rd/Source/Game/training/training_fork.h"
 #include "sf33rd/Source/Game/training/training_state.h"
 
 #include <deque>
@@ -92,8 +93,103 @@ static void build_stats_string(char* buf, size_t buf_sz, const TrainingPlayerSta
     }
 }
 
+// One line of the lookahead's answer for a dummy behaviour, e.g. "Hit on F5 / Advantage +3".
+static void build_prediction_string(char* buf, size_t buf_sz, const char* label, const TrainingForkBranch& b) {
+    char tmp[64];
+
+    switch (b.outcome) {
+    case FORK_OUTCOME_PENDING:
+        snprintf(buf, buf_sz, "%s ...", label);
+        return;
+    case FORK_OUTCOME_UNRESOLVED:
+        snprintf(buf, buf_sz, "%s --", label);
+        return;
+    case FORK_OUTCOME_WHIFF:
+        snprintf(buf, buf_sz, "%s Whiff", label);
+        break;
+    case FORK_OUTCOME_HIT:
+        snprintf(buf, buf_sz, "%s Hit on F%d", label, (int)b.connect_frame);
+        break;
+    case FORK_OUTCOME_BLOCK:
+        snprintf(buf, buf_sz, "%s Blocked on F%d", label, (int)b.connect_frame);
+        break;
+    }
+
+    if (!b.resolved || b.outcome == FORK_OUTCOME_WHIFF)
+        return;
+
+    snprintf(tmp, sizeof(tmp), " / Advantage %+d", (int)b.advantage);
+    strncat(buf, tmp, buf_sz - strlen(buf) - 1);
+
+    if (b.punish_window > 0) {
+        snprintf(tmp, sizeof(tmp), " / Punish %dF", (int)b.punish_window);
+        strncat(buf, tmp, buf_sz - strlen(buf) - 1);
+    }
+}
+
+static ImVec4 get_color_for_prediction(const TrainingForkBranch& b) {
+    if (b.resolved && b.outcome != FORK_OUTCOME_WHIFF && b.advantage > 0)
+        return ImVec4(0.4f, 1.0f, 0.4f, 1.0f);
+    if (b.resolved && b.outcome != FORK_OUTCOME_WHIFF && b.advantage < 0)
+        return ImVec4(1.0f, 0.35f, 0.35f, 1.0f);
+    return ImVec4(1.0f, 1.0f, 1.0f, 0.9f);
+}
+
+// The forked-simulation results for the last move, just below where the frame meter sits.
+static void render_prediction() {
+    if (!g_training_fork.active)
+        return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    SDL_FRect game_rect = get_letterbox_rect((int)io.DisplaySize.x, (int)io.DisplaySize.y);
+
+    float scale = game_rect.h / 480.0f;
+    if (scale <= 0.1f)
+        scale = 0.1f;
+
+    float padding = 2.0f * scale;
+    float text_font_scale = scale * 1.8f;
+    float orig_scale = io.FontGlobalScale;
+    io.FontGlobalScale = text_font_scale;
+    float text_height = ImGui::GetTextLineHeight();
+
+    // Below the meter: two text lines and two 4px bars with five paddings
+    float meter_height = padding * 5.0f + text_height * 2.0f + 8.0f * scale;
+    ImVec2 window_pos(game_rect.x + padding, game_rect.y + 64.0f * scale + meter_height + padding);
+
+    ImGui::SetNextWindowPos(window_pos, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.7f);
+
+    if (ImGui::Begin("Prediction",
+                     nullptr,
+                     ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove |
+                         ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoInputs |
+                         ImGuiWindowFlags_AlwaysAutoResize)) {
+        char label[32];
+        char line[128];
+        const char* attacker = (g_training_fork.attacker == 0) ? "P1" : "P2";
+
+        snprintf(label, sizeof(label), "%s vs no block:", attacker);
+        build_prediction_string(line, sizeof(line), label, g_training_fork.branch[FORK_BRANCH_NO_BLOCK]);
+        ImGui::TextColored(get_color_for_prediction(g_training_fork.branch[FORK_BRANCH_NO_BLOCK]), "%s", line);
+
+        snprintf(label, sizeof(label), "%s vs block:", attacker);
+        build_prediction_string(line, sizeof(line), label, g_training_fork.branch[FORK_BRANCH_BLOCK]);
+        ImGui::TextColored(get_color_for_prediction(g_training_fork.branch[FORK_BRANCH_BLOCK]), "%s", line);
+    }
+
+    ImGui::End();
+    io.FontGlobalScale = orig_scale;
+}
+
 void frame_display_render() {
-    if (!g_training_menu_settings.show_frame_meter || show_training_menu)
+    if (show_training_menu)
+        return;
+
+    if (g_training_menu_settings.show_advantage)
+        render_prediction();
+
+    if (!g_training_menu_settings.show_frame_meter)
         return;
 
     s32 current_frame = g_training_state.frame_number;
@@ -14,6 +14,7 @@
 #include "port/broadcast.h"
 #include "port/config.h"
 #include "port/modded_stage.h"
+#include "port/recorder.h"
 #include "port/sdl/control_mapping.h"
 #include "port/sdl/frame_display.h"
 #include "port/sdl/imgui_wrapper.h"
@@ -23,7 +24,9 @@
 #include "port/sdl/sdl_app_input.h"
 #include "port/sdl/sdl_app_internal.h"
 #include "port/sdl/sdl_app_shader_config.h"
+#include "port/sdl/sdl_frame_pacer.h"
 #include "port/sdl/sdl_netplay_ui.h"
+#include "port/sdl/sdl_render_pipeline.h"
 #include "port/sdl/sdl_texture_util.h"
 #include "port/sdl/shader_menu.h"
 #include "port/sdl/stage_config_menu.h"
@@ -205,7 +208,6 @@ static SDL_GPUTransferBuffer* s_bezel_transfer_buffer = NULL;
 
 static ScaleMode scale_mode = SCALEMODE_NEAREST;
 
-static Uint64 frame_deadline = 0;
 static Uint64 frame_end_times[FRAME_END_TIMES_MAX];
 static int frame_end_times_index = 0;
 static bool frame_end_times_filled = false;
@@ -227,6 +229,10 @@ bool game_paused = false;
 static bool frame_rate_uncapped = false;
 static bool vsync_enabled = true; // user preference, independent of frame_rate_uncapped
 static bool present_only_mode = false; // when true, EndFrame re-blits canvas without re-rendering game
+static bool pipelined_frame = false;   // when true, logic runs on the pipeline thread (pad handled there)
+static Uint64 end_frame_start_ns = 0;
+static Uint64 present_wait_ns = 0;   // Time blocked in swap/present this frame
+static Uint64 render_work_ns = 0;    // EndFrame CPU work, excluding present and pacer waits
 bool show_debug_hud = false;
 
 // FPS history — unbounded, grows since game start
@@ -433,6 +439,21 @@ static void ShutdownBezelGPU() {
         SDL_ReleaseGPUTransferBuffer(gpu_device, s_bezel_transfer_buffer);
 }
 
+/** @brief True if the SDL_GPU scene shaders were built; they need glslc or glslangValidator at build time. */
+static bool gpu_shaders_available() {
+    static const char* const names[] = { "scene_indexed.vert.spv", "scene_indexed.frag.spv" };
+    const char* base_path = SDL_GetBasePath();
+    char path[1024];
+
+    for (size_t i = 0; i < SDL_arraysize(names); i++) {
+        snprintf(path, sizeof(path), "%sshaders/%s", base_path ? base_path : "", names[i]);
+        if (!SDL_GetPathInfo(path, NULL)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /** @brief Initialize SDL3, create window + GL context, compile shaders, load config. */
 int SDLApp_Init() {
     Config_Init();
@@ -451,6 +472,11 @@ int SDLApp_Init() {
     SDL_SetHint(SDL_HINT_VIDEO_WAYLAND_PREFER_LIBDECOR, "1");
     SDL_SetHint(SDL_HINT_NO_SIGNAL_HANDLERS, "1");
 
+    if (g_renderer_backend == RENDERER_SDLGPU && !gpu_shaders_available()) {
+        SDL_Log("SDL_GPU shaders were not built with this copy, falling back to OpenGL");
+        g_renderer_backend = RENDERER_OPENGL;
+    }
+
     if (g_renderer_backend == RENDERER_OPENGL) {
 #ifdef PLATFORM_RPI4
         SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
@@ -684,6 +710,8 @@ int SDLApp_Init() {
 
     SDL_free(base_path);
 
+    SDLFramePacer_Init();
+
     return 0;
 }
 
@@ -691,7 +719,10 @@ extern BroadcastConfig broadcast_config;
 
 /** @brief Shut down SDL, release shaders, destroy window. */
 void SDLApp_Quit() {
+    SDLFramePacer_LogStats();
+    Recorder_Stop();
     Broadcast_Shutdown();
+    LobbyServer_Shutdown();
     SDLGameRenderer_Shutdown();
     SDLTextRenderer_Shutdown();
 
@@ -1020,6 +1051,8 @@ static /** @brief Build NDC vertices for a bezel quad from an SDL_FRect. */
 /** @brief End the frame: render game to FBO, apply shaders, draw bezels/UI, swap buffers. */
 void SDLApp_EndFrame() {
     TRACE_ZONE_N("EndFrame");
+    end_frame_start_ns = SDL_GetTicksNS();
+    present_wait_ns = 0;
     Broadcast_Update();
 
     // Render all queued tasks to the FBO (skip in present-only mode — canvas already has last frame)
@@ -1032,10 +1065,6 @@ void SDLApp_EndFrame() {
 
     if (g_renderer_backend == RENDERER_SDL2D) {
         // --- SDL2D Backend ---
-        if (!game_paused && !present_only_mode) {
-            ADX_ProcessTracks();
-        }
-
         SDL_SetRenderTarget(sdl_renderer, NULL);
 
         const SDL_FRect dst_rect = get_letterbox_rect(win_w, win_h);
@@ -1053,62 +1082,43 @@ void SDLApp_EndFrame() {
             float base_x = dst_rect.x + (10.0f * overlay_scale);
             float base_y = dst_rect.y + (2.0f * overlay_scale);
 
-            SDLTextRenderer_DrawText(
-                debug_text, base_x - 1, base_y - 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-            SDLTextRenderer_DrawText(
-                debug_text, base_x, base_y - 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-            SDLTextRenderer_DrawText(
-                debug_text, base_x + 1, base_y - 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-
-            SDLTextRenderer_DrawText(
-                debug_text, base_x - 1, base_y, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-            SDLTextRenderer_DrawText(
-                debug_text, base_x + 1, base_y, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-
-            SDLTextRenderer_DrawText(
-                debug_text, base_x - 1, base_y + 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-            SDLTextRenderer_DrawText(
-                debug_text, base_x, base_y + 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-            SDLTextRenderer_DrawText(
-                debug_text, base_x + 1, base_y + 1, overlay_scale, 0.0f, 0.0f, 0.0f, (float)win_w, (float)win_h);
-
-            SDLTextRenderer_DrawText(
-                debug_text, base_x, base_y, overlay_scale, 1.0f, 1.0f, 1.0f, (float)win_w, (float)win_h);
+            SDLTextRenderer_DrawTextStyled(debug_text,
+                                           base_x,
+                                           base_y,
+                                           overlay_scale,
+                                           1.0f,
+                                           1.0f,
+                                           1.0f,
+                                           TEXT_STYLE_OUTLINE,
+                                           (float)win_w,
+                                           (float)win_h);
             SDLTextRenderer_Flush();
         }
 
+        SDLRenderPipeline_ReleaseKick();
+        const Uint64 present_start = SDL_GetTicksNS();
         SDL_RenderPresent(sdl_renderer);
+        present_wait_ns = SDL_GetTicksNS() - present_start;
+        if (vsync_enabled) {
+            SDLFramePacer_NotePresent(present_start, present_start + present_wait_ns);
+        }
 
         SDLGameRenderer_EndFrame();
         hide_cursor_if_needed();
 
         // Frame pacing
         Uint64 now = SDL_GetTicksNS();
+        render_work_ns = now - end_frame_start_ns - present_wait_ns;
         if (!frame_rate_uncapped) {
-            if (frame_deadline == 0) {
-                frame_deadline = now + target_frame_time_ns;
-            }
-            if (now < frame_deadline) {
-                Uint64 sleep_time = frame_deadline - now;
-                const Uint64 spin_threshold_ns = 2000000;
-                if (sleep_time > spin_threshold_ns) {
-                    SDL_DelayNS(sleep_time - spin_threshold_ns);
-                }
-                while (SDL_GetTicksNS() < frame_deadline) {
-                    SDL_CPUPauseInstruction();
-                }
-                now = SDL_GetTicksNS();
-            }
-            frame_deadline += target_frame_time_ns;
-            if (now > frame_deadline + target_frame_time_ns) {
-                frame_deadline = now + target_frame_time_ns;
-            }
+            now = SDLFramePacer_Wait(target_frame_time_ns);
         }
 
         frame_counter += 1;
         note_frame_end_time();
         update_fps();
-        SDLPad_UpdatePreviousState();
+        if (!pipelined_frame) {
+            SDLPad_UpdatePreviousState();
+        }
         TRACE_ZONE_END();
         return;
     }
@@ -1380,8 +1390,8 @@ void SDLApp_EndFrame() {
             SDLTextRenderer_SetBackgroundEnabled(1);
             SDLTextRenderer_SetBackgroundColor(0.0f, 0.0f, 0.0f, 0.5f);
 
-            SDLTextRenderer_DrawText(debug_text, base_x + 1, base_y + 1, overlay_scale, 0.0f, 0.0f, 0.0f, win_w, win_h);
-            SDLTextRenderer_DrawText(debug_text, base_x, base_y, overlay_scale, 1.0f, 1.0f, 1.0f, win_w, win_h);
+            SDLTextRenderer_DrawTextStyled(
+                debug_text, base_x, base_y, overlay_scale, 1.0f, 1.0f, 1.0f, TEXT_STYLE_SHADOW, win_w, win_h);
 
             SDLTextRenderer_SetBackgroundEnabled(0);
         }
@@ -1390,12 +1400,14 @@ void SDLApp_EndFrame() {
         SDLTextRenderer_Flush();
 
     gpu_end_frame_submit:; // empty statement after label for C compliance
+        SDLRenderPipeline_ReleaseKick();
 
     } else {
         // --- OpenGL Backend ---
         if (broadcast_config.enabled && broadcast_config.source == BROADCAST_SOURCE_NATIVE) {
             Broadcast_Send(cps3_canvas_texture, 384, 224, true);
         }
+        Recorder_CaptureFrameGL(cps3_canvas_texture, 384, 224);
 
         // Get window dimensions and set viewport for final blit
         int win_w, win_h;
@@ -1759,12 +1771,15 @@ void SDLApp_EndFrame() {
             SDLTextRenderer_SetBackgroundEnabled(1);
             SDLTextRenderer_SetBackgroundColor(0.0f, 0.0f, 0.0f, 0.5f);
 
-            SDLTextRenderer_DrawText(debug_text, base_x + 1, base_y + 1, overlay_scale, 0.0f, 0.0f, 0.0f, win_w, win_h);
-            SDLTextRenderer_DrawText(debug_text, base_x, base_y, overlay_scale, 1.0f, 1.0f, 1.0f, win_w, win_h);
+            SDLTextRenderer_DrawTextStyled(
+                debug_text, base_x, base_y, overlay_scale, 1.0f, 1.0f, 1.0f, TEXT_STYLE_SHADOW, win_w, win_h);
 
             SDLTextRenderer_SetBackgroundEnabled(0);
         }
 
+        // All overlay text of the frame in one draw
+        SDLTextRenderer_Flush();
+
         if (g_training_menu_settings.show_inputs) {
             input_display_render();
         }
@@ -1836,7 +1851,13 @@ void SDLApp_EndFrame() {
 
         // Swap the window to display the final rendered frame
         TRACE_SUB_BEGIN("SwapWindow");
+        SDLRenderPipeline_ReleaseKick();
+        const Uint64 swap_start = SDL_GetTicksNS();
         SDL_GL_SwapWindow(window);
+        present_wait_ns = SDL_GetTicksNS() - swap_start;
+        if (vsync_enabled) {
+            SDLFramePacer_NotePresent(swap_start, swap_start + present_wait_ns);
+        }
         TRACE_SUB_END();
     }
     TRACE_GPU_COLLECT();
@@ -1844,14 +1865,6 @@ void SDLApp_EndFrame() {
     // Now that the frame is displayed, clean up resources for the next frame
     SDLGameRenderer_EndFrame();
 
-    // Run sound processing — after GPU submit so CPU audio decode
-    // overlaps with GPU processing the submitted command buffer.
-    TRACE_SUB_BEGIN("AudioProcess");
-    if (!game_paused && !present_only_mode) {
-        ADX_ProcessTracks();
-    }
-    TRACE_SUB_END();
-
     if (should_save_screenshot) {
         save_screenshot("screenshot.bmp");
         should_save_screenshot = false;
@@ -1862,36 +1875,12 @@ void SDLApp_EndFrame() {
 
     // Do frame pacing (skipped when uncapped for benchmarking)
     Uint64 now = SDL_GetTicksNS();
+    render_work_ns = now - end_frame_start_ns - present_wait_ns;
     TRACE_SUB_BEGIN("FramePacing");
 
     if (!frame_rate_uncapped) {
-        if (frame_deadline == 0) {
-            frame_deadline = now + target_frame_time_ns;
-        }
-
-        if (now < frame_deadline) {
-            Uint64 sleep_time = frame_deadline - now;
-            // ⚡ Bolt: Hybrid sleep+spin — kernel timer jitter on RPi4 is 1-4ms.
-            // Sleep for the bulk, then spin-wait for the final 2ms to hit
-            // the deadline precisely. Eliminates ~2ms frame-time jitter.
-            const Uint64 spin_threshold_ns = 2000000; // 2ms
-            if (sleep_time > spin_threshold_ns) {
-                SDL_DelayNS(sleep_time - spin_threshold_ns);
-            }
-            // Spin-wait for remaining time — SDL_CPUPauseInstruction emits
-            // 'yield' on ARM (reduces power/heat) or 'pause' on x86.
-            while (SDL_GetTicksNS() < frame_deadline) {
-                SDL_CPUPauseInstruction();
-            }
-            now = SDL_GetTicksNS();
-        }
-
-        frame_deadline += target_frame_time_ns;
-
-        // If we fell behind by more than one frame, resync to avoid spiraling
-        if (now > frame_deadline + target_frame_time_ns) {
-            frame_deadline = now + target_frame_time_ns;
-        }
+        // Absolute-deadline sleep; spins only for the measured wake-up jitter
+        now = SDLFramePacer_Wait(target_frame_time_ns);
     }
     TRACE_SUB_END();
 
@@ -1899,10 +1888,23 @@ void SDLApp_EndFrame() {
     frame_counter += 1;
     note_frame_end_time();
     update_fps();
-    SDLPad_UpdatePreviousState();
+    if (!pipelined_frame) {
+        SDLPad_UpdatePreviousState();
+    }
     TRACE_ZONE_END();
 }
 
+/** @brief Mark the next EndFrame as pipelined: its logic ran on the pipeline thread
+ *  and the caller updates pad edge state itself. */
+void SDLApp_SetPipelinedFrame(bool pipelined) {
+    pipelined_frame = pipelined;
+}
+
+/** @brief CPU time the last EndFrame spent rendering, excluding present and pacer waits. */
+Uint64 SDLApp_GetLastRenderWorkNS(void) {
+    return render_work_ns;
+}
+
 /** @brief Request application exit. */
 void SDLApp_Exit() {
     SDL_Event quit_event;
@@ -1973,6 +1975,12 @@ void SDLApp_LoadPreset(int index) {
     SDLAppShader_LoadPreset(index);
 }
 
+float SDLApp_GetShaderGPUTimeMs() {
+    if (!SDLAppShader_IsLibretroMode())
+        return -1.0f;
+    return LibrashaderManager_GetGPUTimeMs(SDLAppShader_GetManager());
+}
+
 void SDLApp_SetWindowPosition(int x, int y) {
     g_cli_window_x = x;
     g_cli_window_y = y;
@@ -2010,6 +2018,7 @@ SDL_Window* SDLApp_GetWindow(void) {
 void SDLApp_ToggleMenu() {
     show_menu = !show_menu;
     game_paused = show_menu;
+    ADX_SetHeld(game_paused);
     if (show_menu) {
         SDL_ShowCursor();
     }
@@ -2018,6 +2027,7 @@ void SDLApp_ToggleMenu() {
 void SDLApp_ToggleModsMenu() {
     show_mods_menu = !show_mods_menu;
     game_paused = show_mods_menu || show_menu;
+    ADX_SetHeld(game_paused);
     if (show_mods_menu) {
         SDL_ShowCursor();
     }
@@ -2026,6 +2036,7 @@ void SDLApp_ToggleModsMenu() {
 void SDLApp_ToggleShaderMenu() {
     show_shader_menu = !show_shader_menu;
     game_paused = show_shader_menu || show_menu;
+    ADX_SetHeld(game_paused);
     if (show_shader_menu) {
         SDL_ShowCursor();
     }
@@ -2145,7 +2156,7 @@ void SDLApp_ToggleFrameRateUncap() {
     // When uncapped + VSync OFF: full speed benchmarking (no pacer, no vsync)
 
     // Reset frame deadline so the pacer doesn't spiral on re-enable
-    frame_deadline = 0;
+    SDLFramePacer_Reset();
 
     SDL_Log("Frame rate %s", frame_rate_uncapped ? "UNCAPPED" : "capped (59.6 FPS)");
 }
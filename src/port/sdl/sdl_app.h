@@ -26,6 +26,10 @@ void SDLApp_PresentOnly(void);
 Uint64 SDLApp_GetTargetFrameTimeNS(void);
 bool SDLApp_IsFrameRateUncapped(void);
 
+// Render pipeline (see sdl_render_pipeline.h)
+void SDLApp_SetPipelinedFrame(bool pipelined);
+Uint64 SDLApp_GetLastRenderWorkNS(void);
+
 unsigned int SDLApp_GetPassthruShaderProgram();
 unsigned int SDLApp_GetSceneShaderProgram();
 unsigned int SDLApp_GetSceneArrayShaderProgram();
@@ -44,6 +48,8 @@ void SDLApp_SetCurrentPresetIndex(int index);
 int SDLApp_GetAvailablePresetCount();
 const char* SDLApp_GetPresetName(int index);
 void SDLApp_LoadPreset(int index);
+/// GPU time of the active Libretro preset in ms, or -1 when not measured.
+float SDLApp_GetShaderGPUTimeMs();
 
 // CLI / Config Accessors
 void SDLApp_SetWindowPosition(int x, int y);
@@ -10,6 +10,8 @@
 #include "netplay/netplay.h"
 #include "port/config.h"
 #include "port/modded_stage.h"
+#include "port/recorder.h"
+#include "port/replay_viewer.h"
 #include "port/sdl/control_mapping.h"
 #include "port/sdl/imgui_wrapper.h"
 #include "port/sdl/input_display.h"
@@ -41,11 +43,17 @@ static void handle_shader_menu_toggle(SDL_KeyboardEvent* event) {
 }
 
 static void set_screenshot_flag_if_needed(SDL_KeyboardEvent* event) {
-    if ((event->key == SDLK_GRAVE) && event->down && !event->repeat) {
+    if ((event->key == SDLK_GRAVE) && !(event->mod & SDL_KMOD_SHIFT) && event->down && !event->repeat) {
         SDLApp_SaveScreenshot();
     }
 }
 
+static void handle_recording_toggle(SDL_KeyboardEvent* event) {
+    if ((event->key == SDLK_GRAVE) && (event->mod & SDL_KMOD_SHIFT) && event->down && !event->repeat) {
+        Recorder_Toggle();
+    }
+}
+
 static void handle_fullscreen_toggle(SDL_KeyboardEvent* event) {
     const bool is_alt_enter = (event->key == SDLK_RETURN) && (event->mod & SDL_KMOD_ALT);
     const bool is_f11 = (event->key == SDLK_F11);
@@ -62,6 +70,31 @@ static void handle_scale_mode_toggle(SDL_KeyboardEvent* event) {
     }
 }
 
+static void handle_replay_controls(SDL_KeyboardEvent* event) {
+    if (!event->down || !ReplayViewer_IsActive())
+        return;
+
+    // Step and speed changes auto-repeat while held
+    switch (event->key) {
+    case SDLK_SPACE:
+        if (!event->repeat) {
+            ReplayViewer_TogglePause();
+        }
+        break;
+    case SDLK_PERIOD:
+        ReplayViewer_Step();
+        break;
+    case SDLK_LEFTBRACKET:
+        ReplayViewer_ChangeSpeed(-1);
+        break;
+    case SDLK_RIGHTBRACKET:
+        ReplayViewer_ChangeSpeed(1);
+        break;
+    default:
+        break;
+    }
+}
+
 bool SDLAppInput_HandleEvent(SDL_Event* event) {
     bool request_quit = false;
 
@@ -77,8 +110,10 @@ bool SDLAppInput_HandleEvent(SDL_Event* event) {
             handle_shader_menu_toggle(&event->key);
             handle_mods_menu_toggle(&event->key);
             set_screenshot_flag_if_needed(&event->key);
+            handle_recording_toggle(&event->key);
             handle_fullscreen_toggle(&event->key);
             handle_scale_mode_toggle(&event->key);
+            handle_replay_controls(&event->key);
 
             if (event->key.key == SDLK_F7 && event->key.down && !event->key.repeat) {
                 SDLApp_ToggleTrainingMenu();
@@ -113,6 +148,7 @@ bool SDLAppInput_HandleEvent(SDL_Event* event) {
         // SDL2D mode: handle essential keys that don't require ImGui/shader subsystems
         if (event->type == SDL_EVENT_KEY_DOWN) {
             handle_fullscreen_toggle(&event->key);
+            handle_replay_controls(&event->key);
             if (event->key.key == SDLK_F5 && event->key.down && !event->key.repeat) {
                 if (!Netplay_IsEnabled()) {
                     SDLApp_ToggleFrameRateUncap();
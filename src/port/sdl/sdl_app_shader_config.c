@@ -5,6 +5,13 @@
  * Manages librashader preset scanning, loading, and runtime switching.
  * Supports both built-in and libretro-format shader presets with
  * recursive directory scanning. Split from sdl_app.c for modularity.
+ *
+ * On the OpenGL backend a preset switch is compiled first on a worker thread
+ * with its own shared context while the current preset keeps rendering. The
+ * worker's throwaway filter chain fills librashader's program cache (and the
+ * driver's), so the render-thread instantiation that follows mostly loads
+ * binaries. The chain itself can't be handed over: framebuffers and vertex
+ * arrays are per-context objects.
  */
 #include "port/sdl/sdl_app_shader_config.h"
 #include "port/config.h"
@@ -12,6 +19,7 @@
 #include "port/sdl/sdl_app_config.h"
 #include "port/sdl/sdl_app_internal.h"
 #include <SDL3/SDL.h>
+#include <glad/gl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,6 +33,24 @@ static bool shader_mode_libretro = false;
 static char* g_base_path =
     NULL; // Owned reference (strdup'd or managed elsewhere? In sdl_app it was a pointer to SDL_GetBasePath result)
 
+typedef enum PrecompileState {
+    PRECOMPILE_IDLE,
+    PRECOMPILE_RUNNING,
+    PRECOMPILE_DONE,
+    PRECOMPILE_UNAVAILABLE, // The worker couldn't use its context and has exited
+} PrecompileState;
+
+// Background compile worker (OpenGL only)
+static SDL_Thread* precompile_thread = NULL;
+static SDL_Semaphore* precompile_sem = NULL;
+static SDL_Window* precompile_window = NULL; // Hidden 1x1 window the worker's context is current on
+static SDL_GLContext precompile_context = NULL;
+static SDL_AtomicInt precompile_state;
+static SDL_AtomicInt precompile_quit;
+static char precompile_path[1024];
+static int precompile_index = -1;
+static Uint64 precompile_ms = 0;
+
 // Recursive scanner helper
 static void scan_presets_recursive(const char* base_path, const char* relative_path, char*** list, int* count,
                                    int* capacity) {
@@ -94,6 +120,17 @@ static int compare_strings(const void* a, const void* b) {
     return strcmp(*(const char**)a, *(const char**)b);
 }
 
+static void build_preset_path(int index, char* out, size_t size) {
+    snprintf(out, size, "%s%s/%s", g_base_path, "shaders/libretro", available_presets[index]);
+
+    // Normalize path separators
+    for (int i = 0; out[i]; i++) {
+        if (out[i] == '\\') {
+            out[i] = '/';
+        }
+    }
+}
+
 static void load_preset_internal(int index) {
     SDL_Log("load_preset called with index %d", index);
     if (index < 0 || index >= available_preset_count) {
@@ -108,6 +145,27 @@ static void load_preset_internal(int index) {
 
     SDL_Log("Loading preset name: %s", available_presets[index]);
 
+    if (!g_base_path) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "g_base_path is NULL");
+        return;
+    }
+
+    char full_path[1024];
+    build_preset_path(index, full_path, sizeof(full_path));
+
+    // GL: build the new chain before dropping the old one, so a failed load
+    // keeps the current preset on screen
+    LibrashaderManager* new_manager = NULL;
+    if (SDLApp_GetRenderer() == RENDERER_OPENGL) {
+        const Uint64 start = SDL_GetTicks();
+        new_manager = LibrashaderManager_Init(full_path);
+        if (!new_manager) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize librashader manager.");
+            return;
+        }
+        SDL_Log("Preset instantiated in %llu ms", (unsigned long long)(SDL_GetTicks() - start));
+    }
+
     if (libretro_manager) {
         SDL_Log("Freeing existing manager...");
 
@@ -126,30 +184,119 @@ static void load_preset_internal(int index) {
         SDL_Log("Manager freed.");
     }
 
-    if (!g_base_path) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "g_base_path is NULL");
+    libretro_manager = new_manager ? new_manager : LibrashaderManager_Init(full_path);
+
+    if (!libretro_manager) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize librashader manager.");
         return;
     }
 
-    char full_path[1024];
-    snprintf(full_path, sizeof(full_path), "%s%s/%s", g_base_path, "shaders/libretro", available_presets[index]);
+    // Save configuration
+    Config_SetString(CFG_KEY_SHADER_PATH, available_presets[index]);
+}
 
-    // Normalize path separators
-    for (int i = 0; full_path[i]; i++) {
-        if (full_path[i] == '\\') {
-            full_path[i] = '/';
+/** @brief Worker: compile each requested preset on the shared context, then throw the chain away. */
+static int SDLCALL precompile_thread_main(void* data) {
+    (void)data;
+
+    if (!SDL_GL_MakeCurrent(precompile_window, precompile_context)) {
+        SDL_Log("Shader precompile: MakeCurrent failed (%s), presets load synchronously", SDL_GetError());
+        SDL_SetAtomicInt(&precompile_state, PRECOMPILE_UNAVAILABLE);
+        return 0;
+    }
+
+    for (;;) {
+        SDL_WaitSemaphore(precompile_sem);
+        if (SDL_GetAtomicInt(&precompile_quit)) {
+            break;
+        }
+
+        const Uint64 start = SDL_GetTicks();
+        LibrashaderManager* warm = LibrashaderManager_Init(precompile_path);
+        if (warm) {
+            glFinish(); // Make sure the driver is really done before the render thread relinks
+            LibrashaderManager_Free(warm);
         }
+        precompile_ms = SDL_GetTicks() - start;
+
+        SDL_SetAtomicInt(&precompile_state, PRECOMPILE_DONE);
     }
 
-    libretro_manager = LibrashaderManager_Init(full_path);
+    SDL_GL_MakeCurrent(precompile_window, NULL);
+    return 0;
+}
 
-    if (!libretro_manager) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to initialize librashader manager.");
+/** @brief Destroy the worker's context and hidden window. */
+static void destroy_precompile_context(void) {
+    if (precompile_context) {
+        SDL_GL_DestroyContext(precompile_context);
+        precompile_context = NULL;
+    }
+    if (precompile_window) {
+        SDL_DestroyWindow(precompile_window);
+        precompile_window = NULL;
+    }
+}
+
+/**
+ * @brief Create the worker's shared GL context (main context must be current).
+ *
+ * The context gets its own hidden window: the game window is current on the
+ * render thread, and one drawable current on two threads is not portable.
+ * If the worker can't make its context current it exits, and presets load
+ * synchronously from then on.
+ */
+static void start_precompile_worker(void) {
+    SDL_GLContext main_context = SDL_GL_GetCurrentContext();
+    SDL_Window* main_window = SDL_GL_GetCurrentWindow();
+    if (!main_context || !main_window) {
         return;
     }
 
-    // Save configuration
-    Config_SetString(CFG_KEY_SHADER_PATH, available_presets[index]);
+    precompile_window = SDL_CreateWindow("", 1, 1, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (!precompile_window) {
+        SDL_Log("Shader precompile: no hidden window (%s), presets load synchronously", SDL_GetError());
+        return;
+    }
+
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+    precompile_context = SDL_GL_CreateContext(precompile_window);
+    SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+    SDL_GL_MakeCurrent(main_window, main_context); // CreateContext made the new one current
+
+    if (!precompile_context) {
+        SDL_Log("Shader precompile: no shared context (%s), presets load synchronously", SDL_GetError());
+        destroy_precompile_context();
+        return;
+    }
+
+    SDL_SetAtomicInt(&precompile_state, PRECOMPILE_IDLE);
+    SDL_SetAtomicInt(&precompile_quit, 0);
+    precompile_sem = SDL_CreateSemaphore(0);
+    precompile_thread = SDL_CreateThread(precompile_thread_main, "ShaderCompile", NULL);
+    if (!precompile_sem || !precompile_thread) {
+        SDL_Log("Shader precompile: failed to start worker, presets load synchronously");
+        if (precompile_sem) {
+            SDL_DestroySemaphore(precompile_sem);
+            precompile_sem = NULL;
+        }
+        destroy_precompile_context();
+    }
+}
+
+static void stop_precompile_worker(void) {
+    if (precompile_thread) {
+        // An in-flight compile finishes first; the worker only checks quit between jobs
+        SDL_SetAtomicInt(&precompile_quit, 1);
+        SDL_SignalSemaphore(precompile_sem);
+        SDL_WaitThread(precompile_thread, NULL);
+        precompile_thread = NULL;
+    }
+    if (precompile_sem) {
+        SDL_DestroySemaphore(precompile_sem);
+        precompile_sem = NULL;
+    }
+    destroy_precompile_context();
 }
 
 void SDLAppShader_Init(const char* base_path) {
@@ -182,6 +329,10 @@ void SDLAppShader_Init(const char* base_path) {
         }
     }
 
+    if (SDLApp_GetRenderer() == RENDERER_OPENGL) {
+        start_precompile_worker();
+    }
+
     if (shader_mode_libretro && available_preset_count > 0) {
         // Immediate load on init
         load_preset_internal(current_preset_index);
@@ -189,6 +340,7 @@ void SDLAppShader_Init(const char* base_path) {
 }
 
 void SDLAppShader_Shutdown() {
+    stop_precompile_worker();
     if (libretro_manager) {
         LibrashaderManager_Free(libretro_manager);
         libretro_manager = NULL;
@@ -207,8 +359,43 @@ void SDLAppShader_Shutdown() {
 }
 
 void SDLAppShader_ProcessPendingLoad() {
-    if (s_pending_preset_index >= 0) {
-        load_preset_internal(s_pending_preset_index);
+    if (precompile_thread && SDL_GetAtomicInt(&precompile_state) == PRECOMPILE_UNAVAILABLE) {
+        stop_precompile_worker(); // Already exited; this just reaps it
+    }
+
+    if (!precompile_thread) {
+        if (s_pending_preset_index >= 0) {
+            load_preset_internal(s_pending_preset_index);
+            s_pending_preset_index = -1;
+        }
+        return;
+    }
+
+    const int state = SDL_GetAtomicInt(&precompile_state);
+    if (state == PRECOMPILE_RUNNING) {
+        return; // Old preset keeps rendering
+    }
+
+    if (state == PRECOMPILE_DONE) {
+        SDL_SetAtomicInt(&precompile_state, PRECOMPILE_IDLE);
+        // Skip presets the user has already scrolled past
+        if (s_pending_preset_index == precompile_index) {
+            SDL_Log("Preset compiled in background in %llu ms", (unsigned long long)precompile_ms);
+            load_preset_internal(precompile_index);
+            s_pending_preset_index = -1;
+        }
+        precompile_index = -1;
+    }
+
+    if (s_pending_preset_index >= 0 && s_pending_preset_index < available_preset_count && g_base_path) {
+        precompile_index = s_pending_preset_index;
+        build_preset_path(precompile_index, precompile_path, sizeof(precompile_path));
+        // Only from IDLE: a worker that has just given up must not be handed a job
+        if (SDL_CompareAndSwapAtomicInt(&precompile_state, PRECOMPILE_IDLE, PRECOMPILE_RUNNING)) {
+            SDL_SignalSemaphore(precompile_sem);
+        }
+    } else if (s_pending_preset_index >= 0) {
+        load_preset_internal(s_pending_preset_index); // Logs the invalid index
         s_pending_preset_index = -1;
     }
 }
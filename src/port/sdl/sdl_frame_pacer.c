@@ -0,0 +1,346 @@
+/**
+ * @file sdl_frame_pacer.c
+ * @brief Frame pacing with absolute-deadline sleeps and optional vblank alignment.
+ *
+ * The original pacer slept until 2 ms before the deadline and busy-spun the
+ * rest, every frame. On passively cooled ARM boards that spin alone keeps a
+ * core loaded. This pacer sleeps to an absolute deadline (clock_nanosleep with
+ * TIMER_ABSTIME on Linux, so a late wake-up never pushes the next one later)
+ * and only spins for a margin derived from the wake-up latency actually
+ * measured on this host — typically tens of microseconds instead of 2 ms.
+ *
+ * With vblank alignment on, present/swap completion times are used as vblank
+ * timestamps. The frame still presents at the same vblank it would have hit
+ * from the deadline, but the pacer wakes as late as the measured frame work
+ * allows, which trims input-to-scanout latency without changing the game rate.
+ */
+#include "port/sdl/sdl_frame_pacer.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <time.h>
+#define FRAME_PACER_ABSTIME_SLEEP 1
+#endif
+
+/// Legacy hybrid pacer's fixed spin window
+#define SPIN_MODE_SLACK_NS 2000000ULL
+/// Bounds for the calibrated early-wake margin
+#define MIN_SLACK_NS 20000ULL
+#define MAX_SLACK_NS 2000000ULL
+/// Sleeps used to seed the wake-up latency estimate at Init
+#define CALIBRATION_SLEEPS 16
+#define CALIBRATION_SLEEP_NS 1000000ULL
+/// Safety margin between predicted frame completion and the vblank
+#define VBLANK_MARGIN_NS 1000000ULL
+
+static FramePacerMode pacer_mode = FRAME_PACER_SLEEP;
+static bool vblank_align = false;
+
+static Uint64 frame_deadline = 0;
+
+// Wake-up latency estimate: exponentially weighted mean and mean deviation (1/16 weight)
+static double overshoot_mean_ns = 0.0;
+static double overshoot_dev_ns = 0.0;
+static Uint64 slack_ns = MAX_SLACK_NS;
+
+// Vblank tracking
+static Uint64 last_vblank_ns = 0;
+static double refresh_period_ns = 0.0;
+static double work_mean_ns = 0.0;
+static double work_dev_ns = 0.0;
+static Uint64 last_wake_ns = 0;
+
+// Statistics (Welford running variance of frame intervals)
+static Uint64 stat_frames = 0;
+static double stat_interval_mean = 0.0;
+static double stat_interval_m2 = 0.0;
+static Uint64 stat_interval_max = 0;
+static Uint64 stat_spin_total_ns = 0;
+static Uint64 stat_overshoot_total_ns = 0;
+static Uint64 stat_sleeps = 0;
+static Uint64 stat_first_wake_ns = 0;
+static Uint64 stat_first_cpu_ns = 0;
+static Uint64 stat_last_cpu_ns = 0;
+
+void SDLFramePacer_SetMode(FramePacerMode mode) {
+    pacer_mode = mode;
+}
+
+FramePacerMode SDLFramePacer_GetMode(void) {
+    return pacer_mode;
+}
+
+void SDLFramePacer_SetVBlankAlign(bool enabled) {
+    vblank_align = enabled;
+}
+
+/** @brief CPU time consumed by the calling thread, or 0 where unavailable. */
+static Uint64 thread_cpu_ns(void) {
+#if defined(FRAME_PACER_ABSTIME_SLEEP)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+        return (Uint64)ts.tv_sec * SDL_NS_PER_SECOND + (Uint64)ts.tv_nsec;
+    }
+#endif
+    return 0;
+}
+
+/** @brief Sleep until `target_ns` on the SDL_GetTicksNS clock. */
+static void sleep_until(Uint64 target_ns) {
+    const Uint64 now = SDL_GetTicksNS();
+    if (target_ns <= now) {
+        return;
+    }
+
+#if defined(FRAME_PACER_ABSTIME_SLEEP)
+    // SDL's tick clock may be CLOCK_MONOTONIC_RAW, so translate the remaining
+    // time onto CLOCK_MONOTONIC rather than assuming the epochs match.
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+        const Uint64 abs_ns = (Uint64)ts.tv_sec * SDL_NS_PER_SECOND + (Uint64)ts.tv_nsec + (target_ns - now);
+        ts.tv_sec = (time_t)(abs_ns / SDL_NS_PER_SECOND);
+        ts.tv_nsec = (long)(abs_ns % SDL_NS_PER_SECOND);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        }
+        return;
+    }
+#endif
+
+    SDL_DelayNS(target_ns - now);
+}
+
+/** @brief Fold one measured wake-up overshoot into the estimate and update the slack. */
+static void note_overshoot(Uint64 overshoot_ns) {
+    const double sample = (double)overshoot_ns;
+    overshoot_dev_ns += (SDL_fabs(sample - overshoot_mean_ns) - overshoot_dev_ns) / 16.0;
+    overshoot_mean_ns += (sample - overshoot_mean_ns) / 16.0;
+
+    Uint64 slack = (Uint64)(overshoot_mean_ns + 3.0 * overshoot_dev_ns);
+    if (slack < MIN_SLACK_NS) {
+        slack = MIN_SLACK_NS;
+    } else if (slack > MAX_SLACK_NS) {
+        slack = MAX_SLACK_NS;
+    }
+    slack_ns = slack;
+}
+
+void SDLFramePacer_Init(void) {
+    frame_deadline = 0;
+    last_vblank_ns = 0;
+    refresh_period_ns = 0.0;
+    work_mean_ns = 0.0;
+    work_dev_ns = 0.0;
+    last_wake_ns = 0;
+
+    stat_frames = 0;
+    stat_interval_mean = 0.0;
+    stat_interval_m2 = 0.0;
+    stat_interval_max = 0;
+    stat_spin_total_ns = 0;
+    stat_overshoot_total_ns = 0;
+    stat_sleeps = 0;
+    stat_first_wake_ns = 0;
+    stat_first_cpu_ns = 0;
+    stat_last_cpu_ns = 0;
+
+    if (pacer_mode == FRAME_PACER_SPIN) {
+        slack_ns = SPIN_MODE_SLACK_NS;
+        SDL_Log("Frame pacer: spin (sleep to 2 ms before the deadline, spin the rest)");
+        return;
+    }
+
+    // Seed the estimate from a burst of short sleeps; steady-state frames keep refining it
+    overshoot_mean_ns = 0.0;
+    overshoot_dev_ns = 0.0;
+    for (int i = 0; i < CALIBRATION_SLEEPS; i++) {
+        const Uint64 target = SDL_GetTicksNS() + CALIBRATION_SLEEP_NS;
+        sleep_until(target);
+        const Uint64 woke = SDL_GetTicksNS();
+        const Uint64 overshoot = woke > target ? woke - target : 0;
+        if (i == 0) {
+            overshoot_mean_ns = (double)overshoot;
+        }
+        note_overshoot(overshoot);
+    }
+
+    SDL_Log("Frame pacer: %s, wake-up latency %.0f us (+/- %.0f), spin margin %.0f us%s",
+            pacer_mode == FRAME_PACER_SLEEP ? "sleep" : "spin",
+            overshoot_mean_ns / 1e3,
+            overshoot_dev_ns / 1e3,
+            (double)slack_ns / 1e3,
+            vblank_align ? ", vblank alignment on" : "");
+}
+
+void SDLFramePacer_Reset(void) {
+    frame_deadline = 0;
+    last_wake_ns = 0;
+}
+
+/** @brief Latest wake-up time that still lets the frame hit the vblank the deadline would. */
+static Uint64 vblank_aligned_wake(Uint64 deadline) {
+    if (refresh_period_ns <= 0.0 || last_vblank_ns == 0 || work_mean_ns <= 0.0 || deadline <= last_vblank_ns) {
+        return deadline;
+    }
+
+    const Uint64 period = (Uint64)refresh_period_ns;
+    const Uint64 work = (Uint64)(work_mean_ns + 3.0 * work_dev_ns) + VBLANK_MARGIN_NS;
+
+    // First predicted vblank the frame can make when started at the deadline
+    const Uint64 ready = deadline + work;
+    const Uint64 vblanks = (ready - last_vblank_ns + period - 1) / period;
+    const Uint64 vblank = last_vblank_ns + vblanks * period;
+
+    const Uint64 wake = vblank - work;
+    if (wake <= deadline || wake - deadline >= period) {
+        return deadline;
+    }
+    return wake;
+}
+
+Uint64 SDLFramePacer_Wait(Uint64 frame_ns) {
+    Uint64 now = SDL_GetTicksNS();
+
+    if (frame_deadline == 0) {
+        frame_deadline = now + frame_ns;
+    }
+
+    const Uint64 wake_target = vblank_align ? vblank_aligned_wake(frame_deadline) : frame_deadline;
+    Uint64 spin_ns = 0;
+
+    if (now < wake_target) {
+        if (wake_target - now > slack_ns) {
+            const Uint64 sleep_target = wake_target - slack_ns;
+            sleep_until(sleep_target);
+            now = SDL_GetTicksNS();
+            if (pacer_mode == FRAME_PACER_SLEEP) {
+                const Uint64 overshoot = now > sleep_target ? now - sleep_target : 0;
+                note_overshoot(overshoot);
+                stat_overshoot_total_ns += overshoot;
+                stat_sleeps += 1;
+            }
+        }
+
+        const Uint64 spin_start = now;
+        while (now < wake_target) {
+            SDL_CPUPauseInstruction();
+            now = SDL_GetTicksNS();
+        }
+        spin_ns = now - spin_start;
+    }
+
+    frame_deadline += frame_ns;
+    // Resync if we fell too far behind (e.g. after a stall)
+    if (now > frame_deadline + frame_ns) {
+        frame_deadline = now + frame_ns;
+    }
+
+    // Statistics
+    const Uint64 cpu_ns = thread_cpu_ns();
+    if (last_wake_ns != 0) {
+        const Uint64 interval = now - last_wake_ns;
+        stat_frames += 1;
+        const double delta = (double)interval - stat_interval_mean;
+        stat_interval_mean += delta / (double)stat_frames;
+        stat_interval_m2 += delta * ((double)interval - stat_interval_mean);
+        if (interval > stat_interval_max) {
+            stat_interval_max = interval;
+        }
+        stat_spin_total_ns += spin_ns;
+    } else if (stat_first_wake_ns == 0) {
+        stat_first_wake_ns = now;
+        stat_first_cpu_ns = cpu_ns;
+    }
+    stat_last_cpu_ns = cpu_ns;
+
+    last_wake_ns = now;
+    return now;
+}
+
+void SDLFramePacer_NotePresent(Uint64 start_ns, Uint64 end_ns) {
+    // Frame work the vblank alignment has to leave room for
+    if (last_wake_ns != 0 && start_ns > last_wake_ns) {
+        const double work = (double)(start_ns - last_wake_ns);
+        if (work_mean_ns <= 0.0) {
+            work_mean_ns = work;
+        }
+        work_dev_ns += (SDL_fabs(work - work_mean_ns) - work_dev_ns) / 16.0;
+        work_mean_ns += (work - work_mean_ns) / 16.0;
+    }
+
+    if (last_vblank_ns != 0 && end_ns > last_vblank_ns) {
+        const double interval = (double)(end_ns - last_vblank_ns);
+
+        if (refresh_period_ns <= 0.0) {
+            // Accept a first estimate anywhere between 24 and 240 Hz
+            if (interval > 4.0e6 && interval < 42.0e6) {
+                refresh_period_ns = interval;
+            }
+        } else {
+            // Intervals that span skipped vblanks still measure the period
+            const double periods = SDL_floor(interval / refresh_period_ns + 0.5);
+            if (periods >= 1.0 && SDL_fabs(interval - periods * refresh_period_ns) < 0.5e6) {
+                refresh_period_ns += (interval / periods - refresh_period_ns) / 32.0;
+            } else if (periods < 1.0) {
+                // Present didn't block on a vblank (vsync off or a compositor queue)
+                refresh_period_ns = 0.0;
+            }
+        }
+    }
+    last_vblank_ns = end_ns;
+}
+
+void SDLFramePacer_GetStats(SDLFramePacerStats* out) {
+    memset(out, 0, sizeof(*out));
+    out->frames = stat_frames;
+    out->slack_us = (double)slack_ns / 1e3;
+    out->refresh_hz = refresh_period_ns > 0.0 ? 1e9 / refresh_period_ns : 0.0;
+    out->cpu_utilization = -1.0;
+
+    if (stat_frames == 0) {
+        return;
+    }
+
+    out->mean_interval_ms = stat_interval_mean / 1e6;
+    out->stddev_interval_ms = SDL_sqrt(stat_interval_m2 / (double)stat_frames) / 1e6;
+    out->max_interval_ms = (double)stat_interval_max / 1e6;
+    out->mean_spin_us = (double)stat_spin_total_ns / (double)stat_frames / 1e3;
+    if (stat_sleeps > 0) {
+        out->mean_overshoot_us = (double)stat_overshoot_total_ns / (double)stat_sleeps / 1e3;
+    }
+
+    const Uint64 wall_ns = last_wake_ns > stat_first_wake_ns ? last_wake_ns - stat_first_wake_ns : 0;
+    if (wall_ns > 0 && stat_first_cpu_ns != 0 && stat_last_cpu_ns >= stat_first_cpu_ns) {
+        out->cpu_utilization = (double)(stat_last_cpu_ns - stat_first_cpu_ns) / (double)wall_ns;
+    }
+}
+
+void SDLFramePacer_LogStats(void) {
+    SDLFramePacerStats stats;
+    SDLFramePacer_GetStats(&stats);
+    if (stats.frames == 0) {
+        return;
+    }
+
+    char cpu[32] = "n/a";
+    if (stats.cpu_utilization >= 0.0) {
+        SDL_snprintf(cpu, sizeof(cpu), "%.1f%%", stats.cpu_utilization * 100.0);
+    }
+
+    SDL_Log("Frame pacer [%s]: %llu frames, interval %.3f ms +/- %.3f (max %.2f), "
+            "spin %.0f us/frame, wake-up overshoot %.0f us, margin %.0f us, main thread CPU %s",
+            pacer_mode == FRAME_PACER_SLEEP ? "sleep" : "spin",
+            (unsigned long long)stats.frames,
+            stats.mean_interval_ms,
+            stats.stddev_interval_ms,
+            stats.max_interval_ms,
+            stats.mean_spin_us,
+            stats.mean_overshoot_us,
+            stats.slack_us,
+            cpu);
+    if (stats.refresh_hz > 0.0) {
+        SDL_Log("Frame pacer: measured display refresh %.3f Hz", stats.refresh_hz);
+    }
+}
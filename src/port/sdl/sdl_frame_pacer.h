@@ -0,0 +1,62 @@
+#ifndef SDL_FRAME_PACER_H
+#define SDL_FRAME_PACER_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// SLEEP: absolute-deadline sleep (clock_nanosleep on Linux) that wakes a calibrated
+///        margin early and spins only for that margin.
+/// SPIN:  the original hybrid pacer — sleep to 2 ms before the deadline, spin the rest.
+///        Kept for comparison.
+typedef enum FramePacerMode {
+    FRAME_PACER_SLEEP,
+    FRAME_PACER_SPIN,
+} FramePacerMode;
+
+typedef struct SDLFramePacerStats {
+    Uint64 frames;
+    double mean_interval_ms;
+    double stddev_interval_ms;
+    double max_interval_ms;
+    double mean_spin_us;     // Busy-wait per frame
+    double mean_overshoot_us; // How late the sleep woke up, past its target
+    double slack_us;         // Current early-wake margin
+    double cpu_utilization;  // Pacing thread CPU time / wall time (0-1), negative if unavailable
+    double refresh_hz;       // Measured display refresh (0 = unknown)
+} SDLFramePacerStats;
+
+void SDLFramePacer_SetMode(FramePacerMode mode);
+FramePacerMode SDLFramePacer_GetMode(void);
+
+/// Wake up just in time for the frame to reach its vblank instead of at the
+/// deadline (needs vsync and present timestamps). Doesn't change the game rate.
+void SDLFramePacer_SetVBlankAlign(bool enabled);
+
+/// Measure this host's sleep wake-up jitter and reset the statistics.
+void SDLFramePacer_Init(void);
+
+/// Forget the current deadline (e.g. after uncapping or a long stall).
+void SDLFramePacer_Reset(void);
+
+/// Wait for the next frame deadline, `frame_ns` after the previous one.
+/// Returns the wake time (SDL_GetTicksNS clock).
+Uint64 SDLFramePacer_Wait(Uint64 frame_ns);
+
+/// Report a present/swap that blocked from `start_ns` to `end_ns`. Used as a
+/// vblank timestamp for refresh-rate measurement and vblank alignment.
+void SDLFramePacer_NotePresent(Uint64 start_ns, Uint64 end_ns);
+
+void SDLFramePacer_GetStats(SDLFramePacerStats* out);
+
+/// Log the statistics gathered since Init.
+void SDLFramePacer_LogStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
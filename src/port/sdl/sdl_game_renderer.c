@@ -1,6 +1,299 @@
 #include "port/sdl/sdl_game_renderer.h"
+#include "common.h"
 #include "port/sdl/sdl_app.h"
 #include "port/sdl/sdl_game_renderer_internal.h"
+#include "sf33rd/AcrSDK/ps2/flps2etc.h"
+#include "sf33rd/AcrSDK/ps2/foundaps2.h"
+#include <libgraph.h>
+
+// --- Command recording (render pipeline) ---
+// Calls made from the recording thread are queued with their arguments and
+// executed later by SDLGameRenderer_ReplayRecorded on the thread that owns the
+// graphics context. Backends only ever see calls from that thread.
+//
+// Unlocks also capture the texture or palette bytes as they were at the call.
+// Replay writes each capture back before the backend sees the unlock, and
+// puts the memory back as logic left it once the list has run, so backends
+// read the same bytes at each call as they would running serially.
+
+typedef enum RenderCmdType {
+    RENDER_CMD_CREATE_TEXTURE,
+    RENDER_CMD_DESTROY_TEXTURE,
+    RENDER_CMD_UNLOCK_TEXTURE,
+    RENDER_CMD_CREATE_PALETTE,
+    RENDER_CMD_DESTROY_PALETTE,
+    RENDER_CMD_UNLOCK_PALETTE,
+    RENDER_CMD_UNLOCK_PALETTES,
+    RENDER_CMD_SET_TEXTURE,
+    RENDER_CMD_DRAW_TEXTURED_QUAD,
+    RENDER_CMD_DRAW_SOLID_QUAD,
+    RENDER_CMD_DRAW_SPRITE,
+    RENDER_CMD_DRAW_SPRITE2,
+    RENDER_CMD_RESET_BATCH_STATE,
+} RenderCmdType;
+
+typedef struct RenderCmd {
+    RenderCmdType type;
+    unsigned int arg; // Handle or color
+    union {
+        struct {
+            unsigned int count;  // Palettes in an UNLOCK_PALETTES run
+            size_t bytes_offset; // Captured bytes in snapshot_bytes
+            size_t bytes_size;
+        } unlock;
+        Sprite sprite;
+        Quad quad;
+        Sprite2 sprite2;
+    } prim;
+} RenderCmd;
+
+// Memory a capture was written over during replay, put back when it ends
+typedef struct RenderUndo {
+    void* pixels;
+    size_t offset; // In undo_bytes
+    size_t size;
+} RenderUndo;
+
+static SDL_ThreadID recording_thread = 0;
+static RenderCmd* recorded_cmds = NULL;
+static int recorded_count = 0;
+static int recorded_capacity = 0;
+
+static Uint8* snapshot_bytes = NULL;
+static size_t snapshot_used = 0;
+static size_t snapshot_capacity = 0;
+
+static RenderUndo* undo_list = NULL;
+static int undo_count = 0;
+static int undo_capacity = 0;
+static Uint8* undo_bytes = NULL;
+static size_t undo_used = 0;
+static size_t undo_capacity_bytes = 0;
+
+/** @brief Grow `*buf` to hold at least `needed` bytes. */
+static bool reserve_bytes(Uint8** buf, size_t* capacity, size_t needed) {
+    if (needed <= *capacity) {
+        return true;
+    }
+
+    size_t new_capacity = *capacity ? *capacity : 64 * 1024;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+
+    Uint8* grown = (Uint8*)SDL_realloc(*buf, new_capacity);
+    if (!grown) {
+        return false;
+    }
+    *buf = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/** @brief Game memory behind a texture or palette handle, and its size in bytes. */
+static void* resource_bytes(unsigned int handle, bool palette, size_t* size) {
+    *size = 0;
+    if (handle == 0 || handle > (palette ? FL_PALETTE_MAX : FL_TEXTURE_MAX)) {
+        return NULL;
+    }
+
+    const FLTexture* fl = palette ? &flPalette[handle - 1] : &flTexture[handle - 1];
+    void* pixels = flPS2GetSystemBuffAdrs(fl->mem_handle);
+    if (!pixels) {
+        return NULL;
+    }
+
+    const size_t texels = (size_t)fl->width * fl->height;
+    if (palette) {
+        *size = texels * ((fl->format == SCE_GS_PSMCT32) ? 4 : 2);
+        return pixels;
+    }
+
+    switch (fl->format) {
+    case SCE_GS_PSMT8:
+        *size = texels;
+        break;
+    case SCE_GS_PSMT4:
+        *size = (size_t)((fl->width + 1) / 2) * fl->height;
+        break;
+    case SCE_GS_PSMCT16:
+        *size = texels * 2;
+        break;
+    default:
+        *size = texels * 4;
+        break;
+    }
+    return pixels;
+}
+
+/** @brief Append a command when called from the recording thread; NULL means execute directly. */
+static RenderCmd* record_cmd(RenderCmdType type, unsigned int arg) {
+    if (recording_thread == 0 || SDL_GetCurrentThreadID() != recording_thread) {
+        return NULL;
+    }
+
+    if (recorded_count == recorded_capacity) {
+        const int capacity = recorded_capacity ? recorded_capacity * 2 : 4096;
+        RenderCmd* cmds = (RenderCmd*)SDL_realloc(recorded_cmds, capacity * sizeof(RenderCmd));
+        if (!cmds) {
+            // There is no graphics context on this thread to run the call on instead
+            fatal_error("SDLGameRenderer: out of memory recording render commands");
+        }
+        recorded_cmds = cmds;
+        recorded_capacity = capacity;
+    }
+
+    RenderCmd* cmd = &recorded_cmds[recorded_count++];
+    cmd->type = type;
+    cmd->arg = arg;
+    return cmd;
+}
+
+/** @brief Record an unlock of `count` consecutive handles along with their current bytes. */
+static bool record_unlock(RenderCmdType type, unsigned int first, unsigned int count, bool palette) {
+    RenderCmd* cmd = record_cmd(type, first);
+    if (!cmd) {
+        return false;
+    }
+
+    cmd->prim.unlock.count = count;
+    cmd->prim.unlock.bytes_offset = snapshot_used;
+
+    for (unsigned int i = 0; i < count; i++) {
+        size_t size;
+        const void* pixels = resource_bytes(first + i, palette, &size);
+        if (!pixels) {
+            continue;
+        }
+        if (!reserve_bytes(&snapshot_bytes, &snapshot_capacity, snapshot_used + size)) {
+            fatal_error("SDLGameRenderer: out of memory capturing unlocked render data");
+        }
+        SDL_memcpy(snapshot_bytes + snapshot_used, pixels, size);
+        snapshot_used += size;
+    }
+
+    cmd->prim.unlock.bytes_size = snapshot_used - cmd->prim.unlock.bytes_offset;
+    return true;
+}
+
+/** @brief Remember the bytes at `pixels` the first time replay overwrites them. */
+static bool save_undo(void* pixels, size_t size) {
+    for (int i = 0; i < undo_count; i++) {
+        if (undo_list[i].pixels == pixels) {
+            return true;
+        }
+    }
+
+    if (undo_count == undo_capacity) {
+        const int capacity = undo_capacity ? undo_capacity * 2 : 256;
+        RenderUndo* list = (RenderUndo*)SDL_realloc(undo_list, capacity * sizeof(RenderUndo));
+        if (!list) {
+            return false;
+        }
+        undo_list = list;
+        undo_capacity = capacity;
+    }
+    if (!reserve_bytes(&undo_bytes, &undo_capacity_bytes, undo_used + size)) {
+        return false;
+    }
+
+    undo_list[undo_count++] = (RenderUndo){ pixels, undo_used, size };
+    SDL_memcpy(undo_bytes + undo_used, pixels, size);
+    undo_used += size;
+    return true;
+}
+
+/**
+ * @brief Put a recorded unlock's captured bytes back into game memory.
+ *
+ * A handle whose size changed since the capture keeps the memory logic left;
+ * so does everything if the memory as logic left it can't be saved.
+ */
+static void apply_capture(const RenderCmd* cmd, bool palette) {
+    size_t offset = cmd->prim.unlock.bytes_offset;
+
+    for (unsigned int i = 0; i < cmd->prim.unlock.count; i++) {
+        size_t size;
+        void* pixels = resource_bytes(cmd->arg + i, palette, &size);
+        if (!pixels) {
+            continue;
+        }
+        if (offset + size > cmd->prim.unlock.bytes_offset + cmd->prim.unlock.bytes_size) {
+            return;
+        }
+        if (!save_undo(pixels, size)) {
+            SDL_Log("SDLGameRenderer: out of memory replaying captured render data");
+            return;
+        }
+        SDL_memcpy(pixels, snapshot_bytes + offset, size);
+        offset += size;
+    }
+}
+
+void SDLGameRenderer_SetRecordingThread(SDL_ThreadID thread) {
+    recording_thread = thread;
+}
+
+void SDLGameRenderer_ReplayRecorded(void) {
+    for (int i = 0; i < recorded_count; i++) {
+        const RenderCmd* cmd = &recorded_cmds[i];
+
+        switch (cmd->type) {
+        case RENDER_CMD_CREATE_TEXTURE:
+            SDLGameRenderer_CreateTexture(cmd->arg);
+            break;
+        case RENDER_CMD_DESTROY_TEXTURE:
+            SDLGameRenderer_DestroyTexture(cmd->arg);
+            break;
+        case RENDER_CMD_UNLOCK_TEXTURE:
+            apply_capture(cmd, false);
+            SDLGameRenderer_UnlockTexture(cmd->arg);
+            break;
+        case RENDER_CMD_CREATE_PALETTE:
+            SDLGameRenderer_CreatePalette(cmd->arg);
+            break;
+        case RENDER_CMD_DESTROY_PALETTE:
+            SDLGameRenderer_DestroyPalette(cmd->arg);
+            break;
+        case RENDER_CMD_UNLOCK_PALETTE:
+            apply_capture(cmd, true);
+            SDLGameRenderer_UnlockPalette(cmd->arg);
+            break;
+        case RENDER_CMD_UNLOCK_PALETTES:
+            apply_capture(cmd, true);
+            SDLGameRenderer_UnlockPalettes(cmd->arg, cmd->prim.unlock.count);
+            break;
+        case RENDER_CMD_SET_TEXTURE:
+            SDLGameRenderer_SetTexture(cmd->arg);
+            break;
+        case RENDER_CMD_DRAW_TEXTURED_QUAD:
+            SDLGameRenderer_DrawTexturedQuad(&cmd->prim.sprite, cmd->arg);
+            break;
+        case RENDER_CMD_DRAW_SOLID_QUAD:
+            SDLGameRenderer_DrawSolidQuad(&cmd->prim.quad, cmd->arg);
+            break;
+        case RENDER_CMD_DRAW_SPRITE:
+            SDLGameRenderer_DrawSprite(&cmd->prim.sprite, cmd->arg);
+            break;
+        case RENDER_CMD_DRAW_SPRITE2:
+            SDLGameRenderer_DrawSprite2(&cmd->prim.sprite2);
+            break;
+        case RENDER_CMD_RESET_BATCH_STATE:
+            SDLGameRenderer_ResetBatchState();
+            break;
+        }
+    }
+
+    // Back to the memory logic left, which is what the frame renders from
+    for (int i = undo_count - 1; i >= 0; i--) {
+        SDL_memcpy(undo_list[i].pixels, undo_bytes + undo_list[i].offset, undo_list[i].size);
+    }
+
+    recorded_count = 0;
+    snapshot_used = 0;
+    undo_count = 0;
+    undo_used = 0;
+}
 
 void SDLGameRenderer_Init() {
     RendererBackend r = SDLApp_GetRenderer();
@@ -59,6 +352,10 @@ void SDLGameRenderer_EndFrame() {
 
 extern void SDLGameRendererGL_ResetBatchState(void);
 void SDLGameRenderer_ResetBatchState() {
+    if (record_cmd(RENDER_CMD_RESET_BATCH_STATE, 0)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_OPENGL) {
         SDLGameRendererGL_ResetBatchState();
@@ -68,6 +365,10 @@ void SDLGameRenderer_ResetBatchState() {
 }
 
 void SDLGameRenderer_CreateTexture(unsigned int th) {
+    if (record_cmd(RENDER_CMD_CREATE_TEXTURE, th)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_CreateTexture(th);
@@ -79,6 +380,10 @@ void SDLGameRenderer_CreateTexture(unsigned int th) {
 }
 
 void SDLGameRenderer_DestroyTexture(unsigned int texture_handle) {
+    if (record_cmd(RENDER_CMD_DESTROY_TEXTURE, texture_handle)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DestroyTexture(texture_handle);
@@ -90,6 +395,10 @@ void SDLGameRenderer_DestroyTexture(unsigned int texture_handle) {
 }
 
 void SDLGameRenderer_UnlockTexture(unsigned int th) {
+    if (record_unlock(RENDER_CMD_UNLOCK_TEXTURE, th, 1, false)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_UnlockTexture(th);
@@ -101,6 +410,10 @@ void SDLGameRenderer_UnlockTexture(unsigned int th) {
 }
 
 void SDLGameRenderer_CreatePalette(unsigned int ph) {
+    if (record_cmd(RENDER_CMD_CREATE_PALETTE, ph)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_CreatePalette(ph);
@@ -112,6 +425,10 @@ void SDLGameRenderer_CreatePalette(unsigned int ph) {
 }
 
 void SDLGameRenderer_DestroyPalette(unsigned int palette_handle) {
+    if (record_cmd(RENDER_CMD_DESTROY_PALETTE, palette_handle)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DestroyPalette(palette_handle);
@@ -123,6 +440,10 @@ void SDLGameRenderer_DestroyPalette(unsigned int palette_handle) {
 }
 
 void SDLGameRenderer_UnlockPalette(unsigned int ph) {
+    if (record_unlock(RENDER_CMD_UNLOCK_PALETTE, ph, 1, true)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_UnlockPalette(ph);
@@ -133,7 +454,22 @@ void SDLGameRenderer_UnlockPalette(unsigned int ph) {
     }
 }
 
+void SDLGameRenderer_UnlockPalettes(unsigned int first, unsigned int count) {
+    if (record_unlock(RENDER_CMD_UNLOCK_PALETTES, first, count, true)) {
+        return;
+    }
+
+    // Backends track palettes individually; the GPU one merges adjacent slots into one upload
+    for (unsigned int i = 0; i < count; i++) {
+        SDLGameRenderer_UnlockPalette(first + i);
+    }
+}
+
 void SDLGameRenderer_SetTexture(unsigned int th) {
+    if (record_cmd(RENDER_CMD_SET_TEXTURE, th)) {
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_SetTexture(th);
@@ -145,6 +481,12 @@ void SDLGameRenderer_SetTexture(unsigned int th) {
 }
 
 void SDLGameRenderer_DrawTexturedQuad(const Sprite* sprite, unsigned int color) {
+    RenderCmd* cmd = record_cmd(RENDER_CMD_DRAW_TEXTURED_QUAD, color);
+    if (cmd) {
+        cmd->prim.sprite = *sprite;
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DrawTexturedQuad(sprite, color);
@@ -156,6 +498,12 @@ void SDLGameRenderer_DrawTexturedQuad(const Sprite* sprite, unsigned int color)
 }
 
 void SDLGameRenderer_DrawSolidQuad(const Quad* vertices, unsigned int color) {
+    RenderCmd* cmd = record_cmd(RENDER_CMD_DRAW_SOLID_QUAD, color);
+    if (cmd) {
+        cmd->prim.quad = *vertices;
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DrawSolidQuad(vertices, color);
@@ -167,6 +515,12 @@ void SDLGameRenderer_DrawSolidQuad(const Quad* vertices, unsigned int color) {
 }
 
 void SDLGameRenderer_DrawSprite(const Sprite* sprite, unsigned int color) {
+    RenderCmd* cmd = record_cmd(RENDER_CMD_DRAW_SPRITE, color);
+    if (cmd) {
+        cmd->prim.sprite = *sprite;
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DrawSprite(sprite, color);
@@ -178,6 +532,12 @@ void SDLGameRenderer_DrawSprite(const Sprite* sprite, unsigned int color) {
 }
 
 void SDLGameRenderer_DrawSprite2(const Sprite2* sprite2) {
+    RenderCmd* cmd = record_cmd(RENDER_CMD_DRAW_SPRITE2, 0);
+    if (cmd) {
+        cmd->prim.sprite2 = *sprite2;
+        return;
+    }
+
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLGameRendererGPU_DrawSprite2(sprite2);
@@ -198,3 +558,12 @@ unsigned int SDLGameRenderer_GetCachedGLTexture(unsigned int texture_handle, uns
         return SDLGameRendererGL_GetCachedGLTexture(texture_handle, palette_handle);
     }
 }
+
+bool SDLGameRenderer_GetUploadStats(SDLGameRenderer_UploadStats* stats) {
+    if (SDLApp_GetRenderer() == RENDERER_SDLGPU) {
+        SDLGameRendererGPU_GetUploadStats(stats);
+        return true;
+    }
+    SDL_zerop(stats);
+    return false;
+}
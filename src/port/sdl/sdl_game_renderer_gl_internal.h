@@ -108,7 +108,7 @@ typedef struct {
     bool palette_dirty_flags[FL_PALETTE_MAX];
     int dirty_palette_indices[FL_PALETTE_MAX];
     int dirty_palette_count;
-    uint32_t palette_hash[FL_PALETTE_MAX];
+    uint64_t palette_hash[FL_PALETTE_MAX];
 
     // Upload & Conversion
     u32 conversion_buffer[CONVERSION_BUFFER_MAX_PIXELS];
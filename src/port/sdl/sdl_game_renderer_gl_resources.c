@@ -7,6 +7,7 @@
  * detection, and the texture cache live-set. Part of the GL rendering backend.
  */
 #include "port/config.h"
+#include "port/content_hash.h"
 #include "port/sdl/sdl_app.h"
 #include "port/sdl/sdl_app_config.h"
 #include "port/sdl/sdl_game_renderer_gl_internal.h"
@@ -43,17 +44,6 @@ static void read_rgba16_color(Uint16 pixel, float* out_rgba) {
     out_rgba[3] = ((pixel & 0x8000) ? 1.0f : 0.0f);
 }
 
-// FNV-1a hash of palette color data — fast, good distribution, 1 cache line
-static inline uint32_t hash_palette(const void* data, size_t size) {
-    uint32_t h = 2166136261u;
-    const uint8_t* p = (const uint8_t*)data;
-    for (size_t i = 0; i < size; i++) {
-        h ^= p[i];
-        h *= 16777619u;
-    }
-    return h;
-}
-
 // --- CLUT Shuffle for PS2 ---
 #define clut_shuf(x) (((x) & ~0x18) | ((((x) & 0x08) << 1) | (((x) & 0x10) >> 1)))
 
@@ -474,7 +464,7 @@ void SDLGameRendererGL_UnlockPalette(unsigned int ph) {
         size_t size = fl_pal->width * fl_pal->height * ((fl_pal->format == SCE_GS_PSMCT32) ? 4 : 2);
 
         if (pixels) {
-            uint32_t new_hash = hash_palette(pixels, size);
+            const uint64_t new_hash = ContentHash_Compute(pixels, size);
             if (new_hash == gl_state.palette_hash[palette_handle - 1]) {
                 return;
             }
@@ -2,11 +2,14 @@
  * @file sdl_game_renderer_gpu.c
  * @brief SDL_GPU rendering backend implementation.
  *
- * Full renderer using SDL3's GPU API with compute shader-based texture
- * decoding, batched vertex rendering, and palette management. Alternative
+ * Full renderer using SDL3's GPU API with batched vertex rendering and
+ * palette lookup in the fragment shader. Textures stay in their PS2 indexed
+ * form on the GPU and palettes live in a storage buffer, so a palette change
+ * is a small buffer update rather than a texture re-conversion. Alternative
  * to the OpenGL backend for platforms with SDL_GPU support.
  */
 #include "common.h"
+#include "port/content_hash.h"
 #include "port/sdl/sdl_app.h"
 #include "port/sdl/sdl_game_renderer_internal.h"
 #include "port/tracy_zones.h"
@@ -27,7 +30,6 @@ static SDL_GPUDevice* device = NULL;
 static SDL_Window* window = NULL;
 static SDL_GPUCommandBuffer* current_cmd_buf = NULL;
 static SDL_GPUGraphicsPipeline* pipeline = NULL;
-static SDL_GPUComputePipeline* s_compute_pipeline = NULL; // Palette conversion pipeline
 static SDL_GPUSampler* sampler = NULL;
 
 static SDL_GPUBuffer* vertex_buffer = NULL;
@@ -39,13 +41,13 @@ static SDL_GPUTransferBuffer* transfer_buffers[VERTEX_TRANSFER_BUFFER_COUNT] = {
 static SDL_GPUTransferBuffer* index_transfer_buffer = NULL; // Dynamic index uploads each frame
 static int current_transfer_idx = 0;
 
-// Compute Shader Resources
-#define COMPUTE_STORAGE_SIZE (16 * 1024 * 1024)                // 16MB shared buffer for raw pixels + palettes
-static SDL_GPUBuffer* s_compute_storage_buffer = NULL;         // GPU-resident
-static SDL_GPUTransferBuffer* s_compute_staging_buffer = NULL; // CPU-to-GPU transfer
-static u8* s_compute_staging_ptr = NULL;                       // Mapped pointer
-static size_t s_compute_staging_offset = 0;
-static int s_compute_drops_last_frame = 0;
+// Texture and palette uploads, staged once per frame
+#define UPLOAD_STAGING_SIZE (16 * 1024 * 1024)
+static SDL_GPUTransferBuffer* s_upload_staging_buffer = NULL;
+static u8* s_upload_staging_ptr = NULL; // Mapped between BeginFrame and RenderFrame
+static size_t s_upload_staging_offset = 0;
+static int s_upload_drops = 0;
+static SDLGameRenderer_UploadStats s_upload_stats_last_frame;
 
 static float* mapped_vertex_ptr = NULL;
 static unsigned int vertex_count = 0;
@@ -54,22 +56,53 @@ static SDL_GPUTexture* s_swapchain_texture = NULL;
 static SDL_GPUTexture* s_canvas_texture = NULL;
 
 // Texture Array Management
+// Each resident texture owns one R8_UINT layer holding its raw PS2 bytes
+// (indices or ABGR1555) laid out linearly, TEX_ARRAY_SIZE bytes per row.
 #define TEX_ARRAY_SIZE 512
 #define TEX_ARRAY_MAX_LAYERS 256
+#define TEX_LAYER_BYTES (TEX_ARRAY_SIZE * TEX_ARRAY_SIZE)
 static SDL_GPUTexture* texture_array = NULL;
 static int tex_array_free[TEX_ARRAY_MAX_LAYERS];
 static int tex_array_free_count = 0;
-// Map (texture_handle-1, palette_handle) → array layer index, or -1 if not in array
-static int16_t tex_array_layer[FL_TEXTURE_MAX][FL_PALETTE_MAX + 1];
+// Map texture_handle-1 → array layer index, or -1 if not in array
+static int16_t tex_array_layer[FL_TEXTURE_MAX];
+// Layer contents are out of date and must be re-uploaded before use
+static bool tex_array_stale[FL_TEXTURE_MAX];
+
+// Texel format as decoded by scene_indexed.gpu.frag
+enum {
+    GPU_TEX_FORMAT_NONE = 0,
+    GPU_TEX_FORMAT_8BIT = 1,
+    GPU_TEX_FORMAT_4BIT = 2,
+    GPU_TEX_FORMAT_16BIT = 3,
+};
+
+// Palette storage buffer: one 256-color RGBA8 slot per flPalette entry
+#define PALETTE_SLOT_COLORS 256
+#define PALETTE_BUFFER_SIZE (FL_PALETTE_MAX * PALETTE_SLOT_COLORS * sizeof(Uint32))
+static SDL_GPUBuffer* palette_buffer = NULL;
+static Uint32 palette_colors[FL_PALETTE_MAX][PALETTE_SLOT_COLORS];
+static int palette_color_count[FL_PALETTE_MAX];
+static bool palette_upload_flags[FL_PALETTE_MAX];
+static int palette_upload_indices[FL_PALETTE_MAX];
+static int palette_upload_count = 0;
+
+// A run of adjacent palette slots staged as one copy
+typedef struct PaletteRun {
+    int first;
+    Uint32 offset; // In the staging buffer
+    Uint32 size;
+} PaletteRun;
 
 // Stacks for current frame texture state
-static int texture_layers[FL_PALETTE_MAX];
-static float texture_uv_sx[FL_PALETTE_MAX];
-static float texture_uv_sy[FL_PALETTE_MAX];
+typedef struct GPUTextureState {
+    int layer;      // -1 if the texture could not be made resident
+    Uint32 info[4]; // As in GPUVertex
+} GPUTextureState;
+static GPUTextureState texture_states[FL_PALETTE_MAX];
 static int texture_count = 0;
 
 static SDL_Surface* surfaces[FL_TEXTURE_MAX] = { NULL };
-static SDL_Palette* palettes[FL_PALETTE_MAX] = { NULL };
 
 // Dirty flags
 static bool texture_dirty_flags[FL_TEXTURE_MAX] = { false };
@@ -81,34 +114,28 @@ static int dirty_texture_count = 0;
 static int dirty_palette_indices[FL_PALETTE_MAX];
 static int dirty_palette_count = 0;
 
-// Hash-based dirty detection
-static uint32_t palette_hash[FL_PALETTE_MAX] = { 0 };
-static uint32_t texture_hash[FL_TEXTURE_MAX] = { 0 };
-
-// FNV-1a hash of a raw memory block
-static inline uint32_t hash_memory(const void* ptr, size_t len) {
-    uint32_t h = 2166136261u;
-    const uint8_t* data = (const uint8_t*)ptr;
-    for (size_t i = 0; i < len; i++) {
-        h ^= data[i];
-        h *= 16777619u;
+// Hash-based dirty detection: unlocks that leave the data unchanged upload nothing
+static uint64_t palette_hash[FL_PALETTE_MAX] = { 0 };
+static uint64_t texture_hash[FL_TEXTURE_MAX] = { 0 };
+
+/** @brief Return a texture's array layer to the free list. */
+static void release_texture_layer(int texture_index) {
+    if (tex_array_layer[texture_index] >= 0) {
+        tex_array_free[tex_array_free_count++] = tex_array_layer[texture_index];
+        tex_array_layer[texture_index] = -1;
     }
-    return h;
+    tex_array_stale[texture_index] = false;
 }
 
-// Compute Job Queue
-#define MAX_COMPUTE_JOBS 256
+// Texture Upload Queue
+#define MAX_TEXTURE_UPLOADS 256
 typedef struct {
-    Uint32 width;
-    Uint32 height;
-    Uint32 format; // 0=8bit, 1=4bit, 2=16bit
     Uint32 layer;
-    Uint32 pixel_offset;
-    Uint32 palette_offset;
-    Uint32 pitch;
-} ComputeJob;
-static ComputeJob s_compute_jobs[MAX_COMPUTE_JOBS];
-static int s_compute_job_count = 0;
+    Uint32 offset; // Byte offset in the staging buffer
+    Uint32 rows;   // TEX_ARRAY_SIZE-byte rows
+} TextureUpload;
+static TextureUpload s_texture_uploads[MAX_TEXTURE_UPLOADS];
+static int s_texture_upload_count = 0;
 
 #define MAX_VERTICES 65536
 #define MAX_QUADS (MAX_VERTICES / 4)
@@ -127,8 +154,8 @@ static QuadSortKey quad_sort_temp[MAX_QUADS];
 typedef struct GPUVertex {
     float x, y;
     float r, g, b, a;
-    float u, v;
-    float layer;
+    float u, v;     // Texels
+    Uint32 info[4]; // Layer | format << 16, palette slot, width, height
 } GPUVertex;
 
 // --- CLUT Shuffle for PS2 ---
@@ -190,40 +217,6 @@ static SDL_GPUShader* CreateGPUShader(const char* filename, SDL_GPUShaderStage s
     return shader;
 }
 
-static SDL_GPUComputePipeline* CreateGPUComputePipeline(const char* filename) {
-    size_t size;
-    void* code = LoadShaderCode(filename, &size);
-    if (!code)
-        return NULL;
-
-    SDL_ShaderCross_SPIRV_Info info;
-    SDL_zero(info);
-    info.bytecode = (const Uint8*)code;
-    info.bytecode_size = size;
-    info.entrypoint = "main";
-    info.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_COMPUTE;
-
-    SDL_ShaderCross_ComputePipelineMetadata* metadata =
-        SDL_ShaderCross_ReflectComputeSPIRV(info.bytecode, info.bytecode_size, 0);
-
-    if (!metadata) {
-        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to reflect Compute SPIRV: %s", filename);
-        SDL_free(code);
-        return NULL;
-    }
-
-    SDL_GPUComputePipeline* pipeline = SDL_ShaderCross_CompileComputePipelineFromSPIRV(device, &info, metadata, 0);
-
-    if (!pipeline) {
-        SDL_LogError(
-            SDL_LOG_CATEGORY_RENDER, "CompileComputePipelineFromSPIRV failed for %s: %s", filename, SDL_GetError());
-    }
-
-    SDL_free(metadata);
-    SDL_free(code);
-    return pipeline;
-}
-
 /** @brief Initialize the SDL_GPU renderer backend (Device, Window, Shaders, Pipelines). */
 void SDLGameRendererGPU_Init(void) {
     SDL_Log("SDLGameRendererGPU_Init: Initializing SDL_GPU renderer backend.");
@@ -244,28 +237,16 @@ void SDLGameRendererGPU_Init(void) {
     const char* base_path = SDL_GetBasePath();
     char vert_path[1024];
     char frag_path[1024];
-    char comp_path[1024];
-    snprintf(vert_path, sizeof(vert_path), "%sshaders/vert.spv", base_path);
-    snprintf(frag_path, sizeof(frag_path), "%sshaders/scene.spv", base_path);
-    snprintf(comp_path, sizeof(comp_path), "%sshaders/palette_convert.comp.spv", base_path);
+    snprintf(vert_path, sizeof(vert_path), "%sshaders/scene_indexed.vert.spv", base_path);
+    snprintf(frag_path, sizeof(frag_path), "%sshaders/scene_indexed.frag.spv", base_path);
 
     SDL_GPUShader* vert_shader = CreateGPUShader(vert_path, SDL_GPU_SHADERSTAGE_VERTEX);
     SDL_GPUShader* frag_shader = CreateGPUShader(frag_path, SDL_GPU_SHADERSTAGE_FRAGMENT);
-    s_compute_pipeline = CreateGPUComputePipeline(comp_path);
 
     if (!vert_shader || !frag_shader) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to create graphics shaders.");
         return;
     }
-    if (!s_compute_pipeline) {
-        SDL_LogError(SDL_LOG_CATEGORY_RENDER,
-                     "Failed to create compute pipeline: %s. "
-                     "GPU backend requires compute shader support. "
-                     "Use --renderer gl for devices without compute shaders.",
-                     SDL_GetError());
-        return;
-    }
-    SDL_Log("GPU Compute palette conversion pipeline initialized successfully.");
 
     // Create Graphics Pipeline
     SDL_GPUGraphicsPipelineCreateInfo pipeline_info;
@@ -291,10 +272,10 @@ void SDLGameRendererGPU_Init(void) {
     attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
     attributes[2].offset = 6 * sizeof(float);
     attributes[2].buffer_slot = 0;
-    // Layer
+    // Texture info (layer/format, palette, size)
     attributes[3].location = 3;
-    attributes[3].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT;
-    attributes[3].offset = 8 * sizeof(float);
+    attributes[3].format = SDL_GPU_VERTEXELEMENTFORMAT_UINT4;
+    attributes[3].offset = offsetof(GPUVertex, info);
     attributes[3].buffer_slot = 0;
 
     pipeline_info.vertex_input_state.vertex_attributes = attributes;
@@ -303,7 +284,7 @@ void SDLGameRendererGPU_Init(void) {
     SDL_GPUVertexBufferDescription bindings[1];
     SDL_zero(bindings);
     bindings[0].slot = 0;
-    bindings[0].pitch = 9 * sizeof(float);
+    bindings[0].pitch = sizeof(GPUVertex);
     bindings[0].input_rate = SDL_GPU_VERTEXINPUTRATE_VERTEX;
 
     pipeline_info.vertex_input_state.vertex_buffer_descriptions = bindings;
@@ -355,15 +336,15 @@ void SDLGameRendererGPU_Init(void) {
         transfer_buffers[i] = SDL_CreateGPUTransferBuffer(device, &tb_info);
     }
 
-    // Create Compute Storage Buffer (GPU Resident)
-    SDL_GPUBufferCreateInfo sb_info = { .usage = SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
-                                        .size = COMPUTE_STORAGE_SIZE };
-    s_compute_storage_buffer = SDL_CreateGPUBuffer(device, &sb_info);
+    // Create Palette Storage Buffer (read by the fragment shader)
+    SDL_GPUBufferCreateInfo pb_info = { .usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ,
+                                        .size = PALETTE_BUFFER_SIZE };
+    palette_buffer = SDL_CreateGPUBuffer(device, &pb_info);
 
-    // Create Compute Staging Buffer (Transfer)
+    // Create Upload Staging Buffer (Transfer)
     SDL_GPUTransferBufferCreateInfo ttb_info = { .usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
-                                                 .size = COMPUTE_STORAGE_SIZE };
-    s_compute_staging_buffer = SDL_CreateGPUTransferBuffer(device, &ttb_info);
+                                                 .size = UPLOAD_STAGING_SIZE };
+    s_upload_staging_buffer = SDL_CreateGPUTransferBuffer(device, &ttb_info);
 
     // Create Index Buffer (Static Quad Indices)
     const int max_quads = MAX_VERTICES / 4;
@@ -379,8 +360,7 @@ void SDLGameRendererGPU_Init(void) {
         if (!transfer_buffers[i])
             any_transfer_missing = true;
     }
-    if (!vertex_buffer || any_transfer_missing || !s_compute_staging_buffer || !index_buffer ||
-        !s_compute_storage_buffer) {
+    if (!vertex_buffer || any_transfer_missing || !s_upload_staging_buffer || !index_buffer || !palette_buffer) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Failed to create GPU buffers: %s", SDL_GetError());
         return;
     }
@@ -437,9 +417,8 @@ void SDLGameRendererGPU_Init(void) {
     SDL_GPUTextureCreateInfo tex_info;
     SDL_zero(tex_info);
     tex_info.type = SDL_GPU_TEXTURETYPE_2D_ARRAY;
-    tex_info.format = SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
-    // Note: Added COMPUTE_STORAGE_WRITE usage
-    tex_info.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER | SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE;
+    tex_info.format = SDL_GPU_TEXTUREFORMAT_R8_UINT;
+    tex_info.usage = SDL_GPU_TEXTUREUSAGE_SAMPLER;
     tex_info.width = TEX_ARRAY_SIZE;
     tex_info.height = TEX_ARRAY_SIZE;
     tex_info.layer_count_or_depth = TEX_ARRAY_MAX_LAYERS;
@@ -465,13 +444,12 @@ void SDLGameRendererGPU_Init(void) {
     }
 
     // Init free list (layers 0..MAX-1)
-    // Note: We used to clear layer 0 to white, but now we can just leave it or clear via compute later if needed.
-    // For simplicity, we initialize all layers as free.
     tex_array_free_count = TEX_ARRAY_MAX_LAYERS;
     for (int i = 0; i < tex_array_free_count; i++) {
         tex_array_free[i] = TEX_ARRAY_MAX_LAYERS - 1 - i;
     }
     memset(tex_array_layer, -1, sizeof(tex_array_layer));
+    SDL_zeroa(tex_array_stale);
 
     SDL_Log("SDLGameRendererGPU_Init: Complete.");
 }
@@ -480,8 +458,6 @@ void SDLGameRendererGPU_Init(void) {
 void SDLGameRendererGPU_Shutdown(void) {
     if (pipeline)
         SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
-    if (s_compute_pipeline)
-        SDL_ReleaseGPUComputePipeline(device, s_compute_pipeline);
     if (vertex_buffer)
         SDL_ReleaseGPUBuffer(device, vertex_buffer);
     if (index_buffer)
@@ -490,10 +466,10 @@ void SDLGameRendererGPU_Shutdown(void) {
         if (transfer_buffers[i])
             SDL_ReleaseGPUTransferBuffer(device, transfer_buffers[i]);
     }
-    if (s_compute_staging_buffer)
-        SDL_ReleaseGPUTransferBuffer(device, s_compute_staging_buffer);
-    if (s_compute_storage_buffer)
-        SDL_ReleaseGPUBuffer(device, s_compute_storage_buffer);
+    if (s_upload_staging_buffer)
+        SDL_ReleaseGPUTransferBuffer(device, s_upload_staging_buffer);
+    if (palette_buffer)
+        SDL_ReleaseGPUBuffer(device, palette_buffer);
     if (texture_array)
         SDL_ReleaseGPUTexture(device, texture_array);
     if (s_canvas_texture)
@@ -517,12 +493,7 @@ void SDLGameRendererGPU_BeginFrame(void) {
     // Drain dirty-index lists
     for (int d = 0; d < dirty_texture_count; d++) {
         const int i = dirty_texture_indices[d];
-        for (int pal = 0; pal <= FL_PALETTE_MAX; ++pal) {
-            if (tex_array_layer[i][pal] >= 0) {
-                tex_array_free[tex_array_free_count++] = tex_array_layer[i][pal];
-                tex_array_layer[i][pal] = -1;
-            }
-        }
+        release_texture_layer(i);
         if (surfaces[i]) {
             SDL_DestroySurface(surfaces[i]);
             surfaces[i] = NULL;
@@ -534,16 +505,6 @@ void SDLGameRendererGPU_BeginFrame(void) {
 
     for (int d = 0; d < dirty_palette_count; d++) {
         const int i = dirty_palette_indices[d];
-        for (int tex = 0; tex < FL_TEXTURE_MAX; ++tex) {
-            if (tex_array_layer[tex][i + 1] >= 0) {
-                tex_array_free[tex_array_free_count++] = tex_array_layer[tex][i + 1];
-                tex_array_layer[tex][i + 1] = -1;
-            }
-        }
-        if (palettes[i]) {
-            SDL_DestroyPalette(palettes[i]);
-            palettes[i] = NULL;
-        }
         SDLGameRendererGPU_CreatePalette((i + 1) << 16);
         palette_dirty_flags[i] = false;
     }
@@ -552,21 +513,21 @@ void SDLGameRendererGPU_BeginFrame(void) {
     current_transfer_idx = (current_transfer_idx + 1) % VERTEX_TRANSFER_BUFFER_COUNT;
     mapped_vertex_ptr = (float*)SDL_MapGPUTransferBuffer(device, transfer_buffers[current_transfer_idx], true);
 
-    // Map Compute Staging Buffer for the frame
-    s_compute_staging_ptr = (u8*)SDL_MapGPUTransferBuffer(device, s_compute_staging_buffer, true);
-    s_compute_staging_offset = 0;
+    // Map Upload Staging Buffer for the frame
+    s_upload_staging_ptr = (u8*)SDL_MapGPUTransferBuffer(device, s_upload_staging_buffer, true);
+    s_upload_staging_offset = 0;
 
     vertex_count = 0;
     quad_count = 0;
     texture_count = 0;
-    s_compute_job_count = 0;
+    s_texture_upload_count = 0;
 
-    if (s_compute_drops_last_frame > 0) {
+    if (s_upload_stats_last_frame.drops > 0) {
         SDL_LogWarn(SDL_LOG_CATEGORY_RENDER,
-                    "Compute staging overflow: dropped %d texture(s) last frame",
-                    s_compute_drops_last_frame);
+                    "Texture uploads: dropped %u texture(s) last frame",
+                    s_upload_stats_last_frame.drops);
     }
-    s_compute_drops_last_frame = 0;
+    s_upload_drops = 0;
 
     TRACE_ZONE_END();
 }
@@ -609,6 +570,11 @@ static void stable_sort_quads(void) {
     }
 }
 
+/** @brief qsort comparator for palette slot indices. */
+static int compare_palette_index(const void* a, const void* b) {
+    return *(const int*)a - *(const int*)b;
+}
+
 /** @brief Flush buffered vertices to the GPU and execute the render pass. */
 void SDLGameRendererGPU_RenderFrame(void) {
     TRACE_ZONE_N("GPU:RenderFrame");
@@ -645,21 +611,77 @@ void SDLGameRendererGPU_RenderFrame(void) {
     SDL_UnmapGPUTransferBuffer(device, transfer_buffers[current_transfer_idx]);
     mapped_vertex_ptr = NULL;
 
+    // Stage palettes changed this frame after the textures; only their final colors are uploaded.
+    // Runs of adjacent slots (a character's ColorRAM rows, say) go up as one contiguous copy.
+    const size_t texture_bytes = s_upload_staging_offset;
+    int palette_uploads = 0;
+    int palette_runs = 0;
+    PaletteRun runs[FL_PALETTE_MAX];
+    if (s_upload_staging_ptr && palette_upload_count > 0) {
+        SDL_qsort(palette_upload_indices, palette_upload_count, sizeof(int), compare_palette_index);
+
+        while (palette_uploads < palette_upload_count) {
+            const int first = palette_upload_indices[palette_uploads];
+            int n = 1;
+            while (palette_uploads + n < palette_upload_count &&
+                   palette_upload_indices[palette_uploads + n] == first + n) {
+                n++;
+            }
+
+            const int last = first + n - 1;
+            const size_t size = ((size_t)(n - 1) * PALETTE_SLOT_COLORS + palette_color_count[last]) * sizeof(Uint32);
+            if (s_upload_staging_offset + size > UPLOAD_STAGING_SIZE)
+                break;
+
+            runs[palette_runs].first = first;
+            runs[palette_runs].size = (Uint32)size;
+            runs[palette_runs].offset = (Uint32)s_upload_staging_offset;
+            palette_runs++;
+
+            memcpy(s_upload_staging_ptr + s_upload_staging_offset, palette_colors[first], size);
+            s_upload_staging_offset += size;
+            for (int i = 0; i < n; i++) {
+                palette_upload_flags[first + i] = false;
+            }
+            palette_uploads += n;
+        }
+    }
+
     // Unmap staging buffer
-    SDL_UnmapGPUTransferBuffer(device, s_compute_staging_buffer);
-    s_compute_staging_ptr = NULL;
+    SDL_UnmapGPUTransferBuffer(device, s_upload_staging_buffer);
+    s_upload_staging_ptr = NULL;
+
+    s_upload_stats_last_frame.texture_bytes = (unsigned int)texture_bytes;
+    s_upload_stats_last_frame.palette_bytes = (unsigned int)(s_upload_staging_offset - texture_bytes);
+    s_upload_stats_last_frame.drops = (unsigned int)s_upload_drops;
 
-    // --- 1. Copy Pass (Buffers) ---
-    if (s_compute_staging_offset > 0 || vertex_count > 0 || index_count > 0) {
+    // --- 1. Copy Pass (Textures, Palettes, Buffers) ---
+    if (s_upload_staging_offset > 0 || vertex_count > 0 || index_count > 0) {
         SDL_GPUCopyPass* copy_pass = SDL_BeginGPUCopyPass(current_cmd_buf);
 
-        // Upload Compute Staging -> Compute Storage
-        if (s_compute_staging_offset > 0) {
-            SDL_GPUTransferBufferLocation src = { .transfer_buffer = s_compute_staging_buffer, .offset = 0 };
-            SDL_GPUBufferRegion dst = { .buffer = s_compute_storage_buffer,
-                                        .offset = 0,
-                                        .size = s_compute_staging_offset };
-            SDL_UploadToGPUBuffer(copy_pass, &src, &dst, true);
+        // Upload raw texture bytes into their array layers
+        for (int i = 0; i < s_texture_upload_count; i++) {
+            const TextureUpload* upload = &s_texture_uploads[i];
+            SDL_GPUTextureTransferInfo src = { .transfer_buffer = s_upload_staging_buffer,
+                                               .offset = upload->offset,
+                                               .pixels_per_row = TEX_ARRAY_SIZE,
+                                               .rows_per_layer = upload->rows };
+            SDL_GPUTextureRegion dst = { .texture = texture_array,
+                                         .layer = upload->layer,
+                                         .w = TEX_ARRAY_SIZE,
+                                         .h = upload->rows,
+                                         .d = 1 };
+            SDL_UploadToGPUTexture(copy_pass, &src, &dst, false);
+        }
+
+        // Upload changed palettes into their slots, one region per run
+        for (int i = 0; i < palette_runs; i++) {
+            SDL_GPUTransferBufferLocation src = { .transfer_buffer = s_upload_staging_buffer,
+                                                  .offset = runs[i].offset };
+            SDL_GPUBufferRegion dst = { .buffer = palette_buffer,
+                                        .offset = (Uint32)(runs[i].first * PALETTE_SLOT_COLORS * sizeof(Uint32)),
+                                        .size = runs[i].size };
+            SDL_UploadToGPUBuffer(copy_pass, &src, &dst, false);
         }
 
         // Upload Vertex Data
@@ -682,46 +704,11 @@ void SDLGameRendererGPU_RenderFrame(void) {
         SDL_EndGPUCopyPass(copy_pass);
     }
 
-    // --- 2. Compute Pass (Palette Conversion) ---
-    if (s_compute_job_count > 0 && s_compute_pipeline) {
-        // Each job needs a different array layer as write target.
-        // Read-write storage textures must be bound at pass creation via
-        // SDL_BeginGPUComputePass, so we create one pass per job.
+    // Palettes that didn't fit stay queued for the next frame
+    palette_upload_count -= palette_uploads;
+    memmove(palette_upload_indices, palette_upload_indices + palette_uploads, palette_upload_count * sizeof(int));
 
-        for (int i = 0; i < s_compute_job_count; i++) {
-            ComputeJob* job = &s_compute_jobs[i];
-
-            SDL_GPUStorageTextureReadWriteBinding rw_binding = {
-                .texture = texture_array, .mip_level = 0, .layer = job->layer, .cycle = false
-            };
-
-            SDL_GPUComputePass* compute_pass =
-                SDL_BeginGPUComputePass(current_cmd_buf,
-                                        &rw_binding,
-                                        1, // Read-write storage texture (imageStore target)
-                                        NULL,
-                                        0 // No read-write storage buffers
-                );
-
-            SDL_BindGPUComputePipeline(compute_pass, s_compute_pipeline);
-
-            // Bind raw pixel+palette data as read-only storage buffer
-            SDL_GPUBuffer* storage_buffers[] = { s_compute_storage_buffer };
-            SDL_BindGPUComputeStorageBuffers(compute_pass, 0, storage_buffers, 1);
-
-            Uint32 uniforms[7] = { job->width,        job->height,         job->format, 0,
-                                   job->pixel_offset, job->palette_offset, job->pitch };
-            SDL_PushGPUComputeUniformData(current_cmd_buf, 0, uniforms, sizeof(uniforms));
-
-            uint32_t group_x = (job->width + 7) / 8;
-            uint32_t group_y = (job->height + 7) / 8;
-            SDL_DispatchGPUCompute(compute_pass, group_x, group_y, 1);
-
-            SDL_EndGPUComputePass(compute_pass);
-        }
-    }
-
-    // --- 3. Render Pass ---
+    // --- 2. Render Pass ---
     if (s_canvas_texture) {
         SDL_GPUColorTargetInfo color_target;
         SDL_zero(color_target);
@@ -770,6 +757,7 @@ void SDLGameRendererGPU_RenderFrame(void) {
                 tex_binding.texture = texture_array;
                 tex_binding.sampler = sampler;
                 SDL_BindGPUFragmentSamplers(pass, 0, &tex_binding, 1);
+                SDL_BindGPUFragmentStorageBuffers(pass, 0, &palette_buffer, 1);
 
                 SDL_DrawGPUIndexedPrimitives(pass, index_count, 1, 0, 0, 0);
             }
@@ -831,6 +819,8 @@ void SDLGameRendererGPU_CreateTexture(unsigned int th) {
 
     surfaces[texture_index] =
         SDL_CreateSurfaceFrom(fl_texture->width, fl_texture->height, pixel_format, (void*)pixels, pitch);
+    if (tex_array_layer[texture_index] >= 0)
+        tex_array_stale[texture_index] = true;
 }
 
 /** @brief Mark a texture for destruction. */
@@ -849,7 +839,7 @@ void SDLGameRendererGPU_DestroyTexture(unsigned int texture_handle) {
     }
 }
 
-/** @brief Create a CPU-side palette. */
+/** @brief Convert a palette to RGBA8 and queue it for upload to its slot. */
 void SDLGameRendererGPU_CreatePalette(unsigned int ph) {
     const int palette_index = HI_16_BITS(ph) - 1;
     if (palette_index < 0 || palette_index >= FL_PALETTE_MAX)
@@ -890,22 +880,27 @@ void SDLGameRendererGPU_CreatePalette(unsigned int ph) {
         }
         colors[0].a = 0;
         break;
+    default:
+        return;
     }
 
-    if (palettes[palette_index])
-        SDL_DestroyPalette(palettes[palette_index]);
-    palettes[palette_index] = SDL_CreatePalette(color_count);
-    SDL_SetPaletteColors(palettes[palette_index], colors, 0, color_count);
+    Uint32* slot = palette_colors[palette_index];
+    for (int i = 0; i < color_count; i++) {
+        const SDL_Color c = colors[i];
+        slot[i] = ((Uint32)c.a << 24) | ((Uint32)c.b << 16) | ((Uint32)c.g << 8) | c.r;
+    }
+    palette_color_count[palette_index] = color_count;
+
+    if (!palette_upload_flags[palette_index]) {
+        palette_upload_flags[palette_index] = true;
+        palette_upload_indices[palette_upload_count++] = palette_index;
+    }
 }
 
 /** @brief Mark a palette for destruction. */
 void SDLGameRendererGPU_DestroyPalette(unsigned int palette_handle) {
     const int idx = palette_handle - 1;
     if (idx >= 0 && idx < FL_PALETTE_MAX) {
-        if (palettes[idx]) {
-            SDL_DestroyPalette(palettes[idx]);
-            palettes[idx] = NULL;
-        }
         if (!palette_dirty_flags[idx]) {
             palette_dirty_flags[idx] = true;
             dirty_palette_indices[dirty_palette_count++] = idx;
@@ -935,18 +930,15 @@ void SDLGameRendererGPU_UnlockTexture(unsigned int th) {
             break;
         }
         if (pixels && data_size > 0) {
-            uint32_t new_hash = hash_memory(pixels, data_size);
+            const uint64_t new_hash = ContentHash_Compute(pixels, data_size);
             if (new_hash == texture_hash[idx]) {
                 return;
             }
             texture_hash[idx] = new_hash;
         }
-        for (int pal = 0; pal <= FL_PALETTE_MAX; ++pal) {
-            if (tex_array_layer[idx][pal] >= 0) {
-                tex_array_free[tex_array_free_count++] = tex_array_layer[idx][pal];
-                tex_array_layer[idx][pal] = -1;
-            }
-        }
+        // Keep the layer; SetTexture re-uploads the new bytes into it
+        if (tex_array_layer[idx] >= 0)
+            tex_array_stale[idx] = true;
     }
 }
 
@@ -959,27 +951,39 @@ void SDLGameRendererGPU_UnlockPalette(unsigned int ph) {
         size_t color_size = (fl_pal->format == SCE_GS_PSMCT32) ? 4 : 2;
         size_t data_size = color_count * color_size;
         if (pixels && data_size > 0) {
-            uint32_t new_hash = hash_memory(pixels, data_size);
+            const uint64_t new_hash = ContentHash_Compute(pixels, data_size);
             if (new_hash == palette_hash[idx]) {
                 return;
             }
             palette_hash[idx] = new_hash;
         }
-        for (int tex = 0; tex < FL_TEXTURE_MAX; ++tex) {
-            if (tex_array_layer[tex][idx + 1] >= 0) {
-                tex_array_free[tex_array_free_count++] = tex_array_layer[tex][idx + 1];
-                tex_array_layer[tex][idx + 1] = -1;
-            }
-        }
-        if (palettes[idx]) {
-            SDL_DestroyPalette(palettes[idx]);
-            palettes[idx] = NULL;
-        }
+        // Textures sample the palette slot directly, so none of them need touching
         SDLGameRendererGPU_CreatePalette((idx + 1) << 16);
     }
 }
 
-/** @brief Prepare a texture for rendering, uploading to the GPU array if needed. */
+/** @brief Stage a texture's raw bytes for upload into its array layer. Returns false if it doesn't fit. */
+static bool stage_texture_upload(int texture_index, const SDL_Surface* surface) {
+    const size_t data_size = (size_t)surface->h * surface->pitch;
+    const Uint32 rows = (Uint32)((data_size + TEX_ARRAY_SIZE - 1) / TEX_ARRAY_SIZE);
+    const size_t staged_size = (size_t)rows * TEX_ARRAY_SIZE;
+
+    if (!s_upload_staging_ptr || s_texture_upload_count >= MAX_TEXTURE_UPLOADS ||
+        s_upload_staging_offset + staged_size > UPLOAD_STAGING_SIZE) {
+        return false;
+    }
+
+    // The layer is addressed linearly, so the PS2 bytes are copied as-is with no conversion
+    TextureUpload* upload = &s_texture_uploads[s_texture_upload_count++];
+    upload->layer = (Uint32)tex_array_layer[texture_index];
+    upload->offset = (Uint32)s_upload_staging_offset;
+    upload->rows = rows;
+    memcpy(s_upload_staging_ptr + s_upload_staging_offset, surface->pixels, data_size);
+    s_upload_staging_offset += staged_size;
+    return true;
+}
+
+/** @brief Prepare a texture for rendering, uploading its indexed data to the GPU array if needed. */
 void SDLGameRendererGPU_SetTexture(unsigned int th) {
     TRACE_ZONE_N("GPU:SetTexture");
     if ((th & 0xFFFF) == 0)
@@ -992,93 +996,65 @@ void SDLGameRendererGPU_SetTexture(unsigned int th) {
         return;
     }
 
-    if (!surfaces[texture_handle - 1]) {
+    const int texture_index = texture_handle - 1;
+    const SDL_Surface* surface = surfaces[texture_index];
+    if (!surface) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Texture %d has no surface!", texture_handle);
         TRACE_ZONE_END();
         return;
     }
 
-    int layer = tex_array_layer[texture_handle - 1][palette_handle];
+    if ((size_t)surface->h * surface->pitch > TEX_LAYER_BYTES) {
+        SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Texture %d is too large for an array layer", texture_handle);
+        TRACE_ZONE_END();
+        return;
+    }
 
-    if (layer < 0) {
-        if (tex_array_free_count > 0 && s_compute_staging_ptr) {
-            layer = tex_array_free[--tex_array_free_count];
-            tex_array_layer[texture_handle - 1][palette_handle] = layer;
-
-            SDL_Surface* surface = surfaces[texture_handle - 1];
-            const SDL_Palette* palette = (palette_handle > 0) ? palettes[palette_handle - 1] : NULL;
-            const FLTexture* fl_texture = &flTexture[texture_handle - 1];
-
-            // Calculate sizes
-            // Pitch is already in surface->pitch (which comes from fl_texture->width or (width+1)/2)
-            size_t pixel_data_size = surface->h * surface->pitch;
-            size_t palette_data_size = 0;
-            if (palette)
-                palette_data_size = palette->ncolors * 4; // RGBA8888 packed
-
-            size_t total_size = pixel_data_size + palette_data_size;
-
-            // Check if we have space in staging buffer
-            if (s_compute_job_count < MAX_COMPUTE_JOBS &&
-                s_compute_staging_offset + total_size <= COMPUTE_STORAGE_SIZE) {
-
-                // Copy Pixel Data
-                Uint32 pixel_offset = (Uint32)s_compute_staging_offset;
-                memcpy(s_compute_staging_ptr + s_compute_staging_offset, surface->pixels, pixel_data_size);
-                s_compute_staging_offset += pixel_data_size;
-
-                // Ensure 4-byte alignment for palette data (required for u32* cast and Shader uint reading)
-                s_compute_staging_offset = (s_compute_staging_offset + 3) & ~3;
-
-                // Copy Palette Data
-                Uint32 palette_offset = 0;
-                if (palette) {
-                    palette_offset = (Uint32)s_compute_staging_offset;
-                    u32* pal_dest = (u32*)(s_compute_staging_ptr + s_compute_staging_offset);
-                    for (int i = 0; i < palette->ncolors; i++) {
-                        SDL_Color c = palette->colors[i];
-                        // Pack RGBA8888
-                        pal_dest[i] = (c.a << 24) | (c.b << 16) | (c.g << 8) | c.r;
-                    }
-                    s_compute_staging_offset += palette_data_size;
-                }
-
-                // Add Job
-                ComputeJob* job = &s_compute_jobs[s_compute_job_count++];
-                job->width = surface->w;
-                job->height = surface->h;
-                job->layer = layer;
-                job->pixel_offset = pixel_offset;
-                job->palette_offset = palette_offset; // Byte offset
-                job->pitch = surface->pitch;
-
-                if (fl_texture->format == SCE_GS_PSMT4)
-                    job->format = 1;
-                else if (fl_texture->format == SCE_GS_PSMCT16)
-                    job->format = 2;
-                else
-                    job->format = 0; // 8-bit
+    bool needs_upload = tex_array_stale[texture_index];
+    if (tex_array_layer[texture_index] < 0 && tex_array_free_count > 0) {
+        tex_array_layer[texture_index] = (int16_t)tex_array_free[--tex_array_free_count];
+        needs_upload = true;
+    }
 
-            } else {
-                s_compute_drops_last_frame++;
-                tex_array_free[tex_array_free_count++] = layer;
-                tex_array_layer[texture_handle - 1][palette_handle] = -1;
-            }
+    int layer = tex_array_layer[texture_index];
+    if (layer < 0) {
+        s_upload_drops++;
+    } else if (needs_upload) {
+        if (stage_texture_upload(texture_index, surface)) {
+            tex_array_stale[texture_index] = false;
+        } else {
+            // Retried on the next SetTexture; don't draw whatever the layer held
+            s_upload_drops++;
+            release_texture_layer(texture_index);
+            layer = -1;
         }
     }
 
     if (texture_count >= FL_PALETTE_MAX) {
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Texture stack overflow!");
+        TRACE_ZONE_END();
         return;
     }
 
-    if (layer < 0)
-        layer = 0;
+    Uint32 format;
+    switch (flTexture[texture_index].format) {
+    case SCE_GS_PSMT4:
+        format = GPU_TEX_FORMAT_4BIT;
+        break;
+    case SCE_GS_PSMCT16:
+        format = GPU_TEX_FORMAT_16BIT;
+        break;
+    default:
+        format = GPU_TEX_FORMAT_8BIT;
+        break;
+    }
 
-    texture_layers[texture_count] = layer;
-    texture_uv_sx[texture_count] = (float)surfaces[texture_handle - 1]->w / TEX_ARRAY_SIZE;
-    texture_uv_sy[texture_count] = (float)surfaces[texture_handle - 1]->h / TEX_ARRAY_SIZE;
-    texture_count++;
+    GPUTextureState* state = &texture_states[texture_count++];
+    state->layer = layer;
+    state->info[0] = (Uint32)SDL_max(layer, 0) | (format << 16);
+    state->info[1] = (palette_handle > 0) ? (Uint32)(palette_handle - 1) : 0;
+    state->info[2] = (Uint32)surface->w;
+    state->info[3] = (Uint32)surface->h;
     TRACE_ZONE_END();
 }
 
@@ -1086,13 +1062,17 @@ static void draw_quad(const SDLGameRenderer_Vertex* vertices, bool textured) {
     if (!mapped_vertex_ptr || vertex_count + 4 > MAX_VERTICES)
         return;
 
-    float layer = 0.0f;
+    static const Uint32 solid_info[4] = { GPU_TEX_FORMAT_NONE << 16, 0, 1, 1 };
+    const Uint32* info = solid_info;
     float uv_sx = 1.0f, uv_sy = 1.0f;
 
     if (textured && texture_count > 0) {
-        layer = (float)texture_layers[texture_count - 1];
-        uv_sx = texture_uv_sx[texture_count - 1];
-        uv_sy = texture_uv_sy[texture_count - 1];
+        const GPUTextureState* state = &texture_states[texture_count - 1];
+        if (state->layer < 0)
+            return;
+        info = state->info;
+        uv_sx = (float)state->info[2];
+        uv_sy = (float)state->info[3];
     }
 
     GPUVertex* v = (GPUVertex*)(mapped_vertex_ptr) + vertex_count;
@@ -1103,45 +1083,17 @@ static void draw_quad(const SDLGameRenderer_Vertex* vertices, bool textured) {
     float r = ((c >> 16) & 0xFF) / 255.0f;
     float a = ((c >> 24) & 0xFF) / 255.0f;
 
-    v[0].x = vertices[0].coord.x;
-    v[0].y = vertices[0].coord.y;
-    v[0].r = r;
-    v[0].g = g;
-    v[0].b = b;
-    v[0].a = a;
-    v[0].u = vertices[0].tex_coord.s * uv_sx;
-    v[0].v = vertices[0].tex_coord.t * uv_sy;
-    v[0].layer = layer;
-
-    v[1].x = vertices[1].coord.x;
-    v[1].y = vertices[1].coord.y;
-    v[1].r = r;
-    v[1].g = g;
-    v[1].b = b;
-    v[1].a = a;
-    v[1].u = vertices[1].tex_coord.s * uv_sx;
-    v[1].v = vertices[1].tex_coord.t * uv_sy;
-    v[1].layer = layer;
-
-    v[2].x = vertices[2].coord.x;
-    v[2].y = vertices[2].coord.y;
-    v[2].r = r;
-    v[2].g = g;
-    v[2].b = b;
-    v[2].a = a;
-    v[2].u = vertices[2].tex_coord.s * uv_sx;
-    v[2].v = vertices[2].tex_coord.t * uv_sy;
-    v[2].layer = layer;
-
-    v[3].x = vertices[3].coord.x;
-    v[3].y = vertices[3].coord.y;
-    v[3].r = r;
-    v[3].g = g;
-    v[3].b = b;
-    v[3].a = a;
-    v[3].u = vertices[3].tex_coord.s * uv_sx;
-    v[3].v = vertices[3].tex_coord.t * uv_sy;
-    v[3].layer = layer;
+    for (int i = 0; i < 4; i++) {
+        v[i].x = vertices[i].coord.x;
+        v[i].y = vertices[i].coord.y;
+        v[i].r = r;
+        v[i].g = g;
+        v[i].b = b;
+        v[i].a = a;
+        v[i].u = vertices[i].tex_coord.s * uv_sx;
+        v[i].v = vertices[i].tex_coord.t * uv_sy;
+        SDL_memcpy(v[i].info, info, sizeof(v[i].info));
+    }
 
     if (quad_count < MAX_QUADS) {
         quad_sort_keys[quad_count].z = flPS2ConvScreenFZ(vertices[0].coord.z);
@@ -1242,6 +1194,10 @@ unsigned int SDLGameRendererGPU_GetCachedGLTexture(unsigned int texture_handle,
     return 0; // Not applicable
 }
 
+void SDLGameRendererGPU_GetUploadStats(SDLGameRenderer_UploadStats* stats) {
+    *stats = s_upload_stats_last_frame;
+}
+
 SDL_GPUTexture* SDLGameRendererGPU_GetSwapchainTexture(void) {
     if (!s_swapchain_texture && current_cmd_buf && window) {
         if (!SDL_AcquireGPUSwapchainTexture(current_cmd_buf, window, &s_swapchain_texture, NULL, NULL)) {
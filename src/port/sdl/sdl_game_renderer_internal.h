@@ -47,6 +47,7 @@ void SDLGameRendererGPU_DrawSolidQuad(const Quad* vertices, unsigned int color);
 void SDLGameRendererGPU_DrawSprite(const Sprite* sprite, unsigned int color);
 void SDLGameRendererGPU_DrawSprite2(const Sprite2* sprite2);
 unsigned int SDLGameRendererGPU_GetCachedGLTexture(unsigned int texture_handle, unsigned int palette_handle);
+void SDLGameRendererGPU_GetUploadStats(SDLGameRenderer_UploadStats* stats);
 
 // SDL2D Backend (SDL_Renderer software/accelerated 2D)
 void SDLGameRendererSDL_Init(void);
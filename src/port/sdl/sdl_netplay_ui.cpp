@@ -22,7 +22,11 @@
 #include "netplay/lobby_server.h"
 #include "netplay/stun.h"
 #include "netplay/upnp.h"
+#include "port/broadcast.h"
 #include "port/config.h"
+#include "port/recorder.h"
+#include "port/sdl/sdl_text_renderer.h"
+#include "sf33rd/Source/Game/rendering/cashstats.h"
 
 static bool hud_visible = true;
 static bool diagnostics_visible = false;
@@ -42,6 +46,12 @@ static int lobby_server_player_count = 0;
 static uint32_t lobby_server_last_poll = 0;
 static char lobby_my_player_id[64] = { 0 };
 #define LOBBY_POLL_INTERVAL_MS 2000
+#define LOBBY_PRESENCE_INTERVAL_MS 10000 // Presence refresh while long-polling (server expires at 60s)
+#define LOBBY_WAIT_TIMEOUT_MS 20000       // Server holds a long-poll at most this long
+
+// Lobby version last seen via long-poll; -1 = server has no long-poll, use interval polling
+static SDL_AtomicInt lobby_server_version = { 0 };
+static SDL_AtomicInt lobby_poll_failed = { 0 };
 
 // Async state machine
 enum LobbyAsyncState {
@@ -82,16 +92,21 @@ typedef struct {
     char display_name[64];
     char room_code[32];
     char connect_to[32];
+    bool start_searching;
 } AsyncPresenceData;
 
 static int SDLCALL async_presence_fn(void* data) {
     AsyncPresenceData* d = (AsyncPresenceData*)data;
-    LobbyServer_UpdatePresence(d->player_id, d->display_name, "", d->room_code, d->connect_to);
+    if (d->start_searching)
+        LobbyServer_UpdatePresenceAndStartSearching(d->player_id, d->display_name, "", d->room_code, d->connect_to);
+    else
+        LobbyServer_UpdatePresence(d->player_id, d->display_name, "", d->room_code, d->connect_to);
     free(d);
     return 0;
 }
 
-static void AsyncUpdatePresence(const char* pid, const char* disp, const char* rc, const char* ct) {
+static void AsyncPresenceRequest(const char* pid, const char* disp, const char* rc, const char* ct,
+                                 bool start_searching) {
     if (!LobbyServer_IsConfigured() || !pid || !pid[0])
         return;
     AsyncPresenceData* d = (AsyncPresenceData*)malloc(sizeof(AsyncPresenceData));
@@ -103,6 +118,7 @@ static void AsyncUpdatePresence(const char* pid, const char* disp, const char* r
         snprintf(d->room_code, sizeof(d->room_code), "%s", rc);
     if (ct)
         snprintf(d->connect_to, sizeof(d->connect_to), "%s", ct);
+    d->start_searching = start_searching;
     SDL_Thread* t = SDL_CreateThread(async_presence_fn, "AsyncPresence", d);
     if (t)
         SDL_DetachThread(t);
@@ -110,6 +126,15 @@ static void AsyncUpdatePresence(const char* pid, const char* disp, const char* r
         free(d);
 }
 
+static void AsyncUpdatePresence(const char* pid, const char* disp, const char* rc, const char* ct) {
+    AsyncPresenceRequest(pid, disp, rc, ct, false);
+}
+
+// Presence + start searching pipelined on one connection, so the server never sees them out of order
+static void AsyncRegisterAndSearch(const char* pid, const char* disp, const char* rc) {
+    AsyncPresenceRequest(pid, disp, rc, "", true);
+}
+
 typedef struct {
     char player_id[128];
     int action;
@@ -145,7 +170,21 @@ static SDL_AtomicInt lobby_poll_active = { 0 };
 static int SDLCALL lobby_poll_thread_fn(void* data) {
     (void)data;
     static LobbyPlayer temp_players[16];
-    int count = LobbyServer_GetSearching(temp_players, 16, NULL);
+    int count;
+    int version = SDL_GetAtomicInt(&lobby_server_version);
+
+    if (version >= 0) {
+        // Returns as soon as the lobby changes, or after LOBBY_WAIT_TIMEOUT_MS with the same list
+        count = LobbyServer_WaitSearching(temp_players, 16, NULL, &version, LOBBY_WAIT_TIMEOUT_MS);
+        SDL_SetAtomicInt(&lobby_poll_failed, count < 0 ? 1 : 0);
+        if (count < 0) {
+            count = 0;
+        } else {
+            SDL_SetAtomicInt(&lobby_server_version, version);
+        }
+    } else {
+        count = LobbyServer_GetSearching(temp_players, 16, NULL);
+    }
 
     SDL_MemoryBarrierRelease();
     memcpy(lobby_server_players, temp_players, sizeof(temp_players));
@@ -172,7 +211,29 @@ static void lobby_poll_server(void) {
         return;
 
     uint32_t now = SDL_GetTicks();
-    if (now - lobby_server_last_poll >= LOBBY_POLL_INTERVAL_MS || lobby_server_last_poll == 0) {
+    bool long_poll = SDL_GetAtomicInt(&lobby_server_version) >= 0 && SDL_GetAtomicInt(&lobby_poll_failed) == 0;
+
+    if (long_poll) {
+        // The server pushes changes through the long-poll, so re-arm it as soon as it returns;
+        // presence only needs refreshing often enough to beat the server's expiry.
+        if (lobby_server_searching &&
+            (now - lobby_server_last_poll >= LOBBY_PRESENCE_INTERVAL_MS || lobby_server_last_poll == 0)) {
+            const char* display = Config_GetString(CFG_KEY_LOBBY_DISPLAY_NAME);
+            if (!display || !display[0])
+                display = my_room_code;
+            AsyncUpdatePresence(lobby_my_player_id, display, my_room_code, "");
+            lobby_server_last_poll = now;
+        }
+
+        if (SDL_GetAtomicInt(&lobby_poll_active) == 0) {
+            SDL_SetAtomicInt(&lobby_poll_active, 1);
+            SDL_Thread* t = SDL_CreateThread(lobby_poll_thread_fn, "LobbyPoll", NULL);
+            if (t)
+                SDL_DetachThread(t);
+            else
+                SDL_SetAtomicInt(&lobby_poll_active, 0);
+        }
+    } else if (now - lobby_server_last_poll >= LOBBY_POLL_INTERVAL_MS || lobby_server_last_poll == 0) {
         if (SDL_GetAtomicInt(&lobby_poll_active) == 0) {
             SDL_SetAtomicInt(&lobby_poll_active, 1);
 
@@ -338,6 +399,8 @@ static void lobby_reset(void) {
     lobby_server_searching = false;
     lobby_server_player_count = 0;
     lobby_server_last_poll = 0;
+    SDL_SetAtomicInt(&lobby_server_version, 0);
+    SDL_SetAtomicInt(&lobby_poll_failed, 0);
 
     // Clear pending invite state
     lobby_has_pending_invite = false;
@@ -625,6 +688,48 @@ static void RenderDiagnostics() {
             ImGui::TextDisabled("FPS: waiting for data...");
         }
 
+        TextRendererStats overlay;
+        SDLTextRenderer_GetStats(&overlay);
+        ImGui::TextDisabled("Overlay: %d draw call%s, %d quads",
+                            overlay.draw_calls,
+                            overlay.draw_calls == 1 ? "" : "s",
+                            overlay.quads);
+
+        TexcashStats cache;
+        texcash_get_frame_stats(&cache);
+        ImGui::TextDisabled("Sprite cache x%d: %u hit, %u revived, %u decoded (%.1f KiB)",
+                            cache.scale,
+                            cache.hits,
+                            cache.revived,
+                            cache.misses,
+                            (double)cache.bytes / 1024.0);
+
+        RecorderStats rec;
+        Recorder_GetStats(&rec);
+        if (rec.active) {
+            const ImVec4 rec_color = rec.capture_us > RECORDER_CAPTURE_BUDGET_US ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f)
+                                                                                  : ImVec4(1.0f, 0.4f, 0.4f, 0.8f);
+            ImGui::TextColored(rec_color,
+                               "REC %llu frames, %.1f MiB [Shift+`]",
+                               (unsigned long long)rec.frames,
+                               (double)rec.bytes / (1024.0 * 1024.0));
+            ImGui::TextDisabled("Capture %.0f us (max %.0f, budget %.0f) | encode %.2f ms | %llu repeated",
+                                rec.capture_us,
+                                rec.capture_max_us,
+                                RECORDER_CAPTURE_BUDGET_US,
+                                rec.encode_ms,
+                                (unsigned long long)rec.repeated);
+        }
+
+        BroadcastStats broadcast;
+        Broadcast_GetStats(&broadcast);
+        if (broadcast.measured) {
+            ImGui::TextDisabled("Broadcast send %.3f ms/frame over %u frames | %u dropped",
+                                broadcast.send_ms,
+                                broadcast.frames,
+                                broadcast.dropped);
+        }
+
         // --- Netplay Section (only during active sessions) ---
         if (Netplay_GetSessionState() == NETPLAY_SESSION_RUNNING) {
             ImGui::Separator();
@@ -730,13 +835,14 @@ void SDLNetplayUI_Render(int window_width, int window_height) {
 
                 snprintf(lobby_my_player_id, sizeof(lobby_my_player_id), "%s", client_id);
                 if (!lobby_server_registered) {
-                    AsyncUpdatePresence(lobby_my_player_id, display, my_room_code, "");
                     lobby_server_registered = true;
                     // Auto-start searching if configured
                     if (Config_GetBool(CFG_KEY_LOBBY_AUTO_SEARCH) && !lobby_server_searching) {
-                        AsyncLobbyAction(lobby_my_player_id, 1);
+                        AsyncRegisterAndSearch(lobby_my_player_id, display, my_room_code);
                         lobby_server_searching = true;
                         lobby_server_last_poll = 0;
+                    } else {
+                        AsyncUpdatePresence(lobby_my_player_id, display, my_room_code, "");
                     }
                 }
             }
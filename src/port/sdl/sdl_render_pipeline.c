@@ -0,0 +1,307 @@
+/**
+ * @file sdl_render_pipeline.c
+ * @brief Optional logic/render pipelining and frame-time histograms.
+ *
+ * In pipelined frames the game logic runs on a worker thread while the main
+ * thread, which owns the GL/GPU context, submits and presents the previous
+ * frame. The worker never touches the graphics API: its SDLGameRenderer calls
+ * are recorded (see SDLGameRenderer_SetRecordingThread) and replayed by the
+ * main thread at the hand-off point, while the worker is parked. The recorded
+ * list and the backend's render task arrays form the double buffer — one is
+ * being filled by logic while the other is being submitted.
+ *
+ * The main thread also reads game memory and globals while it renders the
+ * frame, draws overlays and builds ImGui menus, so the next logic frame is
+ * only released right before present: logic overlaps the present and the
+ * frame pacer's wait, never anything that reads what it writes.
+ */
+#include "port/sdl/sdl_render_pipeline.h"
+#include "port/sdl/sdl_game_renderer.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+/// AUTO: frames looked at when deciding to start pipelining
+#define AUTO_WINDOW_FRAMES 60
+/// AUTO: over-budget frames within the window that switch to pipelined
+#define AUTO_OVER_BUDGET_TRIGGER 3
+/// AUTO: consecutive comfortable frames before going back to serial (~5 s)
+#define AUTO_SETTLE_FRAMES 300
+
+static RenderPipelineMode pipeline_mode = RENDER_PIPELINE_OFF;
+static RenderPipelineLogicFn logic_fn = NULL;
+
+static SDL_Thread* logic_thread = NULL;
+static SDL_Semaphore* kick_sem = NULL;
+static SDL_Semaphore* done_sem = NULL;
+static SDL_AtomicInt quit_requested;
+static bool in_flight = false;
+static bool kick_pending = false; // Kicked but held until SDLRenderPipeline_ReleaseKick
+static Uint64 last_logic_ns = 0;
+
+static bool auto_pipelined = false;
+static bool over_budget_ring[AUTO_WINDOW_FRAMES];
+static int over_budget_index = 0;
+static int over_budget_count = 0;
+static int comfortable_streak = 0;
+
+static RenderPipelineHistogram histograms[2]; // [0] = serial, [1] = pipelined
+static Uint64 last_frame_end_ns = 0;
+
+void SDLRenderPipeline_SetMode(RenderPipelineMode mode) {
+    pipeline_mode = mode;
+}
+
+RenderPipelineMode SDLRenderPipeline_GetMode(void) {
+    return pipeline_mode;
+}
+
+const char* SDLRenderPipeline_GetModeName(RenderPipelineMode mode) {
+    switch (mode) {
+    case RENDER_PIPELINE_AUTO:
+        return "auto";
+    case RENDER_PIPELINE_ON:
+        return "on";
+    case RENDER_PIPELINE_OFF:
+        break;
+    }
+    return "off";
+}
+
+/** @brief Worker loop: run one logic frame per kick, recording its render calls. */
+static int SDLCALL logic_thread_main(void* data) {
+    (void)data;
+    SDLGameRenderer_SetRecordingThread(SDL_GetCurrentThreadID());
+
+    for (;;) {
+        SDL_WaitSemaphore(kick_sem);
+        if (SDL_GetAtomicInt(&quit_requested)) {
+            break;
+        }
+
+        const Uint64 start = SDL_GetTicksNS();
+        logic_fn();
+        last_logic_ns = SDL_GetTicksNS() - start;
+
+        SDL_SignalSemaphore(done_sem);
+    }
+
+    return 0;
+}
+
+bool SDLRenderPipeline_Init(RenderPipelineLogicFn logic) {
+    memset(histograms, 0, sizeof(histograms));
+    last_frame_end_ns = 0;
+    memset(over_budget_ring, 0, sizeof(over_budget_ring));
+    over_budget_index = 0;
+    over_budget_count = 0;
+    comfortable_streak = 0;
+    auto_pipelined = false;
+
+    if (pipeline_mode == RENDER_PIPELINE_OFF) {
+        return true;
+    }
+
+    logic_fn = logic;
+    SDL_SetAtomicInt(&quit_requested, 0);
+    kick_sem = SDL_CreateSemaphore(0);
+    done_sem = SDL_CreateSemaphore(0);
+    logic_thread = SDL_CreateThread(logic_thread_main, "GameLogic", NULL);
+
+    if (!kick_sem || !done_sem || !logic_thread) {
+        SDL_Log("Render pipeline: failed to start logic thread, running serially");
+        SDLRenderPipeline_Shutdown();
+        pipeline_mode = RENDER_PIPELINE_OFF;
+        return false;
+    }
+
+    SDL_Log("Render pipeline: %s", SDLRenderPipeline_GetModeName(pipeline_mode));
+    return true;
+}
+
+/** @brief Log one histogram as a percentile summary plus its non-empty buckets. */
+static void log_histogram(const char* label, const RenderPipelineHistogram* hist) {
+    if (hist->frames == 0) {
+        return;
+    }
+
+    SDL_Log("Frame times [%s]: %llu frames, mean %.2f ms, p50 %.1f, p95 %.1f, p99 %.1f, max %.2f ms",
+            label,
+            (unsigned long long)hist->frames,
+            (double)hist->total_ns / (double)hist->frames / 1e6,
+            (double)SDLRenderPipeline_HistogramPercentile(hist, 50.0) / 1e6,
+            (double)SDLRenderPipeline_HistogramPercentile(hist, 95.0) / 1e6,
+            (double)SDLRenderPipeline_HistogramPercentile(hist, 99.0) / 1e6,
+            (double)hist->max_ns / 1e6);
+
+    char line[1024];
+    int len = 0;
+    for (int i = 0; i < RENDER_PIPELINE_HISTOGRAM_BUCKETS && len < (int)sizeof(line) - 32; i++) {
+        if (hist->buckets[i] == 0) {
+            continue;
+        }
+        if (i == RENDER_PIPELINE_HISTOGRAM_BUCKETS - 1) {
+            const double floor_ms = (double)(i * RENDER_PIPELINE_HISTOGRAM_BUCKET_NS) / 1e6;
+            len += SDL_snprintf(line + len, sizeof(line) - len, " >%.1f:%u", floor_ms, hist->buckets[i]);
+        } else {
+            const double upper_ms = (double)((i + 1) * RENDER_PIPELINE_HISTOGRAM_BUCKET_NS) / 1e6;
+            len += SDL_snprintf(line + len, sizeof(line) - len, " <%.1f:%u", upper_ms, hist->buckets[i]);
+        }
+    }
+    SDL_Log("Frame times [%s] ms:count%s", label, line);
+}
+
+void SDLRenderPipeline_Shutdown(void) {
+    if (in_flight) {
+        SDLRenderPipeline_Wait();
+    }
+
+    if (logic_thread) {
+        SDL_SetAtomicInt(&quit_requested, 1);
+        SDL_SignalSemaphore(kick_sem);
+        SDL_WaitThread(logic_thread, NULL);
+        logic_thread = NULL;
+    }
+    if (kick_sem) {
+        SDL_DestroySemaphore(kick_sem);
+        kick_sem = NULL;
+    }
+    if (done_sem) {
+        SDL_DestroySemaphore(done_sem);
+        done_sem = NULL;
+    }
+
+    log_histogram("serial", &histograms[0]);
+    log_histogram("pipelined", &histograms[1]);
+}
+
+void SDLRenderPipeline_Kick(void) {
+    SDL_assert(logic_thread != NULL && !in_flight);
+    in_flight = true;
+    SDL_SignalSemaphore(kick_sem);
+}
+
+void SDLRenderPipeline_KickDeferred(void) {
+    SDL_assert(logic_thread != NULL && !in_flight);
+    in_flight = true;
+    kick_pending = true;
+}
+
+void SDLRenderPipeline_ReleaseKick(void) {
+    if (!kick_pending) {
+        return;
+    }
+    kick_pending = false;
+    SDL_SignalSemaphore(kick_sem);
+}
+
+void SDLRenderPipeline_Wait(void) {
+    if (!in_flight) {
+        return;
+    }
+    SDLRenderPipeline_ReleaseKick();
+    SDL_WaitSemaphore(done_sem);
+    in_flight = false;
+}
+
+bool SDLRenderPipeline_IsInFlight(void) {
+    return in_flight;
+}
+
+Uint64 SDLRenderPipeline_GetLastLogicNS(void) {
+    return last_logic_ns;
+}
+
+bool SDLRenderPipeline_WantPipelined(void) {
+    if (logic_thread == NULL) {
+        return false;
+    }
+
+    switch (pipeline_mode) {
+    case RENDER_PIPELINE_ON:
+        return true;
+    case RENDER_PIPELINE_AUTO:
+        return auto_pipelined;
+    case RENDER_PIPELINE_OFF:
+        break;
+    }
+    return false;
+}
+
+/** @brief AUTO policy: pipeline when serial frames stop fitting, go back once they fit with margin. */
+static void update_auto_policy(Uint64 work_ns, Uint64 budget_ns) {
+    // 90% leaves room for pacer/vsync jitter; 75% is the hysteresis for going back
+    const bool over = work_ns * 10 > budget_ns * 9;
+    const bool comfortable = work_ns * 4 <= budget_ns * 3;
+
+    over_budget_count += (int)over - (int)over_budget_ring[over_budget_index];
+    over_budget_ring[over_budget_index] = over;
+    over_budget_index = (over_budget_index + 1) % AUTO_WINDOW_FRAMES;
+
+    if (!auto_pipelined) {
+        if (over_budget_count >= AUTO_OVER_BUDGET_TRIGGER) {
+            auto_pipelined = true;
+            comfortable_streak = 0;
+            SDL_Log("Render pipeline: frames over budget, pipelining logic and rendering");
+        }
+        return;
+    }
+
+    comfortable_streak = comfortable ? comfortable_streak + 1 : 0;
+    if (comfortable_streak >= AUTO_SETTLE_FRAMES) {
+        auto_pipelined = false;
+        memset(over_budget_ring, 0, sizeof(over_budget_ring));
+        over_budget_count = 0;
+        SDL_Log("Render pipeline: frames fit the budget again, back to serial");
+    }
+}
+
+void SDLRenderPipeline_EndFrame(bool pipelined, Uint64 work_ns, Uint64 budget_ns) {
+    const Uint64 now = SDL_GetTicksNS();
+    if (last_frame_end_ns != 0) {
+        SDLRenderPipeline_HistogramAdd(&histograms[pipelined ? 1 : 0], now - last_frame_end_ns);
+    }
+    last_frame_end_ns = now;
+
+    if (pipeline_mode == RENDER_PIPELINE_AUTO && budget_ns > 0) {
+        update_auto_policy(work_ns, budget_ns);
+    }
+}
+
+const RenderPipelineHistogram* SDLRenderPipeline_GetHistogram(bool pipelined) {
+    return &histograms[pipelined ? 1 : 0];
+}
+
+void SDLRenderPipeline_HistogramAdd(RenderPipelineHistogram* hist, Uint64 frame_ns) {
+    Uint64 bucket = frame_ns / RENDER_PIPELINE_HISTOGRAM_BUCKET_NS;
+    if (bucket >= RENDER_PIPELINE_HISTOGRAM_BUCKETS) {
+        bucket = RENDER_PIPELINE_HISTOGRAM_BUCKETS - 1;
+    }
+
+    hist->buckets[bucket] += 1;
+    hist->frames += 1;
+    hist->total_ns += frame_ns;
+    if (frame_ns > hist->max_ns) {
+        hist->max_ns = frame_ns;
+    }
+}
+
+Uint64 SDLRenderPipeline_HistogramPercentile(const RenderPipelineHistogram* hist, double pct) {
+    if (hist->frames == 0) {
+        return 0;
+    }
+
+    Uint64 target = (Uint64)((double)hist->frames * pct / 100.0 + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+
+    Uint64 seen = 0;
+    for (int i = 0; i < RENDER_PIPELINE_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target) {
+            return (Uint64)(i + 1) * RENDER_PIPELINE_HISTOGRAM_BUCKET_NS;
+        }
+    }
+    return hist->max_ns;
+}
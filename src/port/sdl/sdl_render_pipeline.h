@@ -0,0 +1,92 @@
+#ifndef SDL_RENDER_PIPELINE_H
+#define SDL_RENDER_PIPELINE_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// How game logic and rendering are scheduled against each other.
+///
+/// OFF:  logic and rendering run back to back on the main thread (no added latency).
+/// AUTO: serial while logic + render work fit the frame budget, pipelined once
+///       they stop fitting; drops back to serial after a sustained run of frames
+///       that fit again.
+/// ON:   always pipelined. Logic for frame N+1 runs on a worker thread while the
+///       main thread (which owns the GL/GPU context) submits and presents frame N.
+///       Costs one frame of latency.
+typedef enum RenderPipelineMode {
+    RENDER_PIPELINE_OFF,
+    RENDER_PIPELINE_AUTO,
+    RENDER_PIPELINE_ON,
+} RenderPipelineMode;
+
+typedef void (*RenderPipelineLogicFn)(void);
+
+/// Frame-time histogram: 0.5 ms buckets, last bucket collects everything slower.
+#define RENDER_PIPELINE_HISTOGRAM_BUCKETS 81
+#define RENDER_PIPELINE_HISTOGRAM_BUCKET_NS 500000ULL
+
+typedef struct RenderPipelineHistogram {
+    Uint32 buckets[RENDER_PIPELINE_HISTOGRAM_BUCKETS];
+    Uint64 frames;
+    Uint64 total_ns;
+    Uint64 max_ns;
+} RenderPipelineHistogram;
+
+void SDLRenderPipeline_SetMode(RenderPipelineMode mode);
+RenderPipelineMode SDLRenderPipeline_GetMode(void);
+const char* SDLRenderPipeline_GetModeName(RenderPipelineMode mode);
+
+/// Spawn the logic thread (no-op when the mode is OFF). `logic` runs one game frame;
+/// every SDLGameRenderer call it makes is recorded for SDLGameRenderer_ReplayRecorded.
+bool SDLRenderPipeline_Init(RenderPipelineLogicFn logic);
+
+/// Drain any in-flight frame, stop the thread and log the frame-time histograms.
+void SDLRenderPipeline_Shutdown(void);
+
+/// Start the next logic frame on the worker thread.
+void SDLRenderPipeline_Kick(void);
+
+/// Queue the next logic frame without starting it yet. The main thread still
+/// reads game memory and globals while it renders, draws overlays and builds
+/// menus, so the worker only starts at SDLRenderPipeline_ReleaseKick.
+void SDLRenderPipeline_KickDeferred(void);
+
+/// Start a queued logic frame, if there is one. Called right before present,
+/// once nothing on the main thread reads game state until the next Wait.
+void SDLRenderPipeline_ReleaseKick(void);
+
+/// Block until the in-flight logic frame (if any) has finished recording.
+void SDLRenderPipeline_Wait(void);
+
+/// True while a kicked logic frame hasn't been waited for.
+bool SDLRenderPipeline_IsInFlight(void);
+
+/// Wall time the last logic frame took on the worker thread.
+Uint64 SDLRenderPipeline_GetLastLogicNS(void);
+
+/// Decide how to schedule the next frame: true = pipelined.
+bool SDLRenderPipeline_WantPipelined(void);
+
+/// Report one finished main-loop iteration. `work_ns` is the CPU work the frame
+/// needed (logic + render submission, excluding vsync/pacer waits); `budget_ns`
+/// is the target frame time. Feeds the AUTO policy and the histograms.
+void SDLRenderPipeline_EndFrame(bool pipelined, Uint64 work_ns, Uint64 budget_ns);
+
+/// Histogram of frame intervals for serial (pipelined = false) or pipelined frames.
+const RenderPipelineHistogram* SDLRenderPipeline_GetHistogram(bool pipelined);
+
+/// Frame time at percentile `pct` (0-100) of a histogram, in nanoseconds (bucket upper bound).
+Uint64 SDLRenderPipeline_HistogramPercentile(const RenderPipelineHistogram* hist, double pct);
+
+/// Add one frame interval to a histogram.
+void SDLRenderPipeline_HistogramAdd(RenderPipelineHistogram* hist, Uint64 frame_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
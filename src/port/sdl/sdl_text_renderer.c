@@ -11,6 +11,10 @@
 #include "port/sdl/sdl_text_renderer_internal.h"
 #include "types.h"
 
+#include <string.h>
+
+static int s_bg_enabled = 1; // Mirrors the backend, for styled-text emulation
+
 void SDLTextRenderer_Init(const char* base_path, const char* font_path) {
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
@@ -45,6 +49,48 @@ void SDLTextRenderer_DrawText(const char* text, float x, float y, float scale, f
     }
 }
 
+/**
+ * @brief Draw text with a shadow or outline.
+ *
+ * The GL backend does the effect in its shader (one quad per glyph). The
+ * others batch anyway, so they get the classic offset copies; only the
+ * first copy carries the background box.
+ */
+void SDLTextRenderer_DrawTextStyled(const char* text, float x, float y, float scale, float r, float g, float b,
+                                    TextStyle style, float target_width, float target_height) {
+    RendererBackend rend = SDLApp_GetRenderer();
+    if (rend == RENDERER_OPENGL) {
+        SDLTextRendererGL_DrawTextStyled(text, x, y, scale, r, g, b, style, target_width, target_height);
+        return;
+    }
+
+    static const float shadow_offsets[][2] = { { 1, 1 } };
+    static const float outline_offsets[][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { -1, 0 },
+                                                { 1, 0 },   { -1, 1 }, { 0, 1 },  { 1, 1 } };
+    const float(*offsets)[2] = NULL;
+    int offset_count = 0;
+    if (style == TEXT_STYLE_SHADOW) {
+        offsets = shadow_offsets;
+        offset_count = 1;
+    } else if (style == TEXT_STYLE_OUTLINE) {
+        offsets = outline_offsets;
+        offset_count = 8;
+    }
+
+    const int bg_enabled = s_bg_enabled;
+    for (int i = 0; i < offset_count; i++) {
+        SDLTextRenderer_DrawText(
+            text, x + offsets[i][0], y + offsets[i][1], scale, 0.0f, 0.0f, 0.0f, target_width, target_height);
+        if (i == 0 && bg_enabled) {
+            SDLTextRenderer_SetBackgroundEnabled(0);
+        }
+    }
+    SDLTextRenderer_DrawText(text, x, y, scale, r, g, b, target_width, target_height);
+    if (bg_enabled && offset_count > 0) {
+        SDLTextRenderer_SetBackgroundEnabled(1);
+    }
+}
+
 void SDLTextRenderer_Flush(void) {
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
@@ -56,6 +102,17 @@ void SDLTextRenderer_Flush(void) {
     }
 }
 
+void SDLTextRenderer_GetStats(TextRendererStats* out) {
+    RendererBackend r = SDLApp_GetRenderer();
+    if (r == RENDERER_SDLGPU) {
+        SDLTextRendererGPU_GetStats(out);
+    } else if (r == RENDERER_OPENGL) {
+        SDLTextRendererGL_GetStats(out);
+    } else {
+        memset(out, 0, sizeof(*out)); // SDL_Renderer batches internally; nothing to count
+    }
+}
+
 void SDLTextRenderer_SetYOffset(float y_offset) {
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
@@ -68,6 +125,7 @@ void SDLTextRenderer_SetYOffset(float y_offset) {
 }
 
 void SDLTextRenderer_SetBackgroundEnabled(int enabled) {
+    s_bg_enabled = enabled ? 1 : 0;
     RendererBackend r = SDLApp_GetRenderer();
     if (r == RENDERER_SDLGPU) {
         SDLTextRendererGPU_SetBackgroundEnabled(enabled);
@@ -169,9 +227,9 @@ void SDLTextRenderer_DrawDebugBuffer(float target_width, float target_height) {
         float px = (float)ch->x * scale;
         float py = (float)ch->y * scale;
 
-        // Single drop shadow for contrast (2 draws vs 9 for the old 8-direction outline)
-        SDLTextRenderer_DrawText(text, px + 1, py + 1, char_scale, 0.0f, 0.0f, 0.0f, target_width, target_height);
-        SDLTextRenderer_DrawText(text, px, py, char_scale, rf, gf, bf, target_width, target_height);
+        // Single drop shadow for contrast
+        SDLTextRenderer_DrawTextStyled(
+            text, px, py, char_scale, rf, gf, bf, TEXT_STYLE_SHADOW, target_width, target_height);
     }
 
     // Restore background setting (Default is enabled for UI text usually)
@@ -1,14 +1,18 @@
 /**
  * @file sdl_text_renderer_gl.c
- * @brief OpenGL TrueType text renderer using stb_truetype.
+ * @brief OpenGL overlay text renderer (retained batch, one draw per flush).
  *
- * Rasterizes bitmap fonts from TTF files, renders text as textured quads
- * with per-character glyph caching, and provides debug overlay text
- * with optional background rectangles.
+ * Text and background rectangles are appended as quads to a single vertex
+ * stream and drawn with one glDrawElements call at SDLTextRendererGL_Flush.
+ * Drop shadows and outlines are produced by the fragment shader from the
+ * glyph's neighbouring atlas texels rather than by redrawing the string.
+ * On GL 4.4+ the stream is a persistently mapped ring guarded by fences;
+ * older contexts (the Pi's 3.3 core) orphan and re-upload one buffer.
  */
 #include "port/sdl/sdl_text_renderer.h"
 #include "port/sdl/sdl_text_renderer_internal.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,28 +24,57 @@
 #include "port/imgui_font_8x8.h"
 #include "port/sdl/sdl_app.h"
 
+#define MAX_OVERLAY_QUADS 4096 // 16384 vertices, the most a 16-bit index can reach
+#define OVERLAY_RING_REGIONS 3 // Frames a persistent region gets before it is rewritten
+
+// Must match overlay.frag
+#define STYLE_SOLID 0
+#define STYLE_GLYPH 1
+#define STYLE_SHADOW 2
+#define STYLE_OUTLINE 3
+
 typedef struct {
     GLuint texture_id;
     int width;
     int height;
 } FontAtlas;
 
+typedef struct {
+    float x, y;   // Clip space
+    float tx, ty; // Atlas texels
+    Uint8 color[4];
+    Sint16 cell_x, cell_y;
+    Sint32 style;
+} OverlayVertex;
+
 static FontAtlas s_font_atlas;
-static GLuint s_text_vao = 0;
-static GLuint s_text_vbo = 0;
-static GLuint s_text_shader = 0;
+static GLuint s_overlay_vao = 0;
+static GLuint s_overlay_vbo = 0;
+static GLuint s_overlay_ibo = 0;
+static GLuint s_overlay_shader = 0;
 static float s_text_y_offset = 8.0f;
-static GLuint s_rect_shader = 0;
 static int s_bg_enabled = 1;
 static float s_bg_color[4] = { 0.0f, 0.0f, 0.0f, 0.6f };
 static float s_bg_padding = 2.0f;
 
+// Batch
+static OverlayVertex* s_staging = NULL; // CPU copy when the buffer can't stay mapped
+static OverlayVertex* s_mapped = NULL;  // Persistent mapping (GL 4.4+)
+static OverlayVertex* s_write = NULL;   // Where this frame's quads go
+static GLsync s_region_fences[OVERLAY_RING_REGIONS];
+static int s_region = 0;
+static int s_quad_count = 0;
+static bool s_overflow_logged = false;
+static TextRendererStats s_last_stats;
+
 void SDLTextRendererGL_Init(const char* base_path, const char* font_path) {
     (void)font_path; // Unused, we use internal 8x8 font
     SDL_Log("Initializing OpenGL text renderer...");
 
-    s_text_shader = create_shader_program(base_path, "shaders/text.vert", "shaders/text.frag");
-    s_rect_shader = create_shader_program(base_path, "shaders/rect.vert", "shaders/rect.frag");
+    s_overlay_shader = create_shader_program(base_path, "shaders/overlay.vert", "shaders/overlay.frag");
+    glUseProgram(s_overlay_shader);
+    glUniform1i(glGetUniformLocation(s_overlay_shader, "atlas"), 0);
+    glUseProgram(0);
 
     s_font_atlas.width = 128; // 16 chars per row * 8 pixels = 128 width
     s_font_atlas.height = 64; // 8 rows of chars * 8 pixels = 64 height
@@ -75,47 +108,151 @@ void SDLTextRendererGL_Init(const char* base_path, const char* font_path) {
 
     free(bitmap);
 
-    glGenVertexArrays(1, &s_text_vao);
-    glGenBuffers(1, &s_text_vbo);
-    glBindVertexArray(s_text_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, s_text_vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    // Position attribute
+    glGenVertexArrays(1, &s_overlay_vao);
+    glGenBuffers(1, &s_overlay_vbo);
+    glGenBuffers(1, &s_overlay_ibo);
+    glBindVertexArray(s_overlay_vao);
+
+    // Static quad indices, shared by every region
+    Uint16* indices = (Uint16*)malloc(MAX_OVERLAY_QUADS * 6 * sizeof(Uint16));
+    for (int q = 0; q < MAX_OVERLAY_QUADS; q++) {
+        const Uint16 base = (Uint16)(q * 4);
+        Uint16* idx = &indices[q * 6];
+        idx[0] = base;
+        idx[1] = base + 1;
+        idx[2] = base + 2;
+        idx[3] = base + 2;
+        idx[4] = base + 3;
+        idx[5] = base;
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_overlay_ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_OVERLAY_QUADS * 6 * sizeof(Uint16), indices, GL_STATIC_DRAW);
+    free(indices);
+
+    const GLsizeiptr region_bytes = MAX_OVERLAY_QUADS * 4 * sizeof(OverlayVertex);
+    glBindBuffer(GL_ARRAY_BUFFER, s_overlay_vbo);
+#ifdef GL_VERSION_4_4
+    if (GLAD_GL_VERSION_4_4) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, region_bytes * OVERLAY_RING_REGIONS, NULL, flags);
+        s_mapped = (OverlayVertex*)glMapBufferRange(GL_ARRAY_BUFFER, 0, region_bytes * OVERLAY_RING_REGIONS, flags);
+    }
+#endif
+    if (!s_mapped) {
+        glBufferData(GL_ARRAY_BUFFER, region_bytes, NULL, GL_STREAM_DRAW);
+        s_staging = (OverlayVertex*)malloc(region_bytes);
+    }
+
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    // Texture coordinate attribute
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, x));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, tx));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(
+        2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, color));
+    glEnableVertexAttribArray(3);
+    glVertexAttribIPointer(3, 2, GL_SHORT, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, cell_x));
+    glEnableVertexAttribArray(4);
+    glVertexAttribIPointer(4, 1, GL_INT, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, style));
+
     glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    SDL_Log("Overlay batch: %d quads, %s",
+            MAX_OVERLAY_QUADS,
+            s_mapped ? "persistent mapped ring" : "orphaned stream buffer");
 }
 
 void SDLTextRendererGL_Shutdown() {
-    glDeleteProgram(s_text_shader);
-    glDeleteProgram(s_rect_shader);
+    for (int i = 0; i < OVERLAY_RING_REGIONS; i++) {
+        if (s_region_fences[i]) {
+            glDeleteSync(s_region_fences[i]);
+            s_region_fences[i] = NULL;
+        }
+    }
+    if (s_mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, s_overlay_vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        s_mapped = NULL;
+    }
+    free(s_staging);
+    s_staging = NULL;
+    s_write = NULL;
+    s_quad_count = 0;
+
+    glDeleteProgram(s_overlay_shader);
     glDeleteTextures(1, &s_font_atlas.texture_id);
-    glDeleteBuffers(1, &s_text_vbo);
-    glDeleteVertexArrays(1, &s_text_vao);
+    glDeleteBuffers(1, &s_overlay_vbo);
+    glDeleteBuffers(1, &s_overlay_ibo);
+    glDeleteVertexArrays(1, &s_overlay_vao);
 }
 
-void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale, float r, float g, float b,
-                                float target_width, float target_height) {
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+/** @brief Start a batch: pick the write target, waiting for the GPU if the ring caught up. */
+static void begin_batch(void) {
+    if (!s_mapped) {
+        s_write = s_staging;
+        return;
+    }
 
-    glUseProgram(s_text_shader);
+    GLsync fence = s_region_fences[s_region];
+    if (fence) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ULL);
+        glDeleteSync(fence);
+        s_region_fences[s_region] = NULL;
+    }
+    s_write = s_mapped + (size_t)s_region * MAX_OVERLAY_QUADS * 4;
+}
 
-    // Projection matrix based on target dimensions
-    const float projection[4][4] = { { 2.0f / target_width, 0.0f, 0.0f, 0.0f },
-                                     { 0.0f, -2.0f / target_height, 0.0f, 0.0f },
-                                     { 0.0f, 0.0f, -1.0f, 0.0f },
-                                     { -1.0f, 1.0f, 0.0f, 1.0f } };
-    glUniformMatrix4fv(glGetUniformLocation(s_text_shader, "projection"), 1, GL_FALSE, &projection[0][0]);
-    glUniform3f(glGetUniformLocation(s_text_shader, "textColor"), r, g, b);
+/** @brief Append one quad (pixel rect x0,y0-x1,y1 over texel rect t0-t1). */
+static void push_quad(float x0, float y0, float x1, float y1, float t0x, float t0y, float t1x, float t1y,
+                      const Uint8 color[4], int cell_x, int cell_y, int style, float target_width,
+                      float target_height) {
+    if (s_quad_count >= MAX_OVERLAY_QUADS) {
+        if (!s_overflow_logged) {
+            SDL_Log("Overlay batch full (%d quads), dropping text", MAX_OVERLAY_QUADS);
+            s_overflow_logged = true;
+        }
+        return;
+    }
+    if (s_quad_count == 0) {
+        begin_batch();
+    }
 
-    glBindTexture(GL_TEXTURE_2D, s_font_atlas.texture_id);
-    glBindVertexArray(s_text_vao);
+    const float sx = 2.0f / target_width;
+    const float sy = -2.0f / target_height;
+    const float cx0 = x0 * sx - 1.0f;
+    const float cx1 = x1 * sx - 1.0f;
+    const float cy0 = y0 * sy + 1.0f;
+    const float cy1 = y1 * sy + 1.0f;
+
+    OverlayVertex* v = &s_write[s_quad_count * 4];
+    const float pos[4][4] = {
+        { cx0, cy1, t0x, t1y }, { cx1, cy1, t1x, t1y }, { cx1, cy0, t1x, t0y }, { cx0, cy0, t0x, t0y }
+    };
+    for (int i = 0; i < 4; i++) {
+        v[i].x = pos[i][0];
+        v[i].y = pos[i][1];
+        v[i].tx = pos[i][2];
+        v[i].ty = pos[i][3];
+        memcpy(v[i].color, color, 4);
+        v[i].cell_x = (Sint16)cell_x;
+        v[i].cell_y = (Sint16)cell_y;
+        v[i].style = style;
+    }
+    s_quad_count++;
+}
 
+static Uint8 to_byte(float c) {
+    if (c <= 0.0f)
+        return 0;
+    if (c >= 1.0f)
+        return 255;
+    return (Uint8)(c * 255.0f + 0.5f);
+}
+
+void SDLTextRendererGL_DrawTextStyled(const char* text, float x, float y, float scale, float r, float g, float b,
+                                      TextStyle style, float target_width, float target_height) {
     // Apply global Y offset so callers can shift all text up/down easily
     y += s_text_y_offset;
 
@@ -150,43 +287,39 @@ void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale,
         if (minx <= maxx && miny <= maxy) {
             // apply scale and padding
             float px = s_bg_padding;
-            float x0 = x + (minx * scale) - px;
-            float y0 = y + (miny * scale) - px;
-            float x1 = x + (maxx * scale) + px;
-            float y1 = y + (maxy * scale) + px;
-
-            // Build rectangle vertices (with dummy texcoords)
-            float rect_verts[] = {
-                x0, y1, 0.0f, 0.0f, x1, y1, 0.0f, 0.0f, x1, y0, 0.0f, 0.0f,
-
-                x1, y0, 0.0f, 0.0f, x0, y0, 0.0f, 0.0f, x0, y1, 0.0f, 0.0f,
+            const Uint8 bg[4] = {
+                to_byte(s_bg_color[0]), to_byte(s_bg_color[1]), to_byte(s_bg_color[2]), to_byte(s_bg_color[3])
             };
-
-            // Draw rect using rect shader
-            glUseProgram(s_rect_shader);
-            glUniformMatrix4fv(glGetUniformLocation(s_rect_shader, "projection"), 1, GL_FALSE, &projection[0][0]);
-            glUniform4f(glGetUniformLocation(s_rect_shader, "rectColor"),
-                        s_bg_color[0],
-                        s_bg_color[1],
-                        s_bg_color[2],
-                        s_bg_color[3]);
-
-            glBindBuffer(GL_ARRAY_BUFFER, s_text_vbo);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(rect_verts), rect_verts);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-            glBindVertexArray(s_text_vao);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-
-            // restore text shader before drawing glyphs
-            glUseProgram(s_text_shader);
-            glUniformMatrix4fv(glGetUniformLocation(s_text_shader, "projection"), 1, GL_FALSE, &projection[0][0]);
-            glUniform3f(glGetUniformLocation(s_text_shader, "textColor"), r, g, b);
-            glBindTexture(GL_TEXTURE_2D, s_font_atlas.texture_id);
-            glBindVertexArray(s_text_vao);
+            push_quad(x + (minx * scale) - px,
+                      y + (miny * scale) - px,
+                      x + (maxx * scale) + px,
+                      y + (maxy * scale) + px,
+                      0.0f,
+                      0.0f,
+                      0.0f,
+                      0.0f,
+                      bg,
+                      0,
+                      0,
+                      STYLE_SOLID,
+                      target_width,
+                      target_height);
         }
     }
 
+    const Uint8 color[4] = { to_byte(r), to_byte(g), to_byte(b), 255 };
+    int shader_style = STYLE_GLYPH;
+    if (style == TEXT_STYLE_SHADOW) {
+        shader_style = STYLE_SHADOW;
+    } else if (style == TEXT_STYLE_OUTLINE) {
+        shader_style = STYLE_OUTLINE;
+    }
+
+    // Shadow/outline quads grow by one atlas texel on each side so the edge has room
+    const float grow = (shader_style == STYLE_GLYPH) ? 0.0f : 1.0f;
+    const float grow_x = grow * (glyph_w / 8.0f) * scale;
+    const float grow_y = grow * (glyph_h / 8.0f) * scale;
+
     const char* p;
     float current_rx = 0;
     float current_ry = 0;
@@ -202,30 +335,67 @@ void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale,
         if (ch >= 128)
             ch = 127;
 
-        float u0 = (ch % 16) * 8.0f / s_font_atlas.width;
-        float v0 = (ch / 16) * 8.0f / s_font_atlas.height;
-        float u1 = u0 + (8.0f / s_font_atlas.width);
-        float v1 = v0 + (8.0f / s_font_atlas.height);
+        const int cell_x = (ch % 16) * 8;
+        const int cell_y = (ch / 16) * 8;
+
+        push_quad(x + (current_rx * scale) - grow_x,
+                  y + (current_ry * scale) - grow_y,
+                  x + ((current_rx + glyph_w) * scale) + grow_x,
+                  y + ((current_ry + glyph_h) * scale) + grow_y,
+                  (float)cell_x - grow,
+                  (float)cell_y - grow,
+                  (float)cell_x + 8.0f + grow,
+                  (float)cell_y + 8.0f + grow,
+                  color,
+                  cell_x,
+                  cell_y,
+                  shader_style,
+                  target_width,
+                  target_height);
 
-        float x0 = x + (current_rx * scale);
-        float y0 = y + (current_ry * scale);
-        float x1 = x + ((current_rx + glyph_w) * scale);
-        float y1 = y + ((current_ry + glyph_h) * scale);
+        current_rx += x_advance;
+    }
+}
 
-        float vertices[] = {
-            x0, y1, u0, v1, x1, y1, u1, v1, x1, y0, u1, v0,
+void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale, float r, float g, float b,
+                                float target_width, float target_height) {
+    SDLTextRendererGL_DrawTextStyled(text, x, y, scale, r, g, b, TEXT_STYLE_PLAIN, target_width, target_height);
+}
 
-            x1, y0, u1, v0, x0, y0, u0, v0, x0, y1, u0, v1,
-        };
+void SDLTextRendererGL_Flush(void) {
+    s_last_stats.draw_calls = 0;
+    s_last_stats.quads = s_quad_count;
+    if (s_quad_count == 0) {
+        return;
+    }
 
-        glBindBuffer(GL_ARRAY_BUFFER, s_text_vbo);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    glBindVertexArray(s_overlay_vao);
+    GLint base_vertex = 0;
+    if (s_mapped) {
+        base_vertex = s_region * MAX_OVERLAY_QUADS * 4;
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, s_overlay_vbo);
+        const GLsizeiptr bytes = (GLsizeiptr)s_quad_count * 4 * sizeof(OverlayVertex);
+        glBufferData(GL_ARRAY_BUFFER, MAX_OVERLAY_QUADS * 4 * sizeof(OverlayVertex), NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, s_staging);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glUseProgram(s_overlay_shader);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, s_font_atlas.texture_id);
 
-        current_rx += x_advance;
+    glDrawElementsBaseVertex(GL_TRIANGLES, s_quad_count * 6, GL_UNSIGNED_SHORT, NULL, base_vertex);
+    s_last_stats.draw_calls = 1;
+
+    if (s_mapped) {
+        s_region_fences[s_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s_region = (s_region + 1) % OVERLAY_RING_REGIONS;
     }
+    s_quad_count = 0;
+    s_write = NULL;
 
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -233,8 +403,8 @@ void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale,
     glDisable(GL_BLEND);
 }
 
-void SDLTextRendererGL_Flush(void) {
-    // Immediate mode; nothing to flush
+void SDLTextRendererGL_GetStats(TextRendererStats* out) {
+    *out = s_last_stats;
 }
 
 void SDLTextRendererGL_SetYOffset(float y_offset) {
@@ -58,6 +58,7 @@ static float s_bg_color[4] = { 0.0f, 0.0f, 0.0f, 0.6f };
 static float s_bg_padding = 2.0f;
 
 static SDL_GPUDevice* device = NULL;
+static TextRendererStats s_last_stats;
 
 static SDL_GPUShader* CreateGPUShader(const char* filename, SDL_GPUShaderStage stage) {
     size_t size;
@@ -409,6 +410,8 @@ void SDLTextRendererGPU_DrawText(const char* text, float x, float y, float scale
 
 /** @brief Flush queued text and background rects to the GPU. */
 void SDLTextRendererGPU_Flush(void) {
+    s_last_stats.draw_calls = 0;
+    s_last_stats.quads = (s_text_vert_count + s_rect_vert_count) / 6;
     if (s_text_vert_count == 0 && s_rect_vert_count == 0)
         return;
 
@@ -469,6 +472,7 @@ void SDLTextRendererGPU_Flush(void) {
             SDL_GPUBufferBinding vb = { .buffer = s_vertex_buffer, .offset = 0 };
             SDL_BindGPUVertexBuffers(pass, 0, &vb, 1);
             SDL_DrawGPUPrimitives(pass, s_rect_vert_count, 1, 0, 0);
+            s_last_stats.draw_calls++;
         }
 
         // Draw Text
@@ -483,6 +487,7 @@ void SDLTextRendererGPU_Flush(void) {
             SDL_BindGPUFragmentSamplers(pass, 0, &tex_binding, 1);
 
             SDL_DrawGPUPrimitives(pass, s_text_vert_count, 1, 0, 0);
+            s_last_stats.draw_calls++;
         }
 
         SDL_EndGPURenderPass(pass);
@@ -493,6 +498,11 @@ void SDLTextRendererGPU_Flush(void) {
     s_rect_vert_count = 0;
 }
 
+/** @brief Draw calls and quads submitted by the last flush. */
+void SDLTextRendererGPU_GetStats(TextRendererStats* out) {
+    *out = s_last_stats;
+}
+
 /** @brief Set vertical offset for text rendering. */
 void SDLTextRendererGPU_SetYOffset(float y_offset) {
     s_text_y_offset = y_offset;
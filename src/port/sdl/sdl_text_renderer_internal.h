@@ -1,12 +1,17 @@
 #ifndef SDL_TEXT_RENDERER_INTERNAL_H
 #define SDL_TEXT_RENDERER_INTERNAL_H
 
+#include "port/sdl/sdl_text_renderer.h"
+
 // OpenGL Backend
 void SDLTextRendererGL_Init(const char* base_path, const char* font_path);
 void SDLTextRendererGL_Shutdown(void);
 void SDLTextRendererGL_DrawText(const char* text, float x, float y, float scale, float r, float g, float b,
                                 float target_width, float target_height);
+void SDLTextRendererGL_DrawTextStyled(const char* text, float x, float y, float scale, float r, float g, float b,
+                                      TextStyle style, float target_width, float target_height);
 void SDLTextRendererGL_Flush(void);
+void SDLTextRendererGL_GetStats(TextRendererStats* out);
 void SDLTextRendererGL_SetYOffset(float y_offset);
 void SDLTextRendererGL_SetBackgroundEnabled(int enabled);
 void SDLTextRendererGL_SetBackgroundColor(float r, float g, float b, float a);
@@ -18,6 +23,7 @@ void SDLTextRendererGPU_Shutdown(void);
 void SDLTextRendererGPU_DrawText(const char* text, float x, float y, float scale, float r, float g, float b,
                                  float target_width, float target_height);
 void SDLTextRendererGPU_Flush(void);
+void SDLTextRendererGPU_GetStats(TextRendererStats* out);
 void SDLTextRendererGPU_SetYOffset(float y_offset);
 void SDLTextRendererGPU_SetBackgroundEnabled(int enabled);
 void SDLTextRendererGPU_SetBackgroundColor(float r, float g, float b, float a);
@@ -35,6 +35,7 @@ int SDLApp_GetAvailablePresetCount();
 const char* SDLApp_GetPresetName(int index);
 
 void SDLApp_LoadPreset(int index);
+float SDLApp_GetShaderGPUTimeMs();
 
 // VSync control
 void SDLApp_SetVSync(bool enabled);
@@ -123,6 +124,11 @@ extern "C" void shader_menu_render(int window_width, int window_height) {
         if (preset_count == 0) {
             ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "No Libretro shader presets found!");
         } else {
+            const float gpu_ms = SDLApp_GetShaderGPUTimeMs();
+            if (gpu_ms >= 0.0f) {
+                ImGui::Text("GPU cost: %.2f ms", gpu_ms);
+            }
+
             ImGui::Text("Available Presets (%d):", preset_count);
 
             if (ImGui::BeginChild("PresetList", ImVec2(0, window_height * 0.6f), true)) {
@@ -6,6 +6,7 @@
 #include "port/sdl/training_menu.h"
 #include "imgui.h"
 #include "port/config.h"
+#include "sf33rd/Source/Game/training/training_fork.h"
 #include <cstdio>
 
 bool show_training_menu = false;
@@ -108,7 +109,17 @@ extern "C" void training_menu_render(int window_width, int window_height) {
             Config_SetBool(CFG_KEY_TRAINING_ADVANTAGE, g_training_menu_settings.show_advantage);
             Config_Save();
         }
-        HelpMarker("Display +/- frame advantage numbers upon attack completion.");
+        HelpMarker("Predict each move's +/- frame advantage, punish window and whether it hits, by playing the "
+                   "match ahead with the dummy blocking and not blocking.");
+
+        if (g_training_menu_settings.show_advantage && g_training_fork.active) {
+            ImGui::Indent();
+            ImGui::TextDisabled("Lookahead: %u frames, %u/%u us",
+                                (unsigned)g_training_fork.frames_run,
+                                (unsigned)g_training_fork.last_cost_us,
+                                (unsigned)g_training_fork.budget_us);
+            ImGui::Unindent();
+        }
 
         if (ImGui::Checkbox("Show Stun Timer", &g_training_menu_settings.show_stun)) {
             Config_SetBool(CFG_KEY_TRAINING_STUN, g_training_menu_settings.show_stun);
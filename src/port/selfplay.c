@@ -0,0 +1,668 @@
+/**
+ * @file selfplay.c
+ * @brief CPU-vs-CPU self-play: many seeded demo fights at full speed, with a report.
+ *
+ * Each match is the attract mode's demo fight with its setup replaced: the
+ * ranking screen's demo setup asks for the next match's characters, super
+ * arts and stage, and the first fight tick seeds the engine RNG, so a seed
+ * always plays the same fight. The demo's 30 second cut is held off for the
+ * whole fight, which runs until a KO, time over or SELFPLAY_MAX_FIGHT_FRAMES.
+ *
+ * Headless runs drive whole logic ticks the way replay fast-forward does,
+ * with texture transfers skipped, sound requests held and the SPU unmixed;
+ * a frame is presented only every SELFPLAY_TICKS_PER_PRESENT ticks so the
+ * window keeps handling events. For parallel runs the parent never boots
+ * the game: it starts worker processes on consecutive slices of the match
+ * range, and each writes its totals to a text file the parent merges.
+ * Workers get the parent's other command-line options, so --renderer and
+ * the like apply to them too.
+ *
+ * Every match starts from the same engine state: the first setup snapshots
+ * what a netplay rollback restores, and each later setup loads it back before
+ * applying its own characters and stage. Nothing a fight leaves behind
+ * reaches the next one, so a match replays alone exactly as it played in
+ * sequence. --selfplay-check confirms that by rerunning the last match of
+ * every worker slice, the one with the most history in front of it, in a
+ * process of its own.
+ */
+#include "port/selfplay.h"
+#include "common.h"
+#include "game_state.h"
+#include "main.h"
+#include "port/io/afs.h"
+#include "port/sdl/sdl_app.h"
+#include "port/sdl/sdl_app_internal.h"
+#include "port/selfplay_stats.h"
+#include "port/sound/spu.h"
+#include "sf33rd/Source/Game/demo/demo02.h"
+#include "sf33rd/Source/Game/engine/plcnt.h"
+#include "sf33rd/Source/Game/engine/workuser.h"
+#include "sf33rd/Source/Game/sound/sound3rd.h"
+#include "sf33rd/Source/Game/stage/bg.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+#define SELFPLAY_MAX_FIGHT_FRAMES 7200 // 2 min; past a full round timer, so only stalemates hit it
+#define SELFPLAY_DEMO_TIMER 1800       // Demo00's fight countdown, held here while a match runs
+#define SELFPLAY_WAIT_TICKS 60000      // Give up if no fight starts or ends within this
+#define SELFPLAY_NO_WEAK_PL 2          // Weak_PL matching neither side: no demo handicap
+#define SELFPLAY_MAX_JOBS 64
+
+// Set by ParseCLI
+extern int g_selfplay_matches;
+extern unsigned int g_selfplay_seed;
+extern int g_selfplay_first;
+extern int g_selfplay_jobs;
+extern const char* g_selfplay_out;
+extern const char* g_selfplay_shard;
+extern bool g_selfplay_watch;
+extern bool g_selfplay_check;
+
+typedef enum SelfPlayState {
+    SELFPLAY_WAITING = 0, // For the next demo setup
+    SELFPLAY_ARMED,       // The next match is set up; waiting for its first tick
+    SELFPLAY_FIGHTING,
+} SelfPlayState;
+
+static const char* const char_names[SELFPLAY_CHARACTER_COUNT] = {
+    "Gill", "Alex", "Ryu",  "Yun",   "Dudley", "Necro",   "Hugo",   "Ibuki", "Elena",  "Oro",
+    "Yang", "Ken",  "Sean", "Urien", "Akuma",  "Chun-Li", "Makoto", "Q",     "Twelve", "Remy",
+};
+
+static const char* const end_names[SELFPLAY_END_COUNT] = { "ko", "double_ko", "time", "cap" };
+
+static bool running = false;
+static bool quit_requested = false;
+static SelfPlayState state = SELFPLAY_WAITING;
+static SelfPlayTotals totals;
+static SelfPlayMatch match;    // The match armed or being fought
+static int next_match = 0;     // Matches set up so far
+static s16 last_routine[2][2]; // Each side's routine_no[1] and [2] on the previous tick
+static RollbackState* match_start = NULL; // Engine state the first match was set up in
+static int checked_matches = 0;            // Matches --selfplay-check replayed alone
+static int check_mismatches = 0;           // Those that came out differently
+static int checked_index[SELFPLAY_MAX_JOBS];
+static bool checked_same[SELFPLAY_MAX_JOBS];
+
+bool SelfPlay_IsRequested(void) {
+    return g_selfplay_matches > 0;
+}
+
+bool SelfPlay_IsRunning(void) {
+    return running;
+}
+
+bool SelfPlay_IsParent(void) {
+    return SelfPlay_IsRequested() && (g_selfplay_jobs != 1 || g_selfplay_check) && g_selfplay_shard == NULL &&
+           !g_selfplay_watch;
+}
+
+void SelfPlay_PrepareHeadless(void) {
+    if (SelfPlay_IsRequested() && !g_selfplay_watch) {
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
+}
+
+static int stage_of(int slot) {
+    return Demo_Stage_Play_Data[slot / 2][slot % 2];
+}
+
+// --- Game hooks ---
+
+void SelfPlay_SetupFight(void) {
+    if (!running || state == SELFPLAY_FIGHTING || next_match >= g_selfplay_matches)
+        return;
+
+    // Every match starts where the first one did, whatever the fights before
+    // it left behind; a match played alone starts there too
+    if (match_start == NULL) {
+        match_start = (RollbackState*)SDL_malloc(sizeof(RollbackState));
+        if (match_start == NULL) {
+            fatal_error("SelfPlay: no memory for the match start state");
+        }
+        RollbackState_Save(match_start);
+    } else {
+        RollbackState_Load(match_start);
+    }
+
+    // A setup that never reached its fight is simply replaced
+    SDL_zero(match);
+    match.index = g_selfplay_first + next_match;
+    match.seed = g_selfplay_seed + (unsigned int)match.index;
+    SelfPlaySetup_FromSeed(match.seed, &match.setup);
+
+    for (int i = 0; i < 2; i++) {
+        My_char[i] = (u8)match.setup.chars[i];
+        Super_Arts[i] = (s8)match.setup.super_arts[i];
+        Player_Color[i] = 0;
+        Operator_Status[i] = 0;
+    }
+    bg_w.area = 0;
+    bg_w.stage = (s16)stage_of(match.setup.stage_slot);
+
+    state = SELFPLAY_ARMED;
+}
+
+/** @brief Put the engine RNG where the match's seed says; done on the first fight tick. */
+static void seed_random(const SelfPlaySetup* setup) {
+    s16* const indices[SELFPLAY_RANDOM_COUNT] = {
+        &Random_ix16,        &Random_ix32,        &Random_ix16_ex,
+        &Random_ix32_ex,     &Random_ix16_com,    &Random_ix32_com,
+        &Random_ix16_ex_com, &Random_ix32_ex_com, &Random_ix16_bg,
+    };
+
+    for (int i = 0; i < SELFPLAY_RANDOM_COUNT; i++) {
+        *indices[i] = (s16)setup->random_ix[i];
+    }
+}
+
+/** @brief Count an attack when a side enters its attack routine or switches to another one. */
+static void count_move(int side) {
+    const WORK* wu = &plw[side].wu;
+    const int id = wu->routine_no[2];
+
+    if (wu->routine_no[1] == 4 && (last_routine[side][0] != 4 || last_routine[side][1] != id) &&
+        id >= 0 && id < SELFPLAY_MOVE_COUNT) {
+        totals.moves[match.setup.chars[side]][id] += 1;
+    }
+
+    last_routine[side][0] = wu->routine_no[1];
+    last_routine[side][1] = wu->routine_no[2];
+}
+
+void SelfPlay_Tick(void) {
+    if (!running)
+        return;
+
+    if (state == SELFPLAY_ARMED) {
+        seed_random(&match.setup);
+        Weak_PL = SELFPLAY_NO_WEAK_PL;
+        plw[0].wu.pl_operator = 0;
+        plw[1].wu.pl_operator = 0;
+        SDL_zeroa(last_routine);
+        state = SELFPLAY_FIGHTING;
+    }
+
+    if (state != SELFPLAY_FIGHTING || Conclusion_Flag)
+        return;
+
+    match.frames += 1;
+    count_move(0);
+    count_move(1);
+}
+
+// --- Match driver ---
+
+/** @brief Record the match in progress. */
+static void finish_match(SelfPlayEnd end) {
+    const s16 vital[2] = { plw[0].wu.vital_new, plw[1].wu.vital_new };
+
+    match.end = end;
+    if (end == SELFPLAY_END_DOUBLE_KO || (end == SELFPLAY_END_CAP && vital[0] == vital[1])) {
+        match.winner = -1;
+    } else if (end == SELFPLAY_END_CAP) {
+        match.winner = vital[0] > vital[1] ? 0 : 1;
+    } else {
+        match.winner = Winner_id;
+    }
+
+    SelfPlayTotals_AddMatch(&totals, &match);
+    next_match += 1;
+    state = SELFPLAY_WAITING;
+
+    SDL_Log("SelfPlay: match %d (seed %u) %s vs %s: %s by %s after %d frames",
+            match.index,
+            match.seed,
+            char_names[match.setup.chars[0]],
+            char_names[match.setup.chars[1]],
+            match.winner < 0 ? "draw" : (match.winner == 0 ? "P1" : "P2"),
+            end_names[end],
+            match.frames);
+}
+
+/** @brief Follow the fight after a tick. Returns true while a fight is running. */
+static bool after_tick(void) {
+    if (state != SELFPLAY_FIGHTING)
+        return false;
+
+    if (Conclusion_Flag) {
+        // Conclusion_Type is 0 for a KO, 1 for a double KO and 2 for time over
+        finish_match(Conclusion_Type == 1 ? SELFPLAY_END_DOUBLE_KO
+                     : Conclusion_Type == 2 ? SELFPLAY_END_TIME
+                                            : SELFPLAY_END_KO);
+    } else if (match.frames >= SELFPLAY_MAX_FIGHT_FRAMES) {
+        finish_match(SELFPLAY_END_CAP);
+        D_Timer = 2; // Let Demo00 end the fight on its next tick
+    } else if (D_No[0] == 0 && D_No[1] == 3) {
+        D_Timer = SELFPLAY_DEMO_TIMER;
+    }
+
+    return true;
+}
+
+/** @brief One frame through the serial main-loop path, at normal speed. */
+static void run_watched_frame(const SelfPlayHooks* hooks) {
+    SDLApp_BeginFrame();
+    hooks->step_0();
+    SDLApp_EndFrame();
+
+    if (!SDLApp_PollEvents()) {
+        quit_requested = true;
+    }
+
+    hooks->step_1();
+}
+
+/** @brief SELFPLAY_TICKS_PER_PRESENT logic-only ticks, then present so events keep flowing. */
+static int run_headless_batch(const SelfPlayHooks* hooks, int* idle_ticks) {
+    int ticks = 0;
+
+    SDLApp_BeginFrame();
+
+    while (ticks < SELFPLAY_TICKS_PER_PRESENT && next_match < g_selfplay_matches) {
+        AFS_RunServer();
+        hooks->logic_tick();
+        ticks += 1;
+        *idle_ticks = after_tick() ? 0 : *idle_ticks + 1;
+    }
+
+    SDLApp_EndFrame();
+
+    if (!SDLApp_PollEvents()) {
+        quit_requested = true;
+    }
+
+    return ticks;
+}
+
+// --- Report ---
+
+/** @brief The match_list suffix saying how a match fared under --selfplay-check, if it was replayed. */
+static const char* check_label(int index) {
+    for (int i = 0; i < checked_matches; i++) {
+        if (checked_index[i] == index) {
+            return checked_same[i] ? ", \"check\": \"same\"" : ", \"check\": \"differs\"";
+        }
+    }
+    return "";
+}
+
+static void write_report(FILE* f, int workers, Uint64 wall_ns) {
+    const double wall_s = (double)wall_ns / 1e9;
+    const double busy_s = (double)totals.busy_ns / 1e9;
+    unsigned int ends[SELFPLAY_END_COUNT] = { 0 };
+    unsigned long long fight_frames = 0;
+
+    for (size_t i = 0; i < totals.count; i++) {
+        ends[totals.matches[i].end] += 1;
+        fight_frames += (unsigned long long)totals.matches[i].frames;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"schema\": 1,\n");
+    fprintf(f, "  \"platform\": \"%s\",\n", SDL_GetPlatform());
+#if defined(DEBUG)
+    fprintf(f, "  \"build\": \"debug\",\n");
+#else
+    fprintf(f, "  \"build\": \"release\",\n");
+#endif
+    fprintf(f, "  \"seed\": %u,\n", g_selfplay_seed);
+    fprintf(f, "  \"matches\": %zu,\n", totals.count);
+    fprintf(f, "  \"workers\": %d,\n", workers);
+    fprintf(f, "  \"ticks\": %llu,\n", totals.ticks);
+    fprintf(f, "  \"fight_frames\": %llu,\n", fight_frames);
+    fprintf(f, "  \"wall_s\": %.3f,\n", wall_s);
+    fprintf(f, "  \"ticks_per_second\": %.1f,\n", wall_s > 0.0 ? (double)totals.ticks / wall_s : 0.0);
+    fprintf(f, "  \"ticks_per_second_per_worker\": %.1f,\n", busy_s > 0.0 ? (double)totals.ticks / busy_s : 0.0);
+    fprintf(f, "  \"fight_frames_mean\": %.1f,\n", SelfPlayTotals_MeanFrames(&totals));
+    if (checked_matches > 0) {
+        fprintf(f, "  \"check\": { \"matches\": %d, \"mismatches\": %d },\n", checked_matches, check_mismatches);
+    }
+
+    fprintf(f, "  \"ends\": {");
+    for (int e = 0; e < SELFPLAY_END_COUNT; e++) {
+        fprintf(f, " \"%s\": %u%s", end_names[e], ends[e], e == SELFPLAY_END_COUNT - 1 ? " },\n" : ",");
+    }
+
+    fprintf(f, "  \"characters\": {\n");
+    bool first_char = true;
+    for (int c = 0; c < SELFPLAY_CHARACTER_COUNT; c++) {
+        SelfPlayRecord record;
+        SelfPlayTotals_Record(&totals, c, &record);
+        if (record.matches == 0)
+            continue;
+
+        fprintf(f, "%s    \"%s\": {\n", first_char ? "" : ",\n", char_names[c]);
+        first_char = false;
+        fprintf(f, "      \"matches\": %u,\n", record.matches);
+        fprintf(f, "      \"wins\": %u,\n", record.wins);
+        fprintf(f, "      \"losses\": %u,\n", record.losses);
+        fprintf(f, "      \"draws\": %u,\n", record.draws);
+        fprintf(f, "      \"win_rate\": %.4f,\n", (double)record.wins / record.matches);
+        fprintf(f, "      \"moves\": {");
+
+        bool first_move = true;
+        for (int id = 0; id < SELFPLAY_MOVE_COUNT; id++) {
+            if (totals.moves[c][id] == 0)
+                continue;
+            fprintf(f, "%s \"%d\": %u", first_move ? "" : ",", id, totals.moves[c][id]);
+            first_move = false;
+        }
+        fprintf(f, " }\n    }");
+    }
+    fprintf(f, "%s  },\n", first_char ? "" : "\n");
+
+    fprintf(f, "  \"match_list\": [\n");
+    for (size_t i = 0; i < totals.count; i++) {
+        const SelfPlayMatch* m = &totals.matches[i];
+        fprintf(f,
+                "    { \"index\": %d, \"seed\": %u, \"p1\": \"%s\", \"p2\": \"%s\", \"super_arts\": [%d, %d], "
+                "\"stage\": %d, \"winner\": \"%s\", \"end\": \"%s\", \"frames\": %d%s }%s\n",
+                m->index,
+                m->seed,
+                char_names[m->setup.chars[0]],
+                char_names[m->setup.chars[1]],
+                m->setup.super_arts[0] + 1,
+                m->setup.super_arts[1] + 1,
+                stage_of(m->setup.stage_slot),
+                m->winner < 0 ? "draw" : (m->winner == 0 ? "p1" : "p2"),
+                end_names[m->end],
+                m->frames,
+                check_label(m->index),
+                i == totals.count - 1 ? "" : ",");
+    }
+    fprintf(f, "  ]\n");
+    fprintf(f, "}\n");
+}
+
+/** @brief Write the report to --selfplay-out, or stdout. */
+static bool publish_report(int workers, Uint64 wall_ns) {
+    FILE* f = stdout;
+    if (g_selfplay_out) {
+        f = fopen(g_selfplay_out, "w");
+        if (!f) {
+            SDL_Log("SelfPlay: can't write %s", g_selfplay_out);
+            return false;
+        }
+    }
+
+    SelfPlayTotals_SortMatches(&totals);
+    write_report(f, workers, wall_ns);
+
+    if (f != stdout) {
+        fclose(f);
+        SDL_Log("SelfPlay: report written to %s", g_selfplay_out);
+    }
+    return true;
+}
+
+/** @brief Write this worker's totals for the parent to merge. */
+static bool publish_shard(void) {
+    FILE* f = fopen(g_selfplay_shard, "w");
+    if (!f) {
+        SDL_Log("SelfPlay: can't write %s", g_selfplay_shard);
+        return false;
+    }
+
+    const bool ok = SelfPlayTotals_Write(&totals, f);
+    return (fclose(f) == 0) && ok;
+}
+
+// --- Entry points ---
+
+int SelfPlay_Run(const SelfPlayHooks* hooks) {
+    const bool headless = !g_selfplay_watch;
+    const bool vsync_was_enabled = SDLApp_IsVSyncEnabled();
+    const bool was_uncapped = SDLApp_IsFrameRateUncapped();
+
+    if (headless) {
+        // Run flat out with nothing to see or hear
+        if (vsync_was_enabled) {
+            SDLApp_SetVSync(false);
+        }
+        if (!was_uncapped) {
+            SDLApp_ToggleFrameRateUncap();
+        }
+        SPU_SetManualMix(true);
+        sound_requests_held = true;
+        SDL_HideWindow(SDLApp_GetWindow());
+    }
+
+    SDL_zero(totals);
+    state = SELFPLAY_WAITING;
+    next_match = 0;
+    running = true;
+
+    SDL_Log("SelfPlay: playing matches %d-%d, seed %u",
+            g_selfplay_first,
+            g_selfplay_first + g_selfplay_matches - 1,
+            g_selfplay_seed);
+
+    const Uint64 start = SDL_GetTicksNS();
+    int idle_ticks = 0;
+    bool ok = true;
+
+    while (next_match < g_selfplay_matches && !quit_requested) {
+        if (headless) {
+            totals.ticks += (unsigned long long)run_headless_batch(hooks, &idle_ticks);
+        } else {
+            run_watched_frame(hooks);
+            totals.ticks += 1;
+            idle_ticks = after_tick() ? 0 : idle_ticks + 1;
+        }
+
+        if (idle_ticks >= SELFPLAY_WAIT_TICKS) {
+            SDL_Log("SelfPlay: gave up waiting for the attract demo to start a fight");
+            ok = false;
+            break;
+        }
+    }
+
+    totals.busy_ns = SDL_GetTicksNS() - start;
+    running = false;
+    ok &= !quit_requested;
+
+    if (headless) {
+        sound_requests_held = false;
+        SPU_SetManualMix(false);
+        if (!was_uncapped) {
+            SDLApp_ToggleFrameRateUncap();
+        }
+        if (vsync_was_enabled) {
+            SDLApp_SetVSync(true);
+        }
+    }
+
+    if (!ok) {
+        SDL_Log("SelfPlay: aborted after %zu matches, no report written", totals.count);
+    } else if (g_selfplay_shard) {
+        ok = publish_shard();
+    } else {
+        ok = publish_report(1, totals.busy_ns);
+    }
+
+    SelfPlayTotals_Free(&totals);
+    SDL_free(match_start);
+    match_start = NULL;
+    return ok ? 0 : 1;
+}
+
+/** @brief Worker count from --selfplay-jobs: 0 is one per logical core. */
+static int worker_count(void) {
+    const int jobs = g_selfplay_jobs > 0 ? g_selfplay_jobs : SDL_GetNumLogicalCPUCores();
+    return SDL_clamp(jobs, 1, SDL_min(g_selfplay_matches, SELFPLAY_MAX_JOBS));
+}
+
+/** @brief True for the self-play options the parent sets per worker; `values` is how many arguments follow. */
+static bool is_worker_option(const char* arg, int* values) {
+    static const struct {
+        const char* name;
+        int values;
+    } options[] = {
+        { "--selfplay", 1 },       { "--selfplay-seed", 1 },  { "--selfplay-jobs", 1 },  { "--selfplay-out", 1 },
+        { "--selfplay-watch", 0 }, { "--selfplay-check", 0 }, { "--selfplay-first", 1 }, { "--selfplay-shard", 1 },
+    };
+
+    for (size_t i = 0; i < SDL_arraysize(options); i++) {
+        if (SDL_strcmp(arg, options[i].name) == 0) {
+            *values = options[i].values;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Start a worker on matches [first, first + count) with the parent's other options. */
+static SDL_Process* start_worker(int argc, char* argv[], int first, int count, const char* shard) {
+    const char** args = (const char**)SDL_malloc((size_t)(argc + 9) * sizeof(*args));
+    char count_arg[16];
+    char seed_arg[16];
+    char first_arg[16];
+    int n = 0;
+
+    if (!args)
+        return NULL;
+
+    SDL_snprintf(count_arg, sizeof(count_arg), "%d", count);
+    SDL_snprintf(seed_arg, sizeof(seed_arg), "%u", g_selfplay_seed);
+    SDL_snprintf(first_arg, sizeof(first_arg), "%d", first);
+
+    args[n++] = argv[0];
+    for (int i = 1; i < argc; i++) {
+        int values = 0;
+        if (is_worker_option(argv[i], &values)) {
+            i += values;
+        } else {
+            args[n++] = argv[i];
+        }
+    }
+    args[n++] = "--selfplay";
+    args[n++] = count_arg;
+    args[n++] = "--selfplay-seed";
+    args[n++] = seed_arg;
+    args[n++] = "--selfplay-first";
+    args[n++] = first_arg;
+    args[n++] = "--selfplay-shard";
+    args[n++] = shard;
+    args[n] = NULL;
+
+    SDL_Process* process = SDL_CreateProcess(args, false);
+    SDL_free(args);
+    return process;
+}
+
+/** @brief Wait for a worker and add its totals to `into`. Returns false if it failed. */
+static bool collect_worker(SDL_Process* process, const char* shard, SelfPlayTotals* into) {
+    int exit_code = 1;
+
+    SDL_WaitProcess(process, true, &exit_code);
+    SDL_DestroyProcess(process);
+
+    FILE* f = exit_code == 0 ? fopen(shard, "r") : NULL;
+    const bool ok = f && SelfPlayTotals_Read(into, f);
+    if (!ok) {
+        SDL_Log("SelfPlay: worker for %s failed (exit code %d)", shard, exit_code);
+    }
+
+    if (f) {
+        fclose(f);
+    }
+    SDL_RemovePath(shard);
+    return ok;
+}
+
+/** @brief Replay each slice's last match in a process of its own and compare it with the merged totals. */
+static bool check_matches(int argc, char* argv[], const int* last, int jobs, const char* base) {
+    SDL_Process* workers[SELFPLAY_MAX_JOBS];
+    char shards[SELFPLAY_MAX_JOBS][512];
+    bool ok = true;
+
+    for (int k = 0; k < jobs; k++) {
+        SDL_snprintf(shards[k], sizeof(shards[k]), "%s.check%d.txt", base, k);
+        workers[k] = start_worker(argc, argv, last[k], 1, shards[k]);
+        if (!workers[k]) {
+            SDL_Log("SelfPlay: can't start check worker %d: %s", k, SDL_GetError());
+            ok = false;
+        }
+    }
+
+    for (int k = 0; k < jobs; k++) {
+        SelfPlayTotals alone = { 0 };
+
+        if (!workers[k])
+            continue;
+
+        if (!collect_worker(workers[k], shards[k], &alone)) {
+            ok = false;
+        } else {
+            const SelfPlayMatch* in_sequence = SelfPlayTotals_FindMatch(&totals, last[k]);
+            const SelfPlayMatch* replayed = SelfPlayTotals_FindMatch(&alone, last[k]);
+
+            const bool same = in_sequence && replayed && SelfPlayMatch_SameResult(in_sequence, replayed);
+
+            checked_index[checked_matches] = last[k];
+            checked_same[checked_matches] = same;
+            checked_matches += 1;
+            if (!same) {
+                check_mismatches += 1;
+                SDL_Log("SelfPlay: match %d came out differently when replayed alone", last[k]);
+            }
+        }
+
+        SelfPlayTotals_Free(&alone);
+    }
+
+    return ok;
+}
+
+int SelfPlay_RunWorkers(int argc, char* argv[]) {
+    const int jobs = worker_count();
+    const char* base = g_selfplay_out ? g_selfplay_out : "selfplay";
+    SDL_Process* workers[SELFPLAY_MAX_JOBS];
+    char shards[SELFPLAY_MAX_JOBS][512];
+    int last[SELFPLAY_MAX_JOBS];
+    bool ok = true;
+
+    SDL_zero(totals);
+    checked_matches = 0;
+    check_mismatches = 0;
+    SDL_Log("SelfPlay: %d matches over %d workers, seed %u", g_selfplay_matches, jobs, g_selfplay_seed);
+
+    const Uint64 start = SDL_GetTicksNS();
+
+    for (int k = 0; k < jobs; k++) {
+        // Consecutive slices, so worker k's matches keep the seeds they'd have in one process
+        const int first = g_selfplay_first + (int)((long long)g_selfplay_matches * k / jobs);
+        const int end = g_selfplay_first + (int)((long long)g_selfplay_matches * (k + 1) / jobs);
+
+        last[k] = end - 1;
+        SDL_snprintf(shards[k], sizeof(shards[k]), "%s.worker%d.txt", base, k);
+
+        workers[k] = start_worker(argc, argv, first, end - first, shards[k]);
+        if (!workers[k]) {
+            SDL_Log("SelfPlay: can't start worker %d: %s", k, SDL_GetError());
+            ok = false;
+        }
+    }
+
+    for (int k = 0; k < jobs; k++) {
+        if (workers[k] && !collect_worker(workers[k], shards[k], &totals)) {
+            ok = false;
+        }
+    }
+
+    const Uint64 wall_ns = SDL_GetTicksNS() - start;
+
+    if (ok && g_selfplay_check) {
+        ok = check_matches(argc, argv, last, jobs, base);
+    }
+
+    if (ok) {
+        ok = publish_report(jobs, wall_ns);
+    } else {
+        SDL_Log("SelfPlay: aborted, no report written");
+    }
+
+    SelfPlayTotals_Free(&totals);
+    return (ok && check_mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/**
+ * @file selfplay_stats.c
+ * @brief Match setups, result totals and the worker text format for self-play.
+ */
+#include "port/selfplay_stats.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SELFPLAY_FORMAT_VERSION 1
+
+/** @brief Next value of a splitmix32 stream; neighbouring seeds give unrelated setups. */
+static unsigned int next_random(unsigned int* state) {
+    unsigned int z = (*state += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void SelfPlaySetup_FromSeed(unsigned int seed, SelfPlaySetup* out) {
+    unsigned int state = seed;
+
+    for (int i = 0; i < 2; i++) {
+        out->chars[i] = (int)(next_random(&state) % SELFPLAY_CHARACTER_COUNT);
+        out->super_arts[i] = (int)(next_random(&state) % 3);
+    }
+
+    out->stage_slot = (int)(next_random(&state) % SELFPLAY_STAGE_COUNT);
+
+    for (int i = 0; i < SELFPLAY_RANDOM_COUNT; i++) {
+        out->random_ix[i] = (int)(next_random(&state) & 0x7F);
+    }
+}
+
+bool SelfPlayTotals_AddMatch(SelfPlayTotals* totals, const SelfPlayMatch* match) {
+    if (totals->count == totals->capacity) {
+        const size_t capacity = totals->capacity ? totals->capacity * 2 : 256;
+        SelfPlayMatch* matches = (SelfPlayMatch*)realloc(totals->matches, capacity * sizeof(SelfPlayMatch));
+        if (!matches)
+            return false;
+        totals->matches = matches;
+        totals->capacity = capacity;
+    }
+    totals->matches[totals->count++] = *match;
+    return true;
+}
+
+void SelfPlayTotals_Free(SelfPlayTotals* totals) {
+    free(totals->matches);
+    memset(totals, 0, sizeof(*totals));
+}
+
+bool SelfPlayTotals_Merge(SelfPlayTotals* dst, const SelfPlayTotals* src) {
+    for (size_t i = 0; i < src->count; i++) {
+        if (!SelfPlayTotals_AddMatch(dst, &src->matches[i]))
+            return false;
+    }
+    for (int c = 0; c < SELFPLAY_CHARACTER_COUNT; c++) {
+        for (int m = 0; m < SELFPLAY_MOVE_COUNT; m++) {
+            dst->moves[c][m] += src->moves[c][m];
+        }
+    }
+    dst->ticks += src->ticks;
+    dst->busy_ns += src->busy_ns;
+    return true;
+}
+
+static int compare_matches(const void* a, const void* b) {
+    const int ia = ((const SelfPlayMatch*)a)->index;
+    const int ib = ((const SelfPlayMatch*)b)->index;
+    return (ia > ib) - (ia < ib);
+}
+
+void SelfPlayTotals_SortMatches(SelfPlayTotals* totals) {
+    if (totals->count > 1) {
+        qsort(totals->matches, totals->count, sizeof(SelfPlayMatch), compare_matches);
+    }
+}
+
+const SelfPlayMatch* SelfPlayTotals_FindMatch(const SelfPlayTotals* totals, int index) {
+    for (size_t i = 0; i < totals->count; i++) {
+        if (totals->matches[i].index == index)
+            return &totals->matches[i];
+    }
+    return NULL;
+}
+
+bool SelfPlayMatch_SameResult(const SelfPlayMatch* a, const SelfPlayMatch* b) {
+    return a->index == b->index && a->seed == b->seed && memcmp(&a->setup, &b->setup, sizeof(a->setup)) == 0 &&
+           a->winner == b->winner && a->end == b->end && a->frames == b->frames;
+}
+
+// One line per record:
+//   selfplay <version>
+//   ticks <ticks> <busy_ns>
+//   match <index> <seed> <p1> <p2> <sa1> <sa2> <stage_slot> <winner> <end> <frames> <random_ix...>
+//   move <character> <id> <count>
+bool SelfPlayTotals_Write(const SelfPlayTotals* totals, FILE* f) {
+    fprintf(f, "selfplay %d\n", SELFPLAY_FORMAT_VERSION);
+    fprintf(f, "ticks %llu %llu\n", totals->ticks, totals->busy_ns);
+
+    for (size_t i = 0; i < totals->count; i++) {
+        const SelfPlayMatch* m = &totals->matches[i];
+        fprintf(f,
+                "match %d %u %d %d %d %d %d %d %d %d",
+                m->index,
+                m->seed,
+                m->setup.chars[0],
+                m->setup.chars[1],
+                m->setup.super_arts[0],
+                m->setup.super_arts[1],
+                m->setup.stage_slot,
+                m->winner,
+                m->end,
+                m->frames);
+        for (int r = 0; r < SELFPLAY_RANDOM_COUNT; r++) {
+            fprintf(f, " %d", m->setup.random_ix[r]);
+        }
+        fprintf(f, "\n");
+    }
+
+    for (int c = 0; c < SELFPLAY_CHARACTER_COUNT; c++) {
+        for (int id = 0; id < SELFPLAY_MOVE_COUNT; id++) {
+            if (totals->moves[c][id] != 0) {
+                fprintf(f, "move %d %d %u\n", c, id, totals->moves[c][id]);
+            }
+        }
+    }
+
+    return !ferror(f);
+}
+
+static bool in_range(int value, int count) {
+    return value >= 0 && value < count;
+}
+
+/** @brief Parse a match line after its keyword. */
+static bool read_match(const char* text, SelfPlayMatch* m) {
+    int used = 0;
+
+    if (sscanf(text,
+               "%d %u %d %d %d %d %d %d %d %d%n",
+               &m->index,
+               &m->seed,
+               &m->setup.chars[0],
+               &m->setup.chars[1],
+               &m->setup.super_arts[0],
+               &m->setup.super_arts[1],
+               &m->setup.stage_slot,
+               &m->winner,
+               &m->end,
+               &m->frames,
+               &used) != 10)
+        return false;
+
+    text += used;
+    for (int r = 0; r < SELFPLAY_RANDOM_COUNT; r++) {
+        if (sscanf(text, "%d%n", &m->setup.random_ix[r], &used) != 1)
+            return false;
+        text += used;
+    }
+
+    return in_range(m->setup.chars[0], SELFPLAY_CHARACTER_COUNT) &&
+           in_range(m->setup.chars[1], SELFPLAY_CHARACTER_COUNT) && m->winner >= -1 && m->winner <= 1 &&
+           in_range(m->end, SELFPLAY_END_COUNT);
+}
+
+bool SelfPlayTotals_Read(SelfPlayTotals* totals, FILE* f) {
+    char line[256];
+    bool versioned = false;
+
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '\n' || line[0] == '\0')
+            continue;
+
+        if (strncmp(line, "selfplay ", 9) == 0) {
+            int version = 0;
+            if (sscanf(line + 9, "%d", &version) != 1 || version != SELFPLAY_FORMAT_VERSION)
+                return false;
+            versioned = true;
+        } else if (!versioned) {
+            return false;
+        } else if (strncmp(line, "ticks ", 6) == 0) {
+            unsigned long long ticks;
+            unsigned long long busy_ns;
+            if (sscanf(line + 6, "%llu %llu", &ticks, &busy_ns) != 2)
+                return false;
+            totals->ticks += ticks;
+            totals->busy_ns += busy_ns;
+        } else if (strncmp(line, "match ", 6) == 0) {
+            SelfPlayMatch m;
+            if (!read_match(line + 6, &m) || !SelfPlayTotals_AddMatch(totals, &m))
+                return false;
+        } else if (strncmp(line, "move ", 5) == 0) {
+            int character;
+            int id;
+            unsigned int count;
+            if (sscanf(line + 5, "%d %d %u", &character, &id, &count) != 3 ||
+                !in_range(character, SELFPLAY_CHARACTER_COUNT) || !in_range(id, SELFPLAY_MOVE_COUNT))
+                return false;
+            totals->moves[character][id] += count;
+        } else {
+            return false;
+        }
+    }
+
+    return versioned && !ferror(f);
+}
+
+void SelfPlayTotals_Record(const SelfPlayTotals* totals, int character, SelfPlayRecord* out) {
+    memset(out, 0, sizeof(*out));
+
+    for (size_t i = 0; i < totals->count; i++) {
+        const SelfPlayMatch* m = &totals->matches[i];
+
+        for (int side = 0; side < 2; side++) {
+            if (m->setup.chars[side] != character)
+                continue;
+
+            out->matches += 1;
+            if (m->winner < 0) {
+                out->draws += 1;
+            } else if (m->winner == side) {
+                out->wins += 1;
+            } else {
+                out->losses += 1;
+            }
+        }
+    }
+}
+
+double SelfPlayTotals_MeanFrames(const SelfPlayTotals* totals) {
+    if (totals->count == 0)
+        return 0.0;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < totals->count; i++) {
+        sum += totals->matches[i].frames;
+    }
+    return sum / (double)totals->count;
+}
@@ -0,0 +1,90 @@
+#ifndef SELFPLAY_STATS_H
+#define SELFPLAY_STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Match setups, results and move counts for CPU-vs-CPU self-play (see
+// port/selfplay.h). Worker processes write their totals as plain text lines;
+// the parent reads them back and merges them into one report.
+
+#define SELFPLAY_CHARACTER_COUNT 20
+#define SELFPLAY_MOVE_COUNT 256  // routine_no[2] values counted per character
+#define SELFPLAY_STAGE_COUNT 8   // Stages the attract demo loads
+#define SELFPLAY_RANDOM_COUNT 9  // Engine RNG indices seeded per match
+
+typedef enum SelfPlayEnd {
+    SELFPLAY_END_KO = 0,    // Conclusion_Type 0
+    SELFPLAY_END_DOUBLE_KO, // Conclusion_Type 1, a draw
+    SELFPLAY_END_TIME,      // Conclusion_Type 2, the vitality lead wins
+    SELFPLAY_END_CAP,       // Stopped at the frame cap, the vitality lead wins
+    SELFPLAY_END_COUNT
+} SelfPlayEnd;
+
+// Everything about a match that is drawn from its seed.
+typedef struct SelfPlaySetup {
+    int chars[2];
+    int super_arts[2]; // 0-2
+    int stage_slot;    // Index into the attract demo's stage table
+    int random_ix[SELFPLAY_RANDOM_COUNT];
+} SelfPlaySetup;
+
+typedef struct SelfPlayMatch {
+    int index;         // Match number within the run, from 0
+    unsigned int seed; // Run seed + index
+    SelfPlaySetup setup;
+    int winner; // 0 or 1, -1 for a draw
+    int end;    // SelfPlayEnd
+    int frames; // Fight frames up to the conclusion
+} SelfPlayMatch;
+
+typedef struct SelfPlayTotals {
+    SelfPlayMatch* matches;
+    size_t count;
+    size_t capacity;
+    unsigned int moves[SELFPLAY_CHARACTER_COUNT][SELFPLAY_MOVE_COUNT]; // Attacks started
+    unsigned long long ticks;   // Game ticks run, screens between fights included
+    unsigned long long busy_ns; // Wall time those ticks took, summed over workers
+} SelfPlayTotals;
+
+// Win/loss record of one character, counted per side: a mirror match is a
+// win and a loss.
+typedef struct SelfPlayRecord {
+    unsigned int matches;
+    unsigned int wins;
+    unsigned int losses;
+    unsigned int draws;
+} SelfPlayRecord;
+
+// Draw the setup of the match with `seed`. The same seed always gives the same setup.
+void SelfPlaySetup_FromSeed(unsigned int seed, SelfPlaySetup* out);
+
+// Append one match, growing the list as needed. Returns false on OOM.
+bool SelfPlayTotals_AddMatch(SelfPlayTotals* totals, const SelfPlayMatch* match);
+
+void SelfPlayTotals_Free(SelfPlayTotals* totals);
+
+// Add everything in `src` to `dst`. Returns false on OOM.
+bool SelfPlayTotals_Merge(SelfPlayTotals* dst, const SelfPlayTotals* src);
+
+// Order the matches by index; workers finish in any order.
+void SelfPlayTotals_SortMatches(SelfPlayTotals* totals);
+
+// The match with `index`, or NULL.
+const SelfPlayMatch* SelfPlayTotals_FindMatch(const SelfPlayTotals* totals, int index);
+
+// True if both are the same match with the same setup and outcome.
+bool SelfPlayMatch_SameResult(const SelfPlayMatch* a, const SelfPlayMatch* b);
+
+// Write the totals as text lines, or add the lines read from `f` to `totals`.
+// Reading returns false on a malformed line or OOM.
+bool SelfPlayTotals_Write(const SelfPlayTotals* totals, FILE* f);
+bool SelfPlayTotals_Read(SelfPlayTotals* totals, FILE* f);
+
+void SelfPlayTotals_Record(const SelfPlayTotals* totals, int character, SelfPlayRecord* out);
+
+// Mean fight length in frames; 0 with no matches.
+double SelfPlayTotals_MeanFrames(const SelfPlayTotals* totals);
+
+#endif
@@ -5,10 +5,16 @@
  * Manages multi-track ADX playback via SDL3 audio streams, including
  * file loading from AFS archives, ADX frame decoding, seamless loop
  * handling, and a pre-allocated buffer pool to avoid heap churn.
+ *
+ * Decoding is pulled by the audio stream's callback on SDL's audio thread
+ * (as SPU_SDL_CB does for SFX), so BGM never depends on frame pacing and the
+ * game thread never decodes. The callback runs with the stream lock held;
+ * game-side track changes take the same lock via SDL_LockAudioStream.
  */
 #include "port/sound/adx.h"
 #include "common.h"
 #include "port/io/afs.h"
+#include "port/recorder.h"
 #include "port/sound/adx_decoder.h"
 
 #include <SDL3/SDL.h>
@@ -56,8 +62,6 @@ static void pool_free(void* ptr) {
 #define SAMPLE_RATE 48000
 #define N_CHANNELS 2
 #define BYTES_PER_SAMPLE 2
-#define MIN_QUEUED_DATA_MS 400
-#define MIN_QUEUED_DATA (int)((float)SAMPLE_RATE * MIN_QUEUED_DATA_MS / 1000 * N_CHANNELS * BYTES_PER_SAMPLE)
 #define TRACKS_MAX 10
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -92,17 +96,24 @@ static ADXTrack tracks[TRACKS_MAX] = { 0 };
 static int num_tracks = 0;
 static int first_track_index = 0;
 static bool has_tracks = false;
+static bool feed_held = false; // Menu pause: stop feeding without pausing the device
+static int feed_budget = 0;    // Bytes the running audio callback still has to supply
+static ADXStats stats = { 0 };
+static float out_gain = 1.0f; // Mirrors the stream gain for the recorder
 
 static int stream_data_needed() {
-    return MIN_QUEUED_DATA - SDL_GetAudioStreamQueued(stream);
+    return feed_budget;
 }
 
 static bool stream_needs_data() {
-    return stream_data_needed() > 0;
+    return feed_budget > 0;
 }
 
-static bool stream_is_empty() {
-    return SDL_GetAudioStreamQueued(stream) <= 0;
+static void queue_data(const void* data, int len) {
+    SDL_PutAudioStreamData(stream, data, len);
+    Recorder_PushAudio(RECORDER_AUDIO_ADX, (const int16_t*)data, len / (N_CHANNELS * BYTES_PER_SAMPLE), out_gain);
+    feed_budget -= len;
+    stats.queued_bytes += (uint64_t)len;
 }
 
 static void* load_file(int file_id, int* size) {
@@ -112,7 +123,10 @@ static void* load_file(int file_id, int* size) {
     const size_t buff_size = (size_t)sectors * 2048;
     // ⚡ Bolt: Use static buffer pool instead of malloc — eliminates heap
     // churn during scene transitions with multiple music/SFX changes.
+    // The audio thread frees slots when tracks run out, so claim one under the lock.
+    SDL_LockAudioStream(stream);
     void* buff = pool_alloc(buff_size);
+    SDL_UnlockAudioStream(stream);
 
     AFSHandle handle = AFS_Open(file_id);
     AFS_ReadSync(handle, sectors, buff);
@@ -266,7 +280,7 @@ static void process_track(ADXTrack* track) {
 
         if (samples_to_queue > 0) {
             int bytes_to_queue = samples_to_queue * sizeof(int16_t);
-            SDL_PutAudioStreamData(stream, decode_buf, bytes_to_queue);
+            queue_data(decode_buf, bytes_to_queue);
         }
     }
 
@@ -274,7 +288,7 @@ static void process_track(ADXTrack* track) {
     while (track_loop_filled(track) && stream_needs_data()) {
         const int available_data = track->loop_info.data_size - track->loop_info.position;
         const int data_to_queue = MIN(stream_data_needed(), available_data);
-        SDL_PutAudioStreamData(stream, track->loop_info.data + track->loop_info.position, data_to_queue);
+        queue_data(track->loop_info.data + track->loop_info.position, data_to_queue);
         track->loop_info.position += data_to_queue;
 
         if (track->loop_info.position == track->loop_info.data_size) {
@@ -283,19 +297,14 @@ static void process_track(ADXTrack* track) {
     }
 }
 
-static void track_init(ADXTrack* track, int file_id, void* buf, size_t buf_size, bool looping_allowed) {
-    if (file_id == -1 && buf == NULL) {
-        fatal_error("One of file_id or buf must be valid.");
+static void track_init(ADXTrack* track, void* data, int size, bool owns_data, bool looping_allowed) {
+    if (data == NULL) {
+        fatal_error("ADX track has no data.");
     }
 
-    if (file_id != -1) {
-        track->data = load_file(file_id, &track->size);
-        track->should_free_data_after_use = true;
-    } else {
-        track->data = buf;
-        track->size = (int)buf_size;
-        track->should_free_data_after_use = false;
-    }
+    track->data = data;
+    track->size = size;
+    track->should_free_data_after_use = owns_data;
 
     // Initialize Decoder
     if (ADX_InitContext(&track->ctx, track->data, track->size) < 0) {
@@ -311,7 +320,7 @@ static void track_init(ADXTrack* track, int file_id, void* buf, size_t buf_size,
         loop_info_init(&track->loop_info, track->data);
     }
 
-    process_track(track); // Feed first batch of data to the stream
+    // No prefill: the audio callback pulls the first batch once the device runs
 }
 
 static void track_destroy(ADXTrack* track) {
@@ -331,15 +340,7 @@ static ADXTrack* alloc_track() {
     return &tracks[index];
 }
 
-void ADX_ProcessTracks() {
-    if (!stream)
-        return;
-
-    // ⚡ Bolt: Skip entirely when audio buffer is healthy — avoids
-    // track iteration, loop bookkeeping, and exhaustion checks.
-    if (!stream_needs_data())
-        return;
-
+static void process_tracks() {
     const int first_track_index_old = first_track_index;
     const int num_tracks_old = num_tracks;
 
@@ -364,9 +365,30 @@ void ADX_ProcessTracks() {
     }
 }
 
+/** @brief Audio-thread pull: decode exactly as much BGM as the device asks for. */
+static void SDLCALL ADX_SDL_CB(void* user, SDL_AudioStream* audio_stream, int additional_amount, int total_amount) {
+    (void)user;
+    (void)audio_stream;
+    (void)total_amount;
+
+    if (additional_amount <= 0 || feed_held) {
+        return;
+    }
+
+    feed_budget = additional_amount;
+    process_tracks();
+
+    // Tracks left but not enough decoded data means the device plays a gap
+    if (feed_budget > 0 && num_tracks > 0) {
+        stats.underruns += 1;
+    }
+    feed_budget = 0;
+}
+
 void ADX_Init() {
     const SDL_AudioSpec spec = { .format = SDL_AUDIO_S16, .channels = N_CHANNELS, .freq = SAMPLE_RATE };
-    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, NULL, NULL);
+    stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, ADX_SDL_CB, NULL);
+    SDL_zero(stats);
 }
 
 void ADX_Exit() {
@@ -376,7 +398,11 @@ void ADX_Exit() {
 }
 
 void ADX_Stop() {
+    // Pause before taking the stream lock: pausing takes the device lock,
+    // which the audio thread holds while it runs our callback.
     ADX_Pause(true);
+
+    SDL_LockAudioStream(stream);
     SDL_ClearAudioStream(stream);
 
     for (int i = 0; i < num_tracks; i++) {
@@ -387,6 +413,7 @@ void ADX_Stop() {
     num_tracks = 0;
     first_track_index = 0;
     has_tracks = false;
+    SDL_UnlockAudioStream(stream);
 }
 
 int ADX_IsPaused() {
@@ -404,17 +431,28 @@ void ADX_Pause(int pause) {
 void ADX_StartMem(void* buf, size_t size) {
     ADX_Stop();
 
+    SDL_LockAudioStream(stream);
     ADXTrack* track = alloc_track();
-    track_init(track, -1, buf, size, true);
+    track_init(track, buf, (int)size, false, true);
+    SDL_UnlockAudioStream(stream);
 }
 
 int ADX_GetNumFiles() {
-    return num_tracks;
+    SDL_LockAudioStream(stream);
+    const int count = num_tracks;
+    SDL_UnlockAudioStream(stream);
+    return count;
 }
 
 void ADX_EntryAfs(int file_id) {
+    // Disk I/O stays outside the stream lock so the audio thread never waits on it
+    int size;
+    void* data = load_file(file_id, &size);
+
+    SDL_LockAudioStream(stream);
     ADXTrack* track = alloc_track();
-    track_init(track, file_id, NULL, 0, false);
+    track_init(track, data, size, true, false);
+    SDL_UnlockAudioStream(stream);
 }
 
 void ADX_StartSeamless() {
@@ -428,14 +466,20 @@ void ADX_ResetEntry() {
 void ADX_StartAfs(int file_id) {
     ADX_Stop();
 
+    int size;
+    void* data = load_file(file_id, &size);
+
+    SDL_LockAudioStream(stream);
     ADXTrack* track = alloc_track();
-    track_init(track, file_id, NULL, 0, true);
+    track_init(track, data, size, true, true);
+    SDL_UnlockAudioStream(stream);
 }
 
 void ADX_SetOutVol(int volume) {
     // Convert volume (dB * 10) to linear gain
     const float gain = powf(10.0f, (float)volume / 200.0f);
     SDL_SetAudioStreamGain(stream, gain);
+    out_gain = gain;
 }
 
 void ADX_SetMono(bool mono) {
@@ -445,15 +489,37 @@ void ADX_SetMono(bool mono) {
     (void)mono;
 }
 
+void ADX_SetHeld(bool held) {
+    SDL_LockAudioStream(stream);
+    feed_held = held;
+    SDL_UnlockAudioStream(stream);
+}
+
+void ADX_GetStats(ADXStats* out) {
+    SDL_LockAudioStream(stream);
+    *out = stats;
+    SDL_UnlockAudioStream(stream);
+}
+
 ADXState ADX_GetState() {
-    if (!has_tracks) {
+    const bool paused = ADX_IsPaused();
+
+    SDL_LockAudioStream(stream);
+    const bool tracks_started = has_tracks;
+    const bool tracks_left = num_tracks > 0;
+    const bool stream_is_empty = SDL_GetAudioStreamQueued(stream) <= 0;
+    SDL_UnlockAudioStream(stream);
+
+    if (!tracks_started) {
         return ADX_STATE_STOP;
     }
 
-    if (stream_is_empty()) {
+    // The stream only ever holds what the device just asked for, so the end
+    // is reached once every track has been decoded and that has drained.
+    if (!tracks_left && stream_is_empty) {
         return ADX_STATE_PLAYEND;
     } else {
-        if (ADX_IsPaused()) {
+        if (paused) {
             return ADX_STATE_STOP;
         } else {
             return ADX_STATE_PLAYING;
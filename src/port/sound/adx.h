@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 typedef enum ADXState {
     ADX_STATE_STOP,
@@ -10,7 +11,10 @@ typedef enum ADXState {
     ADX_STATE_PLAYEND,
 } ADXState;
 
-void ADX_ProcessTracks();
+typedef struct ADXStats {
+    uint64_t queued_bytes; // PCM handed to the device since ADX_Init
+    int underruns;         // Callbacks that couldn't be filled while tracks remained
+} ADXStats;
 
 void ADX_Init();
 void ADX_Exit();
@@ -27,4 +31,9 @@ void ADX_SetOutVol(int volume);
 void ADX_SetMono(bool mono);
 ADXState ADX_GetState();
 
+/// Stop feeding BGM (the device plays silence) without touching the game's
+/// pause state. Used while the port's menus pause the game.
+void ADX_SetHeld(bool held);
+void ADX_GetStats(ADXStats* out);
+
 #endif
@@ -8,6 +8,7 @@
  * Uses an active-voice bitmask for efficient tick processing.
  */
 #include "port/sound/spu.h"
+#include "port/recorder.h"
 #include "port/tracy_zones.h"
 
 #include "common.h"
@@ -330,6 +331,33 @@ void SPU_VoiceStart(int vnum, u32 start_addr) {
     v->nax = (v->nax + 1) & 0xfffff;
 }
 
+// The sound driver's timer callback runs at 250 Hz: 48000 / 250 = 192 samples
+static int cb_timer = 192;
+
+/** @brief Mix `count` stereo sample frames into `output`, running the driver timer as they pass. */
+static void SPU_MixBatch(s16* output, u32 count) {
+    // ⚡ Bolt: Hold soundLock only during the mixing loop — not during
+    // SDL_PutAudioStreamData (which may block on SDL's internal lock).
+    // Previously the lock spanned the entire callback, causing the game
+    // thread to stall whenever it needed soundLock (voice setup, key-off,
+    // volume changes). Now the game thread only contends during mixing.
+    SDL_LockMutex(soundLock);
+
+    s16* p = output;
+    for (int i = 0; i < count; i++) {
+        SPU_Tick(p);
+        p += 2;
+
+        cb_timer--;
+        if (!cb_timer) {
+            timer_cb();
+            cb_timer = 192;
+        }
+    }
+
+    SDL_UnlockMutex(soundLock);
+}
+
 void SPU_SDL_CB(void* user, SDL_AudioStream* stream, int additional_amount, int total_amount) {
     TRACE_ZONE_N("SPU_AudioCB");
     u32 samples_per_channel = (additional_amount / sizeof(s16)) >> 1;
@@ -337,43 +365,39 @@ void SPU_SDL_CB(void* user, SDL_AudioStream* stream, int additional_amount, int
     // SPU_Tick writes 2 elements per call, so max safe batch = 4096 / 2 = 2048.
     static s16 outbuf[4096] = {};
 
-    // We need to run the eml callback at 250hz
-    // 48000 / 250 = 192
-    static int cb_timer = 192;
-
     while (samples_per_channel) {
         // ⚡ Bolt: Cap at 2048 — each SPU_Tick writes 2 s16 (L+R) into outbuf,
         // so 2048 ticks × 2 = 4096 elements = full buffer. Previously capped
         // at 4096, which would write 8192 elements — a 2× buffer overrun.
         u32 batch_count = min(samples_per_channel, 2048);
 
-        // ⚡ Bolt: Hold soundLock only during the mixing loop — not during
-        // SDL_PutAudioStreamData (which may block on SDL's internal lock).
-        // Previously the lock spanned the entire callback, causing the game
-        // thread to stall whenever it needed soundLock (voice setup, key-off,
-        // volume changes). Now the game thread only contends during mixing.
-        SDL_LockMutex(soundLock);
-
-        s16* p = outbuf;
-        for (int i = 0; i < batch_count; i++) {
-            SPU_Tick(p);
-            p += 2;
-
-            cb_timer--;
-            if (!cb_timer) {
-                timer_cb();
-                cb_timer = 192;
-            }
-        }
-
-        SDL_UnlockMutex(soundLock);
+        SPU_MixBatch(outbuf, batch_count);
 
         SDL_PutAudioStreamData(stream, outbuf, (batch_count * sizeof(s16)) << 1);
+        Recorder_PushAudio(RECORDER_AUDIO_SPU, outbuf, (int)batch_count, 1.0f);
         samples_per_channel -= batch_count;
     }
     TRACE_ZONE_END();
 }
 
+void SPU_SetManualMix(bool manual) {
+    if (!stream) {
+        return;
+    }
+
+    if (manual) {
+        SDL_PauseAudioStreamDevice(stream);
+    } else {
+        SDL_ResumeAudioStreamDevice(stream);
+    }
+}
+
+void SPU_Mix(s16* output, int sample_frames) {
+    if (sample_frames > 0) {
+        SPU_MixBatch(output, (u32)sample_frames);
+    }
+}
+
 static void nullcb() {}
 
 void SPU_Init(void (*cb)()) {
@@ -2,8 +2,10 @@
  * @file replay_picker.cpp
  * @brief ImGui overlay for selecting replay slots (load/save).
  *
- * Shows a list of 20 replay slots with character names and dates.
- * Supports controller navigation (up/down/confirm/cancel) and mouse.
+ * Lists saved replays newest first with character names and dates; save
+ * mode adds a "new replay" row on top. The list comes from the replay index,
+ * so opening the picker doesn't touch the replay files. Supports controller
+ * navigation (up/down/confirm/cancel) and mouse.
  */
 
 #include "port/ui/replay_picker.h"
@@ -37,18 +39,25 @@ static int s_mode = 0; /* 0=load, 1=save */
 static int s_cursor = 0;
 static int s_result = 1; /* 1=active, 0=done, -1=cancelled */
 static int s_selected_slot = -1;
-static bool s_slot_exists[NATIVE_SAVE_REPLAY_SLOTS];
-static _sub_info s_slot_info[NATIVE_SAVE_REPLAY_SLOTS];
-
-static void refresh_slot_info(void) {
-    for (int i = 0; i < NATIVE_SAVE_REPLAY_SLOTS; i++) {
-        s_slot_exists[i] = NativeSave_ReplayExists(i) != 0;
-        if (s_slot_exists[i]) {
-            NativeSave_GetReplayInfo(i, &s_slot_info[i]);
-        } else {
-            memset(&s_slot_info[i], 0, sizeof(_sub_info));
-        }
+static int s_replay_count = 0;
+
+/* Rows: save mode starts with "new replay", then saved replays newest first */
+static int row_count(void) {
+    return s_replay_count + (s_mode == 1 ? 1 : 0);
+}
+
+/* Replay slot shown on a row; s_replay_count is the "new replay" row */
+static int row_slot(int row) {
+    if (s_mode == 1) {
+        if (row == 0)
+            return s_replay_count;
+        row -= 1;
     }
+    return s_replay_count - 1 - row;
+}
+
+static bool row_selectable(int row) {
+    return row >= 0 && row < row_count();
 }
 
 /* ── Public API ────────────────────────────────────────────────────── */
@@ -59,7 +68,7 @@ extern "C" void ReplayPicker_Open(int mode) {
     s_cursor = 0;
     s_result = 1;
     s_selected_slot = -1;
-    refresh_slot_info();
+    s_replay_count = NativeSave_GetReplayCount();
 }
 
 extern "C" int ReplayPicker_IsOpen(void) {
@@ -83,14 +92,16 @@ extern "C" int ReplayPicker_Update(void) {
     /* Navigate */
     if (trigger & 0x02) { /* Down */
         s_cursor++;
-        if (s_cursor >= NATIVE_SAVE_REPLAY_SLOTS)
-            s_cursor = NATIVE_SAVE_REPLAY_SLOTS - 1;
+        if (s_cursor >= row_count())
+            s_cursor = row_count() - 1;
     }
     if (trigger & 0x01) { /* Up */
         s_cursor--;
         if (s_cursor < 0)
             s_cursor = 0;
     }
+    if (s_cursor < 0)
+        s_cursor = 0;
 
     /* Cancel (button 2 / circle) */
     if (trigger & 0x0200) {
@@ -101,10 +112,10 @@ extern "C" int ReplayPicker_Update(void) {
 
     /* Confirm (button 1 / cross) */
     if (trigger & 0x0100) {
-        if (s_mode == 0 && !s_slot_exists[s_cursor]) {
-            /* Can't load empty slot — do nothing */
+        if (!row_selectable(s_cursor)) {
+            /* Nothing to load — do nothing */
         } else {
-            s_selected_slot = s_cursor;
+            s_selected_slot = row_slot(s_cursor);
             s_open = false;
             s_result = 0;
             return 0;
@@ -140,36 +151,43 @@ extern "C" int ReplayPicker_Update(void) {
         float list_h = ImGui::GetContentRegionAvail().y - 30 * scale;
 
         if (ImGui::BeginChild("ReplayList", ImVec2(0, list_h), true)) {
-            for (int i = 0; i < NATIVE_SAVE_REPLAY_SLOTS; i++) {
+            if (row_count() == 0) {
+                ImGui::TextDisabled("--- no saved replays ---");
+            }
+
+            for (int i = 0; i < row_count(); i++) {
                 bool selected = (i == s_cursor);
+                const int slot = row_slot(i);
                 char label[128];
+                _sub_info info;
 
-                if (s_slot_exists[i]) {
-                    const _sub_info* info = &s_slot_info[i];
+                if (slot == s_replay_count) {
+                    snprintf(label, sizeof(label), "      --- new replay ---");
+                } else if (NativeSave_GetReplayInfo(slot, &info) == 0) {
                     snprintf(label,
                              sizeof(label),
-                             "%02d  %s vs %s  %04d-%02d-%02d %02d:%02d",
-                             i + 1,
-                             get_char_name(info->player[0]),
-                             get_char_name(info->player[1]),
-                             info->date.year,
-                             info->date.month,
-                             info->date.day,
-                             info->date.hour,
-                             info->date.min);
+                             "%4d  %s vs %s  %04d-%02d-%02d %02d:%02d",
+                             slot + 1,
+                             get_char_name(info.player[0]),
+                             get_char_name(info.player[1]),
+                             info.date.year,
+                             info.date.month,
+                             info.date.day,
+                             info.date.hour,
+                             info.date.min);
                 } else {
-                    snprintf(label, sizeof(label), "%02d  --- empty ---", i + 1);
+                    snprintf(label, sizeof(label), "%4d  ???", slot + 1);
                 }
 
+                ImGui::PushID(i);
                 if (ImGui::Selectable(label, selected, 0, ImVec2(0, row_h))) {
+                    /* Click to select */
                     s_cursor = i;
-                    /* Double-click or click to select */
-                    if (s_mode == 1 || s_slot_exists[i]) {
-                        s_selected_slot = i;
-                        s_open = false;
-                        s_result = 0;
-                    }
+                    s_selected_slot = slot;
+                    s_open = false;
+                    s_result = 0;
                 }
+                ImGui::PopID();
 
                 /* Auto-scroll to cursor */
                 if (selected) {
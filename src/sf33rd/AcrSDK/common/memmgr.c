@@ -7,6 +7,10 @@
  * allocation (RegisterS), defragmentation via compaction, and temporary
  * allocations from the tail of the region.
  *
+ * A generation counter tracks whether any gap can exist: only releases and
+ * custom-aligned registrations open one. Compaction returns immediately when
+ * nothing changed since the last pass, instead of re-walking every block.
+ *
  * Part of the AcrSDK common module.
  * Originally from the PS2 SDK abstraction layer.
  */
@@ -39,6 +43,10 @@ void plmemInit(MEM_MGR* memmgr, MEM_BLOCK* block, s32 count, void* mem_ptr, s32
     memmgr->used_size = 0;
     memmgr->tmemsize = 0;
     memmgr->blocklist = MEM_NULL_HANDLE;
+    memmgr->generation = 0;
+    memmgr->compact_generation = 0;
+    memmgr->compact_count = 0;
+    memmgr->compact_moved = 0;
 
     plMemset(block, 0, count * sizeof(MEM_BLOCK));
 }
@@ -70,6 +78,11 @@ u32 plmemRegisterAlign(MEM_MGR* memmgr, s32 len, s32 align) {
     memmgr->block[han].len = len;
     memmgr->block[han].align = memmgr->memalign;
 
+    // Compaction re-packs at memalign, so a custom alignment leaves work for it
+    if (align != memmgr->memalign) {
+        memmgr->generation++;
+    }
+
     if (memmgr->direction != 0) {
         memmgr->block[han].ptr = memmgr->memnow;
         memmgr->memnow = (u8*)(~(align - 1) & ((uintptr_t)&memmgr->block[han].ptr[len] + align - 1));
@@ -222,6 +235,7 @@ s32 plmemRelease(MEM_MGR* memmgr, u32 handle) {
     }
 
     memmgr->used_size -= memmgr->block[index].len;
+    memmgr->generation++;
     memmgr->block[index].len = 0;
     memmgr->block[index].ptr = NULL;
     plmemDeleteBlockList(memmgr, index);
@@ -236,9 +250,15 @@ void* plmemCompact(MEM_MGR* memmgr) {
 
     if (memmgr->blocklist == MEM_NULL_HANDLE) {
         memmgr->memnow = memmgr->memptr;
+        memmgr->compact_generation = memmgr->generation;
+        return memmgr->memnow;
+    }
+
+    if (memmgr->compact_generation == memmgr->generation) {
         return memmgr->memnow;
     }
 
+    memmgr->compact_count++;
     now_block = memmgr->block + memmgr->blocklist;
 
     if (memmgr->direction != 0) {
@@ -246,6 +266,7 @@ void* plmemCompact(MEM_MGR* memmgr) {
 
         if (data_ptr != now_block->ptr) {
             plMemmove(data_ptr, now_block->ptr, now_block->len);
+            memmgr->compact_moved += now_block->len;
             now_block->ptr = data_ptr;
         }
 
@@ -255,6 +276,7 @@ void* plmemCompact(MEM_MGR* memmgr) {
 
             if (data_ptr != next_block->ptr) {
                 plMemmove(data_ptr, next_block->ptr, next_block->len);
+                memmgr->compact_moved += next_block->len;
                 next_block->ptr = data_ptr;
             }
 
@@ -267,6 +289,7 @@ void* plmemCompact(MEM_MGR* memmgr) {
 
         if (data_ptr != now_block->ptr) {
             plMemmove(data_ptr, now_block->ptr, now_block->len);
+            memmgr->compact_moved += now_block->len;
             now_block->ptr = data_ptr;
         }
 
@@ -276,6 +299,7 @@ void* plmemCompact(MEM_MGR* memmgr) {
 
             if (data_ptr != next_block->ptr) {
                 plMemmove(data_ptr, next_block->ptr, next_block->len);
+                memmgr->compact_moved += next_block->len;
                 next_block->ptr = data_ptr;
             }
 
@@ -285,6 +309,7 @@ void* plmemCompact(MEM_MGR* memmgr) {
         memmgr->memnow = now_block->ptr;
     }
 
+    memmgr->compact_generation = memmgr->generation;
     return memmgr->memnow;
 }
 
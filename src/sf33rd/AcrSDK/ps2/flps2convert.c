@@ -0,0 +1,427 @@
+/**
+ * @file flps2convert.c
+ * @brief Pixel format conversion between plContext surfaces and GS-native layouts.
+ *
+ * The generic converters (flPS2ConvertContextGeneric here, plConvertContext
+ * in prilay.c) decode every pixel through the PixelFormat masks and shifts.
+ * The formats that actually reach them are few and fixed: the PPG/PPL
+ * ARGB1555/RGB565/ARGB4444/ARGB8888 layouts on the way in, and the GS
+ * layouts with R and B swapped on the way out. Those pairs get dedicated
+ * kernels with the shifts folded into constants, SSE2 (via SIMDe) for
+ * texture and palette creation; everything else keeps the generic path.
+ *
+ * Part of the AcrSDK ps2 module.
+ */
+#include "sf33rd/AcrSDK/ps2/flps2convert.h"
+#include "sf33rd/AcrSDK/common/prilay.h"
+
+#include <simde/x86/sse2.h>
+
+#include <string.h>
+
+typedef enum {
+    PIXFMT_ARGB1555,
+    PIXFMT_RGB565,
+    PIXFMT_ARGB4444,
+    PIXFMT_RGB888,
+    PIXFMT_ARGB8888,
+    PIXFMT_GS_CT16,
+    PIXFMT_GS_CT24,
+    PIXFMT_GS_CT32,
+    PIXFMT_COUNT,
+} PixFmt;
+
+typedef struct {
+    s32 bitdepth;
+    PixelFormat format;
+} PixFmtDesc;
+
+// rl, rs, rm, gl, gs, gm, bl, bs, bm, al, as, am
+static const PixFmtDesc pixfmt_desc[PIXFMT_COUNT] = {
+    [PIXFMT_ARGB1555] = { 2, { 5, 0xA, 0x1F, 5, 5, 0x1F, 5, 0, 0x1F, 1, 0xF, 1 } },
+    [PIXFMT_RGB565] = { 2, { 5, 0xB, 0x1F, 6, 5, 0x3F, 5, 0, 0x1F, 0, 0, 0 } },
+    [PIXFMT_ARGB4444] = { 2, { 4, 8, 0xF, 4, 4, 0xF, 4, 0, 0xF, 4, 0xC, 0xF } },
+    [PIXFMT_RGB888] = { 3, { 8, 0x10, 0xFF, 8, 8, 0xFF, 8, 0, 0xFF, 0, 0, 0 } },
+    [PIXFMT_ARGB8888] = { 4, { 8, 0x10, 0xFF, 8, 8, 0xFF, 8, 0, 0xFF, 8, 0x18, 0xFF } },
+    [PIXFMT_GS_CT16] = { 2, { 5, 0, 0x1F, 5, 5, 0x1F, 5, 0xA, 0x1F, 1, 0xF, 1 } },
+    [PIXFMT_GS_CT24] = { 3, { 8, 0, 0xFF, 8, 8, 0xFF, 8, 0x10, 0xFF, 0, 0, 0 } },
+    [PIXFMT_GS_CT32] = { 4, { 8, 0, 0xFF, 8, 8, 0xFF, 8, 0x10, 0xFF, 8, 0x18, 0xFF } },
+};
+
+/** @brief Identify a context's pixel layout, or PIXFMT_COUNT if it has no kernels. */
+static PixFmt identify(const plContext* lpcontext) {
+    s32 i;
+
+    // Raw (indexed) contexts are copied as-is by the generic converters
+    if (lpcontext->desc & 4) {
+        return PIXFMT_COUNT;
+    }
+
+    for (i = 0; i < PIXFMT_COUNT; i++) {
+        if (pixfmt_desc[i].bitdepth == lpcontext->bitdepth &&
+            memcmp(&pixfmt_desc[i].format, &lpcontext->pixelformat, sizeof(PixelFormat)) == 0) {
+            return (PixFmt)i;
+        }
+    }
+
+    return PIXFMT_COUNT;
+}
+
+// --- Creation kernels (flPS2ConvertContext, direction 0) ---
+
+static u16 argb1555_to_ct16(u32 c) {
+    return (c & 0x83E0) | ((c >> 10) & 0x1F) | ((c & 0x1F) << 10);
+}
+
+static u16 rgb565_to_ct16(u32 c) {
+    // Green drops its low bit; no alpha source, so the STP bit stays clear
+    return (c >> 11) | ((c >> 1) & 0x3E0) | ((c & 0x1F) << 10);
+}
+
+static u16 argb4444_to_ct16(u32 c) {
+    return ((c >> 7) & 0x1E) | ((c << 2) & 0x3C0) | ((c << 11) & 0x7800) | (c & 0x8000);
+}
+
+static u32 argb8888_to_ct32(u32 c) {
+    u32 a = c >> 24;
+
+    // GS alpha is 0..0x80: halve, keeping 0xFF -> 0x80 and any non-zero alpha non-zero
+    a = (a >> 1) + ((a == 1) || (a == 0xFF));
+    return (a << 24) | ((c & 0xFF) << 16) | (c & 0xFF00) | ((c >> 16) & 0xFF);
+}
+
+static void kernel_argb1555_to_ct16(const u8* src, u8* dst, s32 count) {
+    const simde__m128i rb = simde_mm_set1_epi16(0x1F);
+    const simde__m128i ga = simde_mm_set1_epi16((s16)0x83E0);
+    s32 i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const simde__m128i c = simde_mm_loadu_si128((const simde__m128i*)(src + i * 2));
+        simde__m128i out = simde_mm_and_si128(c, ga);
+        out = simde_mm_or_si128(out, simde_mm_and_si128(simde_mm_srli_epi16(c, 10), rb));
+        out = simde_mm_or_si128(out, simde_mm_slli_epi16(simde_mm_and_si128(c, rb), 10));
+        simde_mm_storeu_si128((simde__m128i*)(dst + i * 2), out);
+    }
+
+    for (; i < count; i++) {
+        ((u16*)dst)[i] = argb1555_to_ct16(((const u16*)src)[i]);
+    }
+}
+
+static void kernel_rgb565_to_ct16(const u8* src, u8* dst, s32 count) {
+    const simde__m128i b = simde_mm_set1_epi16(0x1F);
+    const simde__m128i g = simde_mm_set1_epi16(0x3E0);
+    s32 i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const simde__m128i c = simde_mm_loadu_si128((const simde__m128i*)(src + i * 2));
+        simde__m128i out = simde_mm_srli_epi16(c, 11);
+        out = simde_mm_or_si128(out, simde_mm_and_si128(simde_mm_srli_epi16(c, 1), g));
+        out = simde_mm_or_si128(out, simde_mm_slli_epi16(simde_mm_and_si128(c, b), 10));
+        simde_mm_storeu_si128((simde__m128i*)(dst + i * 2), out);
+    }
+
+    for (; i < count; i++) {
+        ((u16*)dst)[i] = rgb565_to_ct16(((const u16*)src)[i]);
+    }
+}
+
+static void kernel_argb4444_to_ct16(const u8* src, u8* dst, s32 count) {
+    const simde__m128i r = simde_mm_set1_epi16(0x1E);
+    const simde__m128i g = simde_mm_set1_epi16(0x3C0);
+    const simde__m128i b = simde_mm_set1_epi16(0x7800);
+    const simde__m128i a = simde_mm_set1_epi16((s16)0x8000);
+    s32 i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        const simde__m128i c = simde_mm_loadu_si128((const simde__m128i*)(src + i * 2));
+        simde__m128i out = simde_mm_and_si128(simde_mm_srli_epi16(c, 7), r);
+        out = simde_mm_or_si128(out, simde_mm_and_si128(simde_mm_slli_epi16(c, 2), g));
+        out = simde_mm_or_si128(out, simde_mm_and_si128(simde_mm_slli_epi16(c, 11), b));
+        out = simde_mm_or_si128(out, simde_mm_and_si128(c, a));
+        simde_mm_storeu_si128((simde__m128i*)(dst + i * 2), out);
+    }
+
+    for (; i < count; i++) {
+        ((u16*)dst)[i] = argb4444_to_ct16(((const u16*)src)[i]);
+    }
+}
+
+static void kernel_argb8888_to_ct32(const u8* src, u8* dst, s32 count) {
+    const simde__m128i byte = simde_mm_set1_epi32(0xFF);
+    const simde__m128i green = simde_mm_set1_epi32(0xFF00);
+    const simde__m128i one = simde_mm_set1_epi32(1);
+    s32 i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const simde__m128i c = simde_mm_loadu_si128((const simde__m128i*)(src + i * 4));
+        const simde__m128i a = simde_mm_srli_epi32(c, 24);
+        const simde__m128i bump = simde_mm_or_si128(simde_mm_cmpeq_epi32(a, one), simde_mm_cmpeq_epi32(a, byte));
+        const simde__m128i a2 = simde_mm_sub_epi32(simde_mm_srli_epi32(a, 1), bump);
+        simde__m128i out = simde_mm_slli_epi32(a2, 24);
+        out = simde_mm_or_si128(out, simde_mm_slli_epi32(simde_mm_and_si128(c, byte), 16));
+        out = simde_mm_or_si128(out, simde_mm_and_si128(c, green));
+        out = simde_mm_or_si128(out, simde_mm_and_si128(simde_mm_srli_epi32(c, 16), byte));
+        simde_mm_storeu_si128((simde__m128i*)(dst + i * 4), out);
+    }
+
+    for (; i < count; i++) {
+        ((u32*)dst)[i] = argb8888_to_ct32(((const u32*)src)[i]);
+    }
+}
+
+typedef struct {
+    PixFmt src;
+    PixFmt dst;
+    FLPS2ConvertKernel kernel;
+} ConvertKernelDesc;
+
+static const ConvertKernelDesc convert_kernels[] = {
+    { PIXFMT_ARGB1555, PIXFMT_GS_CT16, kernel_argb1555_to_ct16 },
+    { PIXFMT_RGB565, PIXFMT_GS_CT16, kernel_rgb565_to_ct16 },
+    { PIXFMT_ARGB4444, PIXFMT_GS_CT16, kernel_argb4444_to_ct16 },
+    { PIXFMT_ARGB8888, PIXFMT_GS_CT32, kernel_argb8888_to_ct32 },
+};
+
+/** @brief Find the creation kernel for a conversion, or NULL if it takes the generic path. */
+FLPS2ConvertKernel flPS2GetConvertKernel(const plContext* lpSrc, const plContext* lpDst, u32 direction, u32 type) {
+    const s32 count = lpDst->width * lpDst->height;
+    PixFmt src;
+    PixFmt dst;
+    u32 i;
+
+    // Only host -> GS is used; GS -> host stays generic
+    if ((direction != 0) || (lpDst->pitch != lpDst->width * lpDst->bitdepth)) {
+        return NULL;
+    }
+
+    // The CLUT swizzle works on 32-entry blocks and wraps at 256
+    if ((type == 1) && ((count % 32) != 0 || count > 256)) {
+        return NULL;
+    }
+
+    src = identify(lpSrc);
+    dst = identify(lpDst);
+
+    for (i = 0; i < sizeof(convert_kernels) / sizeof(convert_kernels[0]); i++) {
+        if (convert_kernels[i].src == src && convert_kernels[i].dst == dst) {
+            return convert_kernels[i].kernel;
+        }
+    }
+
+    return NULL;
+}
+
+/** @brief Convert pixels between two plContext surfaces with optional CLUT re-ordering. */
+s32 flPS2ConvertContext(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type) {
+    const FLPS2ConvertKernel kernel = flPS2GetConvertKernel(lpSrc, lpDst, direction, type);
+    const s32 count = lpDst->width * lpDst->height;
+    const s32 bitdepth = lpDst->bitdepth;
+    const u8* src = lpSrc->ptr;
+    u8* dst = lpDst->ptr;
+    s32 i;
+
+    if (kernel == NULL) {
+        return flPS2ConvertContextGeneric(lpSrc, lpDst, direction, type);
+    }
+
+    if (type != 1) {
+        kernel(src, dst, count);
+        return 1;
+    }
+
+    // CLUT swizzle: the middle two 8-entry rows of every 32-entry block trade places
+    for (i = 0; i < count; i += 8) {
+        const s32 row = (i >> 3) & 3;
+        const s32 to = (i & ~31) + ((row == 1) ? 16 : (row == 2) ? 8 : row * 8);
+        kernel(src + i * bitdepth, dst + to * bitdepth, 8);
+    }
+
+    return 1;
+}
+
+/** @brief Generic per-pixel converter between two plContext surfaces with optional CLUT re-ordering. */
+s32 flPS2ConvertContextGeneric(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type) {
+    s32 x;
+    s32 y;
+    u32 r;
+    u32 g;
+    u32 b;
+    u32 a;
+    u32 color;
+    u32 wk0;
+    u32 wk1;
+    u8* keep_src;
+    u8* keep_dst;
+    u8* src;
+    u8* dst;
+
+    static u8 clut_tbl[32] = { 0, 1, 2,  3,  4,  5,  6,  7,  16, 17, 18, 19, 20, 21, 22, 23,
+                               8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31 };
+
+    keep_src = lpSrc->ptr;
+    keep_dst = lpDst->ptr;
+    wk0 = 0;
+    wk1 = 0;
+
+    for (y = 0; y < lpDst->height; y++) {
+        for (x = 0; x < lpDst->width; x++) {
+            if ((type == 1) && (direction == 1)) {
+                src = keep_src;
+                src += lpSrc->bitdepth * ((wk0 & 0xE0) + clut_tbl[wk0 & 0x1F]);
+            } else {
+                src = keep_src + wk1;
+                wk1 += lpSrc->bitdepth;
+            }
+
+            switch (lpSrc->bitdepth) {
+            case 2:
+                color = ((u16*)src)[0];
+                break;
+
+            case 3:
+                color = (src[2] << 16) | (src[1] << 8) | src[0];
+                break;
+
+            case 4:
+                color = ((u32*)src)[0];
+                break;
+            }
+
+            r = (lpSrc->pixelformat.rm & (color >> lpSrc->pixelformat.rs)) << (8 - lpSrc->pixelformat.rl);
+            g = (lpSrc->pixelformat.gm & (color >> lpSrc->pixelformat.gs)) << (8 - lpSrc->pixelformat.gl);
+            b = (lpSrc->pixelformat.bm & (color >> lpSrc->pixelformat.bs)) << (8 - lpSrc->pixelformat.bl);
+            a = (lpSrc->pixelformat.am & (color >> lpSrc->pixelformat.as)) << (8 - lpSrc->pixelformat.al);
+
+            if ((type == 1) && (direction == 0)) {
+                dst = keep_dst;
+                dst += lpDst->bitdepth * ((wk0 & 0xE0) + clut_tbl[wk0 & 0x1F]);
+            } else {
+                dst = keep_dst + (lpDst->pitch * y) + (lpDst->bitdepth * x);
+            }
+
+            if (lpSrc->bitdepth == 4) {
+                if (direction == 0) {
+                    if (a == 0xFF) {
+                        a = 0x80;
+                    } else if (a != 0) {
+                        a >>= 1;
+
+                        if (a == 0) {
+                            a = 1;
+                        }
+                    }
+                } else if (a == 0x80) {
+                    a = 0xFF;
+                } else {
+                    a *= 2;
+                }
+            }
+
+            color = ((lpDst->pixelformat.am & (a >> (8 - lpDst->pixelformat.al))) << lpDst->pixelformat.as) |
+                    (((lpDst->pixelformat.bm & (b >> (8 - lpDst->pixelformat.bl))) << lpDst->pixelformat.bs) |
+                     (((lpDst->pixelformat.rm & (r >> (8 - lpDst->pixelformat.rl))) << lpDst->pixelformat.rs) |
+                      ((lpDst->pixelformat.gm & (g >> (8 - lpDst->pixelformat.gl))) << lpDst->pixelformat.gs)));
+
+            switch (lpSrc->bitdepth) {
+            case 2:
+                ((u16*)dst)[0] = color;
+                break;
+
+            case 3:
+                dst[0] = r;
+                dst[1] = g;
+                dst[2] = b;
+                break;
+
+            case 4:
+                ((u32*)dst)[0] = color;
+                break;
+            }
+
+            wk0 += 1;
+        }
+    }
+
+    return 1;
+}
+
+// --- Lock kernels (plConvertContext between a GS layout and its host twin) ---
+
+// plConvertContext widens 5-bit channels to 8 bits and back with truncating
+// divides, which loses one step on everything but 0 and 31
+static const u8 ct16_lock_channel[32] = { 0,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+                                          15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 31 };
+
+static void kernel_lock_ct16(const u8* src, u8* dst, s32 count) {
+    s32 i;
+
+    for (i = 0; i < count; i++) {
+        const u32 c = ((const u16*)src)[i];
+        ((u16*)dst)[i] = (c & 0x8000) | ct16_lock_channel[(c >> 10) & 0x1F] |
+                         (ct16_lock_channel[(c >> 5) & 0x1F] << 5) | (ct16_lock_channel[c & 0x1F] << 10);
+    }
+}
+
+static void kernel_lock_ct24(const u8* src, u8* dst, s32 count) {
+    s32 i;
+
+    for (i = 0; i < count * 3; i += 3) {
+        dst[i + 0] = src[i + 2];
+        dst[i + 1] = src[i + 1];
+        dst[i + 2] = src[i + 0];
+    }
+}
+
+static void kernel_lock_ct32(const u8* src, u8* dst, s32 count) {
+    s32 i;
+
+    for (i = 0; i < count; i++) {
+        const u32 c = ((const u32*)src)[i];
+        ((u32*)dst)[i] = (c & 0xFF00FF00) | ((c >> 16) & 0xFF) | ((c & 0xFF) << 16);
+    }
+}
+
+static const ConvertKernelDesc lock_kernels[] = {
+    { PIXFMT_GS_CT16, PIXFMT_ARGB1555, kernel_lock_ct16 }, { PIXFMT_ARGB1555, PIXFMT_GS_CT16, kernel_lock_ct16 },
+    { PIXFMT_GS_CT24, PIXFMT_RGB888, kernel_lock_ct24 },   { PIXFMT_RGB888, PIXFMT_GS_CT24, kernel_lock_ct24 },
+    { PIXFMT_GS_CT32, PIXFMT_ARGB8888, kernel_lock_ct32 }, { PIXFMT_ARGB8888, PIXFMT_GS_CT32, kernel_lock_ct32 },
+};
+
+/** @brief Find the lock/unlock kernel for a conversion, or NULL if it takes the generic path. */
+FLPS2ConvertKernel flPS2GetLockKernel(const plContext* dst, const plContext* src) {
+    PixFmt src_fmt;
+    PixFmt dst_fmt;
+    u32 i;
+
+    if ((src->width != dst->width) || (src->height != dst->height) ||
+        (src->pitch != src->width * src->bitdepth) || (dst->pitch != dst->width * dst->bitdepth)) {
+        return NULL;
+    }
+
+    src_fmt = identify(src);
+    dst_fmt = identify(dst);
+
+    for (i = 0; i < sizeof(lock_kernels) / sizeof(lock_kernels[0]); i++) {
+        if (lock_kernels[i].src == src_fmt && lock_kernels[i].dst == dst_fmt) {
+            return lock_kernels[i].kernel;
+        }
+    }
+
+    return NULL;
+}
+
+/** @brief Convert a locked surface to or from its GS layout; same result as plConvertContext. */
+s32 flPS2ConvertLockContext(plContext* dst, plContext* src) {
+    const FLPS2ConvertKernel kernel = flPS2GetLockKernel(dst, src);
+
+    if (kernel == NULL) {
+        return plConvertContext(dst, src);
+    }
+
+    if ((dst->width > 0) && (dst->height > 0)) {
+        kernel(src->ptr, dst->ptr, dst->width * dst->height);
+    }
+
+    return 1;
+}
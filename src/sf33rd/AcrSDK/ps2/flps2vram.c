@@ -14,7 +14,7 @@
 #include "common.h"
 #include "sf33rd/AcrSDK/common/memfound.h"
 #include "sf33rd/AcrSDK/common/plcommon.h"
-#include "sf33rd/AcrSDK/common/prilay.h"
+#include "sf33rd/AcrSDK/ps2/flps2convert.h"
 #include "sf33rd/AcrSDK/ps2/flps2debug.h"
 #include "sf33rd/AcrSDK/ps2/flps2etc.h"
 #include "sf33rd/AcrSDK/ps2/foundaps2.h"
@@ -411,6 +411,10 @@ s32 flPS2LockTexture(Rect* /* unused */, FLTexture* lpflTexture, plContext* lpco
             buff_ptr1 = mflTemporaryUse(lpflTexture->size * 2);
             buff_ptr = buff_ptr1 + lpflTexture->size;
             // Loading an image from VRAM used to be here
+        } else if ((lpflTexture->format == SCE_GS_PSMT4) || (lpflTexture->format == SCE_GS_PSMT8)) {
+            // Indexed data needs no conversion, so lock it in place
+            buff_ptr = flPS2GetSystemBuffAdrs(lpflTexture->mem_handle);
+            buff_ptr1 = buff_ptr;
         } else {
             buff_ptr = mflTemporaryUse(lpflTexture->size);
             buff_ptr1 = flPS2GetSystemBuffAdrs(lpflTexture->mem_handle);
@@ -427,13 +431,21 @@ s32 flPS2LockTexture(Rect* /* unused */, FLTexture* lpflTexture, plContext* lpco
         case 20:
             lpcontext->bitdepth = 0;
             lpcontext->pitch = lpcontext->width / 2;
-            flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+
+            if (buff_ptr != buff_ptr1) {
+                flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+            }
+
             break;
 
         case 19:
             lpcontext->bitdepth = 1;
             lpcontext->pitch = lpcontext->width * lpcontext->bitdepth;
-            flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+
+            if (buff_ptr != buff_ptr1) {
+                flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+            }
+
             break;
 
         case 2:
@@ -469,7 +481,7 @@ s32 flPS2LockTexture(Rect* /* unused */, FLTexture* lpflTexture, plContext* lpco
             src.pixelformat.gl = 5;
             src.pixelformat.gm = 0x1F;
             src.pitch = src.width * src.bitdepth;
-            plConvertContext(lpcontext, &src);
+            flPS2ConvertLockContext(lpcontext, &src);
             break;
 
         case 1:
@@ -503,7 +515,7 @@ s32 flPS2LockTexture(Rect* /* unused */, FLTexture* lpflTexture, plContext* lpco
             src.pixelformat.rs = 0;
             src.pixelformat.bs = 0x10;
             src.pitch = src.width * src.bitdepth;
-            plConvertContext(lpcontext, &src);
+            flPS2ConvertLockContext(lpcontext, &src);
             break;
 
         case 0:
@@ -537,7 +549,7 @@ s32 flPS2LockTexture(Rect* /* unused */, FLTexture* lpflTexture, plContext* lpco
             src.pixelformat.rs = 0;
             src.pixelformat.bs = 0x10;
             src.pitch = src.width * src.bitdepth;
-            plConvertContext(lpcontext, &src);
+            flPS2ConvertLockContext(lpcontext, &src);
             break;
         }
 
@@ -834,6 +846,40 @@ s32 flUnlockPalette(u32 th) {
     return ret;
 }
 
+/** @brief Unlock `count` palettes with consecutive handles from `th`, handing them to the renderer as one update. */
+s32 flUnlockPalettes(u32 th, s32 count) {
+    s32 ret = 1;
+    s32 first = 0;
+    s32 i;
+
+    if (th == 0 || count <= 0 || th + count - 1 > FL_PALETTE_MAX) {
+        return 0;
+    }
+
+    for (i = 0; i <= count; i++) {
+        if ((i < count) && flPalette[th - 1 + i].be_flag) {
+            if (!flPS2UnlockTexture(&flPalette[th - 1 + i])) {
+                ret = 0;
+            }
+
+            continue;
+        }
+
+        // A palette that doesn't exist ends the run, as flUnlockPalette would skip it
+        if (i > first) {
+            SDLGameRenderer_UnlockPalettes(th + first, i - first);
+        }
+
+        if (i < count) {
+            ret = 0;
+        }
+
+        first = i + 1;
+    }
+
+    return ret;
+}
+
 /** @brief Internal unlock — convert pixel format and write back to system memory. */
 s32 flPS2UnlockTexture(FLTexture* lpflTexture) {
     u8* buff_ptr;
@@ -863,7 +909,11 @@ s32 flPS2UnlockTexture(FLTexture* lpflTexture) {
         switch (lpflTexture->format) {
         case 20:
         case 19:
-            flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+            // Locked in place when the texture has system memory
+            if (buff_ptr != buff_ptr1) {
+                flMemcpy(buff_ptr, buff_ptr1, lpflTexture->size);
+            }
+
             break;
 
         case 2:
@@ -899,7 +949,7 @@ s32 flPS2UnlockTexture(FLTexture* lpflTexture) {
             dst.pixelformat.gl = 5;
             dst.pixelformat.gm = 0x1F;
             dst.pitch = dst.width * dst.bitdepth;
-            plConvertContext(&dst, &src);
+            flPS2ConvertLockContext(&dst, &src);
             break;
 
         case 1:
@@ -933,7 +983,7 @@ s32 flPS2UnlockTexture(FLTexture* lpflTexture) {
             dst.pixelformat.rs = 0;
             dst.pixelformat.bs = 0x10;
             dst.pitch = dst.width * dst.bitdepth;
-            plConvertContext(&dst, &src);
+            flPS2ConvertLockContext(&dst, &src);
             break;
 
         case 0:
@@ -967,7 +1017,7 @@ s32 flPS2UnlockTexture(FLTexture* lpflTexture) {
             dst.pixelformat.rs = 0;
             dst.pixelformat.bs = 0x10;
             dst.pitch = dst.width * dst.bitdepth;
-            plConvertContext(&dst, &src);
+            flPS2ConvertLockContext(&dst, &src);
             break;
         }
 
@@ -1138,109 +1188,3 @@ static s32 flPS2ConvertTextureFromContext(plContext* lpcontext, FLTexture* lpflT
 
     return 1;
 }
-
-/** @brief Convert pixels between two plContext surfaces with optional CLUT re-ordering. */
-s32 flPS2ConvertContext(plContext* lpSrc, plContext* lpDst, u32 direction, u32 type) {
-    s32 x;
-    s32 y;
-    u32 r;
-    u32 g;
-    u32 b;
-    u32 a;
-    u32 color;
-    u32 wk0;
-    u32 wk1;
-    u8* keep_src;
-    u8* keep_dst;
-    u8* src;
-    u8* dst;
-
-    static u8 clut_tbl[32] = { 0, 1, 2,  3,  4,  5,  6,  7,  16, 17, 18, 19, 20, 21, 22, 23,
-                               8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31 };
-
-    keep_src = lpSrc->ptr;
-    keep_dst = lpDst->ptr;
-    wk0 = 0;
-    wk1 = 0;
-
-    for (y = 0; y < lpDst->height; y++) {
-        for (x = 0; x < lpDst->width; x++) {
-            if ((type == 1) && (direction == 1)) {
-                src = keep_src;
-                src += lpSrc->bitdepth * ((wk0 & 0xE0) + clut_tbl[wk0 & 0x1F]);
-            } else {
-                src = keep_src + wk1;
-                wk1 += lpSrc->bitdepth;
-            }
-
-            switch (lpSrc->bitdepth) {
-            case 2:
-                color = ((u16*)src)[0];
-                break;
-
-            case 3:
-                color = (src[2] << 16) | (src[1] << 8) | src[0];
-                break;
-
-            case 4:
-                color = ((u32*)src)[0];
-                break;
-            }
-
-            r = (lpSrc->pixelformat.rm & (color >> lpSrc->pixelformat.rs)) << (8 - lpSrc->pixelformat.rl);
-            g = (lpSrc->pixelformat.gm & (color >> lpSrc->pixelformat.gs)) << (8 - lpSrc->pixelformat.gl);
-            b = (lpSrc->pixelformat.bm & (color >> lpSrc->pixelformat.bs)) << (8 - lpSrc->pixelformat.bl);
-            a = (lpSrc->pixelformat.am & (color >> lpSrc->pixelformat.as)) << (8 - lpSrc->pixelformat.al);
-
-            if ((type == 1) && (direction == 0)) {
-                dst = keep_dst;
-                dst += lpDst->bitdepth * ((wk0 & 0xE0) + clut_tbl[wk0 & 0x1F]);
-            } else {
-                dst = keep_dst + (lpDst->pitch * y) + (lpDst->bitdepth * x);
-            }
-
-            if (lpSrc->bitdepth == 4) {
-                if (direction == 0) {
-                    if (a == 0xFF) {
-                        a = 0x80;
-                    } else if (a != 0) {
-                        a >>= 1;
-
-                        if (a == 0) {
-                            a = 1;
-                        }
-                    }
-                } else if (a == 0x80) {
-                    a = 0xFF;
-                } else {
-                    a *= 2;
-                }
-            }
-
-            color = ((lpDst->pixelformat.am & (a >> (8 - lpDst->pixelformat.al))) << lpDst->pixelformat.as) |
-                    (((lpDst->pixelformat.bm & (b >> (8 - lpDst->pixelformat.bl))) << lpDst->pixelformat.bs) |
-                     (((lpDst->pixelformat.rm & (r >> (8 - lpDst->pixelformat.rl))) << lpDst->pixelformat.rs) |
-                      ((lpDst->pixelformat.gm & (g >> (8 - lpDst->pixelformat.gl))) << lpDst->pixelformat.gs)));
-
-            switch (lpSrc->bitdepth) {
-            case 2:
-                ((u16*)dst)[0] = color;
-                break;
-
-            case 3:
-                dst[0] = r;
-                dst[1] = g;
-                dst[2] = b;
-                break;
-
-            case 4:
-                ((u32*)dst)[0] = color;
-                break;
-            }
-
-            wk0 += 1;
-        }
-    }
-
-    return 1;
-}
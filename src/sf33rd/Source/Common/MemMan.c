@@ -6,14 +6,130 @@
  * allocation within a pre-allocated memory region. Memory cells are
  * linked in address order; allocation finds the smallest gap that fits.
  *
+ * Free gaps are indexed by segregated size classes (power-of-two multiples
+ * of ownUnit) with a bitmap of non-empty bins, so an allocation only probes
+ * the gaps of a single class instead of walking every cell. Placement is
+ * identical to the original linear scan: smallest fitting gap wins, ties go
+ * to the lowest address (forward) or highest address (reverse).
+ *
  * Part of the Common module.
  * Originally from the PS2 memory management module.
  */
 #include "sf33rd/Source/Common/MemMan.h"
 #include "common.h"
 
+#include <string.h>
+
 u32 mmInitialNumber;
 
+/** @brief Size of the free gap that follows a cell (0 for the final sentinel). */
+static ptrdiff_t mmGapSize(const struct _MEMMAN_CELL* cell) {
+    if (cell->next == NULL) {
+        return 0;
+    }
+
+    return (intptr_t)cell->next - (intptr_t)cell - cell->size;
+}
+
+/** @brief Map a gap size to its size-class bin: floor(log2(gap / unit)). */
+static s32 mmGapClass(const _MEMMAN_OBJ* mmobj, ptrdiff_t gap) {
+    uintptr_t units = (uintptr_t)gap / (uintptr_t)mmobj->ownUnit;
+    s32 cls;
+
+    if (units == 0) {
+        return 0;
+    }
+
+    if (units > 0xFFFFFFFFu) {
+        return MEMMAN_FREE_BINS - 1;
+    }
+
+    cls = 31 - __builtin_clz((u32)units);
+    return (cls < MEMMAN_FREE_BINS) ? cls : (MEMMAN_FREE_BINS - 1);
+}
+
+/** @brief Index the gap following @p cell (if any) in its size-class bin. */
+static void mmGapInsert(_MEMMAN_OBJ* mmobj, struct _MEMMAN_CELL* cell) {
+    ptrdiff_t gap = mmGapSize(cell);
+    struct _MEMMAN_FREE* node;
+    s32 cls;
+
+    if (gap <= 0) {
+        return;
+    }
+
+    cls = mmGapClass(mmobj, gap);
+    node = (struct _MEMMAN_FREE*)((uintptr_t)cell + cell->size);
+    node->owner = cell;
+    node->prev = NULL;
+    node->next = mmobj->freeBin[cls];
+
+    if (node->next != NULL) {
+        node->next->prev = node;
+    }
+
+    mmobj->freeBin[cls] = node;
+    mmobj->freeMap |= 1u << cls;
+}
+
+/** @brief Remove the gap following @p cell (if any) from its bin. Call before relinking. */
+static void mmGapRemove(_MEMMAN_OBJ* mmobj, struct _MEMMAN_CELL* cell) {
+    ptrdiff_t gap = mmGapSize(cell);
+    struct _MEMMAN_FREE* node;
+    s32 cls;
+
+    if (gap <= 0) {
+        return;
+    }
+
+    cls = mmGapClass(mmobj, gap);
+    node = (struct _MEMMAN_FREE*)((uintptr_t)cell + cell->size);
+
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        mmobj->freeBin[cls] = node->next;
+    }
+
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+
+    if (mmobj->freeBin[cls] == NULL) {
+        mmobj->freeMap &= ~(1u << cls);
+    }
+}
+
+/**
+ * @brief Best-fit search within one bin.
+ *
+ * Ties on gap size are broken by address so the result matches the original
+ * address-ordered scan: lowest gap for forward, highest gap for reverse.
+ */
+static struct _MEMMAN_FREE* mmBinBestFit(_MEMMAN_OBJ* mmobj, s32 cls, ssize_t sizeTrue, s32 flag, u32* probes) {
+    struct _MEMMAN_FREE* node;
+    struct _MEMMAN_FREE* best = NULL;
+    ptrdiff_t bestGap = 0;
+    ptrdiff_t gap;
+
+    for (node = mmobj->freeBin[cls]; node != NULL; node = node->next) {
+        *probes += 1;
+        gap = mmGapSize(node->owner);
+
+        if (gap < sizeTrue) {
+            continue;
+        }
+
+        if ((best == NULL) || (gap < bestGap) ||
+            ((gap == bestGap) && ((flag != 1) ? (node < best) : (node > best)))) {
+            best = node;
+            bestGap = gap;
+        }
+    }
+
+    return best;
+}
+
 /** @brief Reset the global heap instance counter. */
 void mmSystemInitialize() {
     mmInitialNumber = 0;
@@ -37,6 +153,11 @@ void mmHeapInitialize(_MEMMAN_OBJ* mmobj, u8* adrs, s32 size, s32 unit, s8* form
     mmobj->cell_fin->prev = mmobj->cell_1st;
     mmobj->cell_fin->next = NULL;
     mmobj->cell_fin->size = mmobj->ownUnit;
+
+    memset(mmobj->freeBin, 0, sizeof(mmobj->freeBin));
+    mmobj->freeMap = 0;
+    memset(&mmobj->stats, 0, sizeof(mmobj->stats));
+    mmGapInsert(mmobj, mmobj->cell_1st);
 }
 
 /** @brief Round a value up to the next alignment boundary. */
@@ -64,14 +185,49 @@ ssize_t mmGetRemainderMin(_MEMMAN_OBJ* mmobj) {
     return mmobj->remainderMin;
 }
 
+/** @brief Collect allocation counters and a fragmentation snapshot of the free bins. */
+void mmGetStats(_MEMMAN_OBJ* mmobj, MMStats* out) {
+    struct _MEMMAN_FREE* node;
+    ptrdiff_t gap;
+    s32 i;
+
+    out->allocCount = mmobj->stats.allocCount;
+    out->freeCount = mmobj->stats.freeCount;
+    out->failCount = mmobj->stats.failCount;
+    out->probeMax = mmobj->stats.probeMax;
+    out->probeAvg = mmobj->stats.allocCount + mmobj->stats.failCount
+                        ? (f32)mmobj->stats.probeTotal / (f32)(mmobj->stats.allocCount + mmobj->stats.failCount)
+                        : 0.0f;
+    out->freeBlocks = 0;
+    out->freeTotal = 0;
+    out->freeLargest = 0;
+
+    for (i = 0; i < MEMMAN_FREE_BINS; i++) {
+        for (node = mmobj->freeBin[i]; node != NULL; node = node->next) {
+            gap = mmGapSize(node->owner);
+            out->freeBlocks += 1;
+            out->freeTotal += gap;
+
+            if (gap > out->freeLargest) {
+                out->freeLargest = gap;
+            }
+        }
+    }
+
+    // 0% = all free space is one contiguous gap, approaching 100% = shattered
+    out->fragmentation = out->freeTotal ? 100.0f - ((f32)out->freeLargest * 100.0f / (f32)out->freeTotal) : 0.0f;
+}
+
 /** @brief Allocate memory from the heap (flag=0: forward, flag=1: reverse). */
 u8* mmAlloc(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag) {
     struct _MEMMAN_CELL* cell = mmAllocSub(mmobj, size, flag);
 
     if (cell == NULL) {
+        mmobj->stats.failCount += 1;
         return NULL;
     }
 
+    mmobj->stats.allocCount += 1;
     mmobj->remainder -= cell->size;
 
     if (mmobj->remainderMin > mmobj->remainder) {
@@ -83,83 +239,60 @@ u8* mmAlloc(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag) {
 
 /** @brief Best-fit allocation subroutine — finds and links a new cell. */
 struct _MEMMAN_CELL* mmAllocSub(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag) {
+    struct _MEMMAN_FREE* node;
     struct _MEMMAN_CELL* myself;
-    struct _MEMMAN_CELL* next;
     struct _MEMMAN_CELL* cell;
     ssize_t sizeTrue;
-    ptrdiff_t gap;
-    ptrdiff_t gapMin;
+    u32 probes = 0;
+    u32 higher;
+    s32 cls;
 
     sizeTrue = mmobj->ownUnit + mmRoundUp(mmobj->ownUnit, size);
-    gapMin = 0x7FFFFFFF;
-    cell = NULL;
+    cls = mmGapClass(mmobj, sizeTrue);
 
-    if (flag != 1) {
-        myself = mmobj->cell_1st;
-
-        do {
-            next = myself->next;
-            gap = (intptr_t)next - (intptr_t)myself - myself->size;
-
-            if (gap >= sizeTrue) {
-                if (gap == sizeTrue) {
-                    cell = myself;
-                    break;
-                } else {
-                    if ((gap - sizeTrue) < gapMin) {
-                        gapMin = gap - sizeTrue;
-                        cell = myself;
-                    }
-                }
-            }
+    // Gaps in the request's own class may still be too small, so probe it first;
+    // anything in a higher class always fits, and the lowest such class holds the best fit.
+    node = mmBinBestFit(mmobj, cls, sizeTrue, flag, &probes);
 
-            myself = next;
-        } while (myself->next != NULL);
+    if (node == NULL) {
+        higher = (cls + 1 < MEMMAN_FREE_BINS) ? (mmobj->freeMap & ~((2u << cls) - 1)) : 0;
 
-        if (cell == NULL) {
-            return NULL;
+        if (higher != 0) {
+            node = mmBinBestFit(mmobj, __builtin_ctz(higher), sizeTrue, flag, &probes);
         }
+    }
+
+    mmobj->stats.probeTotal += probes;
+
+    if (mmobj->stats.probeMax < probes) {
+        mmobj->stats.probeMax = probes;
+    }
 
+    if (node == NULL) {
+        return NULL;
+    }
+
+    cell = node->owner;
+    mmGapRemove(mmobj, cell);
+
+    if (flag != 1) {
         myself = (struct _MEMMAN_CELL*)((uintptr_t)cell + cell->size);
         myself->prev = cell;
         myself->next = cell->next;
         myself->size = sizeTrue;
         cell->next->prev = myself;
         cell->next = myself;
+        mmGapInsert(mmobj, myself);
         return myself;
     }
 
-    myself = mmobj->cell_fin;
-
-    do {
-        next = myself->prev;
-        gap = (intptr_t)myself - (intptr_t)next - next->size;
-
-        if (gap >= sizeTrue) {
-            if (gap == sizeTrue) {
-                cell = myself;
-                break;
-            } else {
-                if ((gap - sizeTrue) < gapMin) {
-                    gapMin = gap - sizeTrue;
-                    cell = myself;
-                }
-            }
-        }
-
-        myself = next;
-    } while (myself->prev != NULL);
-
-    if (cell == NULL) {
-        return NULL;
-    }
-
-    myself = (struct _MEMMAN_CELL*)((uintptr_t)cell - sizeTrue);
-    myself->prev = cell->prev;
-    myself->next = cell;
+    myself = (struct _MEMMAN_CELL*)((uintptr_t)cell->next - sizeTrue);
+    myself->prev = cell;
+    myself->next = cell->next;
     myself->size = sizeTrue;
-    cell->prev->next = myself;
-    cell->prev = myself;
+    cell->next->prev = myself;
+    cell->next = myself;
+    mmGapInsert(mmobj, cell);
     return myself;
 }
 
@@ -170,8 +303,12 @@ void mmFree(_MEMMAN_OBJ* mmobj, u8* adrs) {
     if (adrs != NULL) {
         cell = (struct _MEMMAN_CELL*)((intptr_t)adrs - mmobj->ownUnit);
         mmobj->remainder += cell->size;
+        mmobj->stats.freeCount += 1;
+        mmGapRemove(mmobj, cell->prev);
+        mmGapRemove(mmobj, cell);
         cell->prev->next = cell->next;
         cell->next->prev = cell->prev;
+        mmGapInsert(mmobj, cell->prev);
     } else {
         return;
     }
@@ -10,6 +10,8 @@
 
 #include "types.h"
 
+extern const s8 Demo_Stage_Play_Data[4][2];
+
 s32 Play_Demo();
 void Setup_Demo_PL();
 void Setup_Demo_Arts();
@@ -0,0 +1,153 @@
+/**
+ * @file hitbox.c
+ * World-space hitbox tables and bounds culling for attack_hit_check
+ *
+ * hit_check_subroutine works on raw box rows and redoes the facing flip and
+ * position offset of both boxes for every pair it tests. Here each worker's
+ * boxes are converted once per check, in the same 16-bit arithmetic, so
+ * hitbox_overlap returns exactly what hit_check_subroutine would for the same
+ * two rows. The combined bounds reject worker pairs that cannot touch; they are
+ * only trusted when every box is small enough that none of the 16-bit sums wrap.
+ */
+
+#include "sf33rd/Source/Game/engine/hitbox.h"
+
+/** @brief Convert one box row {x, w, y, h} to world space for its owner. */
+void hitbox_make(HitBox* box, const WORK* wk, const s16* hd) {
+    s16 x = hd[0];
+
+    if (wk->rl_flag) {
+        x = -x;
+        x -= hd[1];
+    }
+
+    x += wk->xyz[0].disp.pos;
+    box->x = x;
+    box->w = hd[1];
+    box->y = wk->xyz[1].disp.pos + hd[2];
+    box->h = hd[3];
+}
+
+static s32 in_safe_range(s16 v) {
+    return (v >= -HITBOX_SAFE_RANGE) && (v <= HITBOX_SAFE_RANGE);
+}
+
+/** @brief Compute the combined bounds of the boxes in use. */
+static void setup_bounds(HitBounds* bounds, const HitBox* boxes, s32 count) {
+    s32 i;
+
+    bounds->used = 0;
+    bounds->exact = 1;
+
+    for (i = 0; i < count; i++) {
+        const HitBox* box = &boxes[i];
+
+        if (box->w == 0) {
+            continue;
+        }
+
+        if (!in_safe_range(box->x) || !in_safe_range(box->y) || (box->w < 0) || (box->w > HITBOX_SAFE_RANGE) ||
+            (box->h < 0) || (box->h > HITBOX_SAFE_RANGE)) {
+            bounds->exact = 0;
+            return;
+        }
+
+        if (!bounds->used) {
+            bounds->x0 = box->x;
+            bounds->x1 = box->x + box->w;
+            bounds->y0 = box->y;
+            bounds->y1 = box->y + box->h;
+            bounds->used = 1;
+            continue;
+        }
+
+        if (box->x < bounds->x0) {
+            bounds->x0 = box->x;
+        }
+
+        if (box->x + box->w > bounds->x1) {
+            bounds->x1 = box->x + box->w;
+        }
+
+        if (box->y < bounds->y0) {
+            bounds->y0 = box->y;
+        }
+
+        if (box->y + box->h > bounds->y1) {
+            bounds->y1 = box->y + box->h;
+        }
+    }
+}
+
+/** @brief Build the attack boxes of a worker from h_att. */
+void hitbox_setup_attack(HitBoxSet* set, const WORK* wk) {
+    s32 i;
+
+    for (i = 0; i < 4; i++) {
+        hitbox_make(&set->att[i], wk, wk->h_att->att_box[i]);
+    }
+
+    setup_bounds(&set->att_bounds, set->att, 4);
+}
+
+/** @brief Build the damage boxes of a worker in dmdat order: body, hand, lower attack boxes, hosei. */
+void hitbox_setup_damage(HitBoxSet* set, const WORK* wk) {
+    s32 i;
+
+    for (i = 0; i < 4; i++) {
+        set->dm_src[i] = wk->h_bod->body_dm[i];
+        set->dm_src[i + 4] = wk->h_han->hand_dm[i];
+    }
+
+    set->dm_src[8] = wk->h_att->att_box[2];
+    set->dm_src[9] = wk->h_att->att_box[3];
+    set->dm_src[10] = wk->h_hos->hos_box;
+
+    for (i = 0; i < 11; i++) {
+        hitbox_make(&set->dm[i], wk, set->dm_src[i]);
+    }
+
+    setup_bounds(&set->dm_bounds, set->dm, 11);
+}
+
+/** @brief Overlap depth of attack box `a` into damage box `d`, 0 if apart; matches hit_check_subroutine. */
+s16 hitbox_overlap(const HitBox* a, const HitBox* d) {
+    s16 d0;
+    s16 d1;
+
+    d0 = d->x + d->w - a->x;
+    d1 = a->w + d->w;
+
+    if ((u32)d0 >= d1) {
+        return 0;
+    }
+
+    if ((u32)(s16)(a->y - d->y + a->h) >= (s16)(a->h + d->h)) {
+        return 0;
+    }
+
+    if (d0 > (d1 - d0)) {
+        d0 = d1 - d0;
+    }
+
+    return d0;
+}
+
+/** @brief False only if no box of `a` can overlap any box of `d`. */
+s32 hitbox_bounds_overlap(const HitBounds* a, const HitBounds* d) {
+    if (!a->exact || !d->exact) {
+        return 1;
+    }
+
+    if (!a->used || !d->used) {
+        return 0;
+    }
+
+    // With no wrap-around, a hit needs d.x < a.x + a.w, a.x <= d.x + d.w,
+    // d.y <= a.y + a.h and a.y < d.y + d.h for some pair of boxes
+    if ((d->x0 >= a->x1) || (d->x1 < a->x0) || (d->y0 > a->y1) || (a->y0 >= d->y1)) {
+        return 0;
+    }
+
+    return 1;
+}
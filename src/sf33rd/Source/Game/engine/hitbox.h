@@ -0,0 +1,43 @@
+#ifndef HITBOX_H
+#define HITBOX_H
+
+#include "structs.h"
+#include "types.h"
+
+// Largest coordinate or size for which the bounds test below is exact
+#define HITBOX_SAFE_RANGE 0x1FFF
+
+// A hitbox moved to world space and flipped for its owner's facing
+typedef struct {
+    s16 x; // Left edge
+    s16 w;
+    s16 y; // Bottom edge
+    s16 h;
+} HitBox;
+
+// Combined extent of a worker's boxes in use (width != 0)
+typedef struct {
+    s16 x0;
+    s16 x1;
+    s16 y0;
+    s16 y1;
+    u8 used;  // At least one box in use
+    u8 exact; // Every box in use lies within HITBOX_SAFE_RANGE
+} HitBounds;
+
+// One hit queue worker's boxes, laid out as attack_hit_check walks them
+typedef struct {
+    HitBox att[4];
+    HitBox dm[11];         // body_dm[0..3], hand_dm[0..3], att_box[2..3], hos_box
+    const s16* dm_src[11]; // The table rows the dm boxes came from
+    HitBounds att_bounds;
+    HitBounds dm_bounds;
+} HitBoxSet;
+
+void hitbox_make(HitBox* box, const WORK* wk, const s16* hd);
+void hitbox_setup_attack(HitBoxSet* set, const WORK* wk);
+void hitbox_setup_damage(HitBoxSet* set, const WORK* wk);
+s16 hitbox_overlap(const HitBox* a, const HitBox* d);
+s32 hitbox_bounds_overlap(const HitBounds* a, const HitBounds* d);
+
+#endif
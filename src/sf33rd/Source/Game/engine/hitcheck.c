@@ -13,6 +13,7 @@
 #include "sf33rd/Source/Game/engine/cmb_win.h"
 #include "sf33rd/Source/Game/engine/cmd_main.h"
 #include "sf33rd/Source/Game/engine/grade.h"
+#include "sf33rd/Source/Game/engine/hitbox.h"
 #include "sf33rd/Source/Game/engine/hitefef.h"
 #include "sf33rd/Source/Game/engine/hitefpl.h"
 #include "sf33rd/Source/Game/engine/hitplef.h"
@@ -31,11 +32,11 @@
 
 // bss
 HS hs[32];
+static HitBoxSet hit_boxes[32];
 
 // sbss
 s16 grdb[2][2][2];
 s16 grdb2[2][2];
-s16* dmdat_adrs[16];
 WORK* q_hit_push[32];
 s16 mkm_wk[32];
 s16 hpq_in;
@@ -1605,16 +1606,20 @@ void catch_hit_check() {
 void attack_hit_check() {
     WORK* mad;
     WORK* sad;
-    s16* mh;
-    s16* sh;
+    HitBoxSet* ms;
+    HitBoxSet* ss;
     s16 mi;
     s16 si;
     s16 lp;
     s16 lp2;
     s16 mw;
+    u8 att_ready[32];
+    u8 dm_ready[32];
 
-    s16* assign1;
-    s16* assign2;
+    // Boxes are only built for workers that get past the filters below; the
+    // tables of the others may not be set up
+    SDL_zeroa(att_ready);
+    SDL_zeroa(dm_ready);
 
     for (si = 0; si < hpq_in; si++) {
         if (hs[si].flag.results & 0x1101) {
@@ -1622,18 +1627,13 @@ void attack_hit_check() {
         }
 
         sad = q_hit_push[si];
-        sh = sad->h_bod->body_dm[0];
-        mh = sad->h_han->hand_dm[0];
+        ss = &hit_boxes[si];
 
-        for (lp = 0; lp < 4; lp++, sh += 4, assign1 = mh += 4) {
-            dmdat_adrs[lp] = sh;
-            dmdat_adrs[lp + 4] = mh;
+        if (!dm_ready[si]) {
+            hitbox_setup_damage(ss, sad);
+            dm_ready[si] = 1;
         }
 
-        dmdat_adrs[8] = &sad->h_att->att_box[2][0];
-        dmdat_adrs[9] = &sad->h_att->att_box[3][0];
-        dmdat_adrs[10] = &sad->h_hos->hos_box[0];
-
         for (mi = 0; mi < hpq_in; mi++) {
             if (mi == si) {
                 continue;
@@ -1672,10 +1672,19 @@ void attack_hit_check() {
                 continue;
             }
 
-            mh = &mad->h_att->att_box[0][0];
+            ms = &hit_boxes[mi];
+
+            if (!att_ready[mi]) {
+                hitbox_setup_attack(ms, mad);
+                att_ready[mi] = 1;
+            }
+
+            if (!hitbox_bounds_overlap(&ms->att_bounds, &ss->dm_bounds)) {
+                continue;
+            }
 
-            for (lp = 0; lp < 4; lp++, assign2 = mh += 4) {
-                if (mh[1] == 0) {
+            for (lp = 0; lp < 4; lp++) {
+                if (ms->att[lp].w == 0) {
                     continue;
                 }
 
@@ -1684,7 +1693,7 @@ void attack_hit_check() {
                         goto end;
                     }
 
-                    if (dmdat_adrs[lp2][1] == 0) {
+                    if (ss->dm[lp2].w == 0) {
                         continue;
                     }
 
@@ -1714,7 +1723,7 @@ void attack_hit_check() {
                         }
                     }
 
-                    mw = hit_check_subroutine(mad, sad, mh, dmdat_adrs[lp2]);
+                    mw = hitbox_overlap(&ms->att[lp], &ss->dm[lp2]);
 
                     if (mw > mkm_wk[si]) {
                         hs[mi].flag.results |= 0x10;
@@ -1725,8 +1734,8 @@ void attack_hit_check() {
                         hs[si].dm_body = lp2;
                         mad->att_hit_ok = 0;
                         mkm_wk[si] = mw;
-                        hs[mi].ah = mh;
-                        hs[si].dh = dmdat_adrs[lp2];
+                        hs[mi].ah = mad->h_att->att_box[lp];
+                        hs[si].dh = (s16*)ss->dm_src[lp2];
                     }
                 }
             }
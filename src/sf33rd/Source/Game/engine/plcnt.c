@@ -6,6 +6,7 @@
 #include "sf33rd/Source/Game/engine/plcnt.h"
 #include "common.h"
 #include "main.h"
+#include "port/selfplay.h"
 #include "sf33rd/Source/Game/animation/win_pl.h"
 #include "sf33rd/Source/Game/debug/Debug.h"
 #include "sf33rd/Source/Game/effect/eff00.h"
@@ -576,6 +577,8 @@ static void plcnt_move() {
         update_training_state();
     }
 
+    SelfPlay_Tick();
+
     if (time_over_check() != 0) {
         return;
     }
@@ -24,6 +24,8 @@
 
 #include "port/io/afs.h"
 
+#include <SDL3/SDL.h>
+
 typedef struct {
     u8 type;
     u8 ix;
@@ -52,7 +54,13 @@ u8 ldreq_break;
 REQ q_ldreq[LDREQ_QUEUE_SIZE];
 u8 ldreq_result[LDREQ_TBL_SIZE];
 
-static AFSHandle afs_handle = AFS_NONE;
+// Load time of the current and the last completed queue run (a screen transition's worth of requests)
+static Uint64 ldreq_run_start = 0;
+static s32 ldreq_run_frames = 0;
+static s32 ldreq_run_count = 0;
+static f32 ldreq_last_ms = 0.0f;
+static s32 ldreq_last_frames = 0;
+static s32 ldreq_last_count = 0;
 
 // forward decls
 static s32 Push_LDREQ_Queue(REQ* ldreq);
@@ -67,26 +75,32 @@ s8* ldreq_process_name[];
 const LDREQ_TBL ldreq_tbl[LDREQ_TBL_SIZE];
 const s16 ldreq_ix[LDREQ_IX_SIZE][2];
 
-/** @brief Open an AFS file by request number. */
+/** @brief Open an AFS file by request number; each request reads through its own handle. */
 s32 fsOpen(REQ* req) {
     if (req->fnum >= AFS_GetFileCount()) {
         return 0;
     }
 
-    if (afs_handle != AFS_NONE) {
-        AFS_Close(afs_handle);
+    if (req->afs != AFS_NONE) {
+        AFS_Close(req->afs);
     }
 
-    afs_handle = AFS_Open(req->fnum);
+    req->afs = AFS_Open(req->fnum);
+
+    if (req->afs == AFS_NONE) {
+        return 0;
+    }
 
     req->info.number = 1;
     return 1;
 }
 
-/** @brief Close an AFS file (no-op on modern platform). */
-void fsClose(REQ* /* unused */) {
-    AFS_Close(afs_handle);
-    afs_handle = AFS_NONE;
+/** @brief Close a request's AFS file. */
+void fsClose(REQ* req) {
+    if (req->afs != AFS_NONE) {
+        AFS_Close(req->afs);
+        req->afs = AFS_NONE;
+    }
 }
 
 /** @brief Return the file size for the given AFS file number. */
@@ -103,46 +117,53 @@ u32 fsCalSectorSize(u32 size) {
     return (size + 2048 - 1) / 2048;
 }
 
-/** @brief Cancel a pending file request (stub). */
-static s32 fsCansel(REQ* /* unused */) {
-    if ((afs_handle != AFS_NONE) && (AFS_GetState(afs_handle) == AFS_READ_STATE_READING)) {
-        AFS_Stop(afs_handle);
+/** @brief Cancel a request's pending read and close its file. */
+static s32 fsCansel(REQ* req) {
+    if ((req->afs != AFS_NONE) && (AFS_GetState(req->afs) == AFS_READ_STATE_READING)) {
+        AFS_Stop(req->afs);
     }
 
+    fsClose(req);
     return 1;
 }
 
-/** @brief Check whether a file command is still executing. */
+/** @brief Check whether any queued request still has a file command executing. */
 s32 fsCheckCommandExecuting() {
-    if (afs_handle == AFS_NONE) {
-        return 0;
-    }
+    s16 i;
 
-    const AFSReadState state = AFS_GetState(afs_handle);
+    for (i = 0; i < LDREQ_QUEUE_SIZE; i++) {
+        if ((q_ldreq[i].be == 0) || (q_ldreq[i].afs == AFS_NONE)) {
+            continue;
+        }
 
-    switch (state) {
-    case AFS_READ_STATE_READING:
-    case AFS_READ_STATE_ERROR:
-        return 1;
+        const AFSReadState state = AFS_GetState(q_ldreq[i].afs);
 
-    case AFS_READ_STATE_IDLE:
-    case AFS_READ_STATE_FINISHED:
-        return 0;
+        switch (state) {
+        case AFS_READ_STATE_READING:
+        case AFS_READ_STATE_ERROR:
+            return 1;
 
-    default:
-        fatal_error("Unhandled AFS state: %d", state);
+        case AFS_READ_STATE_IDLE:
+        case AFS_READ_STATE_FINISHED:
+            break;
+
+        default:
+            fatal_error("Unhandled AFS state: %d", state);
+        }
     }
+
+    return 0;
 }
 
-/** @brief Issue an asynchronous file-read request. */
-s32 fsRequestFileRead(REQ* /* unused */, u32 sec, void* buff) {
-    AFS_Read(afs_handle, sec, buff);
+/** @brief Issue a file-read request; resident files are finished by the time this returns. */
+s32 fsRequestFileRead(REQ* req, u32 sec, void* buff) {
+    AFS_Read(req->afs, sec, buff);
     return 1;
 }
 
 /** @brief Check whether an asynchronous file read has completed. */
-s32 fsCheckFileReaded(REQ* /* unused */) {
-    const AFSReadState state = AFS_GetState(afs_handle);
+s32 fsCheckFileReaded(REQ* req) {
+    const AFSReadState state = AFS_GetState(req->afs);
 
     switch (state) {
     case AFS_READ_STATE_ERROR:
@@ -162,7 +183,7 @@ s32 fsCheckFileReaded(REQ* /* unused */) {
 
 /** @brief Synchronous file read — request and wait for completion. */
 s32 fsFileReadSync(REQ* req, u32 sec, void* buff) {
-    AFS_ReadSync(afs_handle, sec, buff);
+    AFS_ReadSync(req->afs, sec, buff);
     const s32 rnum = fsCheckFileReaded(req);
     return (rnum == 1) ? 1 : 0;
 }
@@ -221,6 +242,7 @@ s32 load_it_use_this_key(u16 fnum, s16 key) {
     u32 err;
 
     req.fnum = fnum;
+    req.afs = AFS_NONE;
 
     while (1) {
         err = fsOpen(&req);
@@ -391,10 +413,18 @@ static s32 Push_LDREQ_Queue(REQ* ldreq) {
     }
 
     if (i != LDREQ_QUEUE_SIZE) {
+        if (i == 0) {
+            ldreq_run_start = SDL_GetPerformanceCounter();
+            ldreq_run_frames = 0;
+            ldreq_run_count = 0;
+        }
+
         q_ldreq[i] = ldreq[0];
         q_ldreq[i].be = 2;
         q_ldreq[i].rno = 0;
         q_ldreq[i].retry = LDREQ_RETRY_COUNT;
+        q_ldreq[i].afs = AFS_NONE;
+        ldreq_run_count += 1;
 
         switch (ldreq->id) {
         case 0:
@@ -418,34 +448,57 @@ static s32 Push_LDREQ_Queue(REQ* ldreq) {
     return 0;
 }
 
-/** @brief Process pending load requests in FIFO order. */
+/**
+ * @brief Process pending load requests in FIFO order.
+ *
+ * Requests still run one after another, since each can depend on what the
+ * ones before it loaded (duplicate texture groups, ramcnt key order), but the
+ * queue keeps going within the frame for as long as the head finishes. Resident
+ * files complete on the spot, so a whole transition usually loads in one frame.
+ */
 void Check_LDREQ_Queue() {
     s16 i;
 
     disp_ldreq_status();
 
     if (!ldreq_break) {
-        if (q_ldreq->be != 0) {
+        if (q_ldreq->be == 0) {
+            return;
+        }
+
+        ldreq_run_frames += 1;
+
+        while (q_ldreq->be != 0) {
             if (q_ldreq->type < LDREQ_PROCESS_COUNT) {
                 ldreq_process[q_ldreq->type](q_ldreq);
             } else {
                 q_ldreq_error(q_ldreq);
             }
 
-            if (q_ldreq->be == 0) {
-                for (i = 0; i < LDREQ_QUEUE_SIZE - 1; i++) {
-                    q_ldreq[i] = q_ldreq[i + 1];
-                }
+            if (q_ldreq->be != 0) {
+                return;
+            }
 
-                q_ldreq[i].be = 0;
-                q_ldreq[i].type = 0;
+            for (i = 0; i < LDREQ_QUEUE_SIZE - 1; i++) {
+                q_ldreq[i] = q_ldreq[i + 1];
             }
 
-            return;
+            q_ldreq[i].be = 0;
+            q_ldreq[i].type = 0;
         }
+
+        // Queue drained: report how long this transition's loads took
+        const Uint64 ticks = SDL_GetPerformanceCounter() - ldreq_run_start;
+        ldreq_last_ms = (f32)(ticks * 1000.0 / SDL_GetPerformanceFrequency());
+        ldreq_last_frames = ldreq_run_frames;
+        ldreq_last_count = ldreq_run_count;
+        flLogOut(
+            "LDREQ: %d requests loaded in %d frames (%.2f ms)\n", ldreq_last_count, ldreq_last_frames, ldreq_last_ms);
     } else {
-        if (q_ldreq->be == 1) {
-            fsCansel(q_ldreq);
+        for (i = 0; i < LDREQ_QUEUE_SIZE; i++) {
+            if (q_ldreq[i].be != 0) {
+                fsCansel(&q_ldreq[i]);
+            }
         }
 
         Init_Load_Request_Queue_1st();
@@ -467,6 +520,7 @@ static void disp_ldreq_status() {
         }
 
         flPrintL(2, i + 18, "%4d", system_timer);
+        flPrintL(2, i + 19, "%2d REQ %3d F %6.2f MS", ldreq_last_count, ldreq_last_frames, ldreq_last_ms);
     }
 }
 
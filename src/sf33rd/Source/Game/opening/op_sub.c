@@ -114,5 +114,4 @@ void opbg_trans(OPBW* opbw, s16 x, s16 y) {
 void COLOR_COPYn(s16 dst, s16 colcd, s16 n) {
     s16* colram = (s16*)ColorRAM;
     palCopyGhostDC(dst * 16, n * 16, &colram[colcd * 16]);
-    palUpdateGhostDC();
 }
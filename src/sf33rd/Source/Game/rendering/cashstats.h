@@ -0,0 +1,33 @@
+/**
+ * @file cashstats.h
+ * @brief Sprite texture cache counters for the diagnostics overlay.
+ */
+
+#ifndef CASHSTATS_H
+#define CASHSTATS_H
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    u32 hits;    // Tiles found in the cache
+    u32 revived; // Freed tiles taken back without decoding
+    u32 misses;  // Tiles decoded
+    u32 bytes;   // Bytes decompressed, melts included
+    s32 scale;   // Cache pages per original page
+} TexcashStats;
+
+// Counts of the frame in progress
+extern TexcashStats texcash_stats;
+
+/// Counts of the last finished frame
+void texcash_get_frame_stats(TexcashStats* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
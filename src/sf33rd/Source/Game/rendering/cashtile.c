@@ -0,0 +1,100 @@
+/**
+ * @file cashtile.c
+ * Free tile choice and reuse for the texture cache
+ *
+ * A tile whose lifetime runs out is only marked free; its pixels stay in the
+ * texture page until the tile is handed out again. The cache used to hand out
+ * the first free tile it found, so a sprite that came back a few frames later
+ * was decompressed into a different tile while its old copy was often still
+ * intact. Here a freed tile remembers what it held: a miss on the same pattern
+ * takes that tile back without decoding, and new patterns go to the tile that
+ * has been free the longest. With no history (palette-baked caches, which have
+ * to pick up the current colours) the first free tile is used as before.
+ */
+
+#include "sf33rd/Source/Game/rendering/cashtile.h"
+
+/** @brief Drop the remembered contents of `count` tiles. */
+void cash_tile_forget(PatternHistory* hist, s32 count) {
+    s32 i;
+
+    if (hist == NULL) {
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        hist[i].cs.code = -1;
+        hist[i].state = 0;
+        hist[i].freed = 0;
+    }
+}
+
+/** @brief Free tile `ix`, remembering what it held. */
+void cash_tile_release(PatternState* mc, PatternHistory* hist, s32 ix, u32 tick) {
+    if (hist != NULL) {
+        hist[ix].cs = mc[ix].cs;
+        hist[ix].state = mc[ix].state;
+        hist[ix].freed = tick;
+    }
+
+    mc[ix].time = 0;
+    mc[ix].cs.code = -1;
+}
+
+static s32 still_holds(const PatternHistory* hist, u32 code, u32 palt) {
+    return (hist->cs.code == code) && (hist->state == palt);
+}
+
+/** @brief Pick the free tile of `mc` to load `code` into; sets `revive` if it still holds it. -1 if none is free. */
+s32 cash_tile_pick(const PatternState* mc, const PatternHistory* hist, s32 count, u32 code, u32 palt, s32* revive) {
+    s32 best = -1;
+    s32 i;
+
+    *revive = 0;
+
+    for (i = 0; i < count; i++) {
+        if (mc[i].cs.code != -1) {
+            continue;
+        }
+
+        if (hist == NULL) {
+            return i;
+        }
+
+        if (still_holds(&hist[i], code, palt)) {
+            *revive = 1;
+            return i;
+        }
+
+        if ((best < 0) || (hist[i].freed < hist[best].freed)) {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+/** @brief As cash_tile_pick over a free list popped from the end; returns a position in `list`. */
+s32 cash_tile_pick_free(const PatternHistory* hist, const u16* list, s32 count, u32 code, u32 palt, s32* revive) {
+    s32 best = -1;
+    s32 i;
+
+    *revive = 0;
+
+    if (hist == NULL) {
+        return count - 1;
+    }
+
+    for (i = count - 1; i >= 0; i--) {
+        if (still_holds(&hist[list[i]], code, palt)) {
+            *revive = 1;
+            return i;
+        }
+
+        if ((best < 0) || (hist[list[i]].freed < hist[list[best]].freed)) {
+            best = i;
+        }
+    }
+
+    return best;
+}
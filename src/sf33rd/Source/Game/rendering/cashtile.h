@@ -0,0 +1,17 @@
+/**
+ * @file cashtile.h
+ * @brief Free tile choice and reuse for the texture cache.
+ */
+
+#ifndef CASHTILE_H
+#define CASHTILE_H
+
+#include "structs.h"
+#include "types.h"
+
+void cash_tile_forget(PatternHistory* hist, s32 count);
+void cash_tile_release(PatternState* mc, PatternHistory* hist, s32 ix, u32 tick);
+s32 cash_tile_pick(const PatternState* mc, const PatternHistory* hist, s32 count, u32 code, u32 palt, s32* revive);
+s32 cash_tile_pick_free(const PatternHistory* hist, const u16* list, s32 count, u32 code, u32 palt, s32* revive);
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file cashwheel.c
+ * Timing wheel for texture cache lifetimes
+ *
+ * The texture cache used to count every entry's lifetime down once per frame.
+ * Here an entry is instead filed under the tick it runs out on, so each frame
+ * only visits the entries that actually expire. Setting an entry again moves
+ * it, exactly like reloading the old counter. Lifetimes longer than
+ * CASH_WHEEL_SIZE frames still work; such entries are passed over until the
+ * wheel comes round to their tick.
+ */
+
+#include "sf33rd/Source/Game/rendering/cashwheel.h"
+
+#define CASH_WHEEL_NIL 0xFFFF
+#define CASH_WHEEL_MASK (CASH_WHEEL_SIZE - 1)
+
+/** @brief Set up an empty wheel over `count` entries (at most 0xFFFF). */
+void cash_wheel_init(CashWheel* cw, CashWheelLink* link, s32 count) {
+    s32 i;
+
+    cw->tick = 0;
+    cw->count = count;
+    cw->link = link;
+
+    for (i = 0; i < CASH_WHEEL_SIZE; i++) {
+        cw->head[i] = CASH_WHEEL_NIL;
+    }
+
+    for (i = 0; i < count; i++) {
+        link[i].next = CASH_WHEEL_NIL;
+        link[i].prev = CASH_WHEEL_NIL;
+        link[i].due = 0;
+        link[i].be = 0;
+    }
+}
+
+/** @brief Take an entry out of its slot list. */
+static void unlink_entry(CashWheel* cw, s32 ix) {
+    CashWheelLink* lk = &cw->link[ix];
+
+    if (lk->prev != CASH_WHEEL_NIL) {
+        cw->link[lk->prev].next = lk->next;
+    } else {
+        cw->head[lk->due & CASH_WHEEL_MASK] = lk->next;
+    }
+
+    if (lk->next != CASH_WHEEL_NIL) {
+        cw->link[lk->next].prev = lk->prev;
+    }
+
+    lk->next = CASH_WHEEL_NIL;
+    lk->prev = CASH_WHEEL_NIL;
+    lk->be = 0;
+}
+
+/** @brief Expire entry `ix` `life` ticks from now, like loading a countdown; 0 keeps it forever. */
+void cash_wheel_set(CashWheel* cw, s32 ix, s32 life) {
+    CashWheelLink* lk = &cw->link[ix];
+    u16* head;
+
+    if (lk->be) {
+        unlink_entry(cw, ix);
+    }
+
+    if (life <= 0) {
+        return;
+    }
+
+    lk->due = cw->tick + life;
+    lk->be = 1;
+    head = &cw->head[lk->due & CASH_WHEEL_MASK];
+    lk->next = *head;
+
+    if (*head != CASH_WHEEL_NIL) {
+        cw->link[*head].prev = ix;
+    }
+
+    *head = ix;
+}
+
+/** @brief Move on by one frame; the entries due now come out of cash_wheel_pop. */
+void cash_wheel_advance(CashWheel* cw) {
+    cw->tick += 1;
+}
+
+/** @brief Remove and return the next entry expiring on this tick, or -1 when there are none left. */
+s32 cash_wheel_pop(CashWheel* cw) {
+    u16 due = cw->tick;
+    u16 ix = cw->head[due & CASH_WHEEL_MASK];
+
+    while (ix != CASH_WHEEL_NIL) {
+        if (cw->link[ix].due == due) {
+            unlink_entry(cw, ix);
+            return ix;
+        }
+
+        ix = cw->link[ix].next;
+    }
+
+    return -1;
+}
+
+/** @brief Ticks entry `ix` has left, matching what the old countdown would hold; 0 if it isn't set. */
+s32 cash_wheel_left(const CashWheel* cw, s32 ix) {
+    if (!cw->link[ix].be) {
+        return 0;
+    }
+
+    return (u16)(cw->link[ix].due - cw->tick);
+}
+
+/** @brief Debug walk of every slot list; returns 0 if the lists and entries agree. */
+s32 cash_wheel_check(const CashWheel* cw) {
+    const CashWheelLink* lk;
+    s32 listed = 0;
+    s32 set = 0;
+    s32 i;
+    u16 prev;
+    u16 ix;
+
+    for (i = 0; i < CASH_WHEEL_SIZE; i++) {
+        prev = CASH_WHEEL_NIL;
+
+        for (ix = cw->head[i]; ix != CASH_WHEEL_NIL; prev = ix, ix = lk->next) {
+            // A cycle would list more entries than there are
+            if ((ix >= cw->count) || (++listed > cw->count)) {
+                return 1;
+            }
+
+            lk = &cw->link[ix];
+
+            // Anything due on this tick should have been popped already
+            if (!lk->be || (lk->prev != prev) || ((lk->due & CASH_WHEEL_MASK) != i) || (lk->due == (u16)cw->tick)) {
+                return 1;
+            }
+        }
+    }
+
+    for (i = 0; i < cw->count; i++) {
+        set += cw->link[i].be;
+    }
+
+    return set != listed;
+}
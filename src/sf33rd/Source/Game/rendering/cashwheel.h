@@ -0,0 +1,19 @@
+/**
+ * @file cashwheel.h
+ * @brief Timing wheel for texture cache lifetimes.
+ */
+
+#ifndef CASHWHEEL_H
+#define CASHWHEEL_H
+
+#include "structs.h"
+#include "types.h"
+
+void cash_wheel_init(CashWheel* cw, CashWheelLink* link, s32 count);
+void cash_wheel_set(CashWheel* cw, s32 ix, s32 life);
+void cash_wheel_advance(CashWheel* cw);
+s32 cash_wheel_pop(CashWheel* cw);
+s32 cash_wheel_left(const CashWheel* cw, s32 ix);
+s32 cash_wheel_check(const CashWheel* cw);
+
+#endif
@@ -122,12 +122,17 @@ void q_ldreq_color_data(REQ* curr) {
             Push_ramcnt_key(curr->key);
             fsClose(curr);
             curr->rno = 0;
-        } else {
-            curr->rno = 4;
-            curr->be = 1;
+            break;
         }
-        break;
 
+        curr->rno = 4;
+        curr->be = 1;
+
+        // Resident files are already read; finish without waiting a frame
+        if (fsCheckFileReaded(curr) == 0) {
+            break;
+        }
+        /* fallthrough */
     case 4:
         switch (fsCheckFileReaded(curr)) {
         case 1:
@@ -202,9 +207,7 @@ void set_hitmark_color() {
     }
 
     palCopyGhostDC(64, 64, ColorRAM[15]);
-    palUpdateGhostDC();
     palCopyGhostDC(576, 64, ColorRAM[31]);
-    palUpdateGhostDC();
     palUpdateGhostCP3(7, 1);
     palUpdateGhostCP3(15, 1);
     palUpdateGhostCP3(23, 1);
@@ -448,20 +451,25 @@ void init_color_trans_req() {
 /** @brief Push a color transition request (from_col → to_col). */
 void push_color_trans_req(s16 from_col, s16 to_col) {
     palCopyGhostDC(to_col << 6, 64, ColorRAM[from_col]);
-    palUpdateGhostDC();
 }
 
-/** @brief Copy ghost palette data from DC (Dreamcast) format. */
+/** @brief Copy ghost palette data from DC (Dreamcast) format and mark the rows it touches dirty. */
 void palCopyGhostDC(s32 ofs, s32 cnt, void* data) {
     s32 i;
     u16* srcAdrs = data;
     u16* dstAdrs = &colPalBuffDC[ofs];
 
+    if (cnt <= 0) {
+        return;
+    }
+
     for (i = 0; i < cnt; i++) {
         *dstAdrs++ = *srcAdrs++;
     }
 
-    col3rd_w.upBits = col3rd_w.upBits | (1 << (ofs / 64));
+    for (i = ofs / 64; i <= (ofs + cnt - 1) / 64; i++) {
+        col3rd_w.upBits |= 1u << i;
+    }
 }
 
 /** @brief Convert a single palette color from source to RAM format. */
@@ -521,6 +529,11 @@ void palCreateGhost() {
     palFormRam.gm = 31;
     palFormConv = 1;
     col3rd_w.upBits = 0;
+
+    for (i = 0; i < 16; i++) {
+        col3rd_w.upBitsCP3[i] = 0;
+    }
+
     ppl.magic = 0;
     ppl.fileSize = 0;
     ppl.free = 0;
@@ -563,42 +576,59 @@ Palette* palGetChunkGhostCP3() {
     return &col3rd_w.palCP3;
 }
 
-/** @brief Update the DC ghost palette from ColorRAM. */
-void palUpdateGhostDC() {
-    plContext bits;
+/** @brief Mark CP3 ghost palette rows [pal, pal + nums) dirty; palFlushGhost converts them. */
+void palUpdateGhostCP3(s32 pal, s32 nums) {
     s32 i;
-    u16* srcAdrs;
-    u16* dstAdrs;
-
-    for (i = 0; i < col3rd_w.palDC.total; i++) {
-        if (col3rd_w.upBits & (1 << i)) {
-            flLockPalette(NULL, col3rd_w.palDC.handle[i], &bits, 2);
-            dstAdrs = bits.ptr;
-            srcAdrs = &colPalBuffDC[i << 6];
-            palConvRowTim2CI8Clut(srcAdrs, dstAdrs, 0x40);
-            flUnlockPalette(col3rd_w.palDC.handle[i]);
-        }
-    }
 
-    col3rd_w.upBits = 0;
+    for (i = pal; i < (pal + nums); i++) {
+        col3rd_w.upBitsCP3[i >> 5] |= 1u << (i & 31);
+    }
 }
 
-/** @brief Update CP3 ghost palette entries from ColorRAM. */
-void palUpdateGhostCP3(s32 pal, s32 nums) {
+/**
+ * @brief Convert the dirty rows of one ghost palette chunk and clear their bits.
+ *
+ * Rows whose handles are consecutive are locked and converted back to back
+ * and unlocked as one run, so the renderer sees a single update per run.
+ */
+static void palFlushRows(Palette* pal, u32* upBits, u16 (*rows)[64]) {
+    const s32 words = (pal->total + 31) / 32;
     plContext bits;
+    s32 first;
     s32 i;
-    u16* srcAdrs;
-    u16* dstAdrs;
+    s32 w;
 
-    for (i = pal; i < (pal + nums); i++) {
-        flLockPalette(NULL, col3rd_w.palCP3.handle[i], &bits, 2);
-        dstAdrs = bits.ptr;
-        srcAdrs = (u16*)&ColorRAM[i];
-        palConvRowTim2CI8Clut(srcAdrs, dstAdrs, 0x40);
-        flUnlockPalette(col3rd_w.palCP3.handle[i]);
+    if (!pal->be || (pal->handle == NULL)) {
+        for (w = 0; w < words; w++) {
+            upBits[w] = 0;
+        }
+
+        return;
+    }
+
+    for (w = 0; w < words; w++) {
+        while (upBits[w] != 0) {
+            i = first = (w << 5) + __builtin_ctz(upBits[w]);
+
+            do {
+                upBits[i >> 5] &= ~(1u << (i & 31));
+                flLockPalette(NULL, pal->handle[i], &bits, 2);
+                palConvRowTim2CI8Clut(rows[i], bits.ptr, 0x40);
+                i++;
+            } while ((i < pal->total) && (upBits[i >> 5] & (1u << (i & 31))) &&
+                     (pal->handle[i] == (pal->handle[i - 1] + 1)));
+
+            flUnlockPalettes(pal->handle[first], i - first);
+        }
     }
 }
 
+/** @brief Convert every dirty ghost palette row and hand the renderer the changed palettes. */
+void palFlushGhost() {
+    palFlushRows(&col3rd_w.palDC, &col3rd_w.upBits, (u16(*)[64])colPalBuffDC);
+    palFlushRows(&col3rd_w.palCP3, col3rd_w.upBitsCP3, ColorRAM);
+}
+
 /** @brief Convert a TIM2 CI8 CLUT row from source to destination format. */
 void palConvRowTim2CI8Clut(u16* src, u16* dst, s32 size) {
     s32 i;
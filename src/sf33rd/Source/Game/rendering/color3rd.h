@@ -23,8 +23,8 @@ u16 palConvSrcToRam(u16 col);
 void palCreateGhost();
 Palette* palGetChunkGhostDC();
 Palette* palGetChunkGhostCP3();
-void palUpdateGhostDC();
 void palUpdateGhostCP3(s32 pal, s32 nums);
+void palFlushGhost();
 void palConvRowTim2CI8Clut(u16* src, u16* dst, s32 size);
 
 #endif
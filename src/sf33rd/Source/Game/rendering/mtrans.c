@@ -14,6 +14,9 @@
 #include "sf33rd/Source/Game/debug/Debug.h"
 #include "sf33rd/Source/Game/effect/effect.h"
 #include "sf33rd/Source/Game/rendering/aboutspr.h"
+#include "sf33rd/Source/Game/rendering/cashstats.h"
+#include "sf33rd/Source/Game/rendering/cashtile.h"
+#include "sf33rd/Source/Game/rendering/cashwheel.h"
 #include "sf33rd/Source/Game/rendering/chren3rd.h"
 #include "sf33rd/Source/Game/rendering/color3rd.h"
 #include "sf33rd/Source/Game/rendering/texcash.h"
@@ -115,6 +118,7 @@ static s32 seqsStoreChip(f32 x, f32 y, s32 w, s32 h, s32 gix, s32 code, s32 attr
 static void appRenewTempPriority(s32 z);
 static s16 check_patcash_ex_trans(PatternCollection* padr, u32 cg);
 static s32 get_free_patcash_index(PatternCollection* padr);
+static void keep_patcash(MultiTexture* mt, PatternInstance* cp);
 static s32 get_mltbuf16(MultiTexture* mt, u32 code, u32 palt, s32* ret);
 
 static s32 get_mltbuf16_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, PatternInstance* cp);
@@ -468,7 +472,7 @@ void mlt_obj_trans_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
             mt->cpat->adr[mt->cpat->kazu] = cp;
             mt->cpat->kazu += 1;
             cp->curr_disp = 1;
-            cp->time = mt->mltcshtime16;
+            keep_patcash(mt, cp);
             cp->cg.code = cc.code;
             cp->x16 = 0;
             cp->x32 = 0;
@@ -565,7 +569,7 @@ void mlt_obj_trans_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
 
         cp = mt->cpat->adr[ix];
         cp->curr_disp = 1;
-        cp->time = mt->mltcshtime16;
+        keep_patcash(mt, cp);
         cc.parts.group = i;
 
         while (count--) {
@@ -853,7 +857,7 @@ void mlt_obj_trans_cp3_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
             mt->cpat->adr[mt->cpat->kazu] = cp;
             mt->cpat->kazu += 1;
             cp->curr_disp = 1;
-            cp->time = mt->mltcshtime16;
+            keep_patcash(mt, cp);
             cp->cg.code = cc.code;
             cp->x16 = 0;
             cp->x32 = 0;
@@ -956,7 +960,7 @@ void mlt_obj_trans_cp3_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
 
         cp = mt->cpat->adr[ix];
         cp->curr_disp = 1;
-        cp->time = mt->mltcshtime16;
+        keep_patcash(mt, cp);
         // makeup_tpu_free(mt->mltnum16 / 256, mt->mltnum32 / 64, &cp->map);
         cc.parts.group = i;
 
@@ -1252,7 +1256,7 @@ void mlt_obj_trans_rgb_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
             mt->cpat->adr[mt->cpat->kazu] = cp;
             mt->cpat->kazu += 1;
             cp->curr_disp = 1;
-            cp->time = mt->mltcshtime16;
+            keep_patcash(mt, cp);
             cp->cg.code = cc.code;
             cp->x16 = 0;
             cp->x32 = 0;
@@ -1344,7 +1348,7 @@ void mlt_obj_trans_rgb_ext(MultiTexture* mt, WORK* wk, s32 base_y) {
 
         cp = mt->cpat->adr[ix];
         cp->curr_disp = 1;
-        cp->time = mt->mltcshtime16;
+        keep_patcash(mt, cp);
         // makeup_tpu_free(mt->mltnum16 / 256, mt->mltnum32 / 64, &cp->map);
         cc.parts.group = i;
 
@@ -1633,6 +1637,11 @@ void seqsAfterProcess() {
     u32 keep = 0;
     u32 val = 0;
 
+    // Palette rows changed this frame reach the renderer before the sprites that use them
+    if (!No_Trans) {
+        palFlushGhost();
+    }
+
     if ((Debug_w[DEBUG_NO_DISP_TYPE_SB] != 3) && (seqs_w.sprTotal != 0)) {
         for (i = 0; i < SPRITE_LAYERS_MAX; i++) {
             if (seqs_w.up[i]) {
@@ -1729,88 +1738,86 @@ static s32 seqsStoreChip(f32 x, f32 y, s32 w, s32 h, s32 gix, s32 code, s32 attr
     return 1;
 }
 
-/** @brief Look up or allocate a 16×16 tile buffer slot. */
+/** @brief Look up or allocate a 16×16 tile buffer slot; returns 1 if the tile has to be decoded. */
 static s32 get_mltbuf16(MultiTexture* mt, u32 code, u32 palt, s32* ret) {
-    s32 i;
-    s32 b = -1;
     PatternState* mc = mt->mltcsh16;
+    s32 revive;
+    s32 i;
 
-    i = mt->mltnum16;
-
-    while (1) {
-        if ((mc->cs.code == code) && (mc->state == palt)) {
-            mc->time = mt->mltcshtime16;
-            *ret = mt->mltnum16 - i;
+    for (i = 0; i < mt->mltnum16; i++) {
+        if ((mc[i].cs.code == code) && (mc[i].state == palt)) {
+            mc[i].time = mt->mltcshtime16;
+            cash_wheel_set(&mt->wheel, i, mt->mltcshtime16);
+            texcash_stats.hits += 1;
+            *ret = i;
             return 0;
         }
+    }
 
-        if ((mc->cs.code == -1) && (b < 0)) {
-            b = i;
-        }
+    if ((i = cash_tile_pick(mc, mt->mltold16, mt->mltnum16, code, palt, &revive)) < 0) {
+        // CG cache is full. 16x16: %d\n
+        flLogOut("ＣＧキャッシュが一杯になりました。１６×１６ : %d\n", mt->id);
+        return 0;
+    }
 
-        mc++;
-        i -= 1;
-
-        if (i <= 0) {
-            if (b >= 0) {
-                b = mt->mltnum16 - b;
-                mt->mltcsh16[b].time = mt->mltcshtime16;
-                mt->mltcsh16[b].state = palt;
-                mt->mltcsh16[b].cs.code = code;
-                *ret = b;
-                return 1;
-            }
+    mc[i].time = mt->mltcshtime16;
+    mc[i].state = palt;
+    mc[i].cs.code = code;
+    cash_wheel_set(&mt->wheel, i, mt->mltcshtime16);
+    *ret = i;
 
-            // CG cache is full. 16x16: %d\n
-            flLogOut("ＣＧキャッシュが一杯になりました。１６×１６ : %d\n", mt->id);
-            return 0;
-        }
+    if (revive) {
+        texcash_stats.revived += 1;
+        return 0;
     }
+
+    texcash_stats.misses += 1;
+    return 1;
 }
 
-/** @brief Look up or allocate a 32×32 tile buffer slot. */
+/** @brief Look up or allocate a 32×32 tile buffer slot; returns 1 if the tile has to be decoded. */
 static s32 get_mltbuf32(MultiTexture* mt, u32 code, u32 palt, s32* ret) {
-    s32 i;
-    s32 b = -1;
     PatternState* mc = mt->mltcsh32;
+    s32 revive;
+    s32 i;
 
-    i = mt->mltnum32;
-
-    while (1) {
-        if ((mc->cs.code == code) && (mc->state == palt)) {
-            mc->time = mt->mltcshtime32;
-            *ret = mt->mltnum32 - i;
+    for (i = 0; i < mt->mltnum32; i++) {
+        if ((mc[i].cs.code == code) && (mc[i].state == palt)) {
+            mc[i].time = mt->mltcshtime32;
+            cash_wheel_set(&mt->wheel, mt->mltnum16 + i, mt->mltcshtime32);
+            texcash_stats.hits += 1;
+            *ret = i;
             return 0;
         }
+    }
 
-        if ((mc->cs.code == -1) && (b < 0)) {
-            b = i;
-        }
+    if ((i = cash_tile_pick(mc, mt->mltold32, mt->mltnum32, code, palt, &revive)) < 0) {
+        // CG cache is full. 32x32 : %d\n
+        flLogOut("ＣＧキャッシュが一杯になりました。３２×３２ : %d\n", mt->id);
+        return 0;
+    }
 
-        mc++;
-        i -= 1;
-
-        if (i <= 0) {
-            if (b >= 0) {
-                b = mt->mltnum32 - b;
-                mt->mltcsh32[b].time = mt->mltcshtime32;
-                mt->mltcsh32[b].state = palt;
-                mt->mltcsh32[b].cs.code = code;
-                *ret = b;
-                return 1;
-            }
+    mc[i].time = mt->mltcshtime32;
+    mc[i].state = palt;
+    mc[i].cs.code = code;
+    cash_wheel_set(&mt->wheel, mt->mltnum16 + i, mt->mltcshtime32);
+    *ret = i;
 
-            // CG cache is full. 32x32 : %d\n
-            flLogOut("ＣＧキャッシュが一杯になりました。３２×３２ : %d\n", mt->id);
-            return 0;
-        }
+    if (revive) {
+        texcash_stats.revived += 1;
+        return 0;
     }
+
+    texcash_stats.misses += 1;
+    return 1;
 }
 
 /** @brief Look up or allocate a 16×16 tile buffer slot (extended, with cache). */
 static s32 get_mltbuf16_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, PatternInstance* cp) {
     PatternState* mc = mt->mltcsh16;
+    s32 revive;
     s32 i;
+    s32 n;
 
     for (i = 0; i < mt->tpu->x16; i++) {
         if ((code == mc[mt->tpu->x16_used[i]].cs.code) && (palt == mc[mt->tpu->x16_used[i]].state)) {
@@ -1821,13 +1828,16 @@ static s32 get_mltbuf16_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, Pa
                 mc[mt->tpu->x16_used[i]].time += 1;
             }
 
+            texcash_stats.hits += 1;
             return 0;
         }
     }
 
     if ((i != mt->mltnum16) && (mt->tpf->x16 != 0)) {
+        n = cash_tile_pick_free(mt->mltold16, mt->tpf->x16_free, mt->tpf->x16, code, palt, &revive);
         mt->tpf->x16 -= 1;
-        mt->tpu->x16_used[i] = mt->tpf->x16_free[mt->tpf->x16];
+        mt->tpu->x16_used[i] = mt->tpf->x16_free[n];
+        mt->tpf->x16_free[n] = mt->tpf->x16_free[mt->tpf->x16];
         mt->tpu->x16 += 1;
         mc[mt->tpu->x16_used[i]].cs.code = code;
         mc[mt->tpu->x16_used[i]].state = palt;
@@ -1838,6 +1848,12 @@ static s32 get_mltbuf16_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, Pa
             cp->x16 += 1;
         }
 
+        if (revive) {
+            texcash_stats.revived += 1;
+            return 0;
+        }
+
+        texcash_stats.misses += 1;
         return 1;
     }
 
@@ -1849,7 +1865,9 @@ static s32 get_mltbuf16_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, Pa
 /** @brief Look up or allocate a 32×32 tile buffer slot (extended, with cache). */
 static s32 get_mltbuf32_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, PatternInstance* cp) {
     PatternState* mc = mt->mltcsh32;
+    s32 revive;
     s32 i;
+    s32 n;
 
     for (i = 0; i < mt->tpu->x32; i++) {
         if ((code == mc[mt->tpu->x32_used[i]].cs.code) && (palt == mc[mt->tpu->x32_used[i]].state)) {
@@ -1860,13 +1878,16 @@ static s32 get_mltbuf32_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, Pa
                 mc[mt->tpu->x32_used[i]].time += 1;
             }
 
+            texcash_stats.hits += 1;
             return 0;
         }
     }
 
     if ((i != mt->mltnum32) && (mt->tpf->x32 != 0)) {
+        n = cash_tile_pick_free(mt->mltold32, mt->tpf->x32_free, mt->tpf->x32, code, palt, &revive);
         mt->tpf->x32 -= 1;
-        mt->tpu->x32_used[i] = mt->tpf->x32_free[mt->tpf->x32];
+        mt->tpu->x32_used[i] = mt->tpf->x32_free[n];
+        mt->tpf->x32_free[n] = mt->tpf->x32_free[mt->tpf->x32];
         mt->tpu->x32 += 1;
         mc[mt->tpu->x32_used[i]].cs.code = code;
         mc[mt->tpu->x32_used[i]].state = palt;
@@ -1877,6 +1898,12 @@ static s32 get_mltbuf32_ext_2(MultiTexture* mt, u32 code, u32 palt, s32* ret, Pa
             cp->x32 += 1;
         }
 
+        if (revive) {
+            texcash_stats.revived += 1;
+            return 0;
+        }
+
+        texcash_stats.misses += 1;
         return 1;
     }
 
@@ -1979,6 +2006,12 @@ static s32 get_free_patcash_index(PatternCollection* padr) {
     return 0x3F;
 }
 
+/** @brief Restart a pattern's cache lifetime; the wheel releases it when it runs out. */
+static void keep_patcash(MultiTexture* mt, PatternInstance* cp) {
+    cp->time = mt->mltcshtime16;
+    cash_wheel_set(&mt->wheel, cp - mt->cpat->patt, mt->mltcshtime16);
+}
+
 /** @brief Decompress LZ-compressed 4bpp fixed-palette texture data. */
 static void lz_ext_p6_fx(u8* srcptr, u8* dstptr, u32 len) {
     u8* endptr = dstptr + len;
@@ -1986,6 +2019,8 @@ static void lz_ext_p6_fx(u8* srcptr, u8* dstptr, u32 len) {
     u32 tmp;
     u32 flg;
 
+    texcash_stats.bytes += len;
+
     while (dstptr < endptr) {
         tmp = *srcptr++;
 
@@ -2037,6 +2072,8 @@ static void lz_ext_p6_cx(u8* srcptr, u16* dstptr, u32 len, u16* palptr) {
     u32 tmp;
     u32 flg;
 
+    texcash_stats.bytes += len * 2;
+
     while (dstptr < endptr) {
         tmp = *srcptr++;
 
@@ -2132,27 +2169,17 @@ void mlt_obj_trans_init(MultiTexture* mt, s32 mode, u8* adrs) {
     }
 }
 
-/** @brief Update texture cache lifetimes for this multi-texture object. */
+/** @brief Free the tiles of this multi-texture object whose cache lifetime ran out this frame. */
 void mlt_obj_trans_update(MultiTexture* mt) {
-    s32 i;
-    PatternState* mc;
+    s32 ix;
 
-    PatternState* assign1;
-    PatternState* assign2;
+    cash_wheel_advance(&mt->wheel);
 
-    for (mc = mt->mltcsh16, i = 0; i < mt->mltnum16; i++, mc += 1, assign1 = mc) {
-        if (mc->time) {
-            if (--mc->time == 0) {
-                mc->cs.code = -1;
-            }
-        }
-    }
-
-    for (mc = mt->mltcsh32, i = 0; i < mt->mltnum32; i++, mc += 1, assign2 = mc) {
-        if (mc->time) {
-            if (--mc->time == 0) {
-                mc->cs.code = -1U;
-            }
+    while ((ix = cash_wheel_pop(&mt->wheel)) >= 0) {
+        if (ix < mt->mltnum16) {
+            cash_tile_release(mt->mltcsh16, mt->mltold16, ix, mt->wheel.tick);
+        } else {
+            cash_tile_release(mt->mltcsh32, mt->mltold32, ix - mt->mltnum16, mt->wheel.tick);
         }
     }
 }
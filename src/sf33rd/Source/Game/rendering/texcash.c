@@ -5,11 +5,16 @@
 
 #include "sf33rd/Source/Game/rendering/texcash.h"
 #include "common.h"
+#include "port/config.h"
 #include "sf33rd/AcrSDK/ps2/flps2debug.h"
+#include "sf33rd/AcrSDK/ps2/foundaps2.h"
 #include "sf33rd/Source/Common/PPGFile.h"
 #include "sf33rd/Source/Game/debug/Debug.h"
 #include "sf33rd/Source/Game/effect/effect.h"
 #include "sf33rd/Source/Game/rendering/aboutspr.h"
+#include "sf33rd/Source/Game/rendering/cashstats.h"
+#include "sf33rd/Source/Game/rendering/cashtile.h"
+#include "sf33rd/Source/Game/rendering/cashwheel.h"
 #include "sf33rd/Source/Game/rendering/mtrans.h"
 #include "sf33rd/Source/Game/stage/bg.h"
 #include "sf33rd/Source/Game/system/ramcnt.h"
@@ -61,15 +66,25 @@ s8* texcash_name[29] = { "    16x16 (tm)  32x32 (tm) GIX      (mn.nw)",
                          "--",
                          "--.--" };
 
+#define TEXCASH_SCALE_MAX 4
+
 // sbss
 u8* texcash_melt_buffer;
 TexturePoolUsed* tpu_free;
 s16 mts_ob_curr_stage;
+static char texcash_error[48];
+
+TexcashStats texcash_stats;
+static TexcashStats texcash_frame_stats;
+static SDL_SpinLock texcash_frame_stats_lock = 0; // Logic publishes, overlays read from the main thread
 
 // forward decls
 extern const s16 mts_OB_page[22][2];
 extern const MTSBase mts_base[24];
 static void clear_texcash_work(s16 ix);
+static void report_texcash_error(const char* format, ...);
+static void check_texcash_work(s16 ix);
+static s32 texcash_page_scale(s16 ix);
 
 /** @brief Display debug info about free texture cache areas. */
 void disp_texcash_free_area() {
@@ -85,6 +100,11 @@ void disp_texcash_free_area() {
             }
         }
 
+        if (texcash_error[0] != '\0') {
+            flPrintColor(0xFFFF8F8F);
+            flPrintL(2, 3, "%s", texcash_error);
+        }
+
         flPrintColor(0xFFCFCFCF);
         for (i = 1; i < 24; i++) {
             if (mts_ok[i].be) {
@@ -180,6 +200,8 @@ void init_texcash_1st() {
         mts_ok[i].key0 = 0;
         mts_ok[i].key1 = 0;
         mts[i].mode = -1;
+        SDL_free(mts[i].hostmem);
+        mts[i].hostmem = NULL;
     }
 }
 
@@ -245,28 +267,25 @@ void init_texcash_2nd(s16 ix) {
 
 /** @brief Update texture cache lifetimes and purge expired entries. */
 void texture_cash_update() {
-    s16 i;
+    PatternInstance* cp;
+    s32 i;
     s16 num;
 
     for (num = 0; num < 24; num++) {
         if (mts_ok[num].be != 0) {
             if (mts[num].ext) {
-                for (i = 0; i < mts[num].cpat->kazu; i++) {
-                    if ((--mts[num].cpat->adr[i]->time) == 0) {
-                        makeup_tpu_free(mts[num].mltnum16 / 256, mts[num].mltnum32 / 64, &mts[num].cpat->adr[i]->map);
-
-                        if ((tpu_free->x16 != mts[num].cpat->adr[i]->x16) ||
-                            (tpu_free->x32 != mts[num].cpat->adr[i]->x32)) {
-                            Debug_w[DEBUG_TEX_CASH_FREE] = 1;
-                            do {
-                                disp_texcash_free_area();
-                                flPrintL(2, 3, "MAPPING MISS : %2d : &2d", num, i);
-                                njWaitVSync_with_N();
-                            } while (1);
-                        }
-
-                        update_with_tpu_free(mts[num].mltcsh16, mts[num].mltcsh32);
+                cash_wheel_advance(&mts[num].wheel);
+
+                while ((i = cash_wheel_pop(&mts[num].wheel)) >= 0) {
+                    cp = &mts[num].cpat->patt[i];
+                    cp->time = 0;
+                    makeup_tpu_free(mts[num].mltnum16 / 256, mts[num].mltnum32 / 64, &cp->map);
+
+                    if ((tpu_free->x16 != cp->x16) || (tpu_free->x32 != cp->x32)) {
+                        report_texcash_error("MAPPING MISS : %2d : %2d", num, i);
                     }
+
+                    update_with_tpu_free(&mts[num]);
                 }
             } else {
                 if ((mts[num].mltcshtime16 + mts[num].mltcshtime32) != 0) {
@@ -276,45 +295,128 @@ void texture_cash_update() {
 
             if (Debug_w[DEBUG_TEX_CASH_FREE]) {
                 search_texcash_free_area(num);
+                check_texcash_work(num);
             }
         }
     }
     disp_texcash_free_area();
+
+    SDL_LockSpinlock(&texcash_frame_stats_lock);
+    texcash_frame_stats = texcash_stats;
+    SDL_UnlockSpinlock(&texcash_frame_stats_lock);
+    SDL_zero(texcash_stats);
+}
+
+/** @brief Fill in the sprite cache counters of the last finished frame. */
+void texcash_get_frame_stats(TexcashStats* out) {
+    SDL_LockSpinlock(&texcash_frame_stats_lock);
+    *out = texcash_frame_stats;
+    SDL_UnlockSpinlock(&texcash_frame_stats_lock);
+    out->scale = SDL_clamp(Config_GetInt(CFG_KEY_SPRITE_CACHE_SCALE), 1, TEXCASH_SCALE_MAX);
 }
 
-/** @brief Update pattern states using the free texture pool. */
-void update_with_tpu_free(PatternState* mc16, PatternState* mc32) {
+/** @brief Release the tiles of an expired pattern; tiles no live pattern maps any more are freed. */
+void update_with_tpu_free(MultiTexture* mt) {
+    PatternState* mc16 = mt->mltcsh16;
+    PatternState* mc32 = mt->mltcsh32;
     s16 i;
 
     for (i = 0; i < tpu_free->x16; i++) {
         mc16[tpu_free->x16_used[i]].time -= 1;
         if (mc16[tpu_free->x16_used[i]].time < 0) {
-            Debug_w[DEBUG_TEX_CASH_FREE] = 1;
-            do {
-                disp_texcash_free_area();
-                flPrintL(2, 3, "CACHE MISS x16 : %3d", tpu_free->x16_used[i]);
-                njWaitVSync_with_N();
-            } while (1);
+            report_texcash_error("CACHE MISS x16 : %3d", tpu_free->x16_used[i]);
+            mc16[tpu_free->x16_used[i]].time = 0;
         }
 
         if (mc16[tpu_free->x16_used[i]].time <= 0) {
-            mc16[tpu_free->x16_used[i]].cs.code = -1;
+            cash_tile_release(mc16, mt->mltold16, tpu_free->x16_used[i], mt->wheel.tick);
         }
     }
 
     for (i = 0; i < tpu_free->x32; i++) {
         mc32[tpu_free->x32_used[i]].time -= 1;
         if (mc32[tpu_free->x32_used[i]].time < 0) {
-            Debug_w[DEBUG_TEX_CASH_FREE] = 1;
-            do {
-                disp_texcash_free_area();
-                flPrintL(2, 3, "CACHE MISS x32 : %3d", tpu_free->x32_used[i]);
-                njWaitVSync_with_N();
-            } while (1);
+            report_texcash_error("CACHE MISS x32 : %3d", tpu_free->x32_used[i]);
+            mc32[tpu_free->x32_used[i]].time = 0;
         }
 
         if (mc32[tpu_free->x32_used[i]].time <= 0) {
-            mc32[tpu_free->x32_used[i]].cs.code = -1;
+            cash_tile_release(mc32, mt->mltold32, tpu_free->x32_used[i], mt->wheel.tick);
+        }
+    }
+}
+
+/** @brief Log a texture cache inconsistency and bring up the free area display showing it. */
+static void report_texcash_error(const char* format, ...) {
+    va_list args;
+
+    va_start(args, format);
+    SDL_vsnprintf(texcash_error, sizeof(texcash_error), format, args);
+    va_end(args);
+    flLogOut("TEXCASH: %s\n", texcash_error);
+    Debug_w[DEBUG_TEX_CASH_FREE] = 1;
+}
+
+/** @brief Debug check that a cache work entry's lifetimes and tile references agree with its wheel. */
+static void check_texcash_work(s16 ix) {
+    MultiTexture* mt = &mts[ix];
+    PatternInstance* cp;
+    s32 i;
+    s32 j;
+    s16 refs;
+
+    if (cash_wheel_check(&mt->wheel)) {
+        report_texcash_error("WHEEL MISS : %2d", ix);
+        return;
+    }
+
+    if (!mt->ext) {
+        // Pre-melted textures (mode 0x20) never go through the tile cache
+        if (((mt->mltcshtime16 + mt->mltcshtime32) == 0) || (mts_base[ix].mode & 0x20)) {
+            return;
+        }
+
+        for (i = 0; i < mt->mltnum16 + mt->mltnum32; i++) {
+            const PatternState* mc = (i < mt->mltnum16) ? &mt->mltcsh16[i] : &mt->mltcsh32[i - mt->mltnum16];
+
+            if ((mc->time != 0) != (cash_wheel_left(&mt->wheel, i) != 0)) {
+                report_texcash_error("LIFE MISS : %2d : %4d", ix, i);
+                return;
+            }
+        }
+
+        return;
+    }
+
+    for (i = 0; i < 0x40; i++) {
+        if ((mt->cpat->patt[i].time != 0) != (cash_wheel_left(&mt->wheel, i) != 0)) {
+            report_texcash_error("LIFE MISS : %2d : %4d", ix, i);
+            return;
+        }
+    }
+
+    // Each cached tile's time counts the live patterns that map it
+    for (i = 0; i < mt->mltnum16; i++) {
+        for (refs = 0, j = 0; j < 0x40; j++) {
+            cp = &mt->cpat->patt[j];
+            refs += (cp->time != 0) && (cp->map.x16_map[i / 256][(i % 256) / 16] & (1 << (i & 15)));
+        }
+
+        if ((mt->mltcsh16[i].cs.code != -1) && (mt->mltcsh16[i].time != refs)) {
+            report_texcash_error("CACHE MISS x16 : %3d", i);
+            return;
+        }
+    }
+
+    for (i = 0; i < mt->mltnum32; i++) {
+        for (refs = 0, j = 0; j < 0x40; j++) {
+            cp = &mt->cpat->patt[j];
+            refs += (cp->time != 0) && (cp->map.x32_map[i / 64][(i % 64) / 8] & (1 << (i & 7)));
+        }
+
+        if ((mt->mltcsh32[i].cs.code != -1) && (mt->mltcsh32[i].time != refs)) {
+            report_texcash_error("CACHE MISS x32 : %3d", i);
+            return;
         }
     }
 }
@@ -328,15 +430,58 @@ s16 get_my_trans_mode(s16 curr) {
     return mts[curr].mode;
 }
 
+/** @brief Pages per original page for cache slot `ix`, from the sprite cache scale setting. */
+static s32 texcash_page_scale(s16 ix) {
+    // Pre-melted textures (mode 0x20) are filled page by page up front
+    if (mts_base[ix].mode & 0x20) {
+        return 1;
+    }
+
+    return SDL_clamp(Config_GetInt(CFG_KEY_SPRITE_CACHE_SCALE), 1, TEXCASH_SCALE_MAX);
+}
+
+/** @brief Set the tile counts and page indices of cache slot `ix`. */
+static void set_texcash_pages(s16 ix, u32 page16, u32 page32) {
+    mts[ix].mltnum16 = page16 << 8;
+    mts[ix].mltnum32 = page32 << 6;
+    mts[ix].mltnum = page16 + page32;
+    mts[ix].mltgidx16 = mts_base[ix].gix;
+    mts[ix].mltgidx32 = page16 + mts_base[ix].gix;
+}
+
+/** @brief Bytes of tile states, pattern pools and wheel links for cache slot `ix`. */
+static size_t texcash_work_size(s16 ix) {
+    if (mts[ix].ext) {
+        return (mts[ix].mltnum16 * 8) + (mts[ix].mltnum32 * 8) + sizeof(PatternCollection) + sizeof(TexturePoolFree) +
+               sizeof(TexturePoolUsed) + (0x40 * sizeof(CashWheelLink));
+    }
+
+    return (mts[ix].mltnum16 * 8) + (mts[ix].mltnum32 * 8) +
+           ((mts[ix].mltnum16 + mts[ix].mltnum32) * sizeof(CashWheelLink));
+}
+
+/** @brief Bytes of tile history for cache slot `ix`; palette-baked and pre-melted textures keep none. */
+static size_t texcash_history_size(s16 ix) {
+    if ((mts_base[ix].mode & 0x20) || ((mts_base[ix].mode & 7) == 4)) {
+        return 0;
+    }
+
+    return (mts[ix].mltnum16 + mts[ix].mltnum32) * sizeof(PatternHistory);
+}
+
+/** @brief Bytes of texture pages for cache slot `ix`. */
+static size_t texcash_page_size(s16 ix) {
+    return (((mts_base[ix].mode & 4) != 0) + 1) * ((size_t)mts[ix].mltnum << 0x10);
+}
+
 /** @brief Allocate and initialize a texture cache work entry. */
 void make_texcash_work(s16 ix) {
-    size_t memreq;
+    PatternHistory* hist;
     u8* adrs;
-    // For some reason page16 is reused later as a pointer.
-    // That's why it's uintptr_t and not u32 like page32.
-    // I guess the devs were too lazy to make another var or something.
-    uintptr_t page16;
+    u8* texadrs;
+    u32 page16;
     u32 page32;
+    s32 scale;
 
     if (mts_ok[ix].be) {
         if ((Test_ramcnt_key(mts_ok[ix].key0) != 0) && (Test_ramcnt_key(mts_ok[ix].key1) != 0)) {
@@ -363,19 +508,52 @@ void make_texcash_work(s16 ix) {
             page32 = mts_base[ix].p32;
         }
 
-        mts[ix].mltnum16 = (u32)page16 << 8;
-        mts[ix].mltnum32 = page32 << 6;
-        mts[ix].mltnum = (u32)page16 + page32;
-        mts[ix].mltgidx16 = mts_base[ix].gix;
-        mts[ix].mltgidx32 = (u32)page16 + mts_base[ix].gix;
+        mts[ix].ext = ((mts_base[ix].mode & 0x2000) != 0);
         mts[ix].mltcshtime16 = mts_base[ix].life16;
         mts[ix].mltcshtime32 = mts_base[ix].life32;
 
-        if ((mts[ix].ext = ((mts_base[ix].mode & 0x2000) != 0))) {
-            memreq = (mts[ix].mltnum16 * 8) + (mts[ix].mltnum32 * 8) + sizeof(PatternCollection) +
-                     sizeof(TexturePoolFree) + sizeof(TexturePoolUsed);
-            mts_ok[ix].key0 = Pull_ramcnt_key(memreq, mts_base[ix].type, 0, 0);
-            adrs = (u8*)Get_ramcnt_address(mts_ok[ix].key0);
+        // The ramcnt heap is laid out as on the original hardware whatever the cache size,
+        // so a scaled cache and the tile history live in host memory
+        set_texcash_pages(ix, page16, page32);
+        mts_ok[ix].key0 = Pull_ramcnt_key(texcash_work_size(ix), mts_base[ix].type, 0, 0);
+        mts_ok[ix].key1 = Pull_ramcnt_key(texcash_page_size(ix), mts_base[ix].type, 0, 0);
+        adrs = (u8*)Get_ramcnt_address(mts_ok[ix].key0);
+        texadrs = (u8*)Get_ramcnt_address(mts_ok[ix].key1);
+        mts[ix].hostmem = NULL;
+        hist = NULL;
+
+        if ((scale = texcash_page_scale(ix)) > 1) {
+            if (mts[ix].ext) {
+                // Pattern maps only reach 4 pages of 16x16 and 10 of 32x32 tiles
+                set_texcash_pages(ix, SDL_max(page16, SDL_min(page16 * scale, 4)),
+                                  SDL_max(page32, SDL_min(page32 * scale, 10)));
+            } else {
+                set_texcash_pages(ix, page16 * scale, page32 * scale);
+            }
+
+            mts[ix].hostmem = SDL_malloc(texcash_work_size(ix) + texcash_history_size(ix) + texcash_page_size(ix));
+
+            if (mts[ix].hostmem != NULL) {
+                adrs = mts[ix].hostmem;
+                hist = (PatternHistory*)(adrs + texcash_work_size(ix));
+                texadrs = (u8*)hist + texcash_history_size(ix);
+
+                if (texcash_history_size(ix) == 0) {
+                    hist = NULL;
+                }
+            } else {
+                flLogOut("TEXCASH: no room to scale cache %d\n", ix);
+                set_texcash_pages(ix, page16, page32);
+            }
+        }
+
+        if ((mts[ix].hostmem == NULL) && (texcash_history_size(ix) != 0)) {
+            mts[ix].hostmem = SDL_malloc(texcash_history_size(ix));
+            hist = (PatternHistory*)mts[ix].hostmem;
+        }
+
+        // The wheel ages the patterns of an extended cache and the tiles of a plain one
+        if (mts[ix].ext) {
             mts[ix].mltcsh16 = (PatternState*)adrs;
             adrs += mts[ix].mltnum16 * 8;
             mts[ix].mltcsh32 = (PatternState*)adrs;
@@ -385,26 +563,27 @@ void make_texcash_work(s16 ix) {
             mts[ix].tpf = (TexturePoolFree*)adrs;
             adrs += sizeof(TexturePoolFree);
             mts[ix].tpu = (TexturePoolUsed*)adrs;
+            adrs += sizeof(TexturePoolUsed);
+            cash_wheel_init(&mts[ix].wheel, (CashWheelLink*)adrs, 0x40);
             SDL_zerop(mts[ix].cpat);
             SDL_zerop(mts[ix].tpf);
             SDL_zerop(mts[ix].tpu);
             init_texcash_2nd(ix);
         } else {
-            memreq = mts[ix].mltnum16 * 8 + mts[ix].mltnum32 * 8;
-            mts_ok[ix].key0 = Pull_ramcnt_key(memreq, mts_base[ix].type, 0, 0);
-            adrs = (u8*)Get_ramcnt_address(mts_ok[ix].key0);
             mts[ix].mltcsh16 = (PatternState*)adrs;
             adrs += mts[ix].mltnum16 * 8;
             mts[ix].mltcsh32 = (PatternState*)adrs;
+            adrs += mts[ix].mltnum32 * 8;
+            cash_wheel_init(&mts[ix].wheel, (CashWheelLink*)adrs, mts[ix].mltnum16 + mts[ix].mltnum32);
         }
 
+        mts[ix].mltold16 = hist;
+        mts[ix].mltold32 = (hist != NULL) ? &hist[mts[ix].mltnum16] : NULL;
+        cash_tile_forget(hist, mts[ix].mltnum16 + mts[ix].mltnum32);
+
         mts[ix].mltbuf = texcash_melt_buffer;
-        memreq = ((mts_base[ix].mode & 4) != 0) + 1;
-        memreq *= (mts[ix].mltnum << 0x10);
-        mts_ok[ix].key1 = Pull_ramcnt_key(memreq, mts_base[ix].type, 0, 0);
         mts[ix].attribute = mts_base[ix].attribute;
-        page16 = Get_ramcnt_address(mts_ok[ix].key1);
-        mlt_obj_trans_init(&mts[ix], mts_base[ix].mode, (u8*)page16);
+        mlt_obj_trans_init(&mts[ix], mts_base[ix].mode, texadrs);
 
         if (mts[ix].ext) {
             init_texcash_2nd(ix);
@@ -419,6 +598,18 @@ void make_texcash_work(s16 ix) {
     }
 }
 
+/** @brief Forget what freed tiles held, after texture group data has been loaded or dropped. */
+void forget_texcash_history() {
+    s16 i;
+
+    for (i = 1; i < 24; i++) {
+        if (mts_ok[i].be) {
+            cash_tile_forget(mts[i].mltold16, mts[i].mltnum16);
+            cash_tile_forget(mts[i].mltold32, mts[i].mltnum32);
+        }
+    }
+}
+
 /** @brief Clear all texture cache work entries. */
 void Clear_texcash_work() {
     s16 i;
@@ -443,6 +634,10 @@ static void clear_texcash_work(s16 ix) {
             mts[ix].mltcsh32[i].cs.code = -1;
         }
 
+        cash_wheel_init(&mts[ix].wheel, mts[ix].wheel.link, mts[ix].wheel.count);
+        cash_tile_forget(mts[ix].mltold16, mts[ix].mltnum16);
+        cash_tile_forget(mts[ix].mltold32, mts[ix].mltnum32);
+
         if (mts[ix].ext) {
             SDL_zerop(mts[ix].cpat);
             SDL_zerop(mts[ix].tpf);
@@ -476,6 +671,10 @@ void purge_texcash_work(s16 ix) {
     }
 
     ppgReleaseTextureHandle(&mts[ix].tex, -1);
+    SDL_free(mts[ix].hostmem);
+    mts[ix].hostmem = NULL;
+    mts[ix].mltold16 = NULL;
+    mts[ix].mltold32 = NULL;
     mts_ok[ix].be = 0;
     mts_ok[ix].key0 = 0;
     mts_ok[ix].key1 = 0;
@@ -17,11 +17,12 @@ void init_texcash_1st();
 void init_texcash_2nd(s16 ix);
 void init_texcash_before_process();
 void search_texcash_free_area(s16 ix);
-void update_with_tpu_free(PatternState* mc16, PatternState* mc32);
+void update_with_tpu_free(MultiTexture* mt);
 void texture_cash_update();
 void make_texcash_work(s16 ix);
 void purge_texcash_work(s16 ix);
 void Clear_texcash_work();
+void forget_texcash_history();
 s16 get_my_trans_mode(s16 curr);
 
 #endif
@@ -252,7 +252,13 @@ void q_ldreq_texture_group(REQ* curr) {
 
         curr->rno = 4;
         curr->be = 1;
-        break;
+
+        // Resident files are already read; finish without waiting a frame
+        if (fsCheckFileReaded(curr) == 0) {
+            break;
+        }
+
+        /* fallthrough */
 
     case 4:
         switch (fsCheckFileReaded(curr)) {
@@ -262,6 +268,7 @@ void q_ldreq_texture_group(REQ* curr) {
             curr->lds->texture_table = ldadr + bsd->to_tex;
             curr->lds->trans_table = ldadr;
             curr->lds->ok = 1;
+            forget_texcash_history();
 
             switch (bsd->ix1st) {
             case 1:
@@ -417,6 +424,7 @@ void purge_texture_group(u8 grp) {
     if (texgrplds[grp].ok != 0) {
         texgrplds[grp].ok = 0;
         Push_ramcnt_key(texgrplds[grp].key);
+        forget_texcash_history();
     }
 }
 
@@ -475,5 +483,6 @@ static s32 load_any_texture_grpnum(u8 grp, u8 kokey) {
     lds->texture_table = ldadr + bsd->to_tex;
     lds->trans_table = ldadr;
     lds->ok = 1;
+    forget_texcash_history();
     return 1;
 }
@@ -5,6 +5,7 @@
 
 #include "sf33rd/Source/Game/screen/ranking.h"
 #include "common.h"
+#include "port/selfplay.h"
 #include "sf33rd/Source/Game/debug/Debug.h"
 #include "sf33rd/Source/Game/demo/demo02.h"
 #include "sf33rd/Source/Game/effect/eff58.h"
@@ -341,6 +342,7 @@ void Ranking_01_2nd() {
         Setup_Demo_PL();
         Setup_Demo_Arts();
         Setup_Demo_Stage();
+        SelfPlay_SetupFight();
         Push_LDREQ_Queue_Player(0, My_char[0]);
         Push_LDREQ_Queue_Player(1, My_char[1]);
         Push_LDREQ_Queue_BG((s32)bg_w.stage);
@@ -65,6 +65,9 @@ s8* sdbd[3];
 /* Master volume multiplier (0.0 = mute, 1.0 = full). Set via --volume CLI. */
 float g_master_volume = 1.0f;
 
+/* Drops SE and BGM requests while set, e.g. over frames the training lookahead resimulates. */
+bool sound_requests_held = false;
+
 // SPU bank state - global for CSE inline migration
 CSE_SYSWORK g_cseSysWork __attribute__((aligned(16)));
 
@@ -290,6 +293,10 @@ void setupSoundMode() {
  * into bgm_req for the next BGM_Server() frame.
  */
 static void ProcessSoundRequest(SoundRequestData* rmc, s16 pan) {
+    if (sound_requests_held) {
+        return;
+    }
+
     if (rmc->ptix != BGM_PTIX) {
         if (pan < -0x20) {
             pan = -0x20;
@@ -17,6 +17,7 @@
 
 extern s16 bgm_level;
 extern float g_master_volume;
+extern bool sound_requests_held;
 extern s16 se_level;
 extern s8* sdbd[3];
 extern SoundEvent* cseTSBDataTable[];
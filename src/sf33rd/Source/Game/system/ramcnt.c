@@ -38,12 +38,17 @@ s16 rckeymin;
 
 /** @brief Display debug overlay showing RAM key pool status (remaining memory, key count). */
 void disp_ramcnt_free_area() {
+    MMStats stats;
+
     if (Debug_w[DEBUG_RAMCNT_FREE_AREA]) {
+        mmGetStats(&rckey_mmobj, &stats);
         flPrintColor(0xFFFFFF8F);
         flPrintL(4, 8, "Ramcnt Status");
         flPrintL(4, 9, "Now %07X", mmGetRemainder(&rckey_mmobj));
         flPrintL(4, 0xA, "Min %07X", mmGetRemainderMin(&rckey_mmobj));
         flPrintL(4, 0xB, "Key %2d / %2d", rckeymin, rckeyctr);
+        flPrintL(4, 0xC, "Frag %3d%% Gaps %3d", (s32)stats.fragmentation, stats.freeBlocks);
+        flPrintL(4, 0xD, "Probe %3d Max %3d", (s32)stats.probeAvg, stats.probeMax);
     }
 }
 
@@ -16,6 +16,7 @@
 #include "common.h"
 #include "main.h"
 #include "port/modded_stage.h"
+#include "port/replay_log.h"
 #include "sf33rd/AcrSDK/common/mlPAD.h"
 #include "sf33rd/AcrSDK/ps2/flps2debug.h"
 #include "sf33rd/Source/Game/com/com_data.h"
@@ -49,11 +50,14 @@
 #define CONVERT_DATA_COUNT 12
 #define CANDIDATE_BUFF_SIZE 16
 #define EM_CANDIDATE_SLOTS 8
-#define REPLAY_KEY_BUFF_SIZE 7198
+#define REPLAY_KEY_BUFF_SIZE 7198 // PS2 key_buff length, still the minimum playback length
 #define RANKING_TOP_N 5
 
 u8 Candidate_Buff[CANDIDATE_BUFF_SIZE];
 
+// Next replay log entry per player (the PS2 build walked Demo_Ptr through key_buff)
+static u32 Replay_Ptr[2];
+
 // forward decls
 void Disp_Win_Record_Sub(u16 win_record, s16 zz);
 s32 Setup_Target_PL();
@@ -1128,13 +1132,7 @@ void Check_Replay() {
         Condense_Buff[0] = 0xFFFF;
         Condense_Buff[1] = 0xFFFF;
         memset(&Replay_w, 0, sizeof(Replay_w));
-
-        if (Mode_Type == MODE_NORMAL_TRAINING || Mode_Type == MODE_PARRY_TRAINING || Mode_Type == MODE_TRIALS) {
-            for (ix = 0; ix < 0x1C1E; ix++) {
-                Replay_w.io_unit.key_buff[0][ix] = 0xF000;
-                Replay_w.io_unit.key_buff[1][ix] = 0xF000;
-            }
-        }
+        ReplayLog_Clear();
 
         Setup_Replay_Header();
 
@@ -1168,8 +1166,8 @@ void Check_Replay() {
     Record_Timer = 0;
     Demo_Timer[0] = 0;
     Demo_Timer[1] = 0;
-    Demo_Ptr[0] = Replay_w.io_unit.key_buff[0];
-    Demo_Ptr[1] = Replay_w.io_unit.key_buff[1];
+    Replay_Ptr[0] = 0;
+    Replay_Ptr[1] = 0;
 }
 
 /** @brief Save current game state (stage, characters, RNG seeds) into the replay header. */
@@ -1312,10 +1310,8 @@ static void Setup_Replay_Buff(s16 PL_id, u16 sw_buff) {
     timer <<= 12;
     buff = Condense_Buff[PL_id] & 0xFFF;
     buff |= timer;
-    *Demo_Ptr[PL_id] = buff;
-    Demo_Ptr[PL_id]++;
 
-    if (&Replay_w.io_unit.key_buff[PL_id][REPLAY_KEY_BUFF_SIZE - 1] < Demo_Ptr[PL_id]) {
+    if (!ReplayLog_Push(PL_id, buff)) {
         Replay_Status[PL_id] = 99;
         Replay_w.full_data |= PL_id + 1;
         Rec_Time[PL_id] = Record_Timer;
@@ -1326,12 +1322,39 @@ static void Setup_Replay_Buff(s16 PL_id, u16 sw_buff) {
     Condense_Buff[PL_id] = sw_buff;
 }
 
+/**
+ * @brief Fetch the next replay log entry for the given player.
+ *
+ * Past the end of the log this returns what the PS2 key_buff held there:
+ * neutral runs in training (pre-filled) and empty entries elsewhere.
+ */
+static u16 Next_Replay_Code(s16 PL_id) {
+    const u32 ix = Replay_Ptr[PL_id]++;
+
+    if (ix < ReplayLog_Count(PL_id)) {
+        return ReplayLog_Codes(PL_id)[ix];
+    }
+
+    if (Mode_Type == MODE_NORMAL_TRAINING || Mode_Type == MODE_PARRY_TRAINING || Mode_Type == MODE_TRIALS) {
+        return 0xF000;
+    }
+
+    return 0;
+}
+
 /** @brief Play back recorded input for the given player from the replay buffer. */
 static void Replay(s16 PL_id) {
     u16 sw;
     u16 buff;
+    u32 end;
+
+    // Short logs play out to the old key_buff length; longer ones end with their data
+    end = ReplayLog_Count(PL_id);
+    if (end < REPLAY_KEY_BUFF_SIZE) {
+        end = REPLAY_KEY_BUFF_SIZE;
+    }
 
-    if (&Replay_w.io_unit.key_buff[PL_id][REPLAY_KEY_BUFF_SIZE] < Demo_Ptr[PL_id]) {
+    if (Replay_Ptr[PL_id] > end) {
         Replay_Status[0] = 2;
         Replay_Status[1] = 2;
 
@@ -1350,8 +1373,7 @@ static void Replay(s16 PL_id) {
     }
 
     if (Demo_Timer[PL_id] == 0) {
-        sw = *Demo_Ptr[PL_id];
-        Demo_Ptr[PL_id]++;
+        sw = Next_Replay_Code(PL_id);
         buff = sw;
         sw &= 0xFFF;
         Condense_Buff[PL_id] = sw;
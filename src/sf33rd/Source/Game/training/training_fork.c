@@ -0,0 +1,274 @@
+/**
+ * @file training_fork.c
+ * @brief Exact frame advantage and hit prediction for Training Mode, by running
+ *        real logic frames ahead on a copy of the match.
+ *
+ * When a player starts a move, the match is snapshotted with the same state a
+ * netplay rollback restores and played forward with rendering and sound
+ * suppressed: once with the dummy not blocking and once with it blocking.
+ * Each future runs until the training state resolves the move's advantage,
+ * so specials, throws and effect-driven motion come out exactly as the engine
+ * plays them, which training_prediction.c's physics-only projection cannot do.
+ *
+ * The attacker's input is held neutral in both futures. The work is spread
+ * over frames within a per-frame time budget: a slow machine gets the same
+ * answers, just later, and a prediction the real match overtakes is dropped.
+ */
+
+#include "training_fork.h"
+#include "game_state.h"
+#include "port/config.h"
+#include "port/renderer.h"
+#include "port/sdl/sdl_game_renderer.h"
+#include "port/sdl/training_menu.h"
+#include "sf33rd/Source/Game/engine/workuser.h"
+#include "sf33rd/Source/Game/rendering/mtrans.h"
+#include "sf33rd/Source/Game/sound/sound3rd.h"
+#include "sf33rd/Source/Game/system/work_sys.h"
+#include "training_dummy.h"
+#include "training_state.h"
+#include <SDL3/SDL.h>
+
+#define FORK_MAX_FRAMES 180 // Longest future followed; covers knockdowns and wakeup
+#define FORK_MIN_BUDGET_US 250
+#define FORK_MAX_BUDGET_US 16000
+
+extern void njUserMain();
+
+// What a netplay rollback restores, plus the training and dummy state the
+// simulated frames advance.
+typedef struct ForkSnapshot {
+    RollbackState match;
+    TrainingGameState training;
+    DummySettings dummy;
+} ForkSnapshot;
+
+enum {
+    SNAP_ORIGIN, // The frame the move was first seen on
+    SNAP_CURSOR, // Where the branch in progress stopped last frame
+    SNAP_LIVE,   // The real match while a slice runs
+    SNAP_COUNT
+};
+
+TrainingForkResult g_training_fork = { 0 };
+
+static ForkSnapshot* snapshots = NULL;
+static s32 branch_ix = FORK_BRANCH_COUNT; // Branch being simulated; FORK_BRANCH_COUNT when idle
+static s32 branch_frames = 0;
+static bool branch_started = false;
+static s32 last_frame_number = -1;
+static Uint64 frame_cost_ns = 0; // Running estimate of one simulated frame
+
+static void save_snapshot(ForkSnapshot* dst) {
+    RollbackState_Save(&dst->match);
+    dst->training = g_training_state;
+    dst->dummy = g_dummy_settings;
+}
+
+static void load_snapshot(const ForkSnapshot* src) {
+    RollbackState_Load(&src->match);
+    g_training_state = src->training;
+    g_dummy_settings = src->dummy;
+}
+
+static void release(void) {
+    SDL_free(snapshots);
+    snapshots = NULL;
+    SDL_zero(g_training_fork);
+    branch_ix = FORK_BRANCH_COUNT;
+    branch_started = false;
+    last_frame_number = -1;
+}
+
+/** @brief Point the dummy at the behaviour `id` stands for. */
+static void apply_branch(s32 id) {
+    g_dummy_settings.block_type = (id == FORK_BRANCH_BLOCK) ? DUMMY_BLOCK_ALWAYS : DUMMY_BLOCK_NONE;
+    g_dummy_settings.parry_type = DUMMY_PARRY_NONE;
+}
+
+/** @brief One logic-only frame with neutral pads, as netplay resimulates it. */
+static void simulate_frame(void) {
+    p1sw_0 = p1sw_1 = 0;
+    p2sw_0 = p2sw_1 = 0;
+    SDL_zeroa(PLsw);
+
+    SDLGameRenderer_ResetBatchState();
+    njUserMain();
+    seqsBeforeProcess();
+    Renderer_Flush2DPrimitives();
+    seqsAfterProcess();
+}
+
+/** @brief Record what the last simulated frame showed; true once the move has played out. */
+static bool observe(TrainingForkBranch* b) {
+    const TrainingPlayerState* atk = get_training_player(g_training_fork.attacker);
+    const TrainingPlayerState* def = get_training_player(g_training_fork.attacker ^ 1);
+
+    if (atk->attack_start_frame != g_training_fork.attack_start_frame) {
+        // Another move began before this one resolved
+        return true;
+    }
+
+    if ((b->connect_frame == 0) && atk->opponent_was_affected) {
+        b->connect_frame = g_training_state.frame_number - g_training_fork.attack_start_frame;
+        b->outcome = (def->current_frame_state == FRAME_STATE_BLOCKSTUN) ? FORK_OUTCOME_BLOCK : FORK_OUTCOME_HIT;
+    }
+
+    if (atk->advantage_active) {
+        return false;
+    }
+
+    if (b->outcome == FORK_OUTCOME_PENDING) {
+        b->outcome = FORK_OUTCOME_WHIFF;
+    }
+
+    b->advantage = atk->advantage_value;
+    b->punish_window = (b->advantage < 0) ? -b->advantage : 0;
+    b->resolved = true;
+    return true;
+}
+
+/** @brief Give up on the branches not simulated to the end, so the overlay shows them as unknown. */
+static void drop_unfinished(void) {
+    for (s32 i = 0; i < FORK_BRANCH_COUNT; i++) {
+        TrainingForkBranch* b = &g_training_fork.branch[i];
+
+        if (!b->resolved) {
+            b->outcome = FORK_OUTCOME_UNRESOLVED;
+        }
+    }
+
+    branch_ix = FORK_BRANCH_COUNT;
+    branch_started = false;
+}
+
+/** @brief Start predicting the move a player just began, if there is a new one. */
+static void find_new_move(void) {
+    for (s16 id = 0; id < 2; id++) {
+        const TrainingPlayerState* ps = get_training_player(id);
+
+        if (!ps->advantage_active) {
+            continue;
+        }
+
+        if (g_training_fork.active && (g_training_fork.attacker == id) &&
+            (g_training_fork.attack_start_frame == ps->attack_start_frame)) {
+            return;
+        }
+
+        if ((snapshots == NULL) && ((snapshots = SDL_malloc(sizeof(ForkSnapshot) * SNAP_COUNT)) == NULL)) {
+            return;
+        }
+
+        SDL_zero(g_training_fork);
+        g_training_fork.active = true;
+        g_training_fork.attacker = id;
+        g_training_fork.attack_start_frame = ps->attack_start_frame;
+        g_training_fork.budget_us =
+            SDL_clamp(Config_GetInt(CFG_KEY_TRAINING_LOOKAHEAD_BUDGET), FORK_MIN_BUDGET_US, FORK_MAX_BUDGET_US);
+
+        save_snapshot(&snapshots[SNAP_ORIGIN]);
+        branch_ix = 0;
+        branch_started = false;
+        return;
+    }
+}
+
+/** @brief Simulate as many frames as the budget allows, then put the real match back. */
+static void run_slice(void) {
+    const Uint64 start = SDL_GetTicksNS();
+    const Uint64 budget_ns = (Uint64)g_training_fork.budget_us * 1000;
+    const u16 saved_sw[4] = { p1sw_0, p1sw_1, p2sw_0, p2sw_1 };
+    const u8 saved_no_trans = No_Trans;
+    bool positioned = false;
+
+    save_snapshot(&snapshots[SNAP_LIVE]);
+    sound_requests_held = true;
+    No_Trans = 1;
+
+    while (branch_ix < FORK_BRANCH_COUNT) {
+        TrainingForkBranch* b = &g_training_fork.branch[branch_ix];
+
+        if (!branch_started) {
+            load_snapshot(&snapshots[SNAP_ORIGIN]);
+            apply_branch(branch_ix);
+            branch_frames = 0;
+            branch_started = true;
+        } else if (!positioned) {
+            load_snapshot(&snapshots[SNAP_CURSOR]);
+        }
+
+        positioned = true;
+
+        const Uint64 frame_start = SDL_GetTicksNS();
+        simulate_frame();
+        frame_cost_ns = (frame_cost_ns * 7 + (SDL_GetTicksNS() - frame_start)) / 8;
+        branch_frames += 1;
+        g_training_fork.frames_run += 1;
+
+        if (observe(b) || (branch_frames >= FORK_MAX_FRAMES)) {
+            if (b->outcome == FORK_OUTCOME_PENDING) {
+                b->outcome = FORK_OUTCOME_UNRESOLVED;
+            }
+
+            branch_ix += 1;
+            branch_started = false;
+        }
+
+        if ((SDL_GetTicksNS() - start + frame_cost_ns) >= budget_ns) {
+            break;
+        }
+    }
+
+    if (branch_started) {
+        save_snapshot(&snapshots[SNAP_CURSOR]);
+    }
+
+    load_snapshot(&snapshots[SNAP_LIVE]);
+    sound_requests_held = false;
+    No_Trans = saved_no_trans;
+    p1sw_0 = saved_sw[0];
+    p1sw_1 = saved_sw[1];
+    p2sw_0 = saved_sw[2];
+    p2sw_1 = saved_sw[3];
+
+    // The real frame starts with a clean texture stack, as in step_game
+    SDLGameRenderer_ResetBatchState();
+    g_training_fork.last_cost_us = (u32)((SDL_GetTicksNS() - start) / 1000);
+}
+
+void training_fork_step(void) {
+    if ((Mode_Type != MODE_NORMAL_TRAINING) || !g_training_menu_settings.show_advantage) {
+        if (snapshots != NULL || g_training_fork.active) {
+            release();
+        }
+
+        return;
+    }
+
+    // Only while the match is running: the training frame counter has to have
+    // moved since the last call, which also keeps menus and pauses out
+    const s32 frame = g_training_state.frame_number;
+    const bool ticking = (frame != last_frame_number);
+    last_frame_number = frame;
+
+    if (!ticking) {
+        return;
+    }
+
+    find_new_move();
+
+    if (branch_ix >= FORK_BRANCH_COUNT) {
+        return;
+    }
+
+    const TrainingPlayerState* atk = get_training_player(g_training_fork.attacker);
+
+    if (!atk->advantage_active || (atk->attack_start_frame != g_training_fork.attack_start_frame)) {
+        // The real match resolved the move first; its own numbers stand
+        drop_unfinished();
+        return;
+    }
+
+    run_slice();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file training_fork.h
+ * @brief Exact frame advantage and hit prediction for Training Mode, by running
+ *        real logic frames ahead on a copy of the match.
+ */
+
+#ifndef TRAINING_FORK_H
+#define TRAINING_FORK_H
+
+#include "structs.h"
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FORK_OUTCOME_PENDING = 0, // Not simulated to the end yet
+    FORK_OUTCOME_WHIFF,
+    FORK_OUTCOME_HIT,
+    FORK_OUTCOME_BLOCK,
+    FORK_OUTCOME_UNRESOLVED // Both sides were still busy when the lookahead ran out
+} TrainingForkOutcome;
+
+// What the dummy does in each simulated future
+typedef enum { FORK_BRANCH_NO_BLOCK = 0, FORK_BRANCH_BLOCK, FORK_BRANCH_COUNT } TrainingForkBranchId;
+
+typedef struct {
+    TrainingForkOutcome outcome;
+    s16 advantage;     // Attacker's frames over the defender once both can act
+    s16 punish_window; // Frames the defender can act before the attacker recovers
+    s16 connect_frame; // Frames from the start of the move to its first hit or block, 0 if none
+    bool resolved;     // advantage and punish_window are final
+} TrainingForkBranch;
+
+typedef struct {
+    bool active; // A move has been (or is being) predicted
+    s16 attacker;
+    s32 attack_start_frame;
+    TrainingForkBranch branch[FORK_BRANCH_COUNT];
+
+    u32 frames_run;   // Frames simulated for this move so far
+    u32 last_cost_us; // Time the last slice took
+    u32 budget_us;
+} TrainingForkResult;
+
+extern TrainingForkResult g_training_fork;
+
+/// Run this frame's slice of the lookahead; call before the frame's own logic
+void training_fork_step(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRAINING_FORK_H
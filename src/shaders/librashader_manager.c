@@ -13,6 +13,7 @@ void LibrashaderManager_Render_GL(LibrashaderManager* manager,
                                   int input_w, int input_h, int viewport_x, int viewport_y, int viewport_w,
                                   int viewport_h);
 void LibrashaderManager_Free_GL(LibrashaderManager* manager);
+float LibrashaderManager_GetGPUTimeMs_GL(const LibrashaderManager* manager);
 
 LibrashaderManager* LibrashaderManager_Init_GPU(const char* preset_path);
 void LibrashaderManager_Render_GPU(LibrashaderManager* manager, void* command_buffer, void* input_texture,
@@ -110,6 +111,13 @@ void LibrashaderManager_Render_GPU_Wrapper(LibrashaderManager* manager, void* co
                                   display_y);
 }
 
+float LibrashaderManager_GetGPUTimeMs(const LibrashaderManager* manager) {
+    if (!manager || !manager->backend_impl || manager->backend_type != RENDERER_OPENGL)
+        return -1.0f;
+
+    return LibrashaderManager_GetGPUTimeMs_GL((const LibrashaderManager*)manager->backend_impl);
+}
+
 void LibrashaderManager_Free(LibrashaderManager* manager) {
     if (!manager)
         return;
@@ -23,6 +23,10 @@ void LibrashaderManager_Render_GPU_Wrapper(LibrashaderManager* manager, void* co
                                            int input_h, int viewport_w, int viewport_h, int swapchain_w,
                                            int swapchain_h, int display_x, int display_y);
 
+// Smoothed GPU time of the whole filter chain in milliseconds, or -1 when
+// unavailable (no timer queries, nothing measured yet, or SDL_GPU backend).
+float LibrashaderManager_GetGPUTimeMs(const LibrashaderManager* manager);
+
 // Free resources.
 void LibrashaderManager_Free(LibrashaderManager* manager);
 
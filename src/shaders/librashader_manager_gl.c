@@ -10,6 +10,8 @@
 // Forward declarations to match the dispatcher's expectation
 typedef struct LibrashaderManagerGL LibrashaderManagerGL;
 
+#define GPU_TIMER_LATENCY 3 // Frames a timer query gets before it is read back
+
 // Loader for librashader
 static const void* gl_loader(const char* name) {
     return (const void*)SDL_GL_GetProcAddress(name);
@@ -28,8 +30,17 @@ struct LibrashaderManagerGL {
 
     // Simple blit shader to draw the result to screen
     GLuint blit_program;
+    GLint blit_source_location;
+    GLint blit_original_location;
     GLuint vao;
     GLuint vbo;
+
+    // GL_TIME_ELAPSED around the whole filter chain (its passes are opaque to us)
+    bool gpu_timers;
+    GLuint timer_queries[GPU_TIMER_LATENCY];
+    bool timer_pending[GPU_TIMER_LATENCY];
+    int timer_slot;
+    float gpu_ms;
 };
 
 // Helper to compile internal blit shader
@@ -78,6 +89,9 @@ static void init_blit_resources(LibrashaderManagerGL* manager) {
     glDeleteShader(vs);
     glDeleteShader(fs);
 
+    manager->blit_source_location = glGetUniformLocation(manager->blit_program, "Source");
+    manager->blit_original_location = glGetUniformLocation(manager->blit_program, "Original");
+
     float vertices[] = { // positions   // texCoords
                          -1.0f, 1.0f, 0.0f, 1.0f, -1.0f, -1.0f, 0.0f, 0.0f, 1.0f, -1.0f, 1.0f, 0.0f,
 
@@ -144,9 +158,32 @@ LibrashaderManagerGL* LibrashaderManager_Init_GL(const char* preset_path) {
 
     init_blit_resources(manager);
 
+    manager->gpu_ms = -1.0f;
+    if (GLAD_GL_VERSION_3_3) {
+        glGenQueries(GPU_TIMER_LATENCY, manager->timer_queries);
+        manager->gpu_timers = true;
+    }
+
     return manager;
 }
 
+/** @brief Read the chain timer issued GPU_TIMER_LATENCY frames ago, if the GPU is done with it. */
+static void collect_gpu_timer(LibrashaderManagerGL* manager, int slot) {
+    if (!manager->timer_pending[slot])
+        return;
+
+    GLuint available = 0;
+    glGetQueryObjectuiv(manager->timer_queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return;
+
+    GLuint64 elapsed_ns = 0;
+    glGetQueryObjectui64v(manager->timer_queries[slot], GL_QUERY_RESULT, &elapsed_ns);
+    const float ms = (float)elapsed_ns / 1e6f;
+    manager->gpu_ms = (manager->gpu_ms < 0.0f) ? ms : manager->gpu_ms + (ms - manager->gpu_ms) * 0.1f;
+    manager->timer_pending[slot] = false;
+}
+
 void LibrashaderManager_Render_GL(LibrashaderManagerGL* manager, GLuint input_texture, int input_w, int input_h,
                                   int viewport_x, int viewport_y, int viewport_w, int viewport_h) {
     if (!manager || !manager->filter_chain)
@@ -208,9 +245,21 @@ void LibrashaderManager_Render_GL(LibrashaderManagerGL* manager, GLuint input_te
     opt.frames_per_second = 60.0f;
     opt.frametime_delta = 16; // ms
 
+    const int timer_slot = manager->timer_slot;
+    if (manager->gpu_timers) {
+        collect_gpu_timer(manager, timer_slot);
+        glBeginQuery(GL_TIME_ELAPSED, manager->timer_queries[timer_slot]);
+    }
+
     libra_error_t err = libra_gl_filter_chain_frame(
         &manager->filter_chain, manager->frame_count++, input_image, output_image, &viewport, mvp, &opt);
 
+    if (manager->gpu_timers) {
+        glEndQuery(GL_TIME_ELAPSED);
+        manager->timer_pending[timer_slot] = true;
+        manager->timer_slot = (timer_slot + 1) % GPU_TIMER_LATENCY;
+    }
+
     if (err != 0) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Librashader frame failed");
         libra_error_print(err);
@@ -224,11 +273,11 @@ void LibrashaderManager_Render_GL(LibrashaderManagerGL* manager, GLuint input_te
     glUseProgram(manager->blit_program);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, manager->output_texture);
-    glUniform1i(glGetUniformLocation(manager->blit_program, "Source"), 0);
+    glUniform1i(manager->blit_source_location, 0);
 
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, input_texture);
-    glUniform1i(glGetUniformLocation(manager->blit_program, "Original"), 1);
+    glUniform1i(manager->blit_original_location, 1);
 
     // Clear background to black before blitting shader output
     // REMOVED: glClearColor/glClear - Caller (SDLApp_EndFrame) is responsible for
@@ -246,6 +295,10 @@ void LibrashaderManager_Render_GL(LibrashaderManagerGL* manager, GLuint input_te
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
+float LibrashaderManager_GetGPUTimeMs_GL(const LibrashaderManagerGL* manager) {
+    return (manager && manager->gpu_timers) ? manager->gpu_ms : -1.0f;
+}
+
 void LibrashaderManager_Free_GL(LibrashaderManagerGL* manager) {
     if (!manager)
         return;
@@ -254,6 +307,8 @@ void LibrashaderManager_Free_GL(LibrashaderManagerGL* manager) {
         libra_gl_filter_chain_free(&manager->filter_chain);
     }
 
+    if (manager->gpu_timers)
+        glDeleteQueries(GPU_TIMER_LATENCY, manager->timer_queries);
     if (manager->output_texture)
         glDeleteTextures(1, &manager->output_texture);
     if (manager->blit_program)
@@ -0,0 +1,44 @@
+#version 330 core
+// Overlay batch: solid rects and 8x8 glyphs in one draw. Shadow and outline
+// are built here from neighbouring atlas texels instead of redrawing the text.
+in vec2 vTexel;
+in vec4 vColor;
+flat in ivec2 vCell;
+flat in int vStyle;
+out vec4 FragColor;
+
+uniform sampler2D atlas;
+
+const int STYLE_SOLID = 0;
+const int STYLE_SHADOW = 2;
+const int STYLE_OUTLINE = 3;
+
+float glyph(ivec2 t)
+{
+    // Quads are one texel larger than the cell; don't bleed into neighbours
+    if (any(lessThan(t, vCell)) || any(greaterThanEqual(t, vCell + ivec2(8))))
+        return 0.0;
+    return texelFetch(atlas, t, 0).r;
+}
+
+void main()
+{
+    if (vStyle == STYLE_SOLID) {
+        FragColor = vColor;
+        return;
+    }
+
+    ivec2 t = ivec2(floor(vTexel));
+    float ink = glyph(t);
+
+    float edge = 0.0;
+    if (vStyle == STYLE_SHADOW) {
+        edge = glyph(t - ivec2(1));
+    } else if (vStyle == STYLE_OUTLINE) {
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+                edge = max(edge, glyph(t + ivec2(dx, dy)));
+    }
+
+    FragColor = mix(vec4(0.0, 0.0, 0.0, vColor.a * edge), vColor, ink);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;      // Already in clip space
+layout (location = 1) in vec2 aTexel;    // Atlas position in texels
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in ivec2 aCell;    // Glyph cell origin in the atlas
+layout (location = 4) in int aStyle;
+
+out vec2 vTexel;
+out vec4 vColor;
+flat out ivec2 vCell;
+flat out int vStyle;
+
+void main()
+{
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    vTexel = aTexel;
+    vColor = aColor;
+    vCell = aCell;
+    vStyle = aStyle;
+}
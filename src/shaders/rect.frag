@@ -1,7 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-uniform vec4 rectColor;
-void main()
-{
-    FragColor = rectColor;
-}
\ No newline at end of file
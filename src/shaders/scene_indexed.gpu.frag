@@ -0,0 +1,69 @@
+#version 450
+layout (location = 0) out vec4 FragColor;
+
+layout (location = 0) in vec4 FgColor;
+layout (location = 1) in vec2 TexCoord; // Texels
+// x: array layer | format << 16, y: palette slot, z: width, w: height
+layout (location = 2) flat in uvec4 TexInfo;
+
+// Raw PS2 texture bytes (R8_UINT), stored linearly: byte n of a texture is
+// texel (n % LAYER_WIDTH, n / LAYER_WIDTH) of its layer
+layout(set = 2, binding = 0) uniform usampler2DArray Source;
+
+// 256 RGBA8 colors per palette slot
+layout(std430, set = 2, binding = 1) readonly buffer Palettes {
+    uint colors[];
+} palettes;
+
+const uint LAYER_WIDTH = 512u;
+
+const uint FORMAT_NONE = 0u;  // Solid quad
+const uint FORMAT_8BIT = 1u;  // PSMT8
+const uint FORMAT_4BIT = 2u;  // PSMT4, low nibble first
+const uint FORMAT_16BIT = 3u; // PSMCT16 (ABGR1555)
+
+uint fetch_byte(uint layer, uint offset)
+{
+    return texelFetch(Source, ivec3(int(offset % LAYER_WIDTH), int(offset / LAYER_WIDTH), int(layer)), 0).r;
+}
+
+vec4 unpack_rgba8(uint c)
+{
+    return vec4(float(c & 0xFFu), float((c >> 8) & 0xFFu), float((c >> 16) & 0xFFu), float(c >> 24)) / 255.0;
+}
+
+void main()
+{
+    uint layer = TexInfo.x & 0xFFFFu;
+    uint format = TexInfo.x >> 16;
+
+    if (format == FORMAT_NONE) {
+        FragColor = FgColor;
+        return;
+    }
+
+    uvec2 size = TexInfo.zw;
+    uvec2 texel = uvec2(clamp(ivec2(floor(TexCoord)), ivec2(0), ivec2(size) - 1));
+    vec4 color;
+
+    if (format == FORMAT_16BIT) {
+        uint offset = (texel.y * size.x + texel.x) * 2u;
+        uint pixel = fetch_byte(layer, offset) | (fetch_byte(layer, offset + 1u) << 8);
+        color = vec4(float(pixel & 0x1Fu) / 31.0,
+                     float((pixel >> 5) & 0x1Fu) / 31.0,
+                     float((pixel >> 10) & 0x1Fu) / 31.0,
+                     (pixel & 0x8000u) != 0u ? 1.0 : 0.0);
+    } else {
+        uint index;
+        if (format == FORMAT_4BIT) {
+            uint pitch = (size.x + 1u) / 2u;
+            uint b = fetch_byte(layer, texel.y * pitch + texel.x / 2u);
+            index = (texel.x & 1u) != 0u ? (b >> 4) : (b & 0x0Fu);
+        } else {
+            index = fetch_byte(layer, texel.y * size.x + texel.x);
+        }
+        color = unpack_rgba8(palettes.colors[TexInfo.y * 256u + index]);
+    }
+
+    FragColor = color * FgColor;
+}
@@ -1,3 +1,4 @@
+#include "sf33rd/Source/Game/effect/effect.h"
 #include "sf33rd/Source/Game/engine/cmb_win.h"
 #include "sf33rd/Source/Game/engine/plcnt.h"
 #include "sf33rd/Source/Game/engine/spgauge.h"
@@ -57,3 +58,12 @@ u16 vital_dec_timer;
 s16 sag_inc_timer[2];
 
 u32 system_timer;
+
+// Effect work saved by RollbackState_Save (effect.c)
+s16 frwctr;
+s16 frwctr_min;
+s16 head_ix[8];
+s16 tail_ix[8];
+s16 exec_tm[8];
+uintptr_t frw[EFFECT_MAX][448];
+s16 frwque[EFFECT_MAX];
@@ -1,4 +1,5 @@
 #include <stdint.h>
+#include <string.h>
 #include "types.h"
 #include "structs.h"
 #include "sf33rd/Source/Game/effect/effect.h"
@@ -38,5 +39,16 @@ void Check_LDREQ_Queue() {}
 void cpExitTask(int task_id) {}
 void grade_check_work_1st_init(int a, int b) {}
 void Setup_Training_Difficulty() {}
-void GameState_Save(void* dst) {}
-void GameState_Load(const void* src) {}
+// Stand-ins for game_state.c that carry only the effect work, which is all
+// these tests check; the full copy is covered by test_game_state_roundtrip.
+void RollbackState_Save(RollbackState* dst) {
+    memcpy(dst->es.frw, frw, sizeof(frw));
+    memcpy(dst->es.exec_tm, exec_tm, sizeof(exec_tm));
+    dst->es.frwctr = frwctr;
+}
+
+void RollbackState_Load(const RollbackState* src) {
+    memcpy(frw, src->es.frw, sizeof(frw));
+    memcpy(exec_tm, src->es.exec_tm, sizeof(exec_tm));
+    frwctr = src->es.frwctr;
+}
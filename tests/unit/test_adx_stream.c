@@ -0,0 +1,212 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "common.h"
+#include "port/io/afs.h"
+#include "port/recorder.h"
+#include "port/sound/adx.h"
+
+// BGM is decoded on the audio thread, so a game loop that stalls for longer
+// than any queue would have covered must not starve it.
+
+#define SAMPLE_RATE 48000
+#define BYTES_PER_SECOND (SAMPLE_RATE * 2 * 2)
+#define ADX_HEADER_SIZE 0x30
+#define ADX_FRAME_SIZE 36 // 2 channels x 18-byte blocks, 32 samples each
+
+static uint8_t* afs_file = NULL;
+static size_t afs_file_size = 0;
+
+// --- Mocks ---
+
+void fatal_error(const s8* fmt, ...) {
+    fail_msg("fatal_error: %s", fmt);
+    abort();
+}
+
+unsigned int AFS_GetSize(int file_num) {
+    (void)file_num;
+    return (unsigned int)afs_file_size;
+}
+
+AFSHandle AFS_Open(int file_num) {
+    return file_num;
+}
+
+void AFS_ReadSync(AFSHandle handle, int sectors, void* buf) {
+    (void)handle;
+    (void)sectors;
+    memcpy(buf, afs_file, afs_file_size);
+}
+
+void AFS_Close(AFSHandle handle) {
+    (void)handle;
+}
+
+void Recorder_PushAudio(RecorderAudioSource source, const int16_t* samples, int sample_frames, float gain) {
+    (void)source;
+    (void)samples;
+    (void)sample_frames;
+    (void)gain;
+}
+
+// --- Helpers ---
+
+static void put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* A silent stereo 48 kHz v3 ADX file, optionally looping over all of it. */
+static uint8_t* make_adx(int samples, bool looping, size_t* size_out) {
+    const int frames = samples / 32;
+    const size_t size = ADX_HEADER_SIZE + (size_t)frames * ADX_FRAME_SIZE;
+    uint8_t* data = calloc(1, size);
+
+    data[0] = 0x80;
+    data[2] = 0x00;
+    data[3] = ADX_HEADER_SIZE - 4; // Copyright offset; data follows at +4
+    data[4] = 3;                   // Encoding
+    data[5] = 18;                  // Block size
+    data[6] = 4;                   // Bits per sample
+    data[7] = 2;                   // Channels
+    put_be32(data + 8, SAMPLE_RATE);
+    put_be32(data + 12, (uint32_t)(frames * 32));
+    data[0x12] = 3; // Version
+
+    if (looping) {
+        data[0x17] = 1;
+        put_be32(data + 0x1C, 0);
+        put_be32(data + 0x24, (uint32_t)(frames * 32));
+    }
+
+    *size_out = size;
+    return data;
+}
+
+static void game_frame(int stall_ms) {
+    SDL_Delay(stall_ms > 0 ? (Uint32)stall_ms : 16);
+}
+
+static int setup(void** state) {
+    (void)state;
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    if (!SDL_Init(SDL_INIT_AUDIO)) {
+        return -1;
+    }
+    ADX_Init();
+    return 0;
+}
+
+static int teardown(void** state) {
+    (void)state;
+    ADX_Exit();
+    SDL_Quit();
+    return 0;
+}
+
+// --- Tests ---
+
+static void test_bgm_survives_game_stalls(void** state) {
+    (void)state;
+    size_t size;
+    uint8_t* bgm = make_adx(SAMPLE_RATE, true, &size);
+
+    ADX_StartMem(bgm, size);
+    ADX_StartSeamless();
+
+    ADXStats before;
+    ADX_GetStats(&before);
+    const Uint64 start = SDL_GetTicks();
+
+    // Regular frames broken up by stalls longer than the old 400 ms queue
+    for (int frame = 0; frame < 90; frame++) {
+        const int stall = (frame == 20) ? 250 : (frame == 50) ? 600 : 0;
+        game_frame(stall);
+        assert_int_equal(ADX_GetState(), ADX_STATE_PLAYING);
+    }
+
+    const Uint64 elapsed_ms = SDL_GetTicks() - start;
+    ADXStats after;
+    ADX_GetStats(&after);
+
+    assert_int_equal(after.underruns, before.underruns);
+    // Music kept flowing through the stalls (audio clocks run a little loose)
+    const uint64_t fed = after.queued_bytes - before.queued_bytes;
+    assert_true(fed >= (uint64_t)BYTES_PER_SECOND * elapsed_ms / 1000 * 8 / 10);
+
+    ADX_Stop();
+    free(bgm);
+}
+
+static void test_held_feed_is_silent_not_an_underrun(void** state) {
+    (void)state;
+    size_t size;
+    uint8_t* bgm = make_adx(SAMPLE_RATE, true, &size);
+
+    ADX_StartMem(bgm, size);
+    ADX_StartSeamless();
+    SDL_Delay(100);
+
+    ADX_SetHeld(true);
+    SDL_Delay(50); // Let a callback that was already running finish
+    ADXStats held;
+    ADX_GetStats(&held);
+    SDL_Delay(300);
+    ADXStats still_held;
+    ADX_GetStats(&still_held);
+    assert_true(still_held.queued_bytes == held.queued_bytes);
+
+    ADX_SetHeld(false);
+    SDL_Delay(200);
+    ADXStats resumed;
+    ADX_GetStats(&resumed);
+    assert_true(resumed.queued_bytes > held.queued_bytes);
+    assert_int_equal(resumed.underruns, held.underruns);
+
+    ADX_Stop();
+    free(bgm);
+}
+
+static void test_entry_track_plays_to_end(void** state) {
+    (void)state;
+    afs_file = make_adx(SAMPLE_RATE / 10, false, &afs_file_size);
+
+    ADX_Stop();
+    ADX_EntryAfs(0);
+    assert_int_equal(ADX_GetNumFiles(), 1);
+    assert_int_equal(ADX_GetState(), ADX_STATE_STOP); // Entered but not started
+
+    ADX_StartSeamless();
+    const Uint64 deadline = SDL_GetTicks() + 2000;
+    while (ADX_GetState() != ADX_STATE_PLAYEND && SDL_GetTicks() < deadline) {
+        SDL_Delay(10);
+    }
+
+    assert_int_equal(ADX_GetState(), ADX_STATE_PLAYEND);
+    assert_int_equal(ADX_GetNumFiles(), 0);
+
+    ADX_Stop();
+    assert_int_equal(ADX_GetState(), ADX_STATE_STOP);
+    free(afs_file);
+    afs_file = NULL;
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_bgm_survives_game_stalls),
+        cmocka_unit_test(test_held_feed_is_silent_not_an_underrun),
+        cmocka_unit_test(test_entry_track_plays_to_end),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
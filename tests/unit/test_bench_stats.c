@@ -0,0 +1,72 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "port/bench_stats.h"
+
+// --- Tests ---
+
+static void test_percentiles_use_nearest_rank(void** state) {
+    (void)state;
+    double sorted[100];
+    for (int i = 0; i < 100; i++) {
+        sorted[i] = i + 1;
+    }
+
+    assert_true(BenchStats_Percentile(sorted, 100, 50.0) == 50.0);
+    assert_true(BenchStats_Percentile(sorted, 100, 90.0) == 90.0);
+    assert_true(BenchStats_Percentile(sorted, 100, 99.0) == 99.0);
+    assert_true(BenchStats_Percentile(sorted, 100, 99.5) == 100.0);
+    assert_true(BenchStats_Percentile(sorted, 100, 0.0) == 1.0);
+    assert_true(BenchStats_Percentile(sorted, 100, 100.0) == 100.0);
+
+    // Small series round up to a measured sample
+    assert_true(BenchStats_Percentile(sorted, 3, 50.0) == 2.0);
+    assert_true(BenchStats_Percentile(sorted, 3, 99.0) == 3.0);
+    assert_true(BenchStats_Percentile(sorted, 1, 50.0) == 1.0);
+}
+
+static void test_summary_of_unsorted_samples(void** state) {
+    (void)state;
+    BenchSeries series = { 0 };
+
+    // 2000 samples: forces the series to grow past its first allocation
+    for (int i = 0; i < 2000; i++) {
+        assert_true(BenchSeries_Push(&series, (double)((i * 7919) % 2000)));
+    }
+
+    BenchSummary summary;
+    BenchSeries_Summarize(&series, &summary);
+    assert_int_equal(summary.count, 2000);
+    assert_true(summary.p50 == 999.0);
+    assert_true(summary.p90 == 1799.0);
+    assert_true(summary.p99 == 1979.0);
+    assert_true(summary.max == 1999.0);
+    assert_true(summary.mean == 999.5);
+
+    BenchSeries_Clear(&series);
+    assert_int_equal(series.count, 0);
+    BenchSeries_Free(&series);
+    assert_null(series.values);
+}
+
+static void test_empty_summary_is_zero(void** state) {
+    (void)state;
+    BenchSeries series = { 0 };
+    BenchSummary summary;
+    BenchSeries_Summarize(&series, &summary);
+    assert_int_equal(summary.count, 0);
+    assert_true(summary.max == 0.0);
+    assert_true(summary.p99 == 0.0);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_percentiles_use_nearest_rank),
+        cmocka_unit_test(test_summary_of_unsorted_samples),
+        cmocka_unit_test(test_empty_summary_is_zero),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
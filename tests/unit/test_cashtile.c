@@ -0,0 +1,193 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include "sf33rd/Source/Game/rendering/cashtile.h"
+
+#define TILES 256 // One page of 16x16 tiles
+#define FRAMES 4000
+#define TRACE_PATTERNS 61 // anim * 7 + n + jitter in run_plain_cache reaches 5 * 7 + 23 + 2
+
+static PatternState tiles[TILES];
+static PatternHistory history[TILES];
+static u32 held[TILES]; // What was last decoded into each tile
+static s16 life[TILES];
+
+static u32 seed;
+
+static u32 next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+static void clear_tiles(s32 count) {
+    for (s32 i = 0; i < count; i++) {
+        tiles[i].time = 0;
+        tiles[i].state = 0;
+        tiles[i].cs.code = -1;
+        held[i] = 0xFFFFFFFF;
+        life[i] = 0;
+    }
+
+    cash_tile_forget(history, count);
+}
+
+// A plain cache the way get_mltbuf16 and mlt_obj_trans_update run it; returns
+// the number of tiles decoded
+static s32 run_plain_cache(PatternHistory* hist, s32 count, s32 patterns, s32 lifetime) {
+    s32 decoded = 0;
+    s32 revive;
+    s32 i;
+
+    clear_tiles(count);
+
+    for (u32 tick = 1; tick <= FRAMES; tick++) {
+        // A fighter cycles through animations that share most of their tiles
+        const u32 anim = (tick / 40) % 6;
+
+        for (s32 n = 0; n < 24; n++) {
+            const u32 code = ((anim * 7 + n + (next_random() % 3)) % patterns) | 0x10000;
+            const u32 palt = code & 1;
+
+            for (i = 0; i < count; i++) {
+                if ((tiles[i].cs.code == code) && (tiles[i].state == palt)) {
+                    break;
+                }
+            }
+
+            if (i == count) {
+                i = cash_tile_pick(tiles, hist, count, code, palt, &revive);
+                assert_true(i >= 0);
+                tiles[i].cs.code = code;
+                tiles[i].state = palt;
+
+                if (revive) {
+                    // The pixels still in the tile have to be the ones asked for
+                    assert_int_equal(held[i], code);
+                } else {
+                    held[i] = code;
+                    decoded++;
+                }
+            }
+
+            tiles[i].time = lifetime;
+            life[i] = lifetime;
+        }
+
+        for (i = 0; i < count; i++) {
+            if ((life[i] != 0) && (--life[i] == 0)) {
+                cash_tile_release(tiles, hist, i, tick);
+            }
+        }
+    }
+
+    return decoded;
+}
+
+// --- Tests ---
+
+static void test_no_history_takes_first_free(void** state) {
+    (void)state;
+    s32 revive;
+
+    clear_tiles(16);
+    tiles[0].cs.code = 5;
+    tiles[1].cs.code = 6;
+    assert_int_equal(cash_tile_pick(tiles, NULL, 16, 7, 0, &revive), 2);
+    assert_false(revive);
+
+    for (s32 i = 0; i < 16; i++) {
+        tiles[i].cs.code = i;
+    }
+
+    assert_int_equal(cash_tile_pick(tiles, NULL, 16, 99, 0, &revive), -1);
+}
+
+static void test_revives_matching_tile(void** state) {
+    (void)state;
+    s32 revive;
+
+    clear_tiles(16);
+
+    for (s32 i = 0; i < 16; i++) {
+        tiles[i].cs.code = 0x20000 + i;
+        tiles[i].state = 3;
+    }
+
+    cash_tile_release(tiles, history, 9, 4);
+    cash_tile_release(tiles, history, 4, 2);
+    assert_int_equal(tiles[9].cs.code, 0xFFFFFFFF);
+    assert_int_equal(tiles[9].time, 0);
+
+    // Same pattern and palette: the old tile comes back
+    assert_int_equal(cash_tile_pick(tiles, history, 16, 0x20009, 3, &revive), 9);
+    assert_true(revive);
+
+    // A different palette is a different tile; the longest free goes first
+    assert_int_equal(cash_tile_pick(tiles, history, 16, 0x20009, 1, &revive), 4);
+    assert_false(revive);
+
+    // Tiles that were never used count as free the longest
+    cash_tile_release(tiles, history, 12, 3);
+    cash_tile_forget(&history[12], 1);
+    assert_int_equal(cash_tile_pick(tiles, history, 16, 0x30000, 0, &revive), 12);
+    assert_false(revive);
+}
+
+static void test_free_list_choice(void** state) {
+    (void)state;
+    // Free lists are built from the top index down and popped from the end
+    static const u16 list[5] = { 14, 11, 8, 5, 2 };
+    s32 revive;
+
+    clear_tiles(16);
+    assert_int_equal(cash_tile_pick_free(NULL, list, 5, 1, 0, &revive), 4);
+    assert_false(revive);
+
+    // Equal ages keep to the lowest tile, like the plain pop
+    assert_int_equal(cash_tile_pick_free(history, list, 5, 1, 0, &revive), 4);
+
+    history[2].freed = 9;
+    history[5].freed = 7;
+    history[11].freed = 8;
+    history[8].freed = 8;
+    history[14].freed = 10;
+    assert_int_equal(cash_tile_pick_free(history, list, 5, 1, 0, &revive), 3);
+
+    history[14].cs.code = 1;
+    history[14].state = 0;
+    assert_int_equal(cash_tile_pick_free(history, list, 5, 1, 0, &revive), 0);
+    assert_true(revive);
+}
+
+static void test_history_cuts_decoding(void** state) {
+    (void)state;
+    s32 plain;
+    s32 kept;
+
+    seed = 3;
+    plain = run_plain_cache(NULL, TILES, 120, 8);
+    seed = 3;
+    kept = run_plain_cache(history, TILES, 120, 8);
+
+    // With room for every pattern, nothing is decoded twice
+    assert_int_equal(kept, TRACE_PATTERNS);
+    assert_true(plain > kept * 4);
+
+    // A cache too small for the working set still never shows stale pixels
+    seed = 4;
+    run_plain_cache(history, 64, 200, 2);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_no_history_takes_first_free),
+        cmocka_unit_test(test_revives_matching_tile),
+        cmocka_unit_test(test_free_list_choice),
+        cmocka_unit_test(test_history_cuts_decoding),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
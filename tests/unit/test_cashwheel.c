@@ -0,0 +1,146 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include "sf33rd/Source/Game/rendering/cashwheel.h"
+
+#define ENTRIES 3200 // Largest plain cache: 4 pages of 16x16 and 34 of 32x32 tiles
+#define FRAMES 6000
+
+static CashWheelLink links[ENTRIES];
+static s16 countdown[ENTRIES];
+static u8 expired[ENTRIES];
+
+static u32 seed;
+
+static u32 next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// The per-frame countdown mlt_obj_trans_update and texture_cash_update used
+// to run over every entry
+static void legacy_update(s32 count) {
+    for (s32 i = 0; i < count; i++) {
+        if (countdown[i]) {
+            if (--countdown[i] == 0) {
+                expired[i] |= 1;
+            }
+        }
+    }
+}
+
+static void wheel_update(CashWheel* cw) {
+    s32 ix;
+
+    cash_wheel_advance(cw);
+
+    while ((ix = cash_wheel_pop(cw)) >= 0) {
+        assert_true(ix < cw->count);
+        assert_false(expired[ix] & 2);
+        expired[ix] |= 2;
+    }
+}
+
+// Replays a frame-by-frame trace of cache hits through both agers: `touches`
+// entries per frame, a hot set that is hit most frames and a cold tail
+static void run_trace(s32 count, const s32* lives, s32 life_count, s32 touches) {
+    CashWheel cw;
+
+    memset(countdown, 0, sizeof(countdown));
+    cash_wheel_init(&cw, links, count);
+
+    for (s32 frame = 0; frame < FRAMES; frame++) {
+        const s32 life = lives[(frame / 500) % life_count];
+
+        for (s32 n = 0; n < touches; n++) {
+            const s32 ix = (next_random() % 4) ? (s32)(next_random() % 64) : (s32)(next_random() % count);
+
+            countdown[ix] = life;
+            cash_wheel_set(&cw, ix, life);
+        }
+
+        // A cache clear in the middle of the trace
+        if (frame == FRAMES / 2) {
+            memset(countdown, 0, sizeof(countdown));
+            cash_wheel_init(&cw, links, count);
+        }
+
+        memset(expired, 0, sizeof(expired));
+        legacy_update(count);
+        wheel_update(&cw);
+
+        for (s32 i = 0; i < count; i++) {
+            assert_true((expired[i] == 0) || (expired[i] == 3));
+            assert_int_equal(cash_wheel_left(&cw, i), countdown[i]);
+        }
+
+        assert_int_equal(cash_wheel_check(&cw), 0);
+    }
+}
+
+// --- Tests ---
+
+static void test_wheel_matches_countdown(void** state) {
+    (void)state;
+    // Every cache lifetime in mts_base
+    const s32 lives[] = { 2, 4, 8, 10, 12, 16, 20 };
+
+    seed = 1;
+    run_trace(ENTRIES, lives, sizeof(lives) / sizeof(lives[0]), 40);
+    run_trace(64, lives, sizeof(lives) / sizeof(lives[0]), 6);
+}
+
+static void test_long_and_zero_lives(void** state) {
+    (void)state;
+    // 0 never expires; lives past the wheel size wait out extra turns
+    const s32 lives[] = { 0, 1, CASH_WHEEL_SIZE - 1, CASH_WHEEL_SIZE, CASH_WHEEL_SIZE + 1, 100 };
+
+    seed = 2;
+    run_trace(ENTRIES, lives, sizeof(lives) / sizeof(lives[0]), 40);
+}
+
+static void test_check_finds_broken_lists(void** state) {
+    (void)state;
+    CashWheel cw;
+
+    cash_wheel_init(&cw, links, 16);
+    cash_wheel_set(&cw, 3, 5);
+    cash_wheel_set(&cw, 4, 5);
+    cash_wheel_set(&cw, 5, 9);
+    assert_int_equal(cash_wheel_check(&cw), 0);
+
+    // Entry marked as set but in no list
+    links[7].be = 1;
+    assert_int_not_equal(cash_wheel_check(&cw), 0);
+    links[7].be = 0;
+
+    // Back link out of step
+    links[3].prev = 9;
+    assert_int_not_equal(cash_wheel_check(&cw), 0);
+    links[3].prev = 4;
+    assert_int_equal(cash_wheel_check(&cw), 0);
+
+    // Overdue entry left behind
+    for (s32 i = 0; i < 5; i++) {
+        cash_wheel_advance(&cw);
+    }
+    assert_int_not_equal(cash_wheel_check(&cw), 0);
+    assert_int_equal(cash_wheel_pop(&cw), 4);
+    assert_int_equal(cash_wheel_pop(&cw), 3);
+    assert_int_equal(cash_wheel_pop(&cw), -1);
+    assert_int_equal(cash_wheel_check(&cw), 0);
+    assert_int_equal(cash_wheel_left(&cw, 5), 4);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_wheel_matches_countdown),
+        cmocka_unit_test(test_long_and_zero_lives),
+        cmocka_unit_test(test_check_finds_broken_lists),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,88 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "port/content_hash.h"
+
+static void fill(uint8_t* data, size_t size, uint32_t seed) {
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+// --- Tests ---
+
+static void test_same_content_same_hash(void** state) {
+    (void)state;
+    uint8_t a[1024];
+    uint8_t b[1024 + 8];
+    fill(a, sizeof(a), 1);
+
+    // Misaligned copy of the same bytes
+    memcpy(b + 3, a, sizeof(a));
+    assert_true(ContentHash_Compute(a, sizeof(a)) == ContentHash_Compute(b + 3, sizeof(a)));
+}
+
+static void test_every_byte_is_covered(void** state) {
+    (void)state;
+    // Odd size exercises the 32-byte lanes, the 8-byte words and the byte tail
+    enum { SIZE = 32 * 5 + 8 * 3 + 5 };
+    uint8_t data[SIZE];
+    fill(data, sizeof(data), 2);
+    const uint64_t original = ContentHash_Compute(data, sizeof(data));
+
+    for (size_t i = 0; i < SIZE; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            data[i] ^= (uint8_t)(1u << bit);
+            assert_true(ContentHash_Compute(data, sizeof(data)) != original);
+            data[i] ^= (uint8_t)(1u << bit);
+        }
+    }
+    assert_true(ContentHash_Compute(data, sizeof(data)) == original);
+}
+
+static void test_length_is_part_of_the_hash(void** state) {
+    (void)state;
+    uint8_t zeros[64] = { 0 };
+    assert_true(ContentHash_Compute(zeros, 32) != ContentHash_Compute(zeros, 33));
+    assert_true(ContentHash_Compute(zeros, 0) != ContentHash_Compute(zeros, 1));
+}
+
+static void test_palette_edits_are_detected(void** state) {
+    (void)state;
+    // A palette fade: every color darkened by one step
+    uint32_t palette[256];
+    for (int i = 0; i < 256; i++) {
+        palette[i] = 0x80000000u | (uint32_t)(i * 0x010101);
+    }
+    const uint64_t before = ContentHash_Compute(palette, sizeof(palette));
+
+    for (int i = 1; i < 256; i++) {
+        palette[i] -= 0x010101;
+    }
+    assert_true(ContentHash_Compute(palette, sizeof(palette)) != before);
+
+    // Swapping two colors keeps the same bytes but not the same hash
+    for (int i = 1; i < 256; i++) {
+        palette[i] += 0x010101;
+    }
+    const uint32_t tmp = palette[10];
+    palette[10] = palette[20];
+    palette[20] = tmp;
+    assert_true(ContentHash_Compute(palette, sizeof(palette)) != before);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_same_content_same_hash),
+        cmocka_unit_test(test_every_byte_is_covered),
+        cmocka_unit_test(test_length_is_part_of_the_hash),
+        cmocka_unit_test(test_palette_edits_are_detected),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
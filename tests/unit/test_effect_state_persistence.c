@@ -8,6 +8,7 @@
 #include "netplay/netplay.h"
 #include "sf33rd/Source/Game/effect/effect.h"
 #include "gekkonet.h"
+#include "game_state.h"
 
 // Externs for functions made non-static
 void save_state(GekkoGameEvent* event);
@@ -24,11 +25,11 @@ static void test_effect_persistence(void **state) {
 
     // 2. Save
     GekkoGameEvent event;
-    State saved_state_storage;
+    RollbackState saved_state_storage;
     // Initialize storage to 0 to avoid garbage
-    memset(&saved_state_storage, 0, sizeof(State));
+    memset(&saved_state_storage, 0, sizeof(RollbackState));
     
-    size_t len = sizeof(State);
+    size_t len = sizeof(RollbackState);
     uint32_t checksum = 0;
 
     event.type = SaveEvent;
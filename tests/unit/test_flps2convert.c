@@ -0,0 +1,161 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sf33rd/AcrSDK/common/prilay.h"
+#include "sf33rd/AcrSDK/ps2/flps2convert.h"
+
+#define MAX_PIXELS (256 * 256)
+
+// rl, rs, rm, gl, gs, gm, bl, bs, bm, al, as, am
+static const PixelFormat argb1555 = { 5, 0xA, 0x1F, 5, 5, 0x1F, 5, 0, 0x1F, 1, 0xF, 1 };
+static const PixelFormat rgb565 = { 5, 0xB, 0x1F, 6, 5, 0x3F, 5, 0, 0x1F, 0, 0, 0 };
+static const PixelFormat argb4444 = { 4, 8, 0xF, 4, 4, 0xF, 4, 0, 0xF, 4, 0xC, 0xF };
+static const PixelFormat rgb888 = { 8, 0x10, 0xFF, 8, 8, 0xFF, 8, 0, 0xFF, 0, 0, 0 };
+static const PixelFormat argb8888 = { 8, 0x10, 0xFF, 8, 8, 0xFF, 8, 0, 0xFF, 8, 0x18, 0xFF };
+static const PixelFormat gs_ct16 = { 5, 0, 0x1F, 5, 5, 0x1F, 5, 0xA, 0x1F, 1, 0xF, 1 };
+static const PixelFormat gs_ct24 = { 8, 0, 0xFF, 8, 8, 0xFF, 8, 0x10, 0xFF, 0, 0, 0 };
+static const PixelFormat gs_ct32 = { 8, 0, 0xFF, 8, 8, 0xFF, 8, 0x10, 0xFF, 8, 0x18, 0xFF };
+
+typedef struct {
+    const PixelFormat* src;
+    const PixelFormat* dst;
+    s32 bitdepth;
+} FormatPair;
+
+static u8 src_buf[MAX_PIXELS * 4];
+static u8 fast_buf[MAX_PIXELS * 4];
+static u8 generic_buf[MAX_PIXELS * 4];
+
+static plContext context(const PixelFormat* format, s32 bitdepth, s32 width, s32 height, void* ptr) {
+    plContext c = { 0 };
+    c.width = width;
+    c.height = height;
+    c.bitdepth = bitdepth;
+    c.pitch = width * bitdepth;
+    c.ptr = ptr;
+    c.pixelformat = *format;
+    return c;
+}
+
+// 16-bit sources get every value once over the full surface; wider ones get
+// noise with every alpha value in turn
+static void fill_source(s32 bitdepth, s32 count, u32 seed) {
+    for (s32 i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+
+        if (bitdepth == 2) {
+            ((u16*)src_buf)[i] = (count == MAX_PIXELS) ? (u16)i : (u16)(seed >> 16);
+        } else {
+            const u32 pixel = ((seed >> 8) & 0xFFFFFF) | ((u32)i << 24);
+            memcpy(src_buf + i * bitdepth, &pixel, bitdepth);
+        }
+    }
+
+    // Destinations start out identical so untouched bytes compare equal too
+    memset(fast_buf, 0xCD, sizeof(fast_buf));
+    memset(generic_buf, 0xCD, sizeof(generic_buf));
+}
+
+// --- Tests ---
+
+static void test_creation_kernels_match_generic(void** state) {
+    (void)state;
+    const FormatPair pairs[] = {
+        { &argb1555, &gs_ct16, 2 },
+        { &rgb565, &gs_ct16, 2 },
+        { &argb4444, &gs_ct16, 2 },
+        { &argb8888, &gs_ct32, 4 },
+    };
+
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        const s32 bitdepth = pairs[p].bitdepth;
+
+        // Textures (odd width exercises the scalar tail) and 16-wide palettes
+        const s32 sizes[][2] = { { 256, 256 }, { 37, 3 }, { 8, 2 } };
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            fill_source(bitdepth, sizes[s][0] * sizes[s][1], (u32)(p * 10 + s));
+            plContext src = context(pairs[p].src, bitdepth, sizes[s][0], sizes[s][1], src_buf);
+            plContext fast = context(pairs[p].dst, bitdepth, sizes[s][0], sizes[s][1], fast_buf);
+            plContext generic = context(pairs[p].dst, bitdepth, sizes[s][0], sizes[s][1], generic_buf);
+
+            assert_non_null(flPS2GetConvertKernel(&src, &fast, 0, 0));
+            flPS2ConvertContext(&src, &fast, 0, 0);
+            flPS2ConvertContextGeneric(&src, &generic, 0, 0);
+            assert_memory_equal(fast_buf, generic_buf, sizeof(fast_buf));
+        }
+
+        // 256-entry palettes with the CLUT swizzle, many times over
+        for (u32 seed = 0; seed < 64; seed++) {
+            fill_source(bitdepth, 256, seed);
+            plContext src = context(pairs[p].src, bitdepth, 256, 1, src_buf);
+            plContext fast = context(pairs[p].dst, bitdepth, 16, 16, fast_buf);
+            plContext generic = context(pairs[p].dst, bitdepth, 16, 16, generic_buf);
+
+            assert_non_null(flPS2GetConvertKernel(&src, &fast, 0, 1));
+            flPS2ConvertContext(&src, &fast, 0, 1);
+            flPS2ConvertContextGeneric(&src, &generic, 0, 1);
+            assert_memory_equal(fast_buf, generic_buf, sizeof(fast_buf));
+        }
+    }
+}
+
+static void test_lock_kernels_match_plConvertContext(void** state) {
+    (void)state;
+    const FormatPair pairs[] = {
+        { &gs_ct16, &argb1555, 2 }, { &argb1555, &gs_ct16, 2 }, { &gs_ct24, &rgb888, 3 },
+        { &rgb888, &gs_ct24, 3 },   { &gs_ct32, &argb8888, 4 }, { &argb8888, &gs_ct32, 4 },
+    };
+
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        const s32 bitdepth = pairs[p].bitdepth;
+        fill_source(bitdepth, MAX_PIXELS, (u32)p);
+        plContext src = context(pairs[p].src, bitdepth, 256, 256, src_buf);
+        plContext fast = context(pairs[p].dst, bitdepth, 256, 256, fast_buf);
+        plContext generic = context(pairs[p].dst, bitdepth, 256, 256, generic_buf);
+
+        assert_non_null(flPS2GetLockKernel(&fast, &src));
+        flPS2ConvertLockContext(&fast, &src);
+        plConvertContext(&generic, &src);
+        assert_memory_equal(fast_buf, generic_buf, sizeof(fast_buf));
+    }
+}
+
+static void test_other_conversions_fall_back(void** state) {
+    (void)state;
+    fill_source(2, 64, 3);
+
+    // A pair without a kernel
+    plContext src = context(&rgb565, 2, 64, 1, src_buf);
+    plContext fast = context(&argb1555, 2, 64, 1, fast_buf);
+    plContext generic = context(&argb1555, 2, 64, 1, generic_buf);
+    assert_null(flPS2GetConvertKernel(&src, &fast, 0, 0));
+    flPS2ConvertContext(&src, &fast, 0, 0);
+    flPS2ConvertContextGeneric(&src, &generic, 0, 0);
+    assert_memory_equal(fast_buf, generic_buf, sizeof(fast_buf));
+
+    // GS -> host, and a CLUT that isn't a whole number of 32-entry blocks
+    src = context(&argb1555, 2, 8, 2, src_buf);
+    fast = context(&gs_ct16, 2, 8, 2, fast_buf);
+    assert_null(flPS2GetConvertKernel(&src, &fast, 1, 0));
+    assert_null(flPS2GetConvertKernel(&src, &fast, 0, 1));
+
+    // Raw contexts keep plConvertContext's copy semantics
+    src = context(&gs_ct16, 2, 8, 2, src_buf);
+    fast = context(&argb1555, 2, 8, 2, fast_buf);
+    src.desc = fast.desc = 4;
+    assert_null(flPS2GetLockKernel(&fast, &src));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_creation_kernels_match_generic),
+        cmocka_unit_test(test_lock_kernels_match_plConvertContext),
+        cmocka_unit_test(test_other_conversions_fall_back),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,125 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "port/sdl/sdl_frame_pacer.h"
+
+#define FRAME_NS 16778000ULL // 59.6 Hz
+#define FRAMES 60
+
+// Timing bounds are deliberately loose: CI machines are noisy, and these tests
+// check the pacer's behaviour rather than the host's scheduler.
+
+static void run_frames(int frames, Uint64 work_ns) {
+    for (int i = 0; i < frames; i++) {
+        const Uint64 start = SDL_GetTicksNS();
+        while (SDL_GetTicksNS() - start < work_ns) {
+        }
+        SDLFramePacer_Wait(FRAME_NS);
+    }
+}
+
+// --- Tests ---
+
+static void test_sleep_mode_keeps_rate(void** state) {
+    (void)state;
+    SDLFramePacer_SetMode(FRAME_PACER_SLEEP);
+    SDLFramePacer_SetVBlankAlign(false);
+    SDLFramePacer_Init();
+
+    const Uint64 start = SDLFramePacer_Wait(FRAME_NS);
+    run_frames(FRAMES, 2000000ULL);
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+
+    SDLFramePacerStats stats;
+    SDLFramePacer_GetStats(&stats);
+    assert_int_equal(stats.frames, FRAMES);
+
+    // Absolute deadlines: no drift over the run
+    assert_true(elapsed >= FRAME_NS * (FRAMES - 1));
+    assert_true(elapsed <= FRAME_NS * (FRAMES + 3));
+    assert_true(stats.mean_interval_ms > 16.0 && stats.mean_interval_ms < 17.6);
+
+    // Only the calibrated margin is spun, never the legacy 2 ms
+    assert_true(stats.slack_us >= 20.0 && stats.slack_us <= 2000.0);
+    assert_true(stats.mean_spin_us <= stats.slack_us + 50.0);
+}
+
+static void test_spin_mode_spins_two_ms(void** state) {
+    (void)state;
+    SDLFramePacer_SetMode(FRAME_PACER_SPIN);
+    SDLFramePacer_Init();
+
+    SDLFramePacer_Wait(FRAME_NS);
+    run_frames(20, 2000000ULL);
+
+    SDLFramePacerStats stats;
+    SDLFramePacer_GetStats(&stats);
+    assert_int_equal(stats.frames, 20);
+    assert_true(stats.slack_us == 2000.0);
+    assert_true(stats.mean_spin_us > 500.0);
+
+    SDLFramePacer_SetMode(FRAME_PACER_SLEEP);
+}
+
+static void test_resyncs_after_stall(void** state) {
+    (void)state;
+    SDLFramePacer_SetMode(FRAME_PACER_SLEEP);
+    SDLFramePacer_Init();
+
+    SDLFramePacer_Wait(FRAME_NS);
+    SDL_Delay(100);
+
+    // Behind by several frames: don't burst to catch up, restart from now
+    const Uint64 before = SDL_GetTicksNS();
+    SDLFramePacer_Wait(FRAME_NS);
+    assert_true(SDL_GetTicksNS() - before < 1000000ULL);
+    const Uint64 resumed = SDL_GetTicksNS();
+    SDLFramePacer_Wait(FRAME_NS);
+    assert_true(SDL_GetTicksNS() - resumed >= FRAME_NS - 1000000ULL);
+
+    // Reset forgets the deadline entirely
+    SDLFramePacer_Reset();
+    const Uint64 after_reset = SDL_GetTicksNS();
+    SDLFramePacer_Wait(FRAME_NS);
+    assert_true(SDL_GetTicksNS() - after_reset >= FRAME_NS - 1000000ULL);
+}
+
+static void test_measures_refresh_rate(void** state) {
+    (void)state;
+    SDLFramePacer_Init();
+
+    // 60 Hz presents, with one skipped vblank
+    const Uint64 period = 16666667ULL;
+    Uint64 t = 1000000000ULL;
+    SDLFramePacer_NotePresent(t - 3000000ULL, t);
+    for (int i = 0; i < 120; i++) {
+        t += (i == 50) ? 2 * period : period;
+        SDLFramePacer_NotePresent(t - 3000000ULL, t);
+    }
+
+    SDLFramePacerStats stats;
+    SDLFramePacer_GetStats(&stats);
+    assert_true(stats.refresh_hz > 59.9 && stats.refresh_hz < 60.1);
+
+    // A present that returned without waiting for a vblank drops the estimate
+    SDLFramePacer_NotePresent(t + 500000ULL, t + 600000ULL);
+    SDLFramePacer_GetStats(&stats);
+    assert_true(stats.refresh_hz == 0.0);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_sleep_mode_keeps_rate),
+        cmocka_unit_test(test_spin_mode_spins_two_ms),
+        cmocka_unit_test(test_resyncs_after_stall),
+        cmocka_unit_test(test_measures_refresh_rate),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
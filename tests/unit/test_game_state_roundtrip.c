@@ -6,6 +6,7 @@
 #include "cmocka.h"
 
 #include "game_state.h"
+#include "sf33rd/Source/Game/effect/effect.h"
 #include "sf33rd/Source/Game/engine/plcnt.h"
 #include "sf33rd/Source/Game/engine/workuser.h"
 
@@ -74,10 +75,51 @@ static void test_roundtrip_complex(void **state) {
     assert_int_equal(plw[0].wu.position_x, 12345);
 }
 
+static void test_roundtrip_rollback_state(void **state) {
+    (void) state;
+    static RollbackState buffer;
+    memset(&buffer, 0, sizeof(RollbackState));
+
+    // Match state and the effect work kept outside GameState
+    G_No[1] = 7;
+    frw[3][10] = 0xCAFE;
+    exec_tm[2] = 42;
+    head_ix[1] = 5;
+    tail_ix[1] = 9;
+    frwque[4] = 11;
+    frwctr = 100;
+    frwctr_min = 3;
+
+    RollbackState_Save(&buffer);
+    assert_int_equal(buffer.gs.G_No[1], 7);
+    assert_true(buffer.es.frw[3][10] == 0xCAFE);
+    assert_int_equal(buffer.es.frwctr, 100);
+
+    G_No[1] = 0;
+    frw[3][10] = 0;
+    exec_tm[2] = 0;
+    head_ix[1] = 0;
+    tail_ix[1] = 0;
+    frwque[4] = 0;
+    frwctr = 0;
+    frwctr_min = 0;
+
+    RollbackState_Load(&buffer);
+    assert_int_equal(G_No[1], 7);
+    assert_true(frw[3][10] == 0xCAFE);
+    assert_int_equal(exec_tm[2], 42);
+    assert_int_equal(head_ix[1], 5);
+    assert_int_equal(tail_ix[1], 9);
+    assert_int_equal(frwque[4], 11);
+    assert_int_equal(frwctr, 100);
+    assert_int_equal(frwctr_min, 3);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_roundtrip_basic),
         cmocka_unit_test(test_roundtrip_complex),
+        cmocka_unit_test(test_roundtrip_rollback_state),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -0,0 +1,227 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <string.h>
+
+#include "sf33rd/Source/Game/engine/hitbox.h"
+
+#define SCENARIOS 20000
+
+typedef struct {
+    WORK wk;
+    UNK_1 bod;
+    UNK_2 han;
+    UNK_5 att;
+    UNK_6 hos;
+} Fighter;
+
+// hit_check_subroutine from hitcheck.c, kept verbatim as the reference
+static s16 reference_hit_check(WORK* wk1, WORK* wk2, const s16* hd1, const s16* hd2) {
+    s16 d0;
+    s16 d1;
+    s16 d2;
+    s16 d3;
+
+    d0 = *hd1++;
+    d1 = *hd1++;
+
+    if (wk1->rl_flag) {
+        d0 = -d0;
+        d0 -= d1;
+    }
+
+    d0 += wk1->xyz[0].disp.pos;
+    d2 = *hd2++;
+    d3 = *hd2++;
+
+    if (wk2->rl_flag) {
+        d2 = -d2;
+        d2 -= d3;
+    }
+
+    d2 += wk2->xyz[0].disp.pos;
+    d2 += d3 - d0;
+    d3 += d1;
+
+    if ((u32)d2 >= d3) {
+        return 0;
+    }
+
+    d0 = (wk1->xyz[1].disp.pos + *hd1++) - (wk2->xyz[1].disp.pos + *hd2++);
+    d0 += d1 = *hd1;
+    d1 += *hd2;
+
+    if ((u32)d0 >= d1) {
+        return 0;
+    }
+
+    if (d2 > (d3 - d2)) {
+        d2 = d3 - d2;
+    }
+
+    return d2;
+}
+
+static u32 seed;
+static s32 wild;
+
+static u32 next_random(void) {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+// Boxes the size of real hitbox data; in wild scenarios some values are also
+// far out of range so the 16-bit wrap-around paths get exercised
+static s16 random_value(s16 lo, s16 hi) {
+    if (wild) {
+        switch (next_random() % 8) {
+        case 0:
+            return (s16)next_random();
+
+        case 1:
+            return (s16)(0x7FFF - (next_random() % 4));
+
+        case 2:
+            return (s16)(-0x8000 + (next_random() % 4));
+        }
+    }
+
+    return (s16)(lo + (s32)(next_random() % (u32)(hi - lo + 1)));
+}
+
+static void random_box(s16* box) {
+    box[0] = random_value(-120, 120);
+    box[1] = (next_random() % 4 == 0) ? 0 : random_value(0, 100);
+    box[2] = random_value(-20, 160);
+    box[3] = random_value(0, 120);
+}
+
+static void random_fighter(Fighter* f) {
+    s32 i;
+
+    memset(f, 0, sizeof(*f));
+    f->wk.h_bod = &f->bod;
+    f->wk.h_han = &f->han;
+    f->wk.h_att = &f->att;
+    f->wk.h_hos = &f->hos;
+    f->wk.rl_flag = next_random() & 1;
+    f->wk.xyz[0].disp.pos = random_value(-300, 700);
+    f->wk.xyz[1].disp.pos = random_value(-10, 200);
+
+    for (i = 0; i < 4; i++) {
+        random_box(f->bod.body_dm[i]);
+        random_box(f->han.hand_dm[i]);
+        random_box(f->att.att_box[i]);
+    }
+
+    random_box(f->hos.hos_box);
+}
+
+// --- Tests ---
+
+static void test_overlap_matches_hit_check_subroutine(void** state) {
+    (void)state;
+    static Fighter a;
+    static Fighter d;
+    HitBoxSet as;
+    HitBoxSet ds;
+    s32 rejected = 0;
+
+    seed = 1;
+
+    for (s32 n = 0; n < SCENARIOS; n++) {
+        wild = n & 1;
+        random_fighter(&a);
+        random_fighter(&d);
+        hitbox_setup_attack(&as, &a.wk);
+        hitbox_setup_damage(&ds, &d.wk);
+
+        const s32 culled = !hitbox_bounds_overlap(&as.att_bounds, &ds.dm_bounds);
+        rejected += culled;
+
+        for (s32 lp = 0; lp < 4; lp++) {
+            for (s32 lp2 = 0; lp2 < 11; lp2++) {
+                const s16 expected = reference_hit_check(&a.wk, &d.wk, a.att.att_box[lp], ds.dm_src[lp2]);
+                assert_int_equal(hitbox_overlap(&as.att[lp], &ds.dm[lp2]), expected);
+
+                // attack_hit_check skips boxes with no width before testing them
+                if (culled && (a.att.att_box[lp][1] != 0) && (ds.dm_src[lp2][1] != 0)) {
+                    assert_int_equal(expected, 0);
+                }
+            }
+        }
+    }
+
+    // The cull has to fire for a fair share of scenarios to be worth anything
+    assert_true(rejected > SCENARIOS / 10);
+}
+
+static void test_damage_boxes_in_dmdat_order(void** state) {
+    (void)state;
+    static Fighter f;
+    HitBoxSet set;
+
+    seed = 7;
+    random_fighter(&f);
+    hitbox_setup_damage(&set, &f.wk);
+
+    for (s32 i = 0; i < 4; i++) {
+        assert_ptr_equal(set.dm_src[i], f.bod.body_dm[i]);
+        assert_ptr_equal(set.dm_src[i + 4], f.han.hand_dm[i]);
+    }
+
+    assert_ptr_equal(set.dm_src[8], f.att.att_box[2]);
+    assert_ptr_equal(set.dm_src[9], f.att.att_box[3]);
+    assert_ptr_equal(set.dm_src[10], f.hos.hos_box);
+}
+
+static void test_far_apart_workers_are_culled(void** state) {
+    (void)state;
+    static Fighter a;
+    static Fighter d;
+    HitBoxSet as;
+    HitBoxSet ds;
+    static const s16 box[4] = { 10, 40, 0, 80 };
+
+    memset(&a, 0, sizeof(a));
+    memset(&d, 0, sizeof(d));
+    a.wk.h_att = &a.att;
+    d.wk.h_bod = &d.bod;
+    d.wk.h_han = &d.han;
+    d.wk.h_att = &d.att;
+    d.wk.h_hos = &d.hos;
+    memcpy(a.att.att_box[0], box, sizeof(box));
+    memcpy(d.bod.body_dm[0], box, sizeof(box));
+    d.wk.rl_flag = 1;
+
+    // Face to face, boxes touching
+    a.wk.xyz[0].disp.pos = 100;
+    d.wk.xyz[0].disp.pos = 190;
+    hitbox_setup_attack(&as, &a.wk);
+    hitbox_setup_damage(&ds, &d.wk);
+    assert_true(hitbox_bounds_overlap(&as.att_bounds, &ds.dm_bounds));
+    assert_int_equal(hitbox_overlap(&as.att[0], &ds.dm[0]), 10);
+
+    // Out of reach
+    d.wk.xyz[0].disp.pos = 400;
+    hitbox_setup_damage(&ds, &d.wk);
+    assert_false(hitbox_bounds_overlap(&as.att_bounds, &ds.dm_bounds));
+
+    // No active attack box
+    a.att.att_box[0][1] = 0;
+    d.wk.xyz[0].disp.pos = 190;
+    hitbox_setup_attack(&as, &a.wk);
+    hitbox_setup_damage(&ds, &d.wk);
+    assert_false(hitbox_bounds_overlap(&as.att_bounds, &ds.dm_bounds));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_overlap_matches_hit_check_subroutine),
+        cmocka_unit_test(test_damage_boxes_in_dmdat_order),
+        cmocka_unit_test(test_far_apart_workers_are_culled),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
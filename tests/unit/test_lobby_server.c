@@ -0,0 +1,264 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+#include "netplay/lobby_server.h"
+#include "port/config.h"
+
+// --- Stub lobby server on loopback ---
+
+#define STUB_MAX_LOG 16
+
+static int stub_listen_sock = -1;
+static int stub_port = 0;
+static SDL_AtomicInt stub_accepts;
+static SDL_AtomicInt stub_close_next; // Answer the next request with Connection: close
+static char stub_log[STUB_MAX_LOG][128];
+static SDL_AtomicInt stub_log_count;
+static char stub_url[64];
+
+const char* Config_GetString(const char* key) {
+    if (strcmp(key, CFG_KEY_LOBBY_SERVER_URL) == 0)
+        return stub_url;
+    if (strcmp(key, CFG_KEY_LOBBY_SERVER_KEY) == 0)
+        return "test-secret";
+    return "";
+}
+
+/* Read one request (headers + Content-Length body) byte-wise so pipelined requests stay separate. */
+static bool stub_read_request(int sock, char* line0, size_t line0_size) {
+    char hdr[2048];
+    int len = 0;
+    int content_length = 0;
+
+    while (len < (int)sizeof(hdr) - 1) {
+        if (recv(sock, hdr + len, 1, 0) != 1)
+            return false;
+        len++;
+        if (len >= 4 && memcmp(hdr + len - 4, "\r\n\r\n", 4) == 0)
+            break;
+    }
+    hdr[len] = '\0';
+
+    const char* cl = strstr(hdr, "Content-Length:");
+    if (cl)
+        content_length = atoi(cl + 15);
+    for (int i = 0; i < content_length; i++) {
+        char c;
+        if (recv(sock, &c, 1, 0) != 1)
+            return false;
+    }
+
+    const char* eol = strstr(hdr, " HTTP/1.1");
+    size_t n = eol ? (size_t)(eol - hdr) : 0;
+    if (n >= line0_size)
+        n = line0_size - 1;
+    memcpy(line0, hdr, n);
+    line0[n] = '\0';
+    return true;
+}
+
+static void stub_send(int sock, const char* body, bool chunked, bool close_after) {
+    char resp[1024];
+    int n;
+    if (chunked) {
+        n = snprintf(resp,
+                     sizeof(resp),
+                     "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n%s\r\n%x\r\n%s\r\n0\r\n\r\n",
+                     close_after ? "Connection: close\r\n" : "",
+                     (unsigned)strlen(body),
+                     body);
+    } else {
+        n = snprintf(resp,
+                     sizeof(resp),
+                     "HTTP/1.1 200 OK\r\nContent-Length: %d\r\n%s\r\n%s",
+                     (int)strlen(body),
+                     close_after ? "Connection: close\r\n" : "",
+                     body);
+    }
+    send(sock, resp, n, 0);
+}
+
+static int SDLCALL stub_client_fn(void* data) {
+    int sock = (int)(intptr_t)data;
+    char line0[128];
+
+    while (stub_read_request(sock, line0, sizeof(line0))) {
+        int idx = SDL_AddAtomicInt(&stub_log_count, 1);
+        if (idx < STUB_MAX_LOG)
+            snprintf(stub_log[idx], sizeof(stub_log[idx]), "%s", line0);
+
+        bool close_after = SDL_SetAtomicInt(&stub_close_next, 0) != 0;
+
+        if (strstr(line0, "GET /searching?wait=")) {
+            stub_send(sock,
+                      "{\"version\":4,\"players\":[{\"player_id\":\"p2\",\"display_name\":\"Ken\",\"region\":\"\","
+                      "\"room_code\":\"R2\",\"connect_to\":\"\"}]}",
+                      false,
+                      close_after);
+        } else if (strstr(line0, "GET /searching")) {
+            stub_send(sock,
+                      "{\"players\":[{\"player_id\":\"p1\",\"display_name\":\"Ryu\",\"region\":\"\","
+                      "\"room_code\":\"R1\",\"connect_to\":\"\"}]}",
+                      true,
+                      close_after);
+        } else {
+            stub_send(sock, "{\"ok\":true}", false, close_after);
+        }
+
+        if (close_after)
+            break;
+    }
+
+    closesocket(sock);
+    return 0;
+}
+
+static int SDLCALL stub_accept_fn(void* data) {
+    (void)data;
+    for (;;) {
+        int client = (int)accept(stub_listen_sock, NULL, NULL);
+        if (client < 0)
+            return 0;
+        SDL_AddAtomicInt(&stub_accepts, 1);
+        SDL_DetachThread(SDL_CreateThread(stub_client_fn, "StubClient", (void*)(intptr_t)client));
+    }
+}
+
+static int setup(void** state) {
+    (void)state;
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    stub_listen_sock = (int)socket(AF_INET, SOCK_STREAM, 0);
+    bind(stub_listen_sock, (struct sockaddr*)&addr, sizeof(addr));
+    listen(stub_listen_sock, 8);
+    getsockname(stub_listen_sock, (struct sockaddr*)&addr, &addr_len);
+    stub_port = ntohs(addr.sin_port);
+    snprintf(stub_url, sizeof(stub_url), "http://127.0.0.1:%d", stub_port);
+
+    SDL_DetachThread(SDL_CreateThread(stub_accept_fn, "StubAccept", NULL));
+    LobbyServer_Init();
+    return 0;
+}
+
+static int teardown(void** state) {
+    (void)state;
+    LobbyServer_Shutdown();
+    return 0;
+}
+
+static void reset_counters(void) {
+    LobbyServer_Shutdown();
+    SDL_SetAtomicInt(&stub_accepts, 0);
+    SDL_SetAtomicInt(&stub_log_count, 0);
+}
+
+// --- Tests ---
+
+static void test_requests_reuse_one_connection(void** state) {
+    (void)state;
+    LobbyServerStats before, after;
+    LobbyPlayer players[4];
+
+    reset_counters();
+    LobbyServer_GetStats(&before);
+
+    assert_true(LobbyServer_UpdatePresence("p1", "Ryu", "", "R1", ""));
+    assert_true(LobbyServer_StartSearching("p1"));
+    assert_int_equal(LobbyServer_GetSearching(players, 4, NULL), 1); // chunked response
+    assert_string_equal(players[0].display_name, "Ryu");
+    assert_true(LobbyServer_StopSearching("p1"));
+
+    LobbyServer_GetStats(&after);
+    assert_int_equal(after.connects - before.connects, 1);
+    assert_int_equal(after.requests - before.requests, 4);
+    assert_int_equal(after.dns_lookups - before.dns_lookups, 1);
+    assert_int_equal(SDL_GetAtomicInt(&stub_accepts), 1);
+}
+
+static void test_pipelined_presence_then_search(void** state) {
+    (void)state;
+    LobbyServerStats before, after;
+
+    reset_counters();
+    LobbyServer_GetStats(&before);
+
+    assert_true(LobbyServer_UpdatePresenceAndStartSearching("p1", "Ryu", "", "R1", ""));
+
+    LobbyServer_GetStats(&after);
+    assert_int_equal(after.connects - before.connects, 1);
+    assert_int_equal(SDL_GetAtomicInt(&stub_log_count), 2);
+    assert_string_equal(stub_log[0], "POST /presence");
+    assert_string_equal(stub_log[1], "POST /searching/start");
+}
+
+static void test_reconnects_after_server_close(void** state) {
+    (void)state;
+    LobbyServerStats before, after;
+
+    reset_counters();
+    LobbyServer_GetStats(&before);
+
+    SDL_SetAtomicInt(&stub_close_next, 1);
+    assert_true(LobbyServer_UpdatePresence("p1", "Ryu", "", "R1", ""));
+    assert_true(LobbyServer_StartSearching("p1"));
+
+    LobbyServer_GetStats(&after);
+    assert_int_equal(after.connects - before.connects, 2);
+    assert_int_equal(SDL_GetAtomicInt(&stub_accepts), 2);
+}
+
+static void test_long_poll_updates_version(void** state) {
+    (void)state;
+    LobbyPlayer players[4];
+    int version = 3;
+
+    reset_counters();
+
+    int count = LobbyServer_WaitSearching(players, 4, NULL, &version, 1000);
+    assert_int_equal(count, 1);
+    assert_int_equal(version, 4);
+    assert_string_equal(players[0].player_id, "p2");
+    assert_string_equal(stub_log[0], "GET /searching?wait=3&timeout=1000");
+
+    // The long-poll connection is separate from the control connection
+    assert_true(LobbyServer_UpdatePresence("p1", "Ryu", "", "R1", ""));
+    assert_int_equal(SDL_GetAtomicInt(&stub_accepts), 2);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_requests_reuse_one_connection),
+        cmocka_unit_test(test_pipelined_presence_then_search),
+        cmocka_unit_test(test_reconnects_after_server_close),
+        cmocka_unit_test(test_long_poll_updates_version),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -3,9 +3,77 @@
 #include <setjmp.h>
 #include <stdint.h>
 #include <cmocka.h>
+#include <string.h>
 
 #include "sf33rd/Source/Common/MemMan.h"
 
+#define HEAP_SIZE (256 * 1024)
+#define HEAP_UNIT 32
+#define STRESS_SLOTS 192
+#define STRESS_OPS 20000
+
+static u8 heap_buf[HEAP_SIZE + HEAP_UNIT];
+
+/**
+ * Reference placement: the original address-ordered best-fit walk over the
+ * cell list. Returns where the new cell must land, or NULL if nothing fits.
+ */
+static struct _MEMMAN_CELL* ref_best_fit(_MEMMAN_OBJ* mmobj, ssize_t size, s32 flag) {
+    struct _MEMMAN_CELL* myself;
+    struct _MEMMAN_CELL* next;
+    struct _MEMMAN_CELL* cell = NULL;
+    ssize_t sizeTrue = mmobj->ownUnit + mmRoundUp(mmobj->ownUnit, size);
+    ptrdiff_t gapMin = 0x7FFFFFFF;
+    ptrdiff_t gap;
+
+    if (flag != 1) {
+        myself = mmobj->cell_1st;
+
+        do {
+            next = myself->next;
+            gap = (intptr_t)next - (intptr_t)myself - myself->size;
+
+            if (gap >= sizeTrue && (gap - sizeTrue) < gapMin) {
+                gapMin = gap - sizeTrue;
+                cell = myself;
+
+                if (gapMin == 0) {
+                    break;
+                }
+            }
+
+            myself = next;
+        } while (myself->next != NULL);
+
+        return cell ? (struct _MEMMAN_CELL*)((uintptr_t)cell + cell->size) : NULL;
+    }
+
+    myself = mmobj->cell_fin;
+
+    do {
+        next = myself->prev;
+        gap = (intptr_t)myself - (intptr_t)next - next->size;
+
+        if (gap >= sizeTrue && (gap - sizeTrue) < gapMin) {
+            gapMin = gap - sizeTrue;
+            cell = myself;
+
+            if (gapMin == 0) {
+                break;
+            }
+        }
+
+        myself = next;
+    } while (myself->prev != NULL);
+
+    return cell ? (struct _MEMMAN_CELL*)((uintptr_t)cell - sizeTrue) : NULL;
+}
+
+static u32 lcg_next(u32* seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return (*seed >> 8) & 0xFFFFFF;
+}
+
 static void test_mmRoundUp(void **state) {
     (void) state;
     // Align 10 to 4 -> 12
@@ -24,10 +92,94 @@ static void test_mmRoundOff(void **state) {
     assert_int_equal(mmRoundOff(16, 31), 16);
 }
 
+static void test_mmAlloc_directions(void **state) {
+    (void) state;
+    _MEMMAN_OBJ mm;
+    u8* fwd;
+    u8* rev;
+
+    mmHeapInitialize(&mm, heap_buf, HEAP_SIZE, HEAP_UNIT, "test");
+
+    fwd = mmAlloc(&mm, 100, 0);
+    rev = mmAlloc(&mm, 100, 1);
+    assert_non_null(fwd);
+    assert_non_null(rev);
+
+    // Forward allocations grow up from the head, reverse ones down from the tail
+    assert_ptr_equal(fwd, (u8*)mm.cell_1st + HEAP_UNIT * 2);
+    assert_ptr_equal(rev + HEAP_UNIT + 96, (u8*)mm.cell_fin);
+    assert_int_equal(mmGetRemainder(&mm), mm.memSize - HEAP_UNIT * 2 - (HEAP_UNIT + 128) * 2);
+
+    mmFree(&mm, fwd);
+    mmFree(&mm, rev);
+    assert_int_equal(mmGetRemainder(&mm), mm.memSize - HEAP_UNIT * 2);
+    assert_null(mmAlloc(&mm, HEAP_SIZE, 0));
+}
+
+static void test_mmAlloc_stress_matches_reference(void **state) {
+    (void) state;
+    _MEMMAN_OBJ mm;
+    MMStats stats;
+    u8* slots[STRESS_SLOTS] = { 0 };
+    struct _MEMMAN_CELL* expect;
+    u32 seed = 0x3533u;
+    ssize_t size;
+    s32 flag;
+    s32 op;
+    s32 idx;
+    u8* adrs;
+
+    mmHeapInitialize(&mm, heap_buf, HEAP_SIZE, HEAP_UNIT, "stress");
+
+    for (op = 0; op < STRESS_OPS; op++) {
+        idx = lcg_next(&seed) % STRESS_SLOTS;
+
+        if (slots[idx] != NULL) {
+            mmFree(&mm, slots[idx]);
+            slots[idx] = NULL;
+            continue;
+        }
+
+        // Mostly small requests with occasional large ones, like scene loads
+        size = (lcg_next(&seed) % 8 == 0) ? (lcg_next(&seed) % 16384) : (lcg_next(&seed) % 700);
+        flag = lcg_next(&seed) & 1;
+        expect = ref_best_fit(&mm, size, flag);
+        adrs = mmAlloc(&mm, size, flag);
+
+        if (expect == NULL) {
+            assert_null(adrs);
+            continue;
+        }
+
+        assert_ptr_equal(adrs, (u8*)expect + HEAP_UNIT);
+        memset(adrs, (u8)op, size);
+        slots[idx] = adrs;
+    }
+
+    mmGetStats(&mm, &stats);
+    assert_int_equal(stats.freeTotal, mmGetRemainder(&mm));
+    assert_true(stats.freeLargest <= stats.freeTotal);
+    assert_in_range(stats.fragmentation, 0.0f, 100.0f);
+    assert_true(stats.allocCount > 0);
+    assert_true(stats.probeMax > 0);
+
+    for (idx = 0; idx < STRESS_SLOTS; idx++) {
+        mmFree(&mm, slots[idx]);
+    }
+
+    // Everything coalesces back into a single gap
+    mmGetStats(&mm, &stats);
+    assert_int_equal(stats.freeBlocks, 1);
+    assert_int_equal(stats.freeTotal, mm.memSize - HEAP_UNIT * 2);
+    assert_true(stats.fragmentation == 0.0f);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_mmRoundUp),
         cmocka_unit_test(test_mmRoundOff),
+        cmocka_unit_test(test_mmAlloc_directions),
+        cmocka_unit_test(test_mmAlloc_stress_matches_reference),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
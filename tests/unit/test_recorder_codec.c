@@ -0,0 +1,130 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "port/recorder_codec.h"
+
+#define WIDTH 384
+#define HEIGHT 224
+
+// Fill a frame with a flat background and one moving "sprite".
+static void draw_frame(uint8_t* pixels, int sprite_x) {
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        pixels[i * 4 + 0] = 0x20;
+        pixels[i * 4 + 1] = 0x30;
+        pixels[i * 4 + 2] = 0x60;
+        pixels[i * 4 + 3] = 0xff;
+    }
+    for (int y = 100; y < 164; y++) {
+        for (int x = sprite_x; x < sprite_x + 48 && x < WIDTH; x++) {
+            uint8_t* p = &pixels[(y * WIDTH + x) * 4];
+            p[0] = (uint8_t)(x * 7);
+            p[1] = (uint8_t)(y * 3);
+            p[2] = (uint8_t)(x ^ y);
+        }
+    }
+}
+
+// --- Tests ---
+
+static void test_roundtrip_is_lossless(void** state) {
+    (void)state;
+    RecorderCodec* enc = RecorderCodec_Create(WIDTH, HEIGHT);
+    RecorderCodec* dec = RecorderCodec_Create(WIDTH, HEIGHT);
+    assert_non_null(enc);
+    assert_non_null(dec);
+
+    const size_t frame_bytes = RecorderCodec_FrameBytes(enc);
+    const size_t capacity = RecorderCodec_MaxEncodedBytes(enc);
+    uint8_t* frame = malloc(frame_bytes);
+    uint8_t* decoded = malloc(frame_bytes);
+    uint8_t* encoded = malloc(capacity);
+
+    for (int i = 0; i < 8; i++) {
+        draw_frame(frame, 10 + i * 5);
+        RecorderChunkType type;
+        const size_t size = RecorderCodec_Encode(enc, frame, false, encoded, capacity, &type);
+        assert_true(size > 0);
+        assert_int_equal(type, i == 0 ? RECORDER_CHUNK_VIDEO_KEY : RECORDER_CHUNK_VIDEO_DELTA);
+
+        assert_true(RecorderCodec_Decode(dec, type, encoded, size, decoded));
+        assert_memory_equal(frame, decoded, frame_bytes);
+    }
+
+    // Repeats show the previous frame again
+    memset(decoded, 0, frame_bytes);
+    assert_true(RecorderCodec_Decode(dec, RECORDER_CHUNK_VIDEO_REPEAT, NULL, 0, decoded));
+    assert_memory_equal(frame, decoded, frame_bytes);
+
+    free(frame);
+    free(decoded);
+    free(encoded);
+    RecorderCodec_Destroy(enc);
+    RecorderCodec_Destroy(dec);
+}
+
+static void test_deltas_are_compact(void** state) {
+    (void)state;
+    RecorderCodec* enc = RecorderCodec_Create(WIDTH, HEIGHT);
+    const size_t frame_bytes = RecorderCodec_FrameBytes(enc);
+    const size_t capacity = RecorderCodec_MaxEncodedBytes(enc);
+    uint8_t* frame = malloc(frame_bytes);
+    uint8_t* encoded = malloc(capacity);
+    RecorderChunkType type;
+
+    draw_frame(frame, 10);
+    const size_t key_size = RecorderCodec_Encode(enc, frame, false, encoded, capacity, &type);
+    draw_frame(frame, 12);
+    const size_t delta_size = RecorderCodec_Encode(enc, frame, false, encoded, capacity, &type);
+    const size_t same_size = RecorderCodec_Encode(enc, frame, false, encoded, capacity, &type);
+
+    assert_true(key_size < frame_bytes / 4);
+    assert_true(delta_size < key_size);
+    assert_true(same_size <= delta_size);
+
+    // Forced key frames ignore the reference
+    const size_t forced = RecorderCodec_Encode(enc, frame, true, encoded, capacity, &type);
+    assert_int_equal(type, RECORDER_CHUNK_VIDEO_KEY);
+    assert_true(forced > 0);
+
+    free(frame);
+    free(encoded);
+    RecorderCodec_Destroy(enc);
+}
+
+static void test_decoder_rejects_bad_input(void** state) {
+    (void)state;
+    RecorderCodec* dec = RecorderCodec_Create(WIDTH, HEIGHT);
+    uint8_t* pixels = malloc(RecorderCodec_FrameBytes(dec));
+    const uint8_t garbage[16] = { 0x78, 0x01, 0xde, 0xad, 0xbe, 0xef };
+
+    // No reference yet
+    assert_false(RecorderCodec_Decode(dec, RECORDER_CHUNK_VIDEO_DELTA, garbage, sizeof(garbage), pixels));
+    assert_false(RecorderCodec_Decode(dec, RECORDER_CHUNK_VIDEO_REPEAT, NULL, 0, pixels));
+    assert_false(RecorderCodec_Decode(dec, RECORDER_CHUNK_VIDEO_KEY, garbage, sizeof(garbage), pixels));
+    assert_false(RecorderCodec_Decode(dec, RECORDER_CHUNK_AUDIO, garbage, sizeof(garbage), pixels));
+
+    free(pixels);
+    RecorderCodec_Destroy(dec);
+}
+
+static void test_file_layout_is_packed(void** state) {
+    (void)state;
+    // tools/rec2video.py reads these with fixed struct formats
+    assert_int_equal(sizeof(RecorderFileHeader), 32);
+    assert_int_equal(sizeof(RecorderChunkHeader), 24);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_roundtrip_is_lossless),
+        cmocka_unit_test(test_deltas_are_compact),
+        cmocka_unit_test(test_decoder_rejects_bad_input),
+        cmocka_unit_test(test_file_layout_is_packed),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,163 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "port/sdl/sdl_render_pipeline.h"
+
+#define BUDGET_NS 16666667ULL
+
+// --- Mocks ---
+
+static SDL_ThreadID recording_thread = 0;
+static SDL_AtomicInt logic_frames;
+static SDL_ThreadID logic_thread_seen = 0;
+
+void SDLGameRenderer_SetRecordingThread(SDL_ThreadID thread) {
+    recording_thread = thread;
+}
+
+static void fake_logic_frame(void) {
+    logic_thread_seen = SDL_GetCurrentThreadID();
+    SDL_Delay(2);
+    SDL_AddAtomicInt(&logic_frames, 1);
+}
+
+static void feed_frames(int count, bool pipelined, Uint64 work_ns) {
+    for (int i = 0; i < count; i++) {
+        SDLRenderPipeline_EndFrame(pipelined, work_ns, BUDGET_NS);
+    }
+}
+
+// --- Tests ---
+
+static void test_histogram_percentiles(void** state) {
+    (void)state;
+    RenderPipelineHistogram hist;
+    memset(&hist, 0, sizeof(hist));
+
+    // 90 frames at 16.6 ms, 9 at 20.2 ms, one 100 ms hitch
+    for (int i = 0; i < 90; i++)
+        SDLRenderPipeline_HistogramAdd(&hist, 16600000ULL);
+    for (int i = 0; i < 9; i++)
+        SDLRenderPipeline_HistogramAdd(&hist, 20200000ULL);
+    SDLRenderPipeline_HistogramAdd(&hist, 100000000ULL);
+
+    assert_int_equal(hist.frames, 100);
+    assert_int_equal(hist.max_ns, 100000000ULL);
+    assert_int_equal(hist.buckets[RENDER_PIPELINE_HISTOGRAM_BUCKETS - 1], 1);
+
+    assert_int_equal(SDLRenderPipeline_HistogramPercentile(&hist, 50.0), 17000000ULL);
+    assert_int_equal(SDLRenderPipeline_HistogramPercentile(&hist, 95.0), 20500000ULL);
+    assert_int_equal(SDLRenderPipeline_HistogramPercentile(&hist, 100.0), 100000000ULL);
+}
+
+static void test_off_runs_serially(void** state) {
+    (void)state;
+    SDLRenderPipeline_SetMode(RENDER_PIPELINE_OFF);
+    assert_true(SDLRenderPipeline_Init(fake_logic_frame));
+
+    feed_frames(120, false, BUDGET_NS * 2);
+    assert_false(SDLRenderPipeline_WantPipelined());
+    assert_int_equal(SDLRenderPipeline_GetHistogram(false)->frames, 119);
+
+    SDLRenderPipeline_Shutdown();
+}
+
+static void test_on_runs_logic_on_worker(void** state) {
+    (void)state;
+    SDL_SetAtomicInt(&logic_frames, 0);
+    SDLRenderPipeline_SetMode(RENDER_PIPELINE_ON);
+    assert_true(SDLRenderPipeline_Init(fake_logic_frame));
+    assert_true(SDLRenderPipeline_WantPipelined());
+
+    for (int i = 0; i < 5; i++) {
+        SDLRenderPipeline_Kick();
+        assert_true(SDLRenderPipeline_IsInFlight());
+        SDLRenderPipeline_Wait();
+        assert_false(SDLRenderPipeline_IsInFlight());
+    }
+
+    assert_int_equal(SDL_GetAtomicInt(&logic_frames), 5);
+    assert_true(SDLRenderPipeline_GetLastLogicNS() >= 1000000ULL);
+    assert_true(logic_thread_seen != SDL_GetCurrentThreadID());
+    assert_true(recording_thread == logic_thread_seen);
+
+    // Shutdown drains a frame still in flight
+    SDLRenderPipeline_Kick();
+    SDLRenderPipeline_Shutdown();
+    assert_int_equal(SDL_GetAtomicInt(&logic_frames), 6);
+}
+
+static void test_deferred_kick_waits_for_release(void** state) {
+    (void)state;
+    SDL_SetAtomicInt(&logic_frames, 0);
+    SDLRenderPipeline_SetMode(RENDER_PIPELINE_ON);
+    assert_true(SDLRenderPipeline_Init(fake_logic_frame));
+
+    // Held while the main thread still reads game state
+    SDLRenderPipeline_KickDeferred();
+    assert_true(SDLRenderPipeline_IsInFlight());
+    SDL_Delay(20);
+    assert_int_equal(SDL_GetAtomicInt(&logic_frames), 0);
+
+    SDLRenderPipeline_ReleaseKick();
+    SDLRenderPipeline_ReleaseKick(); // Only the first release starts a frame
+    SDLRenderPipeline_Wait();
+    assert_int_equal(SDL_GetAtomicInt(&logic_frames), 1);
+
+    // Waiting on a frame nobody released starts it rather than blocking forever
+    SDLRenderPipeline_KickDeferred();
+    SDLRenderPipeline_Wait();
+    assert_false(SDLRenderPipeline_IsInFlight());
+    assert_int_equal(SDL_GetAtomicInt(&logic_frames), 2);
+
+    SDLRenderPipeline_Shutdown();
+}
+
+static void test_auto_switches_with_hysteresis(void** state) {
+    (void)state;
+    SDLRenderPipeline_SetMode(RENDER_PIPELINE_AUTO);
+    assert_true(SDLRenderPipeline_Init(fake_logic_frame));
+
+    // Fits comfortably: stay serial (zero added latency)
+    feed_frames(200, false, BUDGET_NS / 2);
+    assert_false(SDLRenderPipeline_WantPipelined());
+
+    // Occasional single miss isn't enough
+    feed_frames(1, false, BUDGET_NS);
+    feed_frames(100, false, BUDGET_NS / 2);
+    assert_false(SDLRenderPipeline_WantPipelined());
+
+    // Repeated misses start pipelining
+    feed_frames(3, false, BUDGET_NS + BUDGET_NS / 4);
+    assert_true(SDLRenderPipeline_WantPipelined());
+
+    // Work that would only just fit serially keeps the pipeline
+    feed_frames(600, true, BUDGET_NS * 8 / 10);
+    assert_true(SDLRenderPipeline_WantPipelined());
+
+    // A sustained comfortable stretch goes back to serial
+    feed_frames(299, true, BUDGET_NS / 2);
+    assert_true(SDLRenderPipeline_WantPipelined());
+    feed_frames(1, true, BUDGET_NS / 2);
+    assert_false(SDLRenderPipeline_WantPipelined());
+
+    SDLRenderPipeline_Shutdown();
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_histogram_percentiles),
+        cmocka_unit_test(test_off_runs_serially),
+        cmocka_unit_test(test_on_runs_logic_on_worker),
+        cmocka_unit_test(test_deferred_kick_waits_for_release),
+        cmocka_unit_test(test_auto_switches_with_hysteresis),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
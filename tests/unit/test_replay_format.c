@@ -0,0 +1,245 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "port/replay_format.h"
+
+#define CODE(key, frames) ((uint16_t)((((frames) - 1) << 12) | (key)))
+
+// A neutral stretch split over several codes, a button press, then a
+// direction held across code boundaries: the game's recorder caps runs at 16.
+static const uint16_t p1_codes[] = {
+    CODE(0x000, 16), CODE(0x000, 16), CODE(0x000, 3), CODE(0x010, 1), CODE(0x002, 16), CODE(0x002, 5), CODE(0x000, 1),
+};
+static const uint16_t p2_codes[] = { CODE(0x001, 16), CODE(0x001, 16), CODE(0x001, 16), CODE(0x001, 16) };
+
+static void counts_of(uint32_t counts[2]) {
+    counts[0] = sizeof(p1_codes) / sizeof(p1_codes[0]);
+    counts[1] = sizeof(p2_codes) / sizeof(p2_codes[0]);
+}
+
+// --- Tests ---
+
+static void test_input_round_trip(void** state) {
+    (void)state;
+    const uint16_t* codes[2] = { p1_codes, p2_codes };
+    uint32_t counts[2];
+    counts_of(counts);
+
+    size_t size = 0;
+    uint8_t* payload = ReplayFormat_EncodeInput(codes, counts, &size);
+    assert_non_null(payload);
+
+    // Merged runs: p1 is 4 runs of 2 bytes each, p2 one run (key 1, 64 frames)
+    assert_int_equal(size, 1 + 4 * 2 + 1 + 2);
+
+    uint16_t* decoded[2];
+    uint32_t decoded_counts[2];
+    assert_true(ReplayFormat_DecodeInput(payload, size, decoded, decoded_counts));
+
+    // Re-split at 16 frames reproduces the recorder's codes exactly
+    assert_int_equal(decoded_counts[0], counts[0]);
+    assert_int_equal(decoded_counts[1], counts[1]);
+    assert_memory_equal(decoded[0], p1_codes, sizeof(p1_codes));
+    assert_memory_equal(decoded[1], p2_codes, sizeof(p2_codes));
+    assert_int_equal(ReplayFormat_CountFrames(decoded[0], decoded_counts[0]), 58);
+
+    free(decoded[0]);
+    free(decoded[1]);
+    free(payload);
+}
+
+static void test_long_runs_use_multibyte_varints(void** state) {
+    (void)state;
+    // 100k frames of one key: far past the PS2 key_buff
+    const uint32_t n = 100000 / 16;
+    uint16_t* log = malloc(n * sizeof(uint16_t));
+    for (uint32_t i = 0; i < n; i++) {
+        log[i] = CODE(0x123, 16);
+    }
+    const uint16_t* codes[2] = { log, NULL };
+    const uint32_t counts[2] = { n, 0 };
+
+    size_t size = 0;
+    uint8_t* payload = ReplayFormat_EncodeInput(codes, counts, &size);
+    assert_non_null(payload);
+    assert_int_equal(size, 1 + 2 + 3 + 1);
+
+    uint16_t* decoded[2];
+    uint32_t decoded_counts[2];
+    assert_true(ReplayFormat_DecodeInput(payload, size, decoded, decoded_counts));
+    assert_int_equal(decoded_counts[0], n);
+    assert_int_equal(decoded_counts[1], 0);
+    assert_null(decoded[1]);
+    assert_memory_equal(decoded[0], log, n * sizeof(uint16_t));
+
+    free(decoded[0]);
+    free(payload);
+    free(log);
+}
+
+static void test_corrupt_input_is_rejected(void** state) {
+    (void)state;
+    uint16_t* decoded[2];
+    uint32_t decoded_counts[2];
+
+    // Truncated: one run promised, none present
+    const uint8_t truncated[] = { 0x01 };
+    assert_false(ReplayFormat_DecodeInput(truncated, sizeof(truncated), decoded, decoded_counts));
+
+    // Key wider than 12 bits
+    const uint8_t wide_key[] = { 0x01, 0x80, 0x20, 0x01, 0x00 };
+    assert_false(ReplayFormat_DecodeInput(wide_key, sizeof(wide_key), decoded, decoded_counts));
+
+    // Zero-length run
+    const uint8_t empty_run[] = { 0x01, 0x05, 0x00, 0x00 };
+    assert_false(ReplayFormat_DecodeInput(empty_run, sizeof(empty_run), decoded, decoded_counts));
+}
+
+static void test_seek_matches_linear_walk(void** state) {
+    (void)state;
+    // 2000 frames with a code boundary every 7 frames
+    enum { N = 2000 / 7 + 1 };
+    uint16_t log[N];
+    for (int i = 0; i < N; i++) {
+        log[i] = CODE(i & 0xFFF, 7);
+    }
+    const uint16_t* codes[2] = { log, p2_codes };
+    uint32_t counts[2];
+    counts_of(counts);
+    counts[0] = N;
+
+    const uint32_t frames = ReplayFormat_CountFrames(log, N);
+    size_t point_count = 0;
+    ReplaySeekPoint* points = ReplayFormat_BuildSeekPoints(codes, counts, frames, &point_count);
+    assert_int_equal(point_count, (frames - 1) / REPLAY_SEEK_INTERVAL + 1);
+    assert_int_equal(points[1].frame, REPLAY_SEEK_INTERVAL);
+    assert_int_equal(points[1].code[0], REPLAY_SEEK_INTERVAL / 7);
+    assert_int_equal(points[1].elapsed[0], REPLAY_SEEK_INTERVAL % 7);
+    assert_int_equal(points[1].code[1], counts[1]); // P2's 64 frames ended long before
+
+    const uint32_t targets[] = { 0, 1, 599, 600, 601, 1337, frames - 1 };
+    for (size_t t = 0; t < sizeof(targets) / sizeof(targets[0]); t++) {
+        ReplaySeekPoint at;
+        assert_true(ReplayFormat_Seek(points, point_count, codes, counts, targets[t], &at));
+        assert_int_equal(at.frame, targets[t]);
+        assert_int_equal(at.code[0], targets[t] / 7);
+        assert_int_equal(at.elapsed[0], targets[t] % 7);
+    }
+
+    ReplaySeekPoint past;
+    assert_false(ReplayFormat_Seek(points, point_count, codes, counts, frames, &past));
+
+    free(points);
+}
+
+static void test_file_round_trip_skips_unknown_sections(void** state) {
+    (void)state;
+    FILE* f = tmpfile();
+    assert_non_null(f);
+
+    ReplayFileHeader header = { .magic = REPLAY_FILE_MAGIC, .version = REPLAY_FILE_VERSION, .frame_count = 58 };
+    header.meta.year = 2026;
+    header.meta.player[0] = 11;
+    header.meta.player[1] = 2;
+
+    const char setup[] = "setup bytes";
+    uint8_t keyframe[4096];
+    memset(keyframe, 0x5A, sizeof(keyframe));
+
+    assert_true(ReplayFormat_WriteHeader(f, &header));
+    assert_true(ReplayFormat_WriteSection(f, REPLAY_SECTION_SETUP, 0, setup, sizeof(setup), false));
+    assert_true(ReplayFormat_WriteSection(f, (ReplaySectionType)99, 0, "future", 6, false));
+    assert_true(ReplayFormat_WriteSection(f, REPLAY_SECTION_KEYFRAME, 600, keyframe, sizeof(keyframe), true));
+    rewind(f);
+
+    ReplayFileHeader read_header;
+    assert_true(ReplayFormat_ReadHeader(f, &read_header));
+    assert_int_equal(read_header.frame_count, 58);
+    assert_int_equal(read_header.meta.year, 2026);
+    assert_int_equal(read_header.meta.player[0], 11);
+
+    ReplaySectionHeader section;
+    assert_true(ReplayFormat_NextSection(f, &section));
+    assert_int_equal(section.type, REPLAY_SECTION_SETUP);
+    uint8_t* payload = ReplayFormat_ReadPayload(f, &section);
+    assert_memory_equal(payload, setup, sizeof(setup));
+    free(payload);
+
+    assert_true(ReplayFormat_NextSection(f, &section));
+    assert_int_equal(section.type, 99);
+    assert_true(ReplayFormat_SkipPayload(f, &section));
+
+    assert_true(ReplayFormat_NextSection(f, &section));
+    assert_int_equal(section.type, REPLAY_SECTION_KEYFRAME);
+    assert_int_equal(section.frame, 600);
+    assert_true(section.size < section.raw_size); // Deflated
+    payload = ReplayFormat_ReadPayload(f, &section);
+    assert_non_null(payload);
+    assert_memory_equal(payload, keyframe, sizeof(keyframe));
+    free(payload);
+
+    assert_false(ReplayFormat_NextSection(f, &section));
+    fclose(f);
+}
+
+static void test_v1_header_is_not_v2(void** state) {
+    (void)state;
+    FILE* f = tmpfile();
+    const uint32_t v1[4] = { REPLAY_FILE_MAGIC, REPLAY_FILE_VERSION_V1, 30000, 0 };
+    const uint8_t padding[16] = { 0 };
+    fwrite(v1, sizeof(v1), 1, f);
+    fwrite(padding, sizeof(padding), 1, f);
+    rewind(f);
+
+    ReplayFileHeader header;
+    assert_false(ReplayFormat_ReadHeader(f, &header));
+    assert_int_equal(header.version, REPLAY_FILE_VERSION_V1);
+    fclose(f);
+}
+
+static void test_index_round_trip(void** state) {
+    (void)state;
+    FILE* f = tmpfile();
+
+    ReplayIndexEntry entries[3] = { 0 };
+    for (int i = 0; i < 3; i++) {
+        entries[i].id = (uint32_t)(i * 2 + 1);
+        entries[i].frame_count = (uint32_t)(1000 * (i + 1));
+        entries[i].meta.player[0] = i;
+    }
+    assert_true(ReplayFormat_WriteIndex(f, entries, 3, 7));
+    rewind(f);
+
+    ReplayIndexEntry* read_entries;
+    uint32_t count, next_id;
+    assert_true(ReplayFormat_ReadIndex(f, &read_entries, &count, &next_id));
+    assert_int_equal(count, 3);
+    assert_int_equal(next_id, 7);
+    assert_memory_equal(read_entries, entries, sizeof(entries));
+    free(read_entries);
+
+    // Anything else is rejected so the caller rebuilds the index
+    rewind(f);
+    fwrite("garbage!", 8, 1, f);
+    rewind(f);
+    assert_false(ReplayFormat_ReadIndex(f, &read_entries, &count, &next_id));
+    fclose(f);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_input_round_trip),
+        cmocka_unit_test(test_long_runs_use_multibyte_varints),
+        cmocka_unit_test(test_corrupt_input_is_rejected),
+        cmocka_unit_test(test_seek_matches_linear_walk),
+        cmocka_unit_test(test_file_round_trip_skips_unknown_sections),
+        cmocka_unit_test(test_v1_header_is_not_v2),
+        cmocka_unit_test(test_index_round_trip),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,103 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+#include "port/replay_pacer.h"
+
+#define FRAME_NS 16666666ULL
+#define MS(x) ((uint64_t)((x) * 1000000.0))
+
+static ReplayPacer measured(double tick_ms) {
+    ReplayPacer pacer;
+    ReplayPacer_Reset(&pacer);
+    ReplayPacer_ReportTicks(&pacer, 1, MS(tick_ms));
+    return pacer;
+}
+
+// --- Tests ---
+
+static void test_unmeasured_runs_requested_speed(void** state) {
+    (void)state;
+    ReplayPacer pacer;
+    ReplayPacer_Reset(&pacer);
+
+    assert_int_equal(ReplayPacer_Plan(&pacer, 4, FRAME_NS, FRAME_NS, 0), 4);
+
+    ReplayPacer_Reset(&pacer);
+    assert_int_equal(ReplayPacer_Plan(&pacer, REPLAY_PACER_MAX_SPEED, FRAME_NS, FRAME_NS, 0), 2);
+}
+
+static void test_cheap_ticks_follow_speed(void** state) {
+    (void)state;
+    ReplayPacer pacer = measured(0.5);
+
+    for (int i = 0; i < 10; i++) {
+        assert_int_equal(ReplayPacer_Plan(&pacer, 4, FRAME_NS, FRAME_NS, MS(2)), 4);
+    }
+    assert_int_equal(ReplayPacer_Plan(&pacer, 1, FRAME_NS, FRAME_NS, MS(2)), 1);
+}
+
+static void test_expensive_ticks_are_capped_by_budget(void** state) {
+    (void)state;
+    // 15 ms budget - 2 ms render - 5 ms presented tick leaves room for one more
+    ReplayPacer pacer = measured(5.0);
+
+    for (int i = 0; i < 10; i++) {
+        assert_int_equal(ReplayPacer_Plan(&pacer, 8, FRAME_NS, FRAME_NS, MS(2)), 2);
+    }
+
+    // Missed ticks are not banked into a later burst
+    pacer.tick_ns = 0.5 * 1e6;
+    assert_int_equal(ReplayPacer_Plan(&pacer, 8, FRAME_NS, FRAME_NS, MS(2)), 8);
+}
+
+static void test_max_speed_fills_budget(void** state) {
+    (void)state;
+    ReplayPacer pacer = measured(1.0);
+    assert_int_equal(ReplayPacer_Plan(&pacer, REPLAY_PACER_MAX_SPEED, FRAME_NS, FRAME_NS, MS(1.5)), 13);
+}
+
+static void test_slow_frames_keep_real_time(void** state) {
+    (void)state;
+    // Even when a tick doesn't fit the budget, playback never falls behind 1x
+    ReplayPacer pacer = measured(20.0);
+    assert_int_equal(ReplayPacer_Plan(&pacer, 1, FRAME_NS * 2, FRAME_NS, MS(2)), 2);
+
+    // Fractional frames accumulate
+    ReplayPacer_Reset(&pacer);
+    assert_int_equal(ReplayPacer_Plan(&pacer, 1, FRAME_NS * 3 / 2, FRAME_NS, 0), 1);
+    assert_int_equal(ReplayPacer_Plan(&pacer, 1, FRAME_NS * 3 / 2, FRAME_NS, 0), 2);
+
+    // Long hitches are dropped rather than replayed
+    ReplayPacer_Reset(&pacer);
+    assert_int_equal(ReplayPacer_Plan(&pacer, 1, FRAME_NS * 100, FRAME_NS, 0), 4);
+}
+
+static void test_tick_cost_is_smoothed(void** state) {
+    (void)state;
+    ReplayPacer pacer;
+    ReplayPacer_Reset(&pacer);
+
+    ReplayPacer_ReportTicks(&pacer, 0, MS(50));
+    assert_true(pacer.tick_ns == 0.0);
+
+    ReplayPacer_ReportTicks(&pacer, 4, MS(4));
+    assert_true(pacer.tick_ns == 1e6);
+
+    ReplayPacer_ReportTicks(&pacer, 1, MS(9));
+    assert_true(pacer.tick_ns == 2e6);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_unmeasured_runs_requested_speed),
+        cmocka_unit_test(test_cheap_ticks_follow_speed),
+        cmocka_unit_test(test_expensive_ticks_are_capped_by_budget),
+        cmocka_unit_test(test_max_speed_fills_budget),
+        cmocka_unit_test(test_slow_frames_keep_real_time),
+        cmocka_unit_test(test_tick_cost_is_smoothed),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,215 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "port/selfplay_stats.h"
+
+static SelfPlayMatch make_match(int index, int p1, int p2, int winner, int end, int frames) {
+    SelfPlayMatch m;
+    memset(&m, 0, sizeof(m));
+    m.index = index;
+    m.seed = 1000u + (unsigned int)index;
+    SelfPlaySetup_FromSeed(m.seed, &m.setup);
+    m.setup.chars[0] = p1;
+    m.setup.chars[1] = p2;
+    m.winner = winner;
+    m.end = end;
+    m.frames = frames;
+    return m;
+}
+
+// --- Tests ---
+
+static void test_setup_is_reproducible(void** state) {
+    (void)state;
+    bool seen_char[SELFPLAY_CHARACTER_COUNT] = { false };
+    bool seen_stage[SELFPLAY_STAGE_COUNT] = { false };
+    bool seen_arts[3] = { false };
+    int differs = 0;
+
+    for (unsigned int seed = 1; seed <= 2000; seed++) {
+        SelfPlaySetup a;
+        SelfPlaySetup b;
+        SelfPlaySetup_FromSeed(seed, &a);
+        SelfPlaySetup_FromSeed(seed, &b);
+        assert_memory_equal(&a, &b, sizeof(a));
+
+        for (int side = 0; side < 2; side++) {
+            assert_in_range(a.chars[side], 0, SELFPLAY_CHARACTER_COUNT - 1);
+            assert_in_range(a.super_arts[side], 0, 2);
+            seen_char[a.chars[side]] = true;
+            seen_arts[a.super_arts[side]] = true;
+        }
+        assert_in_range(a.stage_slot, 0, SELFPLAY_STAGE_COUNT - 1);
+        seen_stage[a.stage_slot] = true;
+
+        // Consecutive seeds are consecutive matches; they shouldn't repeat a setup
+        SelfPlaySetup_FromSeed(seed + 1, &b);
+        differs += memcmp(&a, &b, sizeof(a)) != 0;
+    }
+
+    for (int i = 0; i < SELFPLAY_CHARACTER_COUNT; i++) {
+        assert_true(seen_char[i]);
+    }
+    for (int i = 0; i < SELFPLAY_STAGE_COUNT; i++) {
+        assert_true(seen_stage[i]);
+    }
+    assert_true(seen_arts[0] && seen_arts[1] && seen_arts[2]);
+    assert_int_equal(differs, 2000);
+}
+
+static void test_records_count_each_side(void** state) {
+    (void)state;
+    SelfPlayTotals totals = { 0 };
+    SelfPlayRecord record;
+
+    SelfPlayMatch m = make_match(0, 2, 11, 0, SELFPLAY_END_KO, 1200);
+    assert_true(SelfPlayTotals_AddMatch(&totals, &m));
+    m = make_match(1, 11, 2, 0, SELFPLAY_END_TIME, 5940);
+    assert_true(SelfPlayTotals_AddMatch(&totals, &m));
+    m = make_match(2, 2, 2, 1, SELFPLAY_END_KO, 900);
+    assert_true(SelfPlayTotals_AddMatch(&totals, &m));
+    m = make_match(3, 11, 2, -1, SELFPLAY_END_DOUBLE_KO, 1960);
+    assert_true(SelfPlayTotals_AddMatch(&totals, &m));
+
+    // Ryu: won once, lost once, split the mirror, drew once
+    SelfPlayTotals_Record(&totals, 2, &record);
+    assert_int_equal(record.matches, 5);
+    assert_int_equal(record.wins, 2);
+    assert_int_equal(record.losses, 2);
+    assert_int_equal(record.draws, 1);
+
+    SelfPlayTotals_Record(&totals, 11, &record);
+    assert_int_equal(record.matches, 3);
+    assert_int_equal(record.wins, 1);
+    assert_int_equal(record.losses, 1);
+    assert_int_equal(record.draws, 1);
+
+    SelfPlayTotals_Record(&totals, 0, &record);
+    assert_int_equal(record.matches, 0);
+
+    assert_true(SelfPlayTotals_MeanFrames(&totals) == 2500.0);
+
+    SelfPlayTotals_Free(&totals);
+    assert_null(totals.matches);
+    assert_true(SelfPlayTotals_MeanFrames(&totals) == 0.0);
+}
+
+static void test_worker_text_round_trip(void** state) {
+    (void)state;
+    SelfPlayTotals worker = { 0 };
+    SelfPlayTotals merged = { 0 };
+
+    // More matches than the first allocation holds
+    for (int i = 0; i < 300; i++) {
+        SelfPlayMatch m = make_match(299 - i, i % 20, (i * 7) % 20, (i % 3) - 1, i % SELFPLAY_END_COUNT, 600 + i);
+        assert_true(SelfPlayTotals_AddMatch(&worker, &m));
+    }
+    worker.moves[2][0x30] = 17;
+    worker.moves[19][255] = 3;
+    worker.ticks = 123456789012ull;
+    worker.busy_ns = 987654321098ull;
+
+    FILE* f = tmpfile();
+    assert_non_null(f);
+    assert_true(SelfPlayTotals_Write(&worker, f));
+    assert_true(SelfPlayTotals_Write(&worker, f)); // A second worker's file, concatenated
+    rewind(f);
+
+    assert_true(SelfPlayTotals_Read(&merged, f));
+    fclose(f);
+
+    assert_int_equal(merged.count, 600);
+    assert_int_equal(merged.moves[2][0x30], 34);
+    assert_int_equal(merged.moves[19][255], 6);
+    assert_int_equal(merged.moves[0][0], 0);
+    assert_true(merged.ticks == 2 * 123456789012ull);
+    assert_true(merged.busy_ns == 2 * 987654321098ull);
+    assert_memory_equal(&merged.matches[0], &worker.matches[0], sizeof(SelfPlayMatch));
+
+    SelfPlayTotals_SortMatches(&merged);
+    for (size_t i = 0; i < merged.count; i++) {
+        assert_int_equal(merged.matches[i].index, (int)(i / 2));
+    }
+
+    SelfPlayTotals sum = { 0 };
+    assert_true(SelfPlayTotals_Merge(&sum, &worker));
+    assert_true(SelfPlayTotals_Merge(&sum, &worker));
+    assert_int_equal(sum.count, 600);
+    assert_int_equal(sum.moves[2][0x30], 34);
+    assert_true(sum.ticks == merged.ticks);
+
+    SelfPlayTotals_Free(&sum);
+    SelfPlayTotals_Free(&merged);
+    SelfPlayTotals_Free(&worker);
+}
+
+static void test_find_and_compare_matches(void** state) {
+    (void)state;
+    SelfPlayTotals totals = { 0 };
+
+    for (int i = 0; i < 5; i++) {
+        SelfPlayMatch m = make_match(10 + i, i, i + 1, i % 2, SELFPLAY_END_KO, 1000 + i);
+        assert_true(SelfPlayTotals_AddMatch(&totals, &m));
+    }
+
+    const SelfPlayMatch* found = SelfPlayTotals_FindMatch(&totals, 13);
+    assert_non_null(found);
+    assert_int_equal(found->index, 13);
+    assert_null(SelfPlayTotals_FindMatch(&totals, 9));
+    assert_null(SelfPlayTotals_FindMatch(&totals, 15));
+
+    // The same match replayed alone
+    SelfPlayMatch alone = *found;
+    assert_true(SelfPlayMatch_SameResult(found, &alone));
+
+    alone.frames += 1;
+    assert_false(SelfPlayMatch_SameResult(found, &alone));
+    alone = *found;
+    alone.winner = -1;
+    assert_false(SelfPlayMatch_SameResult(found, &alone));
+    alone = *found;
+    alone.setup.random_ix[4] ^= 1;
+    assert_false(SelfPlayMatch_SameResult(found, &alone));
+    assert_false(SelfPlayMatch_SameResult(found, &totals.matches[0]));
+
+    SelfPlayTotals_Free(&totals);
+}
+
+static void test_rejects_malformed_text(void** state) {
+    (void)state;
+    static const char* const bad[] = {
+        "ticks 1 2\n",                                          // No header
+        "selfplay 99\n",                                        // Unknown version
+        "selfplay 1\nmatch 0 1 2 3\n",                          // Truncated match
+        "selfplay 1\nmatch 0 1 25 3 0 0 0 0 0 60 1 2 3 4 5 6 7 8 9\n", // Character out of range
+        "selfplay 1\nmove 2 300 1\n",                           // Move id out of range
+        "selfplay 1\nscore 4\n",                                // Unknown line
+    };
+
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        SelfPlayTotals totals = { 0 };
+        FILE* f = tmpfile();
+        assert_non_null(f);
+        fputs(bad[i], f);
+        rewind(f);
+        assert_false(SelfPlayTotals_Read(&totals, f));
+        fclose(f);
+        SelfPlayTotals_Free(&totals);
+    }
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_setup_is_reproducible),
+        cmocka_unit_test(test_records_count_each_side),
+        cmocka_unit_test(test_worker_text_round_trip),
+        cmocka_unit_test(test_find_and_compare_matches),
+        cmocka_unit_test(test_rejects_malformed_text),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
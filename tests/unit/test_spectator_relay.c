@@ -0,0 +1,197 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "netplay/spectator_relay.h"
+
+// Relay trees over loopback: every node is a separate SpectatorRelay with its
+// own UDP socket, exactly as separate processes would be.
+
+#define MAX_NODES 6
+
+static SpectatorRelay* nodes[MAX_NODES];
+static int node_count = 0;
+
+static SpectatorRelay* add_node(SpectatorRelay* upstream) {
+    SpectatorRelay* node = SpectatorRelay_Create(0);
+    assert_non_null(node);
+
+    if (upstream) {
+        char endpoint[32];
+        snprintf(endpoint, sizeof(endpoint), "127.0.0.1:%u", SpectatorRelay_GetPort(upstream));
+        assert_true(SpectatorRelay_SetUpstream(node, endpoint));
+    }
+
+    nodes[node_count++] = node;
+    return node;
+}
+
+static void destroy_nodes(void) {
+    for (int i = 0; i < node_count; i++) {
+        SpectatorRelay_Destroy(nodes[i]);
+    }
+    node_count = 0;
+}
+
+static void poll_all(void) {
+    for (int i = 0; i < node_count; i++) {
+        SpectatorRelay_Poll(nodes[i]);
+    }
+}
+
+/* Poll every node until `node` holds `frames` frames or the deadline passes. */
+static bool wait_for_frames(SpectatorRelay* node, int frames, uint32_t timeout_ms) {
+    Uint64 deadline = SDL_GetTicks() + timeout_ms;
+    while (SDL_GetTicks() < deadline) {
+        poll_all();
+        if (SpectatorRelay_GetFrameCount(node) >= frames)
+            return true;
+        SDL_Delay(1);
+    }
+    return false;
+}
+
+static void frame_inputs(int frame, uint16_t out[2]) {
+    out[0] = (uint16_t)(frame * 7);
+    out[1] = (uint16_t)(frame ^ 0x5A5A);
+}
+
+static void assert_stream_matches(SpectatorRelay* node, int frames) {
+    assert_int_equal(SpectatorRelay_GetFrameCount(node), frames);
+    for (int f = 0; f < frames; f++) {
+        uint16_t got[2], want[2];
+        assert_true(SpectatorRelay_GetFrame(node, f, got));
+        frame_inputs(f, want);
+        assert_int_equal(got[0], want[0]);
+        assert_int_equal(got[1], want[1]);
+    }
+}
+
+// --- Tests ---
+
+static void test_fan_out_and_chain(void** state) {
+    (void)state;
+    SpectatorRelay* source = add_node(NULL);
+    SpectatorRelay* relay = add_node(source);
+    SpectatorRelay* spec_a = add_node(relay);
+    SpectatorRelay* spec_b = add_node(relay);
+    SpectatorRelay* chained = add_node(spec_a);
+
+    SpectatorRelay_BeginSession(source);
+
+    // Stream 600 frames at roughly game pace, several frames per poll
+    for (int f = 0; f < 600; f++) {
+        uint16_t inputs[2];
+        frame_inputs(f, inputs);
+        SpectatorRelay_PushFrame(source, f, inputs);
+        if (f % 4 == 3) {
+            poll_all();
+            SDL_Delay(1);
+        }
+    }
+
+    assert_true(wait_for_frames(chained, 600, 2000));
+    assert_true(wait_for_frames(spec_b, 600, 2000));
+
+    assert_stream_matches(relay, 600);
+    assert_stream_matches(spec_a, 600);
+    assert_stream_matches(spec_b, 600);
+    assert_stream_matches(chained, 600);
+
+    // The player's uplink only serves the relay
+    SpectatorRelayStats stats;
+    SpectatorRelay_GetStats(source, &stats);
+    assert_int_equal(stats.subscribers, 1);
+    SpectatorRelay_GetStats(relay, &stats);
+    assert_int_equal(stats.subscribers, 2);
+    assert_int_equal(SpectatorRelay_GetSessionId(chained), SpectatorRelay_GetSessionId(source));
+
+    destroy_nodes();
+}
+
+static void test_late_joiner_catches_up(void** state) {
+    (void)state;
+    SpectatorRelay* source = add_node(NULL);
+
+    SpectatorRelay_BeginSession(source);
+    for (int f = 0; f < 5000; f++) {
+        uint16_t inputs[2];
+        frame_inputs(f, inputs);
+        SpectatorRelay_PushFrame(source, f, inputs);
+    }
+
+    SpectatorRelay* late = add_node(source);
+    assert_true(wait_for_frames(late, 5000, 3000));
+    assert_stream_matches(late, 5000);
+
+    destroy_nodes();
+}
+
+static void test_out_of_order_push_is_ignored(void** state) {
+    (void)state;
+    SpectatorRelay* source = add_node(NULL);
+    uint16_t inputs[2] = { 1, 2 };
+
+    // No session yet
+    SpectatorRelay_PushFrame(source, 0, inputs);
+    assert_int_equal(SpectatorRelay_GetFrameCount(source), 0);
+
+    SpectatorRelay_BeginSession(source);
+    SpectatorRelay_PushFrame(source, 1, inputs); // Gap
+    assert_int_equal(SpectatorRelay_GetFrameCount(source), 0);
+    SpectatorRelay_PushFrame(source, 0, inputs);
+    SpectatorRelay_PushFrame(source, 0, inputs); // Duplicate
+    assert_int_equal(SpectatorRelay_GetFrameCount(source), 1);
+
+    destroy_nodes();
+}
+
+static void test_new_session_restarts_stream(void** state) {
+    (void)state;
+    SpectatorRelay* source = add_node(NULL);
+    SpectatorRelay* spec = add_node(source);
+    uint16_t inputs[2];
+
+    SpectatorRelay_BeginSession(source);
+    for (int f = 0; f < 100; f++) {
+        frame_inputs(f, inputs);
+        SpectatorRelay_PushFrame(source, f, inputs);
+    }
+    assert_true(wait_for_frames(spec, 100, 2000));
+    const uint32_t first_session = SpectatorRelay_GetSessionId(spec);
+
+    // Rematch: the stream restarts at frame 0 under a new session id
+    SpectatorRelay_BeginSession(source);
+    for (int f = 0; f < 40; f++) {
+        frame_inputs(f, inputs);
+        SpectatorRelay_PushFrame(source, f, inputs);
+    }
+
+    Uint64 deadline = SDL_GetTicks() + 2000;
+    while (SDL_GetTicks() < deadline &&
+           (SpectatorRelay_GetSessionId(spec) == first_session || SpectatorRelay_GetFrameCount(spec) < 40)) {
+        poll_all();
+        SDL_Delay(1);
+    }
+
+    assert_int_not_equal(SpectatorRelay_GetSessionId(spec), first_session);
+    assert_stream_matches(spec, 40);
+
+    destroy_nodes();
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_fan_out_and_chain),
+        cmocka_unit_test(test_late_joiner_catches_up),
+        cmocka_unit_test(test_out_of_order_push_is_ignored),
+        cmocka_unit_test(test_new_session_restarts_stream),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,261 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define closesocket close
+#endif
+
+#include "netplay/stun.h"
+
+// --- Loopback socket pair ---
+
+#define BENCH_ROUNDS 2000
+#define BENCH_BATCH 16
+#define PACKET_SIZE 64
+
+// Frames the benchmark counts allocations over: each one receives and sends
+// BENCH_BATCH packets, about what a netplay frame with spectators moves
+#define BENCH_FRAME_PACKETS BENCH_BATCH
+
+static int sock_a = -1;
+static int sock_b = -1;
+static StunEndpoint ep_a;
+static StunEndpoint ep_b;
+
+static int open_loopback(StunEndpoint* ep) {
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = (int)socket(AF_INET, SOCK_DGRAM, 0);
+    bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+    getsockname(fd, (struct sockaddr*)&addr, &addr_len);
+
+    StunResult r = { 0 };
+    r.socket_fd = fd;
+    Stun_SetNonBlocking(&r);
+
+    memset(ep, 0, sizeof(*ep));
+    ep->ip = addr.sin_addr.s_addr;
+    ep->port = addr.sin_port;
+    return fd;
+}
+
+static void fill_payload(char* buf, int seq) {
+    memset(buf, (char)seq, PACKET_SIZE);
+    memcpy(buf, &seq, sizeof(seq));
+}
+
+static int setup(void** state) {
+    (void)state;
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    sock_a = open_loopback(&ep_a);
+    sock_b = open_loopback(&ep_b);
+    return 0;
+}
+
+static int teardown(void** state) {
+    (void)state;
+    Stun_SocketClose(sock_a);
+    Stun_SocketClose(sock_b);
+    return 0;
+}
+
+// --- Allocation counting through SDL's memory functions ---
+
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+static int allocations = 0;
+
+static void* SDLCALL counting_malloc(size_t size) {
+    allocations++;
+    return real_malloc(size);
+}
+
+static void* SDLCALL counting_calloc(size_t nmemb, size_t size) {
+    allocations++;
+    return real_calloc(nmemb, size);
+}
+
+static void* SDLCALL counting_realloc(void* mem, size_t size) {
+    allocations++;
+    return real_realloc(mem, size);
+}
+
+static void SDLCALL counting_free(void* mem) {
+    real_free(mem);
+}
+
+/* Receive exactly `count` datagrams, spinning briefly for loopback delivery. */
+static int recv_all(StunDatagram* dgrams, int count) {
+    int got = 0;
+    Uint64 deadline = SDL_GetTicks() + 1000;
+    while (got < count && SDL_GetTicks() < deadline) {
+        int n = Stun_SocketRecvBatch(sock_b, dgrams + got, count - got);
+        if (n < 0)
+            return n;
+        got += n;
+    }
+    return got;
+}
+
+// --- Tests ---
+
+static void test_parse_endpoint(void** state) {
+    (void)state;
+    StunEndpoint ep;
+
+    assert_true(Stun_ParseEndpoint("192.168.1.20:7000", &ep));
+    assert_int_equal(ep.ip, inet_addr("192.168.1.20"));
+    assert_int_equal(ntohs(ep.port), 7000);
+    assert_int_equal(ep.pad, 0);
+
+    assert_false(Stun_ParseEndpoint("192.168.1.20", &ep));
+    assert_false(Stun_ParseEndpoint("not-an-ip:7000", &ep));
+    assert_false(Stun_ParseEndpoint("10.0.0.1:0", &ep));
+    assert_false(Stun_ParseEndpoint("10.0.0.1:70000", &ep));
+}
+
+static void test_recv_batch_empty_socket(void** state) {
+    (void)state;
+    char buf[PACKET_SIZE];
+    StunDatagram d = { .buf = buf, .buf_size = sizeof(buf) };
+
+    assert_int_equal(Stun_SocketRecvBatch(sock_b, &d, 1), 0);
+}
+
+static void test_batch_roundtrip(void** state) {
+    (void)state;
+    char tx[BENCH_BATCH][PACKET_SIZE];
+    char rx[BENCH_BATCH][PACKET_SIZE];
+    StunDatagram out[BENCH_BATCH];
+    StunDatagram in[BENCH_BATCH];
+
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        fill_payload(tx[i], i);
+        out[i] = (StunDatagram){ .addr = ep_b, .buf = tx[i], .len = PACKET_SIZE - i };
+        in[i] = (StunDatagram){ .buf = rx[i], .buf_size = PACKET_SIZE };
+    }
+
+    assert_int_equal(Stun_SocketSendBatch(sock_a, out, BENCH_BATCH), BENCH_BATCH);
+    assert_int_equal(recv_all(in, BENCH_BATCH), BENCH_BATCH);
+
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        assert_int_equal(in[i].len, PACKET_SIZE - i);
+        assert_memory_equal(in[i].buf, tx[i], in[i].len);
+        // Source endpoint must compare bytewise-equal to the sender's endpoint
+        assert_memory_equal(&in[i].addr, &ep_a, sizeof(StunEndpoint));
+    }
+}
+
+/* Loopback throughput: string-addressed per-packet path vs. binary batched path. */
+static void test_bench_packets_per_second(void** state) {
+    (void)state;
+    char tx[BENCH_BATCH][PACKET_SIZE];
+    char rx[BENCH_BATCH][PACKET_SIZE];
+    StunDatagram out[BENCH_BATCH];
+    StunDatagram in[BENCH_BATCH];
+    char dest_str[32];
+    char from_str[48];
+    char ip_str[16];
+
+    Stun_FormatIP(ep_b.ip, ip_str, sizeof(ip_str));
+    snprintf(dest_str, sizeof(dest_str), "%s:%u", ip_str, ntohs(ep_b.port));
+
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        fill_payload(tx[i], i);
+        out[i] = (StunDatagram){ .addr = ep_b, .buf = tx[i], .len = PACKET_SIZE };
+        in[i] = (StunDatagram){ .buf = rx[i], .buf_size = PACKET_SIZE };
+    }
+
+    const int total = BENCH_ROUNDS * BENCH_BATCH;
+    const int frames = total / BENCH_FRAME_PACKETS;
+
+    allocations = 0;
+    Uint64 t0 = SDL_GetTicksNS();
+    int string_received = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (int i = 0; i < BENCH_BATCH; i++)
+            Stun_SocketSendTo(sock_a, dest_str, tx[i], PACKET_SIZE);
+        int got = 0;
+        Uint64 deadline = SDL_GetTicks() + 1000;
+        while (got < BENCH_BATCH && SDL_GetTicks() < deadline) {
+            const int len = Stun_SocketRecvFrom(sock_b, rx[0], PACKET_SIZE, from_str, sizeof(from_str));
+            if (len > 0) {
+                // What the adapter used to hand GekkoNet: result, address string and payload
+                void* result = SDL_malloc(32);
+                char* addr = SDL_strdup(from_str);
+                void* payload = SDL_malloc(len);
+                SDL_memcpy(payload, rx[0], len);
+                SDL_free(payload);
+                SDL_free(addr);
+                SDL_free(result);
+                got++;
+            }
+        }
+        string_received += got;
+    }
+    Uint64 t1 = SDL_GetTicksNS();
+    const int string_allocations = allocations;
+
+    allocations = 0;
+    int batch_received = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        Stun_SocketSendBatch(sock_a, out, BENCH_BATCH);
+        batch_received += recv_all(in, BENCH_BATCH);
+    }
+    Uint64 t2 = SDL_GetTicksNS();
+    const int batch_allocations = allocations;
+
+    assert_int_equal(string_received, total);
+    assert_int_equal(batch_received, total);
+    assert_int_equal(batch_allocations, 0);
+
+    double string_pps = total / ((double)(t1 - t0) / 1e9);
+    double batch_pps = total / ((double)(t2 - t1) / 1e9);
+    printf("[bench] %d packets: string path %.0f pkt/s, batched endpoint path %.0f pkt/s (%.2fx)\n",
+           total,
+           string_pps,
+           batch_pps,
+           batch_pps / string_pps);
+    printf("[bench] allocations per %d-packet frame: string path %.2f, batched endpoint path %.2f\n",
+           BENCH_FRAME_PACKETS,
+           (double)string_allocations / frames,
+           (double)batch_allocations / frames);
+}
+
+int main(void) {
+    // Count every SDL allocation the socket paths make from here on
+    SDL_GetOriginalMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, counting_free);
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_parse_endpoint),
+        cmocka_unit_test(test_recv_batch_empty_socket),
+        cmocka_unit_test(test_batch_roundtrip),
+        cmocka_unit_test(test_bench_packets_per_second),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
@@ -0,0 +1,202 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include "cmocka.h"
+#include <SDL3/SDL.h>
+
+#include "game_state.h"
+#include "port/sdl/training_menu.h"
+#include "sf33rd/Source/Game/training/training_dummy.h"
+#include "sf33rd/Source/Game/training/training_fork.h"
+#include "sf33rd/Source/Game/training/training_state.h"
+
+// --- Mocks ---
+ModeType Mode_Type = MODE_NORMAL_TRAINING;
+u8 No_Trans = 0;
+u16 p1sw_0 = 0;
+u16 p1sw_1 = 0;
+u16 p2sw_0 = 0;
+u16 p2sw_1 = 0;
+u16 PLsw[2][2];
+bool sound_requests_held = false;
+TrainingGameState g_training_state = { 0 };
+DummySettings g_dummy_settings = { 0 };
+TrainingMenuSettings g_training_menu_settings = { 0 };
+
+static int frames_simulated = 0;
+static int lookahead_budget_us = 16000;
+static Uint64 frame_delay_ns = 0; // Makes each simulated frame this slow
+
+TrainingPlayerState* get_training_player(s16 id) {
+    return (id == 0) ? &g_training_state.p1 : &g_training_state.p2;
+}
+
+// The match itself is the training state in these tests, which the fork
+// snapshots on its own
+void RollbackState_Save(RollbackState* dst) {
+    (void)dst;
+}
+
+void RollbackState_Load(const RollbackState* src) {
+    (void)src;
+}
+
+int Config_GetInt(const char* key) {
+    (void)key;
+    return lookahead_budget_us;
+}
+
+void SDLGameRenderer_ResetBatchState() {}
+void Renderer_Flush2DPrimitives(void) {}
+void seqsBeforeProcess() {}
+void seqsAfterProcess() {}
+
+// Stubbed tracker: P1's move touches P2 on its 5th frame. On hit it recovers
+// on frame 20 at +3; blocked, on frame 15 at -4. A move started on frame 900
+// never recovers.
+void njUserMain() {
+    TrainingPlayerState* atk = &g_training_state.p1;
+    TrainingPlayerState* def = &g_training_state.p2;
+    const bool blocking = (g_dummy_settings.block_type == DUMMY_BLOCK_ALWAYS);
+
+    frames_simulated += 1;
+    g_training_state.frame_number += 1;
+
+    if (frame_delay_ns > 0) {
+        const Uint64 start = SDL_GetTicksNS();
+        while (SDL_GetTicksNS() - start < frame_delay_ns) {
+        }
+    }
+
+    if (!atk->advantage_active || atk->attack_start_frame >= 900) {
+        return;
+    }
+
+    const s32 elapsed = g_training_state.frame_number - atk->attack_start_frame;
+
+    if (elapsed == 5) {
+        atk->opponent_was_affected = true;
+        def->current_frame_state = blocking ? FRAME_STATE_BLOCKSTUN : FRAME_STATE_HITSTUN;
+    }
+
+    if (elapsed == (blocking ? 15 : 20)) {
+        atk->advantage_active = false;
+        atk->advantage_value = blocking ? -4 : 3;
+    }
+}
+// -----------
+
+static void start_move(s32 frame) {
+    memset(&g_training_state, 0, sizeof(g_training_state));
+    g_training_state.frame_number = frame;
+    g_training_state.p1.advantage_active = true;
+    g_training_state.p1.attack_start_frame = frame;
+    g_dummy_settings.block_type = DUMMY_BLOCK_NONE;
+    g_training_menu_settings.show_advantage = true;
+    frames_simulated = 0;
+    lookahead_budget_us = 16000;
+    frame_delay_ns = 0;
+}
+
+static void test_branches_resolve_hit_and_block(void** state) {
+    (void)state;
+    start_move(100);
+
+    training_fork_step();
+
+    const TrainingForkBranch* hit = &g_training_fork.branch[FORK_BRANCH_NO_BLOCK];
+    const TrainingForkBranch* block = &g_training_fork.branch[FORK_BRANCH_BLOCK];
+
+    assert_true(g_training_fork.active);
+    assert_int_equal(g_training_fork.attacker, 0);
+    assert_int_equal(g_training_fork.attack_start_frame, 100);
+
+    assert_true(hit->resolved);
+    assert_int_equal(hit->outcome, FORK_OUTCOME_HIT);
+    assert_int_equal(hit->connect_frame, 5);
+    assert_int_equal(hit->advantage, 3);
+    assert_int_equal(hit->punish_window, 0);
+
+    assert_true(block->resolved);
+    assert_int_equal(block->outcome, FORK_OUTCOME_BLOCK);
+    assert_int_equal(block->connect_frame, 5);
+    assert_int_equal(block->advantage, -4);
+    assert_int_equal(block->punish_window, 4);
+
+    assert_int_equal(g_training_fork.frames_run, 20 + 15);
+    assert_int_equal(frames_simulated, 20 + 15);
+
+    // The real match is put back as it was
+    assert_int_equal(g_training_state.frame_number, 100);
+    assert_true(g_training_state.p1.advantage_active);
+    assert_false(g_training_state.p1.opponent_was_affected);
+    assert_int_equal(g_dummy_settings.block_type, DUMMY_BLOCK_NONE);
+    assert_false(sound_requests_held);
+
+    // Nothing new is simulated until the real match moves on
+    training_fork_step();
+    assert_int_equal(frames_simulated, 20 + 15);
+}
+
+static void test_lookahead_gives_up_unresolved(void** state) {
+    (void)state;
+    start_move(900);
+
+    training_fork_step();
+
+    for (int i = 0; i < FORK_BRANCH_COUNT; i++) {
+        assert_false(g_training_fork.branch[i].resolved);
+        assert_int_equal(g_training_fork.branch[i].outcome, FORK_OUTCOME_UNRESOLVED);
+    }
+    assert_int_equal(g_training_state.frame_number, 900);
+}
+
+static void test_overtaken_prediction_is_dropped(void** state) {
+    (void)state;
+    start_move(300);
+
+    // A slow machine: the minimum budget only fits a few frames per slice
+    lookahead_budget_us = 0;
+    frame_delay_ns = 100 * 1000;
+
+    training_fork_step();
+    assert_true(g_training_fork.active);
+    assert_true(g_training_fork.frames_run < 20);
+    assert_int_equal(g_training_fork.branch[FORK_BRANCH_BLOCK].outcome, FORK_OUTCOME_PENDING);
+
+    // The real match recovers before the lookahead is done
+    g_training_state.frame_number += 1;
+    g_training_state.p1.advantage_active = false;
+    const u32 frames_run = g_training_fork.frames_run;
+
+    training_fork_step();
+
+    for (int i = 0; i < FORK_BRANCH_COUNT; i++) {
+        assert_false(g_training_fork.branch[i].resolved);
+        assert_int_equal(g_training_fork.branch[i].outcome, FORK_OUTCOME_UNRESOLVED);
+    }
+    assert_int_equal(g_training_fork.frames_run, frames_run);
+}
+
+static void test_off_outside_training(void** state) {
+    (void)state;
+    start_move(200);
+    g_training_menu_settings.show_advantage = false;
+
+    training_fork_step();
+
+    assert_false(g_training_fork.active);
+    assert_int_equal(frames_simulated, 0);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_branches_resolve_hit_and_block),
+        cmocka_unit_test(test_lookahead_gives_up_unresolved),
+        cmocka_unit_test(test_overtaken_prediction_is_dropped),
+        cmocka_unit_test(test_off_outside_training),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
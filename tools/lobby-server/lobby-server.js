@@ -7,6 +7,10 @@
  * Players register presence, mark themselves as "searching", and exchange
  * STUN room codes to establish P2P connections via hole-punching.
  *
+ * Clients keep HTTP/1.1 connections alive and long-poll GET /searching?wait=<version>:
+ * the request is parked until the lobby version changes (or the timeout
+ * passes), so changes are pushed instead of being discovered by polling.
+ *
  * Security: HMAC-SHA256 request signing.
  *   - Every request must include X-Timestamp and X-Signature headers.
  *   - Signature = HMAC-SHA256(secret, timestamp + method + path + body)
@@ -36,14 +40,55 @@ if (!SECRET) {
 /** @type {Map<string, {display_name: string, region: string, room_code: string, connect_to: string, status: string, last_seen: number}>} */
 const players = new Map();
 
+// Bumped on every change visible through GET /searching; long-poll waiters wake on it.
+let lobbyVersion = 1;
+
+/** @type {Set<{res: http.ServerResponse, regionFilter: string|null, timer: NodeJS.Timeout}>} */
+const waiters = new Set();
+
+const WAIT_TIMEOUT_MIN_MS = 1_000;
+const WAIT_TIMEOUT_MAX_MS = 30_000;
+
+function searchingList(regionFilter) {
+    const result = [];
+    for (const [id, p] of players) {
+        if (p.status !== 'searching') continue;
+        if (regionFilter && p.region !== regionFilter) continue;
+        result.push({
+            player_id: id,
+            display_name: p.display_name,
+            region: p.region,
+            room_code: p.room_code,
+            connect_to: p.connect_to || '',
+        });
+    }
+    return result;
+}
+
+function answerWaiter(w) {
+    clearTimeout(w.timer);
+    waiters.delete(w);
+    json(w.res, 200, { version: lobbyVersion, players: searchingList(w.regionFilter) });
+}
+
+function bumpLobby() {
+    lobbyVersion++;
+    for (const w of [...waiters]) {
+        answerWaiter(w);
+    }
+}
+
 // Cleanup stale players every 30 seconds
 setInterval(() => {
     const now = Date.now();
+    let changed = false;
     for (const [id, p] of players) {
         if (now - p.last_seen > 60_000) {
             players.delete(id);
+            changed = true;
         }
     }
+    if (changed) bumpLobby();
 }, 30_000);
 
 // ---- Auth ----
@@ -134,14 +179,21 @@ async function handleRequest(req, res) {
         }
 
         const existing = players.get(player_id);
-        players.set(player_id, {
+        const updated = {
             display_name: String(display_name).slice(0, 31),
             region: String(region || '').slice(0, 7),
             room_code: String(room_code || '').slice(0, 15),
             connect_to: String(connect_to || '').slice(0, 15),
             status: existing ? existing.status : 'idle',
             last_seen: Date.now(),
-        });
+        };
+        // Periodic keep-alive refreshes must not wake every long-poller
+        let changed = !existing ||
+            existing.display_name !== updated.display_name ||
+            existing.region !== updated.region ||
+            existing.room_code !== updated.room_code ||
+            existing.connect_to !== updated.connect_to;
+        players.set(player_id, updated);
 
         // Server-side connect matching: if A wants to connect to B,
         // automatically set B's connect_to to A's room_code so both
@@ -151,12 +203,14 @@ async function handleRequest(req, res) {
                 if (otherId === player_id) continue;
                 if (other.room_code === connect_to) {
                     other.connect_to = String(room_code).slice(0, 15);
+                    changed = true;
                     console.log(`[match] ${display_name} -> ${other.display_name} (mutual connect_to set)`);
                     break;
                 }
             }
         }
 
+        if (changed) bumpLobby();
         return json(res, 200, { ok: true });
     }
 
@@ -168,8 +222,10 @@ async function handleRequest(req, res) {
         const p = players.get(data.player_id);
         if (!p) return json(res, 404, { error: 'Player not found. Call /presence first.' });
 
+        const changed = p.status !== 'searching';
         p.status = 'searching';
         p.last_seen = Date.now();
+        if (changed) bumpLobby();
         return json(res, 200, { ok: true });
     }
 
@@ -181,29 +237,34 @@ async function handleRequest(req, res) {
         const p = players.get(data.player_id);
         if (!p) return json(res, 404, { error: 'Player not found' });
 
+        const changed = p.status !== 'idle';
         p.status = 'idle';
         p.last_seen = Date.now();
+        if (changed) bumpLobby();
         return json(res, 200, { ok: true });
     }
 
-    // --- GET /searching ---
+    // --- GET /searching[?wait=<version>&timeout=<ms>] ---
     if (method === 'GET' && path === '/searching') {
         const regionFilter = url.searchParams.get('region');
-        const result = [];
-
-        for (const [id, p] of players) {
-            if (p.status !== 'searching') continue;
-            if (regionFilter && p.region !== regionFilter) continue;
-            result.push({
-                player_id: id,
-                display_name: p.display_name,
-                region: p.region,
-                room_code: p.room_code,
-                connect_to: p.connect_to || '',
+        const wait = url.searchParams.get('wait');
+
+        // Long-poll: park the request while the client is already up to date
+        if (wait !== null && parseInt(wait, 10) === lobbyVersion) {
+            const requested = parseInt(url.searchParams.get('timeout') || '', 10);
+            const timeout = Math.min(Math.max(isNaN(requested) ? WAIT_TIMEOUT_MAX_MS : requested,
+                WAIT_TIMEOUT_MIN_MS), WAIT_TIMEOUT_MAX_MS);
+            const w = { res, regionFilter, timer: null };
+            w.timer = setTimeout(() => answerWaiter(w), timeout);
+            waiters.add(w);
+            res.on('close', () => {
+                clearTimeout(w.timer);
+                waiters.delete(w);
             });
+            return;
         }
 
-        return json(res, 200, { players: result });
+        return json(res, 200, { version: lobbyVersion, players: searchingList(regionFilter) });
     }
 
     // --- POST /leave ---
@@ -211,7 +272,7 @@ async function handleRequest(req, res) {
         let data;
         try { data = JSON.parse(body); } catch { return json(res, 400, { error: 'Invalid JSON' }); }
 
-        players.delete(data.player_id);
+        if (players.delete(data.player_id)) bumpLobby();
         return json(res, 200, { ok: true });
     }
 
@@ -229,6 +290,10 @@ const server = http.createServer(async (req, res) => {
     }
 });
 
+// Clients hold connections open between requests; outlive their presence/long-poll cadence
+server.keepAliveTimeout = 65_000;
+server.headersTimeout = 66_000;
+
 server.listen(PORT, '0.0.0.0', () => {
     console.log(`3SX Lobby Server listening on port ${PORT}`);
     console.log(`HMAC auth: enabled (key length: ${SECRET.length})`);
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+Transcode a native 3SX recording (.3sxrec) into a regular video file.
+
+The game records the 384x224 canvas as losslessly delta-encoded frames plus
+one raw PCM track per audio source (see src/port/recorder_codec.h). This
+tool decodes the frames, pipes them into ffmpeg and mixes the audio tracks.
+
+Usage:
+    python tools/rec2video.py <input.3sxrec> <output.mp4> [--scale N] [--crf N]
+
+Prerequisites:
+    - ffmpeg on PATH
+"""
+
+import argparse
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+import wave
+import zlib
+
+FILE_MAGIC = 0x52585333  # "3SXR"
+FILE_VERSION = 1
+FLAG_BOTTOM_UP = 0x1
+
+CHUNK_VIDEO_KEY = 1
+CHUNK_VIDEO_DELTA = 2
+CHUNK_VIDEO_REPEAT = 3
+CHUNK_AUDIO = 4
+
+FILE_HEADER = struct.Struct("<IIHHIQIHH")
+CHUNK_HEADER = struct.Struct("<IIQII")
+
+
+def read_header(f):
+    data = f.read(FILE_HEADER.size)
+    if len(data) != FILE_HEADER.size:
+        raise ValueError("file too short")
+    (magic, version, width, height, flags, frame_time_ns, sample_rate, channels, sources) = FILE_HEADER.unpack(data)
+    if magic != FILE_MAGIC:
+        raise ValueError("not a 3SX recording")
+    if version != FILE_VERSION:
+        raise ValueError(f"unsupported recording version {version}")
+    return {
+        "width": width,
+        "height": height,
+        "flags": flags,
+        "frame_time_ns": frame_time_ns,
+        "sample_rate": sample_rate,
+        "channels": channels,
+        "sources": sources,
+    }
+
+
+def chunks(f):
+    """Yield (type, timestamp, track, payload) until the end of the file.
+
+    A recording cut short by a crash ends in a partial chunk, which is ignored.
+    """
+    while True:
+        data = f.read(CHUNK_HEADER.size)
+        if len(data) != CHUNK_HEADER.size:
+            return
+        chunk_type, size, timestamp, track, _ = CHUNK_HEADER.unpack(data)
+        payload = f.read(size)
+        if len(payload) != size:
+            return
+        yield chunk_type, timestamp, track, payload
+
+
+def extract_audio(path, header, out_dir):
+    """Write one WAV per audio source, placing each block at its timestamp."""
+    frame_bytes = header["channels"] * 2
+    files = []
+    writers = []
+    positions = []
+    for source in range(header["sources"]):
+        name = os.path.join(out_dir, f"track{source}.wav")
+        w = wave.open(name, "wb")
+        w.setnchannels(header["channels"])
+        w.setsampwidth(2)
+        w.setframerate(header["sample_rate"])
+        files.append(name)
+        writers.append(w)
+        positions.append(0)
+
+    with open(path, "rb") as f:
+        read_header(f)
+        for chunk_type, timestamp, track, payload in chunks(f):
+            if chunk_type != CHUNK_AUDIO or track >= len(writers):
+                continue
+            # Overruns leave gaps; fill them with silence to keep sync
+            if timestamp > positions[track]:
+                writers[track].writeframes(bytes((timestamp - positions[track]) * frame_bytes))
+                positions[track] = timestamp
+            writers[track].writeframes(payload)
+            positions[track] += len(payload) // frame_bytes
+
+    for w in writers:
+        w.close()
+    return [name for name, pos in zip(files, positions) if pos > 0]
+
+
+def decode_video(path, header, sink):
+    """Decode every frame in order and write raw RGBA to `sink`."""
+    frame_size = header["width"] * header["height"] * 4
+    reference = None
+    frames = 0
+    with open(path, "rb") as f:
+        read_header(f)
+        for chunk_type, timestamp, _, payload in chunks(f):
+            if chunk_type == CHUNK_AUDIO:
+                continue
+            if chunk_type == CHUNK_VIDEO_KEY:
+                reference = zlib.decompress(payload)
+            elif chunk_type == CHUNK_VIDEO_DELTA:
+                if reference is None:
+                    raise ValueError(f"delta frame {timestamp} without a key frame")
+                delta = zlib.decompress(payload)
+                reference = (int.from_bytes(delta, "little") ^ int.from_bytes(reference, "little")).to_bytes(
+                    frame_size, "little"
+                )
+            elif chunk_type == CHUNK_VIDEO_REPEAT:
+                if reference is None:
+                    continue
+            else:
+                continue
+            if len(reference) != frame_size:
+                raise ValueError(f"frame {timestamp} has the wrong size")
+            sink.write(reference)
+            frames += 1
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--scale", type=int, default=3, help="integer upscale factor (nearest neighbour)")
+    parser.add_argument("--crf", type=int, default=16, help="x264 quality, lower is better")
+    args = parser.parse_args()
+
+    ffmpeg = shutil.which("ffmpeg")
+    if not ffmpeg:
+        sys.exit("ffmpeg not found on PATH")
+
+    with open(args.input, "rb") as f:
+        header = read_header(f)
+
+    fps = 1e9 / header["frame_time_ns"]
+    filters = []
+    if header["flags"] & FLAG_BOTTOM_UP:
+        filters.append("vflip")
+    if args.scale > 1:
+        filters.append(f"scale=iw*{args.scale}:ih*{args.scale}:flags=neighbor")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tracks = extract_audio(args.input, header, tmp)
+
+        cmd = [ffmpeg, "-y", "-loglevel", "error", "-f", "rawvideo", "-pix_fmt", "rgba"]
+        cmd += ["-s", f"{header['width']}x{header['height']}", "-r", f"{fps:.5f}", "-i", "pipe:0"]
+        for track in tracks:
+            cmd += ["-i", track]
+
+        graph = [f"[0:v]{','.join(filters) or 'null'}[v]"]
+        if len(tracks) > 1:
+            inputs = "".join(f"[{i + 1}:a]" for i in range(len(tracks)))
+            graph.append(f"{inputs}amix=inputs={len(tracks)}:normalize=0[a]")
+        cmd += ["-filter_complex", ";".join(graph), "-map", "[v]"]
+        if len(tracks) > 1:
+            cmd += ["-map", "[a]"]
+        elif tracks:
+            cmd += ["-map", "1:a"]
+        cmd += ["-c:v", "libx264", "-crf", str(args.crf), "-pix_fmt", "yuv420p"]
+        if tracks:
+            cmd += ["-c:a", "aac", "-b:a", "192k"]
+        cmd.append(args.output)
+
+        proc = subprocess.Popen(cmd, stdin=subprocess.PIPE)
+        try:
+            frames = decode_video(args.input, header, proc.stdin)
+        finally:
+            proc.stdin.close()
+        if proc.wait() != 0:
+            sys.exit("ffmpeg failed")
+
+    print(f"{args.input}: {frames} frames ({frames / fps:.1f} s) -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()